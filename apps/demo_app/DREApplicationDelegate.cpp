@@ -20,14 +20,19 @@
 #include <engine\ApplicationContext.hpp>
 
 #include <foundation\math\Geometry.hpp>
+#include <foundation\system\FrameStats.hpp>
+#include <foundation\system\Log.hpp>
+#include <foundation\system\Profiler.hpp>
+#include <foundation\system\TaskGraph.hpp>
 
 
 ////////////////
 constexpr bool C_COMPILE_GLSL_SOURCES_ON_START = true;
+constexpr std::uint64_t C_ASSET_COMPLETION_BUDGET_US = 4000;
 ////////////////
 
 //////////////////////////////////////////
-DREApplicationDelegate::DREApplicationDelegate(HINSTANCE instance, char const* title, std::uint32_t windowWidth, std::uint32_t windowHeight, std::uint32_t buffering, bool vkDebug, bool imguiEnabled)
+DREApplicationDelegate::DREApplicationDelegate(HINSTANCE instance, char const* title, std::uint32_t windowWidth, std::uint32_t windowHeight, std::uint32_t buffering, bool vkDebug, bool imguiEnabled, char const* inputRecordPath, char const* inputReplayPath)
     : m_MainWindow {
         instance,
         title,
@@ -37,13 +42,17 @@ DREApplicationDelegate::DREApplicationDelegate(HINSTANCE instance, char const* t
         DREApplicationDelegate::WinProc,
         this }
     , m_InputSystem{ m_MainWindow.NativeHandle() }
+    , m_InputRecordPath{ inputRecordPath }
+    , m_InputReplayPath{ inputReplayPath }
     , m_MaterialLibrary{ &DRE::g_MainAllocator }
     , m_GeometryLibrary{ &DRE::g_MainAllocator }
     , m_IOManager{ &DRE::g_MainAllocator, &m_MaterialLibrary, &m_GeometryLibrary }
+    , m_AssetLoader{ &m_IOManager }
     , m_GraphicsManager{ instance, &m_MainWindow, &m_IOManager, vkDebug }
     , m_ImGuiEnabled{ imguiEnabled }
     , m_MainScene{ &DRE::g_MainAllocator }
-    , m_RootEditor{ &m_MainScene }
+    , m_SyntheticSceneGenerator{ &m_MaterialLibrary, &m_GeometryLibrary }
+    , m_RootEditor{ &m_MainScene, &m_SyntheticSceneGenerator }
     , m_WaterGeometry{ sizeof(Data::DREVertex), 4 }
     , m_WaterMaterial{ "water_mat" }
     , m_BeachMaterial{ "beach_mat" }
@@ -101,109 +110,205 @@ WORLD::Scene& DREApplicationDelegate::GetMainScene()
 
 void DREApplicationDelegate::start()
 {
-    if (C_COMPILE_GLSL_SOURCES_ON_START)
-    {  
-        m_IOManager.CompileGLSLSources();
-    }
-    m_IOManager.LoadShaderBinaries();
+    DRE_CPU_THREAD_NAME("Main");
 
-    m_MainScene.GetMainCamera().SetFOV(60.0f);
-    //m_MainScene.GetMainCamera().SetPosition(glm::vec3{ 7.28f, 5.57f, -1.07f });
-    //m_MainScene.GetMainCamera().SetPosition(glm::vec3{ 0.0f, 0.0f, 11.0f });
-    //m_MainScene.GetMainCamera().SetEulerOrientation(glm::vec3{ -17.26f, 107.37f, 0.0f });
+    /////////////////////////////////////////////////////////////////////
+    // models are streamed in while frames keep rendering, start them first so they overlap the whole startup
+    m_AssetLoader.RequestModel("data\\Sponza\\glTF\\Sponza.gltf", m_MainScene, "default_pbr", DRE::TASK_PRIORITY_HIGH,
+        [](WORLD::SceneNode* sponzaNode) { if (sponzaNode != nullptr) sponzaNode->SetScale(0.1f); });
 
-    m_MainScene.GetMainCamera().SetPosition(glm::vec3{ -0.23f, 10.41f, 14.70f });
-    m_MainScene.GetMainCamera().SetCameraEuler(glm::vec3{ -13.32f, -43.83f, 0.0f });
 
-    WORLD::Light* sunLight = m_MainScene.CreateSunLight(m_GraphicsManager.GetMainContext());
-    m_MainScene.SetMainSunLight(sunLight);
+    glm::mat spheresTransform = glm::rotate(glm::identity<glm::mat4>(), glm::radians(180.0f), glm::vec3{ 1.0f, 0.0, 0.0f });
+    m_AssetLoader.RequestModel("data\\MetalRoughSpheres\\glTF\\MetalRoughSpheres.gltf", m_MainScene, "gltf_spheres", DRE::TASK_PRIORITY_NORMAL,
+        nullptr, spheresTransform, Data::TEXTURE_VARIATION_RGBA);
 
-    sunLight->SetEulerOrientation(glm::vec3{ -70.0f, 110.0f, 0.0f });
-    sunLight->ScheduleUpdateGPUData();
 
+    /////////////////////////////////////////////////////////////////////
+    // Startup graph: worker tasks don't touch graphics API or global allocators
+    DRE::ThreadPool startupPool{ DRE::ThreadPool::DefaultWorkerCount() };
+    DRE::TaskGraph startupGraph{ &startupPool };
+
+    Data::Texture2D waterNormalMap;
+    Data::Texture2D beachAlbedo;
+    Data::Texture2D beachNormal;
+    Data::Texture2D beachMetalness;
+    Data::Texture2D beachRoughness;
+    Data::Texture2D blueNoise256;
+
+    auto decodeTask = [this, &startupGraph](char const* name, Data::Texture2D& texture, char const* path, Data::TextureChannelVariations channels)
+    {
+        return startupGraph.AddTask(name, DRE::TASK_AFFINITY_WORKER, [this, &texture, path, channels]() { texture = m_IOManager.ReadTexture2D(path, channels); });
+    };
 
-    if (m_ImGuiEnabled)
-        InitImGui();
+    DRE::TaskGraph::TaskID const compileShaders = startupGraph.AddTask("compile_shaders", DRE::TASK_AFFINITY_WORKER, [this]()
+        {
+            if (C_COMPILE_GLSL_SOURCES_ON_START)
+            {
+                m_IOManager.CompileGLSLSources();
+            }
+        });
 
+    DRE::TaskGraph::TaskID const decodeWaterNormal = decodeTask("decode_water_normal", waterNormalMap, "textures\\water_normal0.jpg", Data::TEXTURE_VARIATION_RGBA);
+    DRE::TaskGraph::TaskID const decodeBeachAlbedo = decodeTask("decode_beach_albedo", beachAlbedo, "textures\\wavy-sand_albedo.png", Data::TEXTURE_VARIATION_RGBA);
+    DRE::TaskGraph::TaskID const decodeBeachNormal = decodeTask("decode_beach_normal", beachNormal, "textures\\wavy-sand_normal-dx.png", Data::TEXTURE_VARIATION_RGBA);
+    DRE::TaskGraph::TaskID const decodeBeachMetalness = decodeTask("decode_beach_metalness", beachMetalness, "textures\\wavy-sand_metallic.png", Data::TEXTURE_VARIATION_GRAY);
+    DRE::TaskGraph::TaskID const decodeBeachRoughness = decodeTask("decode_beach_roughness", beachRoughness, "textures\\wavy-sand_roughness.png", Data::TEXTURE_VARIATION_GRAY);
+    DRE::TaskGraph::TaskID const decodeBlueNoise = decodeTask("decode_blue_noise", blueNoise256, "textures\\blue_noise_rgba.png", Data::TEXTURE_VARIATION_RGBA);
 
-    m_GraphicsManager.LoadDefaultData(&m_ViewportInput);
+    DRE::TaskGraph::TaskID const generateWaterMesh = startupGraph.AddTask("generate_water_mesh", DRE::TASK_AFFINITY_WORKER, [this]()
+        {
+            DRE::ByteBuffer planeVertices;
+            DRE::ByteBuffer planeIndicies;
+            GeneratePlaneMesh(C_WATER_VERTEX_X, C_WATER_VERTEX_Z, planeVertices, planeIndicies);
 
+            m_WaterGeometry.SetVertexData(DRE_MOVE(planeVertices));
+            m_WaterGeometry.SetIndexData(DRE_MOVE(planeIndicies));
+        });
 
+    // SPIR-V reflection runs on IO workers, emplacing into shader data happens on main thread
+    DRE::TaskGraph::TaskID const loadShaderBinaries = startupGraph.AddTask("load_shader_binaries", DRE::TASK_AFFINITY_MAIN_THREAD, [this]()
+        {
+            m_IOManager.LoadShaderBinaries();
+        }, { compileShaders });
 
-    /////////////////////////////////////////////////////////////////////
-    /////////////////////////////////////////////////////////////////////
-    /////////////////////////////////////////////////////////////////////
-    WORLD::SceneNode* sponzaNode = m_IOManager.ParseModelFile("data\\Sponza\\glTF\\Sponza.gltf", m_MainScene, "default_pbr");
-    sponzaNode->SetScale(0.1f);
+    DRE::TaskGraph::TaskID const sceneSetup = startupGraph.AddTask("scene_setup", DRE::TASK_AFFINITY_MAIN_THREAD, [this]()
+        {
+            m_MainScene.GetMainCamera().SetFOV(60.0f);
+            //m_MainScene.GetMainCamera().SetPosition(glm::vec3{ 7.28f, 5.57f, -1.07f });
+            //m_MainScene.GetMainCamera().SetPosition(glm::vec3{ 0.0f, 0.0f, 11.0f });
+            //m_MainScene.GetMainCamera().SetEulerOrientation(glm::vec3{ -17.26f, 107.37f, 0.0f });
 
+            m_MainScene.GetMainCamera().SetPosition(glm::vec3{ -0.23f, 10.41f, 14.70f });
+            m_MainScene.GetMainCamera().SetCameraEuler(glm::vec3{ -13.32f, -43.83f, 0.0f });
 
-    glm::mat spheresTransform = glm::rotate(glm::identity<glm::mat4>(), glm::radians(180.0f), glm::vec3{ 1.0f, 0.0, 0.0f });
-    m_IOManager.ParseModelFile("data\\MetalRoughSpheres\\glTF\\MetalRoughSpheres.gltf", m_MainScene, "gltf_spheres", spheresTransform, Data::TEXTURE_VARIATION_RGBA);
+            WORLD::Light* sunLight = m_MainScene.CreateSunLight(m_GraphicsManager.GetMainContext());
+            m_MainScene.SetMainSunLight(sunLight);
 
-    m_GraphicsManager.GetMainContext().FlushAll();
+            sunLight->SetEulerOrientation(glm::vec3{ -70.0f, 110.0f, 0.0f });
+            sunLight->ScheduleUpdateGPUData();
+        });
 
+    DRE::TaskGraph::TaskID const initImGui = startupGraph.AddTask("init_imgui", DRE::TASK_AFFINITY_MAIN_THREAD, [this]()
+        {
+            if (m_ImGuiEnabled)
+                InitImGui();
+        }, { sceneSetup });
 
-    ////////////
-    DRE::ByteBuffer planeVertices;
-    DRE::ByteBuffer planeIndicies;
-    GeneratePlaneMesh(C_WATER_VERTEX_X, C_WATER_VERTEX_Z, planeVertices, planeIndicies);
+    // pipelines need shader binaries, textures keep decoding in parallel
+    DRE::TaskGraph::TaskID const loadDefaultData = startupGraph.AddTask("load_default_data", DRE::TASK_AFFINITY_MAIN_THREAD, [this]()
+        {
+            m_GraphicsManager.LoadDefaultData(&m_ViewportInput);
+        }, { loadShaderBinaries, initImGui });
 
-    m_WaterGeometry.SetVertexData(DRE_MOVE(planeVertices));
-    m_WaterGeometry.SetIndexData(DRE_MOVE(planeIndicies));
-    Data::Texture2D waterNormalMap = m_IOManager.ReadTexture2D("textures\\water_normal0.jpg", Data::TEXTURE_VARIATION_RGBA);
-    
-    m_WaterMaterial.AssignTextureToSlot(Data::Material::TextureProperty::NORMAL, DRE_MOVE(waterNormalMap));
-    m_WaterMaterial.GetRenderingProperties().SetMaterialType(Data::Material::RenderingProperties::MATERIAL_TYPE_WATER);
-    m_WaterMaterial.GetRenderingProperties().SetShader("water");
+    startupGraph.AddTask("create_water_and_beach", DRE::TASK_AFFINITY_MAIN_THREAD, [&, this]()
+        {
+            m_WaterMaterial.AssignTextureToSlot(Data::Material::TextureProperty::NORMAL, DRE_MOVE(waterNormalMap));
+            m_WaterMaterial.GetRenderingProperties().SetMaterialType(Data::Material::RenderingProperties::MATERIAL_TYPE_WATER);
+            m_WaterMaterial.GetRenderingProperties().SetShader("water");
+
+            glm::mat4 waterTransform = glm::identity<glm::mat4>();
+            //wTrans.model = glm::rotate(wTrans.model, glm::radians(180.0f), glm::vec3(1.0f, 0.0f, 0.0f));
+            waterTransform[3][1] += 1.5f;
+            //wTrans.model[3][2] -= 0.4f;
+            waterTransform = glm::scale(waterTransform, glm::vec3{ 0.1f });
+            WORLD::Entity* waterEntity = m_MainScene.CreateOpaqueEntity(m_GraphicsManager.GetMainContext(), &m_WaterGeometry, &m_WaterMaterial);
+            waterEntity->SetMatrix(waterTransform);
+            waterEntity->GetSceneNode()->SetName("water");
+
+            ////////////
+            m_BeachMaterial.GetRenderingProperties().SetMaterialType(Data::Material::RenderingProperties::MATERIAL_TYPE_OPAQUE);
+            m_BeachMaterial.GetRenderingProperties().SetShader("sand_beach");
+            m_BeachMaterial.AssignTextureToSlot(Data::Material::TextureProperty::DIFFUSE, DRE_MOVE(beachAlbedo));
+            m_BeachMaterial.AssignTextureToSlot(Data::Material::TextureProperty::NORMAL, DRE_MOVE(beachNormal));
+            m_BeachMaterial.AssignTextureToSlot(Data::Material::TextureProperty::METALNESS, DRE_MOVE(beachMetalness));
+            m_BeachMaterial.AssignTextureToSlot(Data::Material::TextureProperty::ROUGHNESS, DRE_MOVE(beachRoughness));
+
+            glm::mat4 beachTransform = waterTransform; // beach transform
+            //bTrans.model = glm::scale(bTrans.model, glm::vec3(1.5f));
+            beachTransform = glm::rotate(beachTransform, glm::radians(20.0f), glm::vec3(1.0f, 0.0f, 0.0f));
+            beachTransform[3][2] -= 6.0f;
+            WORLD::Entity* beachEntity = m_MainScene.CreateOpaqueEntity(m_GraphicsManager.GetMainContext(), &m_WaterGeometry, &m_BeachMaterial); // reuse water geometry
+            beachEntity->SetMatrix(beachTransform);
+            beachEntity->GetSceneNode()->SetName("beach_plane");
+        }, { loadDefaultData, generateWaterMesh, decodeWaterNormal, decodeBeachAlbedo, decodeBeachNormal, decodeBeachMetalness, decodeBeachRoughness });
+
+    startupGraph.AddTask("upload_blue_noise", DRE::TASK_AFFINITY_MAIN_THREAD, [&, this]()
+        {
+            m_GraphicsManager.GetTextureBank().LoadTexture2DSync("blue_noise_256", 256, 256, VKW::FORMAT_R8G8B8A8_UNORM, blueNoise256.GetBuffer());
+        }, { loadDefaultData, decodeBlueNoise });
 
+    startupGraph.Execute();
 
+    DRE_LOG_INFO("Startup graph:");
+    startupGraph.PrintTimings();
 
-    glm::mat4 waterTransform = glm::identity<glm::mat4>();
-    //wTrans.model = glm::rotate(wTrans.model, glm::radians(180.0f), glm::vec3(1.0f, 0.0f, 0.0f));
-    waterTransform[3][1] += 1.5f;
-    //wTrans.model[3][2] -= 0.4f;
-    waterTransform = glm::scale(waterTransform, glm::vec3{ 0.1f });
-    WORLD::Entity* waterEntity = m_MainScene.CreateOpaqueEntity(m_GraphicsManager.GetMainContext(), &m_WaterGeometry, &m_WaterMaterial);
-    waterEntity->SetMatrix(waterTransform);
-    waterEntity->GetSceneNode()->SetName("water");
 
     ////////////
-    m_BeachMaterial.GetRenderingProperties().SetMaterialType(Data::Material::RenderingProperties::MATERIAL_TYPE_OPAQUE);
-    m_BeachMaterial.GetRenderingProperties().SetShader("sand_beach");
-    m_BeachMaterial.AssignTextureToSlot(Data::Material::TextureProperty::DIFFUSE, m_IOManager.ReadTexture2D("textures\\wavy-sand_albedo.png", Data::TEXTURE_VARIATION_RGBA));
-    m_BeachMaterial.AssignTextureToSlot(Data::Material::TextureProperty::NORMAL, m_IOManager.ReadTexture2D("textures\\wavy-sand_normal-dx.png", Data::TEXTURE_VARIATION_RGBA));
-    m_BeachMaterial.AssignTextureToSlot(Data::Material::TextureProperty::METALNESS, m_IOManager.ReadTexture2D("textures\\wavy-sand_metallic.png", Data::TEXTURE_VARIATION_GRAY));
-    m_BeachMaterial.AssignTextureToSlot(Data::Material::TextureProperty::ROUGHNESS, m_IOManager.ReadTexture2D("textures\\wavy-sand_roughness.png", Data::TEXTURE_VARIATION_GRAY));
-
-    glm::mat4 beachTransform = waterTransform; // beach transform
-    //bTrans.model = glm::scale(bTrans.model, glm::vec3(1.5f));
-    beachTransform = glm::rotate(beachTransform, glm::radians(20.0f), glm::vec3(1.0f, 0.0f, 0.0f));
-    beachTransform[3][2] -= 6.0f;
-    WORLD::Entity* beachEntity = m_MainScene.CreateOpaqueEntity(m_GraphicsManager.GetMainContext(), &m_WaterGeometry, &m_BeachMaterial); // reuse water geometry
-    beachEntity->SetMatrix(beachTransform);
-    beachEntity->GetSceneNode()->SetName("beach_plane");
-
-    Data::Texture2D blueNoise256 = m_IOManager.ReadTexture2D("textures\\blue_noise_rgba.png", Data::TEXTURE_VARIATION_RGBA);
-    m_GraphicsManager.GetTextureBank().LoadTexture2DSync("blue_noise_256", 256, 256, VKW::FORMAT_R8G8B8A8_UNORM, blueNoise256.GetBuffer());
-
+    m_GraphicsManager.SubmitTransientUploads();
 
-    ////////////
-    m_GraphicsManager.GetMainContext().FlushAll();
+    if (m_InputReplayPath != nullptr)
+    {
+        if (m_InputRecording.Read(m_InputReplayPath))
+        {
+            m_InputRecording.StartReplay(m_InputSystem);
+            DRE_LOG_INFO("Replaying %u frames from %s", m_InputRecording.GetFramesCount(), m_InputReplayPath);
+        }
+        else
+        {
+            DRE_LOG_ERROR("Failed to read input recording %s", m_InputReplayPath);
+        }
+    }
 }
 
 //////////////////////////////////////////
 void DREApplicationDelegate::update()
 {
+    DRE_CPU_FRAME_MARK();
+
+    bool const wasReplaying = m_InputRecording.IsReplaying();
+    SYS::InputFrame const* replayFrame = m_InputRecording.ApplyNextFrame(m_InputSystem);
+    if (wasReplaying && replayFrame == nullptr)
+    {
+        DRE_LOG_INFO("Input replay finished");
+        PostQuitMessage(0);
+        return;
+    }
+
     ////////////////////////////////////////////////////
     // Frame time
-    DRE::g_AppContext.m_DeltaTimeUS = m_FrameStopwatch.CurrentMicroseconds();
-    DRE::g_AppContext.m_TimeSinceStartUS = m_GlobalStopwatch.CurrentMicroseconds();
+    std::uint64_t const frameUS = m_FrameStopwatch.CurrentMicroseconds();
     DRE::g_AppContext.m_SystemTimeUS = DRE::Stopwatch::GlobalTimeMicroseconds();
     m_FrameStopwatch.Reset();
+
+    // replays step simulation time by the recorded deltas, measured frame time stays real
+    if (replayFrame != nullptr)
+    {
+        DRE::g_AppContext.m_DeltaTimeUS = replayFrame->m_DeltaTimeUS;
+        DRE::g_AppContext.m_TimeSinceStartUS += replayFrame->m_DeltaTimeUS;
+    }
+    else
+    {
+        DRE::g_AppContext.m_DeltaTimeUS = frameUS;
+        DRE::g_AppContext.m_TimeSinceStartUS = m_GlobalStopwatch.CurrentMicroseconds();
+    }
+
+    if (DRE::g_AppContext.m_EngineFrame > 0)
+    {
+        float const frameMS = static_cast<float>(frameUS) / 1000.0f;
+        float const presentWaitMS = static_cast<float>(m_GraphicsManager.GetPresentWaitUS()) / 1000.0f;
+        // GPU time lags FRAMES_BUFFERING frames behind
+        DRE::g_FrameStats.AddFrame(DRE::g_AppContext.m_EngineFrame - 1, frameMS - presentWaitMS, m_GraphicsManager.GetGPUFrameTimeMS(), presentWaitMS);
+    }
     ////////////////////////////////////////////////////
 
     DRE::g_FrameScratchAllocator.Reset();
 
+    // Finish async asset requests
+    m_GraphicsManager.GetMainContext().ResetDependenciesVectors(&DRE::g_FrameScratchAllocator);
+    m_AssetLoader.PumpCompletions(C_ASSET_COMPLETION_BUDGET_US);
+    m_IOManager.ResumeMainThreadTasks();
+    m_GraphicsManager.GetMainContext().WriteResourceDependencies();
+
     // Input maintenance
     m_InputSystem.Update();
     DRE::g_AppContext.m_CursorX = m_InputSystem.GetMouseState().mousePosX_;
@@ -212,12 +317,14 @@ void DREApplicationDelegate::update()
     // ImGui
     if (m_ImGuiEnabled)
     {
+        DRE_CPU_SCOPE(ImGui);
         m_ImGuiHelper->BeginFrame();
         ImGuiUser();
         m_ImGuiHelper->EndFrame();
     }
 
     ProcessViewportInput();
+    RecordOrReplayCamera(replayFrame);
 
     // Reload shaders
     if (m_InputSystem.GetKeyboardButtonJustReleased(Keys::R))
@@ -243,7 +350,14 @@ void DREApplicationDelegate::update()
     }
 
     // Rendering
-    m_GraphicsManager.RenderFrame(DRE::g_AppContext.m_EngineFrame, DRE::g_AppContext.m_DeltaTimeUS, m_GlobalStopwatch.CurrentSeconds());
+    float const timeS = replayFrame != nullptr ? static_cast<float>(DRE::g_AppContext.m_TimeSinceStartUS) / 1000000.0f : m_GlobalStopwatch.CurrentSeconds();
+    m_GraphicsManager.RenderFrame(DRE::g_AppContext.m_EngineFrame, DRE::g_AppContext.m_DeltaTimeUS, timeS);
+
+    if (DRE::g_AppContext.m_EngineFrame == 0)
+    {
+        DRE::g_AppContext.m_TimeToFirstFrameUS = DRE::Stopwatch::GlobalTimeMicroseconds() - DRE::g_AppContext.m_ProcessStartUS;
+        DRE_LOG_INFO("Time to first frame: %.3fms", DRE::g_AppContext.m_TimeToFirstFrameUS / 1000.0);
+    }
 
     if (m_InputSystem.GetKeyboardButtonJustPressed(Keys::Space))
     {
@@ -261,6 +375,14 @@ void DREApplicationDelegate::DEBUGBuildAccelerationStructure()
 //////////////////////////////////////////
 void DREApplicationDelegate::shutdown()
 {
+    if (m_InputRecordPath != nullptr)
+    {
+        if (m_InputRecording.Write(m_InputRecordPath))
+            DRE_LOG_INFO("Recorded %u frames to %s", m_InputRecording.GetFramesCount(), m_InputRecordPath);
+        else
+            DRE_LOG_ERROR("Failed to write input recording %s", m_InputRecordPath);
+    }
+
     m_GraphicsManager.WaitIdle();
     m_GraphicsManager.GetTextureBank().UnloadAllTextures();
     m_GraphicsManager.GetMainRenderGraph().UnloadGraphResources();
@@ -352,6 +474,18 @@ void DREApplicationDelegate::ImGuiUser()
             }
             ImGui::SliderFloat("Generic Scalar", &m_GraphicsManager.GetGraphicsSettings().m_GenericScalar, -2.0f, 2.0f);
 
+            std::uint32_t const recordingJobsMin = 1, recordingJobsMax = GFX::ParallelRecorder::MAX_JOBS;
+            ImGui::SliderScalar("Recording jobs", ImGuiDataType_U32, &m_GraphicsManager.GetGraphicsSettings().m_RecordingJobs, &recordingJobsMin, &recordingJobsMax);
+            ImGui::Checkbox("Split barriers", &m_GraphicsManager.GetGraphicsSettings().m_SplitBarriers);
+            ImGui::Checkbox("Graph bindings cache", &m_GraphicsManager.GetGraphicsSettings().m_GraphBindingsCache);
+            ImGui::Checkbox("Editor overlay", &m_GraphicsManager.GetGraphicsSettings().m_EditorOverlay);
+            ImGui::Checkbox("FFT debug view", &m_GraphicsManager.GetGraphicsSettings().m_DebugView);
+
+            ImGui::Checkbox("Dynamic resolution", &m_GraphicsManager.GetGraphicsSettings().m_DynamicResolution);
+            ImGui::SliderFloat("Target GPU ms", &m_GraphicsManager.GetGraphicsSettings().m_TargetGPUTimeMS, 4.0f, 33.3f);
+            ImGui::SliderFloat("Min render scale", &m_GraphicsManager.GetGraphicsSettings().m_MinRenderScale, 0.25f, 1.0f);
+            ImGui::Text("Render scale: %.2f", m_GraphicsManager.GetDynamicResolution().GetScale());
+
         }
         ImGui::End();
     }
@@ -365,3 +499,29 @@ void DREApplicationDelegate::ProcessViewportInput()
     }
 }
 
+void DREApplicationDelegate::RecordOrReplayCamera(SYS::InputFrame const* replayFrame)
+{
+    WORLD::Camera& camera = m_MainScene.GetMainCamera();
+
+    // camera can also be moved from editor windows which aren't replayed, so it's overridden with the recorded result
+    if (replayFrame != nullptr)
+    {
+        camera.SetPosition(glm::vec3{ replayFrame->m_CameraPosition[0], replayFrame->m_CameraPosition[1], replayFrame->m_CameraPosition[2] });
+        camera.SetCameraEuler(glm::vec3{ replayFrame->m_CameraEuler[0], replayFrame->m_CameraEuler[1], replayFrame->m_CameraEuler[2] });
+        return;
+    }
+
+    if (m_InputRecordPath == nullptr)
+        return;
+
+    SYS::InputFrame& frame = m_InputRecording.AddFrame();
+    frame.m_DeltaTimeUS = DRE::g_AppContext.m_DeltaTimeUS;
+    frame.m_MouseState = m_InputSystem.GetMouseState();
+    frame.m_KeyboardState = m_InputSystem.GetKeyboardState();
+    for (DRE::U32 i = 0; i < 3; i++)
+    {
+        frame.m_CameraPosition[i] = camera.GetPosition()[i];
+        frame.m_CameraEuler[i] = camera.GetCameraEuler()[i];
+    }
+}
+
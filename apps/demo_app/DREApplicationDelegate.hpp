@@ -18,13 +18,16 @@
 #include <foundation\system\Window.hpp>
 #include <foundation\system\DynamicLibrary.hpp>
 #include <foundation\input\InputSystem.hpp>
+#include <foundation\input\InputRecording.hpp>
 
 #include <engine\ApplicationContext.hpp>
 #include <engine\scene\Scene.hpp>
+#include <engine\scene\SyntheticScene.hpp>
 #include <engine\data\MaterialLibrary.hpp>
 #include <engine\data\GeometryLibrary.hpp>
 
 #include <engine\io\IOManager.hpp>
+#include <engine\io\AssetLoader.hpp>
 
 #include <editor\RootEditor.hpp>
 #include <editor\ViewportInputManager.hpp>
@@ -34,7 +37,7 @@ class DREApplicationDelegate
     , public NonMovable
 {
 public:
-    DREApplicationDelegate(HINSTANCE instance, char const* title, std::uint32_t windowWidth, std::uint32_t windowHeight, std::uint32_t buffering, bool vkDebug, bool imguiEnabled);
+    DREApplicationDelegate(HINSTANCE instance, char const* title, std::uint32_t windowWidth, std::uint32_t windowHeight, std::uint32_t buffering, bool vkDebug, bool imguiEnabled, char const* inputRecordPath, char const* inputReplayPath);
     
     virtual void start() override;
     virtual void update() override;
@@ -53,14 +56,19 @@ private:
     void DestroyImGui();
     void ImGuiUser();
     void ProcessViewportInput();
+    void RecordOrReplayCamera(SYS::InputFrame const* replayFrame);
 
     void DEBUGBuildAccelerationStructure();
 
     SYS::Window                         m_MainWindow;
     SYS::InputSystem                    m_InputSystem;
+    SYS::InputRecording                 m_InputRecording;
+    char const*                         m_InputRecordPath;
+    char const*                         m_InputReplayPath;
     Data::MaterialLibrary               m_MaterialLibrary;
     Data::GeometryLibrary               m_GeometryLibrary;
     IO::IOManager                       m_IOManager;
+    IO::AssetLoader                     m_AssetLoader;
 
     Data::Geometry                      m_WaterGeometry;
     Data::Material                      m_WaterMaterial;
@@ -75,6 +83,7 @@ private:
     DRE::Stopwatch  m_GlobalStopwatch;
 
     WORLD::Scene                        m_MainScene;
+    WORLD::SyntheticSceneGenerator      m_SyntheticSceneGenerator;
 
     EDITOR::RootEditor                  m_RootEditor;
     EDITOR::ViewportInputManager        m_ViewportInput;
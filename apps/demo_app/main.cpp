@@ -1,17 +1,42 @@
 #include <demo_app\DREApplicationDelegate.hpp>
 
 #include <foundation\memory\Memory.hpp>
+#include <foundation\system\Log.hpp>
+#include <foundation\system\Time.hpp>
 
-int main()
+#include <engine\ApplicationContext.hpp>
+
+#include <cstring>
+
+/*
+*
+* demo_app [--record-input <path>] [--replay-input <path>] [--log-file <path>]
+*
+*/
+int main(int argc, char** argv)
 {
+    DRE::g_AppContext.m_ProcessStartUS = DRE::Stopwatch::GlobalTimeMicroseconds();
+
     DRE::InitializeGlobalMemory();
 
     HINSTANCE instance = GetModuleHandle(nullptr);
 
     bool imguiEnabled = true;
 
+    char const* inputRecordPath = nullptr;
+    char const* inputReplayPath = nullptr;
+    for (int i = 1; i + 1 < argc; i++)
+    {
+        if (std::strcmp(argv[i], "--record-input") == 0)
+            inputRecordPath = argv[++i];
+        else if (std::strcmp(argv[i], "--replay-input") == 0)
+            inputReplayPath = argv[++i];
+        else if (std::strcmp(argv[i], "--log-file") == 0)
+            DRE::Log::SetFileSink(argv[++i]);
+    }
+
     DREApplicationDelegate* appDelegate = (DREApplicationDelegate*)DRE::g_PersistentDataAllocator.Alloc(sizeof(DREApplicationDelegate), alignof(DREApplicationDelegate));
-    new (appDelegate) DREApplicationDelegate{ instance, "DRE", 1600u, 900u, 2u, DEBUG_OR_RELEASE(true, false), imguiEnabled };
+    new (appDelegate) DREApplicationDelegate{ instance, "DRE", 1600u, 900u, 2u, DEBUG_OR_RELEASE(true, false), imguiEnabled, inputRecordPath, inputReplayPath };
 
     Application* application = (Application*)DRE::g_PersistentDataAllocator.Alloc(sizeof(Application), alignof(Application));
     new (application) Application{ appDelegate };
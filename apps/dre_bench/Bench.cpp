@@ -0,0 +1,110 @@
+#include "Bench.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+namespace BENCH
+{
+
+#if defined(_MSC_VER)
+void const* volatile g_DoNotOptimizeSink = nullptr;
+
+void DoNotOptimizeSink(void const* value)
+{
+    g_DoNotOptimizeSink = value;
+}
+#endif
+
+BenchRunner::BenchRunner(DRE::U32 warmupRepetitions, DRE::U32 repetitions)
+    : m_WarmupRepetitions{ warmupRepetitions }
+    , m_Repetitions{ repetitions > 0 ? repetitions : 1 }
+{
+}
+
+void BenchRunner::Add(char const* name, DRE::U32 iterations, BenchFunc&& func, SetupFunc&& setup)
+{
+    m_Benches.push_back(Bench{ name, iterations, DRE_MOVE(func), DRE_MOVE(setup) });
+}
+
+void BenchRunner::Run(char const* filter)
+{
+    std::vector<double> samples(m_Repetitions);
+
+    for (Bench& bench : m_Benches)
+    {
+        if (filter != nullptr && std::strstr(bench.m_Name, filter) == nullptr)
+            continue;
+
+        for (DRE::U32 i = 0; i < m_WarmupRepetitions; i++)
+        {
+            if (bench.m_Setup)
+                bench.m_Setup();
+
+            bench.m_Func(bench.m_Iterations);
+        }
+
+        for (DRE::U32 i = 0; i < m_Repetitions; i++)
+        {
+            if (bench.m_Setup)
+                bench.m_Setup();
+
+            auto const start = std::chrono::steady_clock::now();
+            bench.m_Func(bench.m_Iterations);
+            auto const end = std::chrono::steady_clock::now();
+
+            double const elapsedNS = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+            samples[i] = elapsedNS / bench.m_Iterations;
+        }
+
+        std::sort(samples.begin(), samples.end());
+
+        double sum = 0.0;
+        for (double sample : samples)
+            sum += sample;
+        double const mean = sum / m_Repetitions;
+
+        double variance = 0.0;
+        for (double sample : samples)
+            variance += (sample - mean) * (sample - mean);
+
+        BenchResult& result = m_Results.emplace_back();
+        result.m_Name = bench.m_Name;
+        result.m_Iterations = bench.m_Iterations;
+        result.m_Repetitions = m_Repetitions;
+        result.m_Min = samples.front();
+        result.m_Median = samples[m_Repetitions / 2];
+        result.m_Mean = mean;
+        result.m_P95 = samples[static_cast<DRE::U32>((m_Repetitions - 1) * 0.95 + 0.5)];
+        result.m_Max = samples.back();
+        result.m_StdDev = std::sqrt(variance / m_Repetitions);
+
+        std::printf("%-40s median %10.2f ns  min %10.2f ns  p95 %10.2f ns  stddev %8.2f ns\n",
+            result.m_Name, result.m_Median, result.m_Min, result.m_P95, result.m_StdDev);
+    }
+}
+
+bool BenchRunner::WriteJSON(char const* path) const
+{
+    std::FILE* file = std::fopen(path, "w");
+    if (file == nullptr)
+        return false;
+
+    std::fprintf(file, "{\n  \"unit\": \"ns/op\",\n  \"benchmarks\": [\n");
+    for (std::size_t i = 0; i < m_Results.size(); i++)
+    {
+        BenchResult const& result = m_Results[i];
+        std::fprintf(file,
+            "    { \"name\": \"%s\", \"iterations\": %u, \"repetitions\": %u, \"min\": %.3f, \"median\": %.3f, \"mean\": %.3f, \"p95\": %.3f, \"max\": %.3f, \"stddev\": %.3f }%s\n",
+            result.m_Name, result.m_Iterations, result.m_Repetitions,
+            result.m_Min, result.m_Median, result.m_Mean, result.m_P95, result.m_Max, result.m_StdDev,
+            i + 1 < m_Results.size() ? "," : "");
+    }
+    std::fprintf(file, "  ]\n}\n");
+
+    return std::fclose(file) == 0;
+}
+
+}
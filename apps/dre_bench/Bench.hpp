@@ -0,0 +1,93 @@
+#pragma once
+
+#include <foundation\Common.hpp>
+#include <foundation\class_features\NonCopyable.hpp>
+#include <foundation\class_features\NonMovable.hpp>
+
+#include <functional>
+#include <vector>
+
+namespace BENCH
+{
+
+/*
+*
+* Minimal microbenchmark harness.
+* A benchmark is a function doing `iterations` operations, every repetition is timed as a whole and reported per operation.
+* Warm-up repetitions are run first and discarded.
+* Optional setup runs before every repetition, outside of the timed region.
+*
+*   runner.Add("fasthash32/256", 1 << 16, [](DRE::U32 iterations) { ... BENCH::DoNotOptimize(result); });
+*
+*/
+
+#if defined(_MSC_VER)
+void DoNotOptimizeSink(void const* value);
+
+template<typename T>
+inline void DoNotOptimize(T const& value)
+{
+    DoNotOptimizeSink(&value);
+}
+#else
+template<typename T>
+inline void DoNotOptimize(T const& value)
+{
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+#endif
+
+struct BenchResult
+{
+    char const*     m_Name;
+    DRE::U32        m_Iterations;
+    DRE::U32        m_Repetitions;
+
+    // nanoseconds per operation
+    double          m_Min;
+    double          m_Median;
+    double          m_Mean;
+    double          m_P95;
+    double          m_Max;
+    double          m_StdDev;
+};
+
+class BenchRunner
+    : public NonCopyable
+    , public NonMovable
+{
+public:
+    using BenchFunc = std::function<void(DRE::U32 iterations)>;
+    using SetupFunc = std::function<void()>;
+
+    BenchRunner(DRE::U32 warmupRepetitions, DRE::U32 repetitions);
+
+    void    Add(char const* name, DRE::U32 iterations, BenchFunc&& func, SetupFunc&& setup = nullptr);
+
+    // runs every benchmark whose name contains filter, nullptr runs all
+    void    Run(char const* filter);
+
+    bool    WriteJSON(char const* path) const;
+
+private:
+    struct Bench
+    {
+        char const* m_Name;
+        DRE::U32    m_Iterations;
+        BenchFunc   m_Func;
+        SetupFunc   m_Setup;
+    };
+
+    DRE::U32                    m_WarmupRepetitions;
+    DRE::U32                    m_Repetitions;
+
+    std::vector<Bench>          m_Benches;
+    std::vector<BenchResult>    m_Results;
+};
+
+void RegisterFoundationBenches(BenchRunner& runner);
+void RegisterSceneBenches(BenchRunner& runner);
+void RegisterDependencyBenches(BenchRunner& runner);
+void RegisterIOBenches(BenchRunner& runner);
+
+}
@@ -0,0 +1,132 @@
+#include "Bench.hpp"
+
+#include <foundation\container\InplaceHashTable.hpp>
+
+#include <memory>
+#include <vector>
+
+namespace BENCH
+{
+
+namespace
+{
+
+/*
+*
+* Data structure comparison only, GFX::DependencyManager itself needs a device and isn't measured here.
+* A stand-in entry and update rule shaped like TextureAccessEntry, looked up three ways:
+* pointer-keyed hash table (the old tracking), flat array by slot index and fixed size pages by slot index
+* (what DependencyManager uses now). Numbers say how the lookups compare, not what barrier tracking costs in a frame.
+*
+*/
+struct TrackedResource
+{
+    DRE::U32    m_StateSlot;
+    DRE::U32    m_Padding[15];
+};
+
+struct AccessEntry
+{
+    DRE::U32    m_Access        = 0;
+    DRE::U32    m_Stage         = 0;
+    DRE::U32    m_QueueFamily   = 0;
+    DRE::U32    m_ReleasedTo    = 0;
+    void*       m_SplitEvent    = nullptr;
+};
+
+DRE::U32 constexpr RESOURCES_COUNT  = 4096;
+DRE::U32 constexpr ACCESS_COUNT     = 6;
+// smaller than DependencyManager::STATES_PAGE_SIZE so the 4096 entries span a few pages
+DRE::U32 constexpr PAGE_SIZE        = 1024;
+
+// returns whether a barrier would be recorded
+inline bool Transition(AccessEntry& entry, DRE::U32 access, DRE::U32 stage)
+{
+    bool const readOnly = access < ACCESS_COUNT / 2;
+    if (entry.m_Access == access && readOnly)
+    {
+        if ((stage & ~entry.m_Stage) == 0)
+            return false;
+
+        entry.m_Stage |= stage;
+        return true;
+    }
+
+    entry.m_Access = access;
+    entry.m_Stage = stage;
+    return true;
+}
+
+std::vector<TrackedResource>& GetResources()
+{
+    static std::vector<TrackedResource> resources = []()
+    {
+        std::vector<TrackedResource> result(RESOURCES_COUNT);
+        for (DRE::U32 i = 0; i < RESOURCES_COUNT; i++)
+            result[i].m_StateSlot = i;
+        return result;
+    }();
+    return resources;
+}
+
+// passes touch resources in a scattered order, consecutive transitions rarely hit the same one
+inline DRE::U32 ResourceIndex(DRE::U32 i)
+{
+    return (i * 2654435761u) % RESOURCES_COUNT;
+}
+
+}
+
+void RegisterDependencyBenches(BenchRunner& runner)
+{
+    runner.Add("StateLookup/hash_table_4096", RESOURCES_COUNT, [](DRE::U32 iterations)
+        {
+            static auto* table = new DRE::InplaceHashTable<TrackedResource*, AccessEntry, RESOURCES_COUNT>{};
+            std::vector<TrackedResource>& resources = GetResources();
+
+            DRE::U32 barriers = 0;
+            for (DRE::U32 i = 0; i < iterations; i++)
+            {
+                AccessEntry& entry = (*table)[&resources[ResourceIndex(i)]];
+                barriers += Transition(entry, i % ACCESS_COUNT, 1u << (i & 7)) ? 1 : 0;
+            }
+            DoNotOptimize(barriers);
+        });
+
+    runner.Add("StateLookup/flat_slots_4096", RESOURCES_COUNT, [](DRE::U32 iterations)
+        {
+            static std::vector<AccessEntry> states(RESOURCES_COUNT);
+            std::vector<TrackedResource>& resources = GetResources();
+
+            DRE::U32 barriers = 0;
+            for (DRE::U32 i = 0; i < iterations; i++)
+            {
+                AccessEntry& entry = states[resources[ResourceIndex(i)].m_StateSlot];
+                barriers += Transition(entry, i % ACCESS_COUNT, 1u << (i & 7)) ? 1 : 0;
+            }
+            DoNotOptimize(barriers);
+        });
+
+    runner.Add("StateLookup/paged_slots_4096", RESOURCES_COUNT, [](DRE::U32 iterations)
+        {
+            static std::vector<std::unique_ptr<AccessEntry[]>> pages = []()
+            {
+                std::vector<std::unique_ptr<AccessEntry[]>> result(RESOURCES_COUNT / PAGE_SIZE);
+                for (auto& page : result)
+                    page = std::make_unique<AccessEntry[]>(PAGE_SIZE);
+                return result;
+            }();
+            std::vector<TrackedResource>& resources = GetResources();
+
+            DRE::U32 barriers = 0;
+            for (DRE::U32 i = 0; i < iterations; i++)
+            {
+                DRE::U32 const slot = resources[ResourceIndex(i)].m_StateSlot;
+                AccessEntry& entry = pages[slot / PAGE_SIZE][slot % PAGE_SIZE];
+                barriers += Transition(entry, i % ACCESS_COUNT, 1u << (i & 7)) ? 1 : 0;
+            }
+            DoNotOptimize(barriers);
+        });
+}
+
+}
@@ -0,0 +1,200 @@
+#include "Bench.hpp"
+
+#include <foundation\memory\Memory.hpp>
+#include <foundation\container\HashTable.hpp>
+#include <foundation\string\InplaceString.hpp>
+#include <foundation\util\Hash.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace BENCH
+{
+
+namespace
+{
+
+// deterministic keys/sizes, no <random> state shared between runs
+inline DRE::U32 XorShift32(DRE::U32& state)
+{
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+using BenchBuddy = DRE::AllocatorBuddy<256, 12>;
+
+void RegisterAllocatorBenches(BenchRunner& runner)
+{
+    runner.Add("AllocatorBuddy/alloc_free_256", 1 << 14, [](DRE::U32 iterations)
+        {
+            static void* memory = std::malloc(BenchBuddy::RequiredMemorySize());
+            BenchBuddy allocator{ memory, BenchBuddy::RequiredMemorySize() };
+
+            for (DRE::U32 i = 0; i < iterations; i++)
+            {
+                void* allocation = allocator.Alloc(256, 16);
+                DoNotOptimize(allocation);
+                allocator.Free(allocation);
+            }
+        });
+
+    runner.Add("AllocatorBuddy/mixed_sizes_churn", 1 << 14, [](DRE::U32 iterations)
+        {
+            static void* memory = std::malloc(BenchBuddy::RequiredMemorySize());
+            BenchBuddy allocator{ memory, BenchBuddy::RequiredMemorySize() };
+
+            DRE::U32 constexpr LIVE_COUNT = 64;
+            void* live[LIVE_COUNT] = {};
+            DRE::U32 state = 0x9E3779B9u;
+
+            for (DRE::U32 i = 0; i < iterations; i++)
+            {
+                DRE::U32 const slot = XorShift32(state) % LIVE_COUNT;
+                if (live[slot] != nullptr)
+                    allocator.Free(live[slot]);
+
+                live[slot] = allocator.Alloc(256u << (XorShift32(state) % 5), 16);
+                DoNotOptimize(live[slot]);
+            }
+
+            for (DRE::U32 i = 0; i < LIVE_COUNT; i++)
+            {
+                if (live[i] != nullptr)
+                    allocator.Free(live[i]);
+            }
+        });
+}
+
+void RegisterHashTableBenches(BenchRunner& runner)
+{
+    runner.Add("HashTable/u32_emplace_1k", 1024, [](DRE::U32 iterations)
+        {
+            DRE::HashTable<DRE::U32, DRE::U32, DRE::DefaultAllocator> table{ &DRE::g_MainAllocator };
+            for (DRE::U32 i = 0; i < iterations; i++)
+            {
+                table.Emplace(i * 2654435761u, i);
+            }
+            DoNotOptimize(table);
+        });
+
+    runner.Add("HashTable/u32_find_1k", 1 << 16, [](DRE::U32 iterations)
+        {
+            static DRE::HashTable<DRE::U32, DRE::U32, DRE::DefaultAllocator>* table = []()
+            {
+                auto* result = new DRE::HashTable<DRE::U32, DRE::U32, DRE::DefaultAllocator>{ &DRE::g_MainAllocator };
+                for (DRE::U32 i = 0; i < 1024; i++)
+                    result->Emplace(i * 2654435761u, i);
+                return result;
+            }();
+
+            DRE::U32 sum = 0;
+            for (DRE::U32 i = 0; i < iterations; i++)
+            {
+                sum += *table->Find((i & 1023) * 2654435761u).value;
+            }
+            DoNotOptimize(sum);
+        });
+
+    runner.Add("HashTable/string64_find_256", 1 << 14, [](DRE::U32 iterations)
+        {
+            static std::vector<DRE::String64> keys;
+            static DRE::HashTable<DRE::String64, DRE::U32, DRE::DefaultAllocator>* table = []()
+            {
+                auto* result = new DRE::HashTable<DRE::String64, DRE::U32, DRE::DefaultAllocator>{ &DRE::g_MainAllocator };
+                char name[64];
+                for (DRE::U32 i = 0; i < 256; i++)
+                {
+                    std::snprintf(name, sizeof(name), "textures/material_%u_albedo", i);
+                    keys.emplace_back(name);
+                    result->Emplace(keys.back(), i);
+                }
+                return result;
+            }();
+
+            DRE::U32 sum = 0;
+            for (DRE::U32 i = 0; i < iterations; i++)
+            {
+                sum += *table->Find(keys[i & 255]).value;
+            }
+            DoNotOptimize(sum);
+        });
+}
+
+void RegisterStringBenches(BenchRunner& runner)
+{
+    runner.Add("InplaceString/construct_64", 1 << 16, [](DRE::U32 iterations)
+        {
+            for (DRE::U32 i = 0; i < iterations; i++)
+            {
+                DRE::String64 string{ "shaders/forward_opaque.frag" };
+                DoNotOptimize(string);
+            }
+        });
+
+    runner.Add("InplaceString/compare_64", 1 << 16, [](DRE::U32 iterations)
+        {
+            DRE::String64 const lhs{ "shaders/forward_opaque.frag" };
+            DRE::String64 const rhs{ "shaders/forward_opaque.vert" };
+
+            DRE::U32 equal = 0;
+            for (DRE::U32 i = 0; i < iterations; i++)
+            {
+                DoNotOptimize(lhs);
+                equal += lhs == rhs ? 1 : 0;
+            }
+            DoNotOptimize(equal);
+        });
+}
+
+void RegisterHashBenches(BenchRunner& runner)
+{
+    static std::vector<DRE::U8> data(4096, 0xAB);
+
+    runner.Add("fasthash32/16", 1 << 18, [](DRE::U32 iterations)
+        {
+            uint32_t result = 0;
+            for (DRE::U32 i = 0; i < iterations; i++)
+            {
+                DoNotOptimize(data[0]);
+                result ^= fasthash32(data.data(), 16, 0xE527A10B);
+            }
+            DoNotOptimize(result);
+        });
+
+    runner.Add("fasthash32/256", 1 << 16, [](DRE::U32 iterations)
+        {
+            uint32_t result = 0;
+            for (DRE::U32 i = 0; i < iterations; i++)
+            {
+                DoNotOptimize(data[0]);
+                result ^= fasthash32(data.data(), 256, 0xE527A10B);
+            }
+            DoNotOptimize(result);
+        });
+
+    runner.Add("fasthash64/4096", 1 << 12, [](DRE::U32 iterations)
+        {
+            uint64_t result = 0;
+            for (DRE::U32 i = 0; i < iterations; i++)
+            {
+                DoNotOptimize(data[0]);
+                result ^= fasthash64(data.data(), 4096, 0xE527A10B);
+            }
+            DoNotOptimize(result);
+        });
+}
+
+}
+
+void RegisterFoundationBenches(BenchRunner& runner)
+{
+    RegisterAllocatorBenches(runner);
+    RegisterHashTableBenches(runner);
+    RegisterStringBenches(runner);
+    RegisterHashBenches(runner);
+}
+
+}
@@ -0,0 +1,163 @@
+#include "Bench.hpp"
+
+#include <engine\io\BatchFileReader.hpp>
+
+#include <foundation\memory\ByteBuffer.hpp>
+#include <foundation\system\ThreadPool.hpp>
+
+#include <cstdio>
+#include <filesystem>
+#include <latch>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace BENCH
+{
+
+namespace
+{
+
+/*
+*
+* Many small files, the shape of LoadShaderBinaries: a few hundred .spv blobs of a few KB each.
+* Warm runs read straight from the OS file cache, cold runs evict every file before each repetition.
+* Results are per file.
+*
+*/
+DRE::U32 constexpr FILES_COUNT  = 256;
+DRE::U32 constexpr FILE_SIZE    = 4096;
+
+struct FileSet
+{
+    std::vector<std::string>                        m_Paths;
+    std::vector<DRE::ByteBuffer>                    m_Buffers;
+    std::vector<IO::BatchFileReader::ReadRequest>   m_Requests;
+};
+
+FileSet& GetFileSet()
+{
+    static FileSet* files = []()
+    {
+        FileSet* result = new FileSet{};
+
+        std::filesystem::path const directory = std::filesystem::temp_directory_path() / "dre_bench_io";
+        std::filesystem::create_directories(directory);
+
+        std::vector<char> content(FILE_SIZE);
+        for (DRE::U32 i = 0; i < FILE_SIZE; i++)
+            content[i] = static_cast<char>(i * 31);
+
+        result->m_Paths.resize(FILES_COUNT);
+        result->m_Buffers.resize(FILES_COUNT);
+        result->m_Requests.resize(FILES_COUNT);
+        for (DRE::U32 i = 0; i < FILES_COUNT; i++)
+        {
+            result->m_Paths[i] = (directory / ("file_" + std::to_string(i) + ".bin")).string();
+
+            std::FILE* file = std::fopen(result->m_Paths[i].c_str(), "wb");
+            if (file != nullptr)
+            {
+                std::fwrite(content.data(), 1, content.size(), file);
+                std::fclose(file);
+            }
+
+            // buffers keep their capacity between repetitions, only the reads are measured
+            result->m_Buffers[i].Resize(FILE_SIZE);
+            result->m_Requests[i].m_Path = result->m_Paths[i].c_str();
+            result->m_Requests[i].m_Buffer = &result->m_Buffers[i];
+        }
+
+        return result;
+    }();
+    return *files;
+}
+
+DRE::ThreadPool& GetIOThreadPool()
+{
+    // same worker count IOManager gives its IO pool
+    static DRE::ThreadPool* pool = new DRE::ThreadPool{ 4 };
+    return *pool;
+}
+
+// best effort, drops the file's pages from the OS cache so the next read goes to the device
+void EvictFromFileCache(char const* path)
+{
+#ifdef _WIN32
+    // opening without buffering flushes and purges the cached data of the file
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_NO_BUFFERING, NULL);
+    if (file != INVALID_HANDLE_VALUE)
+        CloseHandle(file);
+#else
+    int const file = open(path, O_RDONLY);
+    if (file >= 0)
+    {
+        posix_fadvise(file, 0, 0, POSIX_FADV_DONTNEED);
+        close(file);
+    }
+#endif
+}
+
+void EvictFileSet()
+{
+    FileSet& files = GetFileSet();
+    for (std::string const& path : files.m_Paths)
+        EvictFromFileCache(path.c_str());
+}
+
+// one blocking read after another, how shaders were loaded before ReadFile
+void ReadSequential(DRE::U32 iterations)
+{
+    FileSet& files = GetFileSet();
+
+    std::uint64_t bytesRead = 0;
+    for (DRE::U32 i = 0; i < iterations; i++)
+        bytesRead += IO::BatchFileReader::ReadSingle(files.m_Paths[i].c_str(), &files.m_Buffers[i], false);
+    DoNotOptimize(bytesRead);
+}
+
+// every read submitted to the IO pool at once, the work IOManager::ReadFile awaitables do without the coroutine resume
+void ReadThreadPool(DRE::U32 iterations)
+{
+    FileSet& files = GetFileSet();
+
+    std::latch readsComplete{ iterations };
+    for (DRE::U32 i = 0; i < iterations; i++)
+    {
+        GetIOThreadPool().Submit([&files, &readsComplete, i]()
+            {
+                files.m_Requests[i].m_BytesRead = IO::BatchFileReader::ReadSingle(files.m_Paths[i].c_str(), &files.m_Buffers[i], false);
+                readsComplete.count_down();
+            });
+    }
+    readsComplete.wait();
+    DoNotOptimize(files.m_Requests[0].m_BytesRead);
+}
+
+void ReadBatch(DRE::U32 iterations)
+{
+    static IO::BatchFileReader* reader = new IO::BatchFileReader{ &GetIOThreadPool() };
+    FileSet& files = GetFileSet();
+
+    reader->ReadBatch(files.m_Requests.data(), iterations);
+    DoNotOptimize(files.m_Requests[0].m_BytesRead);
+}
+
+}
+
+void RegisterIOBenches(BenchRunner& runner)
+{
+    runner.Add("FileIO/sequential_256x4k_warm", FILES_COUNT, &ReadSequential);
+    runner.Add("FileIO/thread_pool_256x4k_warm", FILES_COUNT, &ReadThreadPool);
+    runner.Add("FileIO/batch_256x4k_warm", FILES_COUNT, &ReadBatch);
+
+    runner.Add("FileIO/sequential_256x4k_cold", FILES_COUNT, &ReadSequential, &EvictFileSet);
+    runner.Add("FileIO/thread_pool_256x4k_cold", FILES_COUNT, &ReadThreadPool, &EvictFileSet);
+    runner.Add("FileIO/batch_256x4k_cold", FILES_COUNT, &ReadBatch, &EvictFileSet);
+}
+
+}
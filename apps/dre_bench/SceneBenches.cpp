@@ -0,0 +1,87 @@
+#include "Bench.hpp"
+
+#include <engine\scene\SceneNode.hpp>
+
+#include <glm\gtc\quaternion.hpp>
+
+#include <vector>
+
+namespace BENCH
+{
+
+namespace
+{
+
+// nodes are never freed, SceneNode children live in g_MainAllocator for the whole run
+std::vector<WORLD::SceneNode*> BuildChain(DRE::U32 depth)
+{
+    std::vector<WORLD::SceneNode*> nodes;
+    WORLD::SceneNode* parent = nullptr;
+    for (DRE::U32 i = 0; i < depth; i++)
+    {
+        WORLD::SceneNode* node = new WORLD::SceneNode{ parent, nullptr };
+        node->SetPosition(glm::vec3{ 1.0f, 0.5f * i, -2.0f });
+        node->SetEulerOrientation(glm::vec3{ 0.0f, 10.0f * i, 5.0f });
+        node->SetScale(1.01f);
+        if (parent != nullptr)
+            parent->AddChild(node);
+
+        nodes.push_back(node);
+        parent = node;
+    }
+    return nodes;
+}
+
+// root -> fanout children -> fanout grandchildren ..., returns the leaves
+std::vector<WORLD::SceneNode*> BuildTree(DRE::U32 depth, DRE::U32 fanout)
+{
+    std::vector<WORLD::SceneNode*> level{ new WORLD::SceneNode{ nullptr, nullptr } };
+    for (DRE::U32 d = 1; d < depth; d++)
+    {
+        std::vector<WORLD::SceneNode*> next;
+        for (WORLD::SceneNode* parent : level)
+        {
+            for (DRE::U32 i = 0; i < fanout; i++)
+            {
+                WORLD::SceneNode* node = new WORLD::SceneNode{ parent, nullptr };
+                node->SetPosition(glm::vec3{ 0.1f * i, 0.2f * d, 0.0f });
+                node->SetEulerOrientation(glm::vec3{ 3.0f * i, 0.0f, 7.0f * d });
+                parent->AddChild(node);
+                next.push_back(node);
+            }
+        }
+        level = DRE_MOVE(next);
+    }
+    return level;
+}
+
+}
+
+void RegisterSceneBenches(BenchRunner& runner)
+{
+    runner.Add("SceneNode/GetGlobalMatrix_chain_8", 1 << 14, [](DRE::U32 iterations)
+        {
+            static std::vector<WORLD::SceneNode*> chain = BuildChain(8);
+            WORLD::SceneNode const* leaf = chain.back();
+
+            for (DRE::U32 i = 0; i < iterations; i++)
+            {
+                glm::mat4 const matrix = leaf->GetGlobalMatrix();
+                DoNotOptimize(matrix);
+            }
+        });
+
+    runner.Add("SceneNode/GetGlobalMatrix_tree_4x8_leaves", 512, [](DRE::U32 iterations)
+        {
+            // 512 leaves at depth 4, the same walk a pass does for every renderable each frame
+            static std::vector<WORLD::SceneNode*> leaves = BuildTree(4, 8);
+
+            for (DRE::U32 i = 0; i < iterations; i++)
+            {
+                glm::mat4 const matrix = leaves[i % leaves.size()]->GetGlobalMatrix();
+                DoNotOptimize(matrix);
+            }
+        });
+}
+
+}
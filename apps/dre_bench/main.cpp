@@ -0,0 +1,56 @@
+#include "Bench.hpp"
+
+#include <foundation\memory\Memory.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+/*
+*
+* dre_bench [--filter <substring>] [--reps <count>] [--warmup <count>] [--json <path>]
+*
+*/
+int main(int argc, char** argv)
+{
+    char const* filter = nullptr;
+    char const* jsonPath = "dre_bench.json";
+    DRE::U32 repetitions = 30;
+    DRE::U32 warmup = 3;
+
+    for (int i = 1; i < argc; i++)
+    {
+        bool const hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--filter") == 0 && hasValue)
+            filter = argv[++i];
+        else if (std::strcmp(argv[i], "--json") == 0 && hasValue)
+            jsonPath = argv[++i];
+        else if (std::strcmp(argv[i], "--reps") == 0 && hasValue)
+            repetitions = static_cast<DRE::U32>(std::atoi(argv[++i]));
+        else if (std::strcmp(argv[i], "--warmup") == 0 && hasValue)
+            warmup = static_cast<DRE::U32>(std::atoi(argv[++i]));
+        else
+        {
+            std::printf("usage: dre_bench [--filter <substring>] [--reps <count>] [--warmup <count>] [--json <path>]\n");
+            return 1;
+        }
+    }
+
+    DRE::InitializeGlobalMemory();
+
+    {
+        BENCH::BenchRunner runner{ warmup, repetitions };
+        BENCH::RegisterFoundationBenches(runner);
+        BENCH::RegisterSceneBenches(runner);
+        BENCH::RegisterDependencyBenches(runner);
+        BENCH::RegisterIOBenches(runner);
+
+        runner.Run(filter);
+
+        if (!runner.WriteJSON(jsonPath))
+            std::printf("Failed to write %s\n", jsonPath);
+    }
+
+    // benchmark fixtures are static and intentionally leaked, global memory stays alive until exit
+    return 0;
+}
@@ -0,0 +1,400 @@
+#include "HeadlessBench.hpp"
+
+#include <foundation\memory\Memory.hpp>
+#include <foundation\system\FrameStats.hpp>
+#include <foundation\system\Log.hpp>
+#include <foundation\system\Profiler.hpp>
+#include <foundation\system\Time.hpp>
+
+#include <engine\ApplicationContext.hpp>
+#include <engine\scene\SceneNode.hpp>
+
+#include <glm\common.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+namespace BENCH
+{
+
+static constexpr std::uint64_t C_FIXED_DELTA_US = 16666;
+
+struct CameraKey
+{
+    glm::vec3 m_Position;
+    glm::vec3 m_Euler;
+};
+
+// a walk through Sponza's atrium starting from the demo view, last key goes back to the first
+static CameraKey constexpr s_CameraPath[] = {
+    CameraKey{ glm::vec3{ -0.23f, 10.41f, 14.70f }, glm::vec3{ -13.32f, -43.83f, 0.0f } },
+    CameraKey{ glm::vec3{ 10.0f, 4.0f, 0.5f },      glm::vec3{ -5.0f, -90.0f, 0.0f } },
+    CameraKey{ glm::vec3{ -10.0f, 4.0f, -0.5f },    glm::vec3{ 0.0f, 90.0f, 0.0f } },
+    CameraKey{ glm::vec3{ 0.0f, 12.0f, 0.0f },      glm::vec3{ -60.0f, 180.0f, 0.0f } },
+};
+static constexpr DRE::U32 C_CAMERA_KEYS_COUNT = sizeof(s_CameraPath) / sizeof(s_CameraPath[0]);
+
+HeadlessBench::HeadlessBench(HeadlessOptions const& options)
+    : m_Options{ options }
+    , m_MaterialLibrary{ &DRE::g_MainAllocator }
+    , m_GeometryLibrary{ &DRE::g_MainAllocator }
+    , m_IOManager{ &DRE::g_MainAllocator, &m_MaterialLibrary, &m_GeometryLibrary }
+    , m_GraphicsManager{ &m_IOManager, options.m_Width, options.m_Height, options.m_Debug }
+    , m_AssetLoader{ &m_IOManager }
+    , m_Scene{ &DRE::g_MainAllocator }
+    , m_SyntheticSceneGenerator{ &m_MaterialLibrary, &m_GeometryLibrary }
+    , m_StreamedModelFrame{ DRE_U32_MAX }
+{
+    WORLD::g_MainScene = &m_Scene;
+
+    m_DeviceName = m_GraphicsManager.GetMainDevice()->GetLogicalDevice()->Properties().properties2.properties.deviceName;
+
+    if (m_Options.m_RecordingJobs != 0)
+        m_GraphicsManager.GetGraphicsSettings().m_RecordingJobs = m_Options.m_RecordingJobs;
+
+    m_GraphicsManager.GetGraphicsSettings().m_SplitBarriers = m_Options.m_SplitBarriers;
+    m_GraphicsManager.GetGraphicsSettings().m_GraphBindingsCache = m_Options.m_GraphBindingsCache;
+
+    if (m_Options.m_TargetGPUTimeMS > 0.0f)
+    {
+        m_GraphicsManager.GetGraphicsSettings().m_DynamicResolution = true;
+        m_GraphicsManager.GetGraphicsSettings().m_TargetGPUTimeMS = m_Options.m_TargetGPUTimeMS;
+    }
+
+    // same order as FixedMetric
+    FindOrAddMetric(m_Metrics, "frame");
+    FindOrAddMetric(m_Metrics, "cpu");
+    FindOrAddMetric(m_Metrics, "present_wait");
+    FindOrAddMetric(m_Metrics, "gpu");
+    FindOrAddMetric(m_Metrics, "cpu/graph_overhead");
+    FindOrAddMetric(m_Metrics, "cpu/asset_pump");
+    DRE_ASSERT(m_Metrics.size() == METRIC_FIXED_COUNT, "HeadlessBench: fixed metrics don't match FixedMetric.");
+}
+
+HeadlessBench::~HeadlessBench()
+{
+    m_AssetLoader.WaitAll();
+    m_GraphicsManager.WaitIdle();
+    m_GraphicsManager.GetTextureBank().UnloadAllTextures();
+    m_GraphicsManager.GetMainRenderGraph().UnloadGraphResources();
+}
+
+bool HeadlessBench::LoadScene()
+{
+    if (m_Options.m_ReplayPath != nullptr)
+    {
+        if (!m_Replay.Read(m_Options.m_ReplayPath) || m_Replay.GetFramesCount() == 0)
+        {
+            DRE_LOG_ERROR("Failed to read input recording %s", m_Options.m_ReplayPath);
+            return false;
+        }
+        m_Options.m_Frames = m_Replay.GetFramesCount();
+    }
+
+    m_IOManager.CompileGLSLSources();
+    m_IOManager.LoadShaderBinaries();
+
+    m_Scene.GetMainCamera().SetFOV(60.0f);
+    UpdateCamera(0);
+
+    WORLD::Light* sunLight = m_Scene.CreateSunLight(m_GraphicsManager.GetMainContext());
+    m_Scene.SetMainSunLight(sunLight);
+    sunLight->SetEulerOrientation(glm::vec3{ -70.0f, 110.0f, 0.0f });
+    sunLight->ScheduleUpdateGPUData();
+
+    m_GraphicsManager.LoadDefaultData(nullptr);
+
+    Data::Texture2D blueNoise256 = m_IOManager.ReadTexture2D("textures\\blue_noise_rgba.png", Data::TEXTURE_VARIATION_RGBA);
+    m_GraphicsManager.GetTextureBank().LoadTexture2DSync("blue_noise_256", 256, 256, VKW::FORMAT_R8G8B8A8_UNORM, blueNoise256.GetBuffer());
+
+    if (m_Options.m_ModelPath != nullptr && m_Options.m_StreamBudgetUS > 0)
+    {
+        // requested now so decoding overlaps warm-up, completions are only pumped from the first measured frame
+        m_AssetLoader.RequestModel(m_Options.m_ModelPath, m_Scene, "default_pbr", DRE::TASK_PRIORITY_HIGH,
+            [this](WORLD::SceneNode* modelNode)
+            {
+                if (modelNode != nullptr)
+                    modelNode->SetScale(0.1f);
+                else
+                    DRE_LOG_WARNING("Failed to stream %s, rendering without it", m_Options.m_ModelPath);
+            });
+    }
+    else if (m_Options.m_ModelPath != nullptr)
+    {
+        WORLD::SceneNode* modelNode = m_IOManager.ParseModelFile(m_Options.m_ModelPath, m_Scene, "default_pbr");
+        if (modelNode != nullptr)
+            modelNode->SetScale(0.1f);
+        else
+            DRE_LOG_WARNING("Failed to load %s, rendering without it", m_Options.m_ModelPath);
+    }
+
+    if (m_Options.m_UseSyntheticScene)
+    {
+        m_SyntheticSceneGenerator.Generate(m_Options.m_SyntheticScene, m_Scene, m_GraphicsManager.GetMainContext());
+    }
+
+    m_GraphicsManager.SubmitTransientUploads();
+
+    return true;
+}
+
+std::uint64_t HeadlessBench::UpdateCamera(DRE::U32 frame)
+{
+    if (m_Replay.GetFramesCount() > 0)
+    {
+        DRE::U32 const replayFrame = frame < m_Options.m_WarmupFrames ? 0 : frame - m_Options.m_WarmupFrames;
+        SYS::InputFrame const& recorded = m_Replay.GetFrame(std::min(replayFrame, m_Replay.GetFramesCount() - 1));
+
+        m_Scene.GetMainCamera().SetPosition(glm::vec3{ recorded.m_CameraPosition[0], recorded.m_CameraPosition[1], recorded.m_CameraPosition[2] });
+        m_Scene.GetMainCamera().SetCameraEuler(glm::vec3{ recorded.m_CameraEuler[0], recorded.m_CameraEuler[1], recorded.m_CameraEuler[2] });
+        return recorded.m_DeltaTimeUS;
+    }
+
+
+    // whole path is covered once per measured run
+    float const pathT = static_cast<float>(frame) / static_cast<float>(std::max(m_Options.m_WarmupFrames + m_Options.m_Frames, 1u)) * C_CAMERA_KEYS_COUNT;
+    DRE::U32 const key = static_cast<DRE::U32>(pathT) % C_CAMERA_KEYS_COUNT;
+    float const t = pathT - std::floor(pathT);
+
+    CameraKey const& from = s_CameraPath[key];
+    CameraKey const& to = s_CameraPath[(key + 1) % C_CAMERA_KEYS_COUNT];
+
+    m_Scene.GetMainCamera().SetPosition(glm::mix(from.m_Position, to.m_Position, t));
+    m_Scene.GetMainCamera().SetCameraEuler(glm::mix(from.m_Euler, to.m_Euler, t));
+
+    return C_FIXED_DELTA_US;
+}
+
+void HeadlessBench::Run()
+{
+    DRE::Stopwatch frameStopwatch;
+    DRE::U32 const framesCount = m_Options.m_WarmupFrames + m_Options.m_Frames;
+    std::uint64_t timeUS = 0;
+
+    for (DRE::U32 frame = 0; frame < framesCount; frame++)
+    {
+        DRE_CPU_FRAME_MARK();
+        frameStopwatch.Reset();
+
+        std::uint64_t const deltaUS = UpdateCamera(frame);
+        timeUS += deltaUS;
+
+        DRE::g_AppContext.m_DeltaTimeUS = deltaUS;
+        DRE::g_AppContext.m_TimeSinceStartUS = timeUS;
+        DRE::g_AppContext.m_EngineFrame = frame;
+
+        DRE::g_FrameScratchAllocator.Reset();
+
+        m_GraphicsManager.GetMainContext().ResetDependenciesVectors(&DRE::g_FrameScratchAllocator);
+
+        std::uint64_t pumpUS = 0;
+        if (m_Options.m_StreamBudgetUS > 0 && frame >= m_Options.m_WarmupFrames)
+        {
+            DRE::Stopwatch pumpStopwatch;
+            bool const pending = m_AssetLoader.GetPendingCount() > 0;
+            m_AssetLoader.PumpCompletions(m_Options.m_StreamBudgetUS);
+            pumpUS = pumpStopwatch.CurrentMicroseconds();
+
+            if (pending && m_AssetLoader.GetPendingCount() == 0)
+                m_StreamedModelFrame = frame - m_Options.m_WarmupFrames;
+        }
+
+        m_IOManager.ResumeMainThreadTasks();
+        m_GraphicsManager.GetMainContext().WriteResourceDependencies();
+
+        float const timeS = static_cast<float>(timeUS) / 1000000.0f;
+        m_GraphicsManager.RenderFrame(frame, deltaUS, timeS);
+
+        if (frame == 0)
+        {
+            DRE::g_AppContext.m_TimeToFirstFrameUS = DRE::Stopwatch::GlobalTimeMicroseconds() - DRE::g_AppContext.m_ProcessStartUS;
+            DRE_LOG_INFO("Time to first frame: %.3fms", DRE::g_AppContext.m_TimeToFirstFrameUS / 1000.0);
+        }
+
+        float const frameMS = static_cast<float>(frameStopwatch.CurrentMicroseconds()) / 1000.0f;
+        float const presentWaitMS = static_cast<float>(m_GraphicsManager.GetPresentWaitUS()) / 1000.0f;
+        DRE::g_FrameStats.AddFrame(frame, frameMS - presentWaitMS, m_GraphicsManager.GetGPUFrameTimeMS(), presentWaitMS);
+
+        if (frame >= m_Options.m_WarmupFrames)
+        {
+            RecordFrame(frameMS, presentWaitMS);
+            if (m_Options.m_StreamBudgetUS > 0)
+                m_Metrics[METRIC_ASSET_PUMP].m_Samples.emplace_back(static_cast<float>(pumpUS) / 1000.0f);
+        }
+    }
+
+    m_GraphicsManager.WaitIdle();
+}
+
+HeadlessBench::Metric& HeadlessBench::FindOrAddMetric(std::vector<Metric>& metrics, char const* name)
+{
+    for (Metric& metric : metrics)
+    {
+        if (metric.m_Name == name)
+            return metric;
+    }
+
+    Metric& metric = metrics.emplace_back();
+    metric.m_Name = name;
+    metric.m_Samples.reserve(m_Options.m_Frames);
+    return metric;
+}
+
+void HeadlessBench::RecordFrame(float frameMS, float presentWaitMS)
+{
+    VKW::TimestampQueries const& timestamps = m_GraphicsManager.GetTimestampQueries();
+    GFX::RenderGraph const& graph = m_GraphicsManager.GetMainRenderGraph();
+
+    m_Metrics[METRIC_FRAME].m_Samples.emplace_back(frameMS);
+    m_Metrics[METRIC_CPU].m_Samples.emplace_back(frameMS - presentWaitMS);
+    m_Metrics[METRIC_PRESENT_WAIT].m_Samples.emplace_back(presentWaitMS);
+    m_Metrics[METRIC_GRAPH_OVERHEAD].m_Samples.emplace_back(static_cast<float>(graph.GetOverheadUS()) / 1000.0f);
+
+    char name[128];
+    RecordCounters("frame", m_GraphicsManager.GetFrameCounters());
+    for (std::uint32_t i = 0, size = graph.GetPassesCount(); i < size; i++)
+    {
+        RecordCounters(GFX::PassIDToString(graph.GetPassID(i)), graph.GetPassCounters(i));
+
+        std::snprintf(name, sizeof(name), "cpu/%s", GFX::PassIDToString(graph.GetPassID(i)));
+        FindOrAddMetric(m_Metrics, name).m_Samples.emplace_back(static_cast<float>(graph.GetPassRecordTimeUS(i)) / 1000.0f);
+    }
+
+    // GPU results lag FRAMES_BUFFERING frames, warm-up is long enough to cover it
+    if (!timestamps.IsSupported())
+        return;
+
+    m_Metrics[METRIC_GPU].m_Samples.emplace_back(m_GraphicsManager.GetGPUFrameTimeMS());
+
+    for (std::uint32_t i = 0, size = timestamps.GetResultsCount(); i < size; i++)
+    {
+        VKW::TimestampQueries::ScopeResult const& result = timestamps.GetResults()[i];
+        std::snprintf(name, sizeof(name), "gpu/%s", result.m_Name);
+        FindOrAddMetric(m_Metrics, name).m_Samples.emplace_back(result.m_TimeMS);
+    }
+
+    VKW::TimestampQueries const* asyncTimestamps = m_GraphicsManager.GetAsyncTimestampQueries();
+    for (std::uint32_t i = 0, size = asyncTimestamps != nullptr ? asyncTimestamps->GetResultsCount() : 0; i < size; i++)
+    {
+        VKW::TimestampQueries::ScopeResult const& result = asyncTimestamps->GetResults()[i];
+        std::snprintf(name, sizeof(name), "gpu_async/%s", result.m_Name);
+        FindOrAddMetric(m_Metrics, name).m_Samples.emplace_back(result.m_TimeMS);
+    }
+}
+
+void HeadlessBench::RecordCounters(char const* prefix, GFX::RenderCounters const& counters)
+{
+    auto record = [this, prefix](char const* counter, std::uint64_t value)
+    {
+        char name[128];
+        std::snprintf(name, sizeof(name), "%s/%s", prefix, counter);
+        FindOrAddMetric(m_Counters, name).m_Samples.emplace_back(static_cast<float>(value));
+    };
+
+    record("draws",             counters.m_Draws);
+    record("dispatches",        counters.m_Dispatches);
+    record("pipeline_binds",    counters.m_PipelineBinds);
+    record("descriptor_writes", counters.m_DescriptorWrites);
+    record("barriers",          counters.m_Barriers);
+    record("barrier_batches",   counters.m_BarrierBatches);
+    record("split_barriers",    counters.m_SplitBarriers);
+    record("flushes",           counters.m_Flushes);
+    record("upload_bytes",      counters.m_UploadBytes);
+    record("uniform_bytes",     counters.m_UniformBytes);
+}
+
+bool HeadlessBench::WriteJSON(char const* path) const
+{
+    std::FILE* file = std::fopen(path, "w");
+    if (file == nullptr)
+        return false;
+
+    std::fprintf(file, "{\n  \"unit\": \"ms\",\n  \"device\": \"%s\",\n  \"width\": %u,\n  \"height\": %u,\n  \"frames\": %u,\n  \"recording_jobs\": %u,\n  \"time_to_first_frame_ms\": %.3f,\n  \"benchmarks\": [\n",
+        m_DeviceName.c_str(), m_Options.m_Width, m_Options.m_Height, m_Options.m_Frames, m_GraphicsManager.GetGraphicsSettings().m_RecordingJobs,
+        DRE::g_AppContext.m_TimeToFirstFrameUS / 1000.0);
+
+    std::vector<float> sorted;
+    auto writeMetrics = [file, &sorted](std::vector<Metric> const& metrics)
+    {
+        bool first = true;
+        for (Metric const& metric : metrics)
+        {
+            if (metric.m_Samples.empty())
+                continue;
+
+            sorted = metric.m_Samples;
+            std::sort(sorted.begin(), sorted.end());
+
+            std::size_t const count = sorted.size();
+            double mean = 0.0;
+            for (float sample : sorted)
+                mean += sample;
+            mean /= count;
+
+            double variance = 0.0;
+            for (float sample : sorted)
+                variance += (sample - mean) * (sample - mean);
+            variance /= count;
+
+            auto percentile = [&sorted, count](double p) { return sorted[std::min(static_cast<std::size_t>(p * count), count - 1)]; };
+
+            std::fprintf(file,
+                "%s    { \"name\": \"%s\", \"samples\": %zu, \"min\": %.4f, \"median\": %.4f, \"mean\": %.4f, \"p95\": %.4f, \"p99\": %.4f, \"max\": %.4f, \"stddev\": %.4f }",
+                first ? "" : ",\n", metric.m_Name.c_str(), count,
+                sorted.front(), percentile(0.5), mean, percentile(0.95), percentile(0.99), sorted.back(), std::sqrt(variance));
+            first = false;
+        }
+    };
+
+    writeMetrics(m_Metrics);
+    std::fprintf(file, "\n  ],\n  \"counters\": [\n");
+    writeMetrics(m_Counters);
+
+    GFX::GraphResourcesManager::TransientMemoryStats const& memory = m_GraphicsManager.GetMainRenderGraph().GetResourcesManager().GetTransientMemoryStats();
+    std::fprintf(file, "\n  ],\n  \"graph_memory\": { \"transient_textures\": %u, \"transient_dedicated_bytes\": %llu, \"transient_heap_bytes\": %llu, \"saved_bytes\": %llu, \"persistent_bytes\": %llu },\n",
+        memory.texturesCount, static_cast<unsigned long long>(memory.dedicatedBytes), static_cast<unsigned long long>(memory.heapBytes),
+        static_cast<unsigned long long>(memory.dedicatedBytes - memory.heapBytes), static_cast<unsigned long long>(memory.persistentBytes));
+
+    // loaded_frame is -1 when the model didn't finish within the measured frames
+    std::fprintf(file, "  \"asset_streaming\": { \"budget_us\": %llu, \"max_pump_us\": %llu, \"over_budget_pumps\": %u, \"loaded_frame\": %d }\n}\n",
+        static_cast<unsigned long long>(m_Options.m_StreamBudgetUS), static_cast<unsigned long long>(m_AssetLoader.GetMaxPumpTimeUS()),
+        m_AssetLoader.GetOverBudgetPumpsCount(), m_StreamedModelFrame == DRE_U32_MAX ? -1 : static_cast<int>(m_StreamedModelFrame));
+
+    return std::fclose(file) == 0;
+}
+
+void HeadlessBench::PrintSummary() const
+{
+    DRE::FrameStats::Summary const summary = DRE::g_FrameStats.ComputeSummary(m_Options.m_Frames);
+
+    DRE_LOG_INFO("%u frames at %ux%u", summary.m_SamplesCount, m_Options.m_Width, m_Options.m_Height);
+    DRE_LOG_INFO("  time to first frame: %.3fms", DRE::g_AppContext.m_TimeToFirstFrameUS / 1000.0);
+    DRE_LOG_INFO("  frame  p50 %7.3fms  p95 %7.3fms  p99 %7.3fms  max %7.3fms", summary.m_Frame.m_P50, summary.m_Frame.m_P95, summary.m_Frame.m_P99, summary.m_Frame.m_Max);
+    DRE_LOG_INFO("  cpu    p50 %7.3fms  p95 %7.3fms  p99 %7.3fms  max %7.3fms", summary.m_CPU.m_P50, summary.m_CPU.m_P95, summary.m_CPU.m_P99, summary.m_CPU.m_Max);
+    DRE_LOG_INFO("  gpu    p50 %7.3fms  p95 %7.3fms  p99 %7.3fms  max %7.3fms", summary.m_GPU.m_P50, summary.m_GPU.m_P95, summary.m_GPU.m_P99, summary.m_GPU.m_Max);
+    DRE_LOG_INFO("  hitches over %.1fms: %u", DRE::g_FrameStats.GetHitchThresholdMS(), DRE::g_FrameStats.GetHitchesCount());
+    if (m_Options.m_TargetGPUTimeMS > 0.0f)
+        DRE_LOG_INFO("  render scale at the end: %.2f (target %.1fms)", m_GraphicsManager.GetDynamicResolution().GetScale(), m_Options.m_TargetGPUTimeMS);
+
+    DRE_LOG_INFO("  graph overhead in the last frame: %.3fms (bindings cache %s)",
+        m_GraphicsManager.GetMainRenderGraph().GetOverheadUS() / 1000.0, m_Options.m_GraphBindingsCache ? "on" : "off");
+
+    if (m_Options.m_StreamBudgetUS > 0)
+        DRE_LOG_INFO("  asset streaming: max pump %.3fms for a %.3fms budget, %u pumps over budget",
+            m_AssetLoader.GetMaxPumpTimeUS() / 1000.0, m_Options.m_StreamBudgetUS / 1000.0, m_AssetLoader.GetOverBudgetPumpsCount());
+
+    GFX::RenderCounters const& counters = m_GraphicsManager.GetFrameCounters();
+    DRE_LOG_INFO("  last frame: %u draws, %u dispatches, %u pipeline binds, %u set writes, %u barriers in %u batches (%u split), %u flushes",
+        counters.m_Draws, counters.m_Dispatches,
+        counters.m_PipelineBinds, counters.m_DescriptorWrites,
+        counters.m_Barriers, counters.m_BarrierBatches,
+        counters.m_SplitBarriers, counters.m_Flushes);
+
+    GFX::GraphResourcesManager::TransientMemoryStats const& memory = m_GraphicsManager.GetMainRenderGraph().GetResourcesManager().GetTransientMemoryStats();
+    DRE_LOG_INFO("  graph textures: %u transient %.1fMB placed in %.1fMB heap (%.1fMB saved), %.1fMB persistent",
+        memory.texturesCount, memory.dedicatedBytes / (1024.0 * 1024.0), memory.heapBytes / (1024.0 * 1024.0),
+        (memory.dedicatedBytes - memory.heapBytes) / (1024.0 * 1024.0), memory.persistentBytes / (1024.0 * 1024.0));
+}
+
+}
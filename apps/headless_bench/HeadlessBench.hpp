@@ -0,0 +1,136 @@
+#pragma once
+
+#include <foundation\Common.hpp>
+#include <foundation\class_features\NonCopyable.hpp>
+#include <foundation\class_features\NonMovable.hpp>
+#include <foundation\input\InputRecording.hpp>
+
+#include <engine\scene\Scene.hpp>
+#include <engine\scene\SyntheticScene.hpp>
+#include <engine\data\MaterialLibrary.hpp>
+#include <engine\data\GeometryLibrary.hpp>
+#include <engine\io\IOManager.hpp>
+#include <engine\io\AssetLoader.hpp>
+
+#include <gfx\GraphicsManager.hpp>
+
+#include <string>
+#include <vector>
+
+namespace BENCH
+{
+
+struct HeadlessOptions
+{
+    DRE::U32        m_Width         = 1600;
+    DRE::U32        m_Height        = 900;
+    DRE::U32        m_WarmupFrames  = 60;
+    DRE::U32        m_Frames        = 600;
+    bool            m_Debug         = false;
+    char const*     m_ModelPath     = "data\\Sponza\\glTF\\Sponza.gltf";
+    char const*     m_JSONPath      = "headless_bench.json";
+    char const*     m_CSVPath       = "headless_frames.csv";
+
+    // demo_app --record-input capture, replaces the scripted camera path and the fixed time step
+    char const*     m_ReplayPath    = nullptr;
+
+    // GraphicsSettings::m_RecordingJobs, 0 keeps the engine default (one job per recording worker + main thread)
+    DRE::U32        m_RecordingJobs = 0;
+
+    // GraphicsSettings::m_SplitBarriers, off to compare against plain barriers
+    bool            m_SplitBarriers = true;
+
+    // GraphicsSettings::m_GraphBindingsCache, off to measure the graph overhead without it
+    bool            m_GraphBindingsCache = true;
+
+    // enables GraphicsSettings::m_DynamicResolution with this GPU frame budget, 0 keeps the full resolution
+    float           m_TargetGPUTimeMS = 0.0f;
+
+    // streams the model through IO::AssetLoader during the measured frames with this per-frame completion budget,
+    // 0 loads it synchronously before the first frame
+    std::uint64_t   m_StreamBudgetUS = 0;
+
+    bool                        m_UseSyntheticScene = false;
+    WORLD::SyntheticSceneDesc   m_SyntheticScene;
+};
+
+/*
+*
+* Renders a fixed number of frames offscreen along a scripted camera path, no window and no swapchain.
+* Time is stepped at a fixed rate so every run renders the same images, only the measured durations differ.
+* With a replay file the camera and time steps come from the recording instead, warm-up holds its first frame.
+* The report keeps dre_bench's layout ("benchmarks" array with median/p95/stddev), in milliseconds.
+* Render counters of the frame and of every pass go to a separate "counters" array with the same statistics.
+* "graph_memory" reports how much the transient render graph textures save by sharing memory, run with
+* --width 1920 --height 1080 and --width 3840 --height 2160 to compare resolutions.
+* "cpu/<pass>" is the recording time of every pass, run a --synthetic scene of 10000+ objects with
+* --record-jobs 1, 2, 4... to see how parallel recording of the draw-heavy passes scales.
+* With --stream-budget-us the model is loaded while frames render, "cpu/asset_pump" and "asset_streaming"
+* show whether the completion pump stayed under its budget.
+*
+*/
+class HeadlessBench
+    : public NonCopyable
+    , public NonMovable
+{
+public:
+    HeadlessBench(HeadlessOptions const& options);
+    ~HeadlessBench();
+
+    // false if the replay file can't be read
+    bool    LoadScene();
+    void    Run();
+
+    bool    WriteJSON(char const* path) const;
+    void    PrintSummary() const;
+
+private:
+    // first entries of m_Metrics, passes are appended after them
+    enum FixedMetric : std::uint32_t
+    {
+        METRIC_FRAME,
+        METRIC_CPU,
+        METRIC_PRESENT_WAIT,
+        METRIC_GPU,
+        METRIC_GRAPH_OVERHEAD,
+        METRIC_ASSET_PUMP,
+        METRIC_FIXED_COUNT
+    };
+
+    struct Metric
+    {
+        std::string         m_Name;
+        std::vector<float>  m_Samples;
+    };
+
+    // returns the time step of the frame
+    std::uint64_t UpdateCamera(DRE::U32 frame);
+    void    RecordFrame(float frameMS, float presentWaitMS);
+    void    RecordCounters(char const* prefix, GFX::RenderCounters const& counters);
+    Metric& FindOrAddMetric(std::vector<Metric>& metrics, char const* name);
+
+private:
+    HeadlessOptions             m_Options;
+    std::string                 m_DeviceName;
+
+    Data::MaterialLibrary       m_MaterialLibrary;
+    Data::GeometryLibrary       m_GeometryLibrary;
+    IO::IOManager               m_IOManager;
+    GFX::GraphicsManager        m_GraphicsManager;
+    IO::AssetLoader             m_AssetLoader;
+
+    WORLD::Scene                m_Scene;
+    WORLD::SyntheticSceneGenerator m_SyntheticSceneGenerator;
+    SYS::InputRecording         m_Replay;
+
+    // measured frame the streamed model was instantiated in, DRE_U32_MAX until then
+    DRE::U32                    m_StreamedModelFrame;
+
+    // FixedMetric slots, then cpu and gpu passes in the order they were first seen
+    std::vector<Metric>         m_Metrics;
+
+    // frame first, then passes, "<scope>/<counter>"
+    std::vector<Metric>         m_Counters;
+};
+
+}
@@ -0,0 +1,112 @@
+#include "HeadlessBench.hpp"
+
+#include <foundation\memory\Memory.hpp>
+#include <foundation\system\Log.hpp>
+#include <foundation\system\FrameStats.hpp>
+#include <foundation\system\Time.hpp>
+
+#include <engine\ApplicationContext.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+/*
+*
+* headless_bench [--frames <count>] [--warmup <count>] [--width <px>] [--height <px>] [--model <path>|none] [--synthetic <objects>,<meshes>,<materials>,<lights>,<depth>,<fanout>] [--record-jobs <count>] [--no-split-barriers] [--no-graph-cache] [--target-gpu-ms <ms>] [--stream-budget-us <us>] [--replay-input <path>] [--json <path>] [--csv <path>] [--log-file <path>] [--debug]
+*
+*/
+int main(int argc, char** argv)
+{
+    DRE::g_AppContext.m_ProcessStartUS = DRE::Stopwatch::GlobalTimeMicroseconds();
+
+    BENCH::HeadlessOptions options;
+
+    for (int i = 1; i < argc; i++)
+    {
+        bool const hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--frames") == 0 && hasValue)
+            options.m_Frames = static_cast<DRE::U32>(std::atoi(argv[++i]));
+        else if (std::strcmp(argv[i], "--warmup") == 0 && hasValue)
+            options.m_WarmupFrames = static_cast<DRE::U32>(std::atoi(argv[++i]));
+        else if (std::strcmp(argv[i], "--width") == 0 && hasValue)
+            options.m_Width = static_cast<DRE::U32>(std::atoi(argv[++i]));
+        else if (std::strcmp(argv[i], "--height") == 0 && hasValue)
+            options.m_Height = static_cast<DRE::U32>(std::atoi(argv[++i]));
+        else if (std::strcmp(argv[i], "--model") == 0 && hasValue)
+            options.m_ModelPath = std::strcmp(argv[++i], "none") == 0 ? nullptr : argv[i];
+        else if (std::strcmp(argv[i], "--synthetic") == 0 && hasValue)
+        {
+            WORLD::SyntheticSceneDesc& desc = options.m_SyntheticScene;
+            options.m_UseSyntheticScene = std::sscanf(argv[++i], "%u,%u,%u,%u,%u,%u",
+                &desc.m_ObjectsCount, &desc.m_MeshesCount, &desc.m_MaterialsCount, &desc.m_LightsCount, &desc.m_HierarchyDepth, &desc.m_FanOut) > 0;
+        }
+        else if (std::strcmp(argv[i], "--record-jobs") == 0 && hasValue)
+            options.m_RecordingJobs = static_cast<DRE::U32>(std::atoi(argv[++i]));
+        else if (std::strcmp(argv[i], "--no-split-barriers") == 0)
+            options.m_SplitBarriers = false;
+        else if (std::strcmp(argv[i], "--no-graph-cache") == 0)
+            options.m_GraphBindingsCache = false;
+        else if (std::strcmp(argv[i], "--target-gpu-ms") == 0 && hasValue)
+            options.m_TargetGPUTimeMS = static_cast<float>(std::atof(argv[++i]));
+        else if (std::strcmp(argv[i], "--stream-budget-us") == 0 && hasValue)
+            options.m_StreamBudgetUS = static_cast<std::uint64_t>(std::atoll(argv[++i]));
+        else if (std::strcmp(argv[i], "--replay-input") == 0 && hasValue)
+            options.m_ReplayPath = argv[++i];
+        else if (std::strcmp(argv[i], "--json") == 0 && hasValue)
+            options.m_JSONPath = argv[++i];
+        else if (std::strcmp(argv[i], "--csv") == 0 && hasValue)
+            options.m_CSVPath = argv[++i];
+        else if (std::strcmp(argv[i], "--log-file") == 0 && hasValue)
+            DRE::Log::SetFileSink(argv[++i]);
+        else if (std::strcmp(argv[i], "--debug") == 0)
+            options.m_Debug = true;
+        else
+        {
+            std::printf("usage: headless_bench [--frames <count>] [--warmup <count>] [--width <px>] [--height <px>] [--model <path>|none] [--synthetic <objects>,<meshes>,<materials>,<lights>,<depth>,<fanout>] [--record-jobs <count>] [--no-split-barriers] [--no-graph-cache] [--target-gpu-ms <ms>] [--stream-budget-us <us>] [--replay-input <path>] [--json <path>] [--csv <path>] [--log-file <path>] [--debug]\n");
+            return 1;
+        }
+    }
+
+    // GPU timings of a frame are resolved FRAMES_BUFFERING frames later
+    options.m_WarmupFrames = std::max(options.m_WarmupFrames, static_cast<DRE::U32>(VKW::CONSTANTS::FRAMES_BUFFERING));
+
+    DRE::InitializeGlobalMemory();
+
+    // same as the demo app delegate, too big for the stack
+    BENCH::HeadlessBench* bench = (BENCH::HeadlessBench*)DRE::g_PersistentDataAllocator.Alloc(sizeof(BENCH::HeadlessBench), alignof(BENCH::HeadlessBench));
+    new (bench) BENCH::HeadlessBench{ options };
+
+    int result = 0;
+    if (!bench->LoadScene())
+    {
+        bench->~HeadlessBench();
+        DRE::TerminateGlobalMemory();
+        std::exit(1);
+    }
+
+    bench->Run();
+    bench->PrintSummary();
+
+    if (!bench->WriteJSON(options.m_JSONPath))
+    {
+        DRE_LOG_ERROR("Failed to write %s", options.m_JSONPath);
+        result = 1;
+    }
+    if (!DRE::g_FrameStats.WriteCSV(options.m_CSVPath))
+    {
+        DRE_LOG_ERROR("Failed to write %s", options.m_CSVPath);
+        result = 1;
+    }
+
+    bench->~HeadlessBench();
+
+    DRE::TerminateGlobalMemory();
+
+    // to terminate all detached threads we don't care about
+    std::exit(result);
+
+    return result;
+}
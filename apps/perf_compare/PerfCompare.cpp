@@ -0,0 +1,343 @@
+#include "PerfCompare.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+namespace BENCH
+{
+
+namespace
+{
+
+// just enough JSON for our own reports: objects, arrays, strings and numbers, string escapes are copied verbatim
+class Reader
+{
+public:
+    Reader(std::string const& text) : m_Text{ text }, m_Pos{ 0 } {}
+
+    void SkipSpace()
+    {
+        while (m_Pos < m_Text.size() && std::isspace(static_cast<unsigned char>(m_Text[m_Pos])))
+            m_Pos++;
+    }
+
+    bool Consume(char c)
+    {
+        SkipSpace();
+        if (m_Pos < m_Text.size() && m_Text[m_Pos] == c)
+        {
+            m_Pos++;
+            return true;
+        }
+        return false;
+    }
+
+    char Peek()
+    {
+        SkipSpace();
+        return m_Pos < m_Text.size() ? m_Text[m_Pos] : '\0';
+    }
+
+    bool ReadString(std::string& result)
+    {
+        if (!Consume('"'))
+            return false;
+
+        result.clear();
+        while (m_Pos < m_Text.size() && m_Text[m_Pos] != '"')
+        {
+            if (m_Text[m_Pos] == '\\' && m_Pos + 1 < m_Text.size())
+                m_Pos++;
+            result += m_Text[m_Pos++];
+        }
+        return Consume('"');
+    }
+
+    bool ReadNumber(double& result)
+    {
+        SkipSpace();
+        char const* start = m_Text.c_str() + m_Pos;
+        char* end = nullptr;
+        result = std::strtod(start, &end);
+        if (end == start)
+            return false;
+
+        m_Pos += end - start;
+        return true;
+    }
+
+    // skips any value, nested ones included
+    bool SkipValue()
+    {
+        char const c = Peek();
+        if (c == '"')
+        {
+            std::string ignored;
+            return ReadString(ignored);
+        }
+        if (c == '{' || c == '[')
+        {
+            char const close = c == '{' ? '}' : ']';
+            m_Pos++;
+            if (Consume(close))
+                return true;
+            do
+            {
+                if (close == '}')
+                {
+                    std::string key;
+                    if (!ReadString(key) || !Consume(':'))
+                        return false;
+                }
+                if (!SkipValue())
+                    return false;
+            } while (Consume(','));
+            return Consume(close);
+        }
+
+        // number, true, false, null
+        while (m_Pos < m_Text.size() && std::strchr(",}] \t\r\n", m_Text[m_Pos]) == nullptr)
+            m_Pos++;
+        return true;
+    }
+
+private:
+    std::string const&  m_Text;
+    std::size_t         m_Pos;
+};
+
+bool ReadMetric(Reader& reader, Metric& metric)
+{
+    if (!reader.Consume('{'))
+        return false;
+    if (reader.Consume('}'))
+        return true;
+
+    std::string key;
+    do
+    {
+        if (!reader.ReadString(key) || !reader.Consume(':'))
+            return false;
+
+        double number = 0.0;
+        if (key == "name")
+        {
+            if (!reader.ReadString(metric.m_Name))
+                return false;
+            continue;
+        }
+
+        if (reader.Peek() == '"' || reader.Peek() == '{' || reader.Peek() == '[')
+        {
+            if (!reader.SkipValue())
+                return false;
+            continue;
+        }
+
+        if (!reader.ReadNumber(number))
+            return false;
+
+        if (key == "median")
+            metric.m_Median = number;
+        else if (key == "mean")
+            metric.m_Mean = number;
+        else if (key == "p95")
+            metric.m_P95 = number;
+        else if (key == "stddev")
+            metric.m_StdDev = number;
+        else if (key == "samples" || key == "repetitions")
+            metric.m_Samples = static_cast<std::uint32_t>(std::max(number, 1.0));
+    } while (reader.Consume(','));
+
+    return reader.Consume('}');
+}
+
+}
+
+Metric const* ResultsFile::FindMetric(std::string const& name) const
+{
+    for (Metric const& metric : m_Metrics)
+    {
+        if (metric.m_Name == name)
+            return &metric;
+    }
+    return nullptr;
+}
+
+bool ReadResultsFile(char const* path, ResultsFile& result)
+{
+    std::ifstream stream{ path };
+    if (!stream)
+        return false;
+
+    std::stringstream buffer;
+    buffer << stream.rdbuf();
+    std::string const text = buffer.str();
+
+    Reader reader{ text };
+    if (!reader.Consume('{'))
+        return false;
+
+    bool hasBenchmarks = false;
+    std::string key;
+    do
+    {
+        if (!reader.ReadString(key) || !reader.Consume(':'))
+            return false;
+
+        if (key == "unit")
+        {
+            if (!reader.ReadString(result.m_Unit))
+                return false;
+        }
+        else if (key == "benchmarks")
+        {
+            if (!reader.Consume('['))
+                return false;
+
+            hasBenchmarks = true;
+            if (reader.Consume(']'))
+                continue;
+
+            do
+            {
+                Metric metric;
+                if (!ReadMetric(reader, metric))
+                    return false;
+
+                // mean isn't written by every producer, median is the next best estimate
+                if (metric.m_Mean == 0.0)
+                    metric.m_Mean = metric.m_Median;
+                result.m_Metrics.emplace_back(metric);
+            } while (reader.Consume(','));
+
+            if (!reader.Consume(']'))
+                return false;
+        }
+        else if (!reader.SkipValue())
+        {
+            return false;
+        }
+    } while (reader.Consume(','));
+
+    return hasBenchmarks;
+}
+
+CompareReport Compare(ResultsFile const& baseline, ResultsFile const& candidate, CompareSettings const& settings)
+{
+    CompareReport report;
+
+    for (Metric const& base : baseline.m_Metrics)
+    {
+        if (settings.m_Filter != nullptr && base.m_Name.find(settings.m_Filter) == std::string::npos)
+            continue;
+
+        Metric const* next = candidate.FindMetric(base.m_Name);
+        if (next == nullptr)
+        {
+            report.m_OnlyInBaseline.emplace_back(base.m_Name);
+            continue;
+        }
+
+        Comparison& comparison = report.m_Comparisons.emplace_back();
+        comparison.m_Name = base.m_Name;
+        comparison.m_BaselineMedian = base.m_Median;
+        comparison.m_CandidateMedian = next->m_Median;
+        comparison.m_DeltaPercent = base.m_Median > 0.0 ? (next->m_Median - base.m_Median) / base.m_Median * 100.0 : 0.0;
+
+        double const standardError = std::sqrt(
+            base.m_StdDev * base.m_StdDev / base.m_Samples +
+            next->m_StdDev * next->m_StdDev / next->m_Samples);
+        double const meanDelta = next->m_Mean - base.m_Mean;
+
+        // zero spread on both sides (single sample, or constant) leaves only the delta threshold
+        comparison.m_ZScore = standardError > 0.0 ? meanDelta / standardError : (meanDelta != 0.0 ? HUGE_VAL * meanDelta : 0.0);
+
+        bool const significant = std::fabs(comparison.m_DeltaPercent) > settings.m_MinDeltaPercent && std::fabs(comparison.m_ZScore) > settings.m_ZScore;
+        if (!significant)
+            comparison.m_Change = ChangeType::Unchanged;
+        else
+            comparison.m_Change = comparison.m_DeltaPercent > 0.0 ? ChangeType::Regression : ChangeType::Improvement;
+
+        if (comparison.m_Change == ChangeType::Regression && comparison.m_DeltaPercent > settings.m_FailPercent)
+            report.m_FailedCount++;
+    }
+
+    for (Metric const& next : candidate.m_Metrics)
+    {
+        if (settings.m_Filter != nullptr && next.m_Name.find(settings.m_Filter) == std::string::npos)
+            continue;
+
+        if (baseline.FindMetric(next.m_Name) == nullptr)
+            report.m_OnlyInCandidate.emplace_back(next.m_Name);
+    }
+
+    std::stable_sort(report.m_Comparisons.begin(), report.m_Comparisons.end(), [](Comparison const& lhs, Comparison const& rhs)
+        {
+            return lhs.m_DeltaPercent > rhs.m_DeltaPercent;
+        });
+
+    return report;
+}
+
+void PrintReport(CompareReport const& report, CompareSettings const& settings, std::string const& unit)
+{
+    auto printRow = [&unit](Comparison const& comparison, char const* tag)
+    {
+        std::printf("  %-12s %-48s %12.4f -> %12.4f %-6s %+8.2f%%  z %+7.2f\n", tag, comparison.m_Name.c_str(),
+            comparison.m_BaselineMedian, comparison.m_CandidateMedian, unit.c_str(), comparison.m_DeltaPercent, comparison.m_ZScore);
+    };
+
+    std::uint32_t regressions = 0;
+    std::uint32_t improvements = 0;
+    std::uint32_t unchanged = 0;
+
+    std::printf("Regressions (median, lower is better):\n");
+    for (Comparison const& comparison : report.m_Comparisons)
+    {
+        if (comparison.m_Change != ChangeType::Regression)
+            continue;
+
+        printRow(comparison, comparison.m_DeltaPercent > settings.m_FailPercent ? "[FAIL]" : "[regressed]");
+        regressions++;
+    }
+
+    std::printf("Improvements:\n");
+    for (auto it = report.m_Comparisons.rbegin(); it != report.m_Comparisons.rend(); ++it)
+    {
+        if (it->m_Change != ChangeType::Improvement)
+            continue;
+
+        printRow(*it, "[improved]");
+        improvements++;
+    }
+
+    if (settings.m_Verbose)
+        std::printf("Unchanged:\n");
+
+    for (Comparison const& comparison : report.m_Comparisons)
+    {
+        if (comparison.m_Change != ChangeType::Unchanged)
+            continue;
+
+        if (settings.m_Verbose)
+            printRow(comparison, "[same]");
+        unchanged++;
+    }
+
+    for (std::string const& name : report.m_OnlyInBaseline)
+        std::printf("  [missing]    %s\n", name.c_str());
+    for (std::string const& name : report.m_OnlyInCandidate)
+        std::printf("  [new]        %s\n", name.c_str());
+
+    std::printf("%u regressed (%u past %.1f%%), %u improved, %u unchanged\n",
+        regressions, report.m_FailedCount, settings.m_FailPercent, improvements, unchanged);
+}
+
+}
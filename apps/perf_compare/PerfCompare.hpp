@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace BENCH
+{
+
+/*
+*
+* Reads dre_bench and headless_bench reports and compares two of them.
+* Standard library only, so it builds and runs on any CI machine regardless of Win32 and Vulkan.
+*
+* Every entry of the "benchmarks" array is a metric where lower is better. A change counts when:
+*   - median moved by more than MinDeltaPercent, so tiny shifts are ignored even if they are consistent
+*   - mean difference is ZScore standard errors away from zero (Welch), so noisy metrics need a bigger shift
+*
+*/
+struct Metric
+{
+    std::string     m_Name;
+    double          m_Median    = 0.0;
+    double          m_Mean      = 0.0;
+    double          m_P95       = 0.0;
+    double          m_StdDev    = 0.0;
+    std::uint32_t   m_Samples   = 1;
+};
+
+struct ResultsFile
+{
+    std::string         m_Unit;
+    std::vector<Metric> m_Metrics;
+
+    Metric const*   FindMetric(std::string const& name) const;
+};
+
+// false if the file can't be read or has no "benchmarks" array
+bool ReadResultsFile(char const* path, ResultsFile& result);
+
+struct CompareSettings
+{
+    double          m_MinDeltaPercent   = 2.0;
+    double          m_ZScore            = 3.0;
+    double          m_FailPercent       = 5.0;
+    char const*     m_Filter            = nullptr;
+    bool            m_Verbose           = false;
+};
+
+enum class ChangeType
+{
+    Unchanged,
+    Improvement,
+    Regression
+};
+
+struct Comparison
+{
+    std::string     m_Name;
+    double          m_BaselineMedian;
+    double          m_CandidateMedian;
+    double          m_DeltaPercent;
+    double          m_ZScore;
+    ChangeType      m_Change;
+};
+
+struct CompareReport
+{
+    std::vector<Comparison>     m_Comparisons;      // regressions first, biggest delta first
+    std::vector<std::string>    m_OnlyInBaseline;
+    std::vector<std::string>    m_OnlyInCandidate;
+    std::uint32_t               m_FailedCount = 0;  // regressions past FailPercent
+};
+
+CompareReport   Compare(ResultsFile const& baseline, ResultsFile const& candidate, CompareSettings const& settings);
+void            PrintReport(CompareReport const& report, CompareSettings const& settings, std::string const& unit);
+
+}
@@ -0,0 +1,70 @@
+#include "PerfCompare.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+/*
+*
+* perf_compare <baseline.json> <candidate.json> [--threshold <percent>] [--min-delta <percent>] [--z <score>] [--filter <substring>] [--verbose]
+* Exit code is 0 if nothing regressed past the threshold, 1 if something did, 2 if inputs couldn't be read.
+*
+*/
+int main(int argc, char** argv)
+{
+    char const* const usage = "usage: perf_compare <baseline.json> <candidate.json> [--threshold <percent>] [--min-delta <percent>] [--z <score>] [--filter <substring>] [--verbose]\n";
+
+    BENCH::CompareSettings settings;
+    char const* paths[2] = { nullptr, nullptr };
+    int pathsCount = 0;
+
+    for (int i = 1; i < argc; i++)
+    {
+        bool const hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--threshold") == 0 && hasValue)
+            settings.m_FailPercent = std::atof(argv[++i]);
+        else if (std::strcmp(argv[i], "--min-delta") == 0 && hasValue)
+            settings.m_MinDeltaPercent = std::atof(argv[++i]);
+        else if (std::strcmp(argv[i], "--z") == 0 && hasValue)
+            settings.m_ZScore = std::atof(argv[++i]);
+        else if (std::strcmp(argv[i], "--filter") == 0 && hasValue)
+            settings.m_Filter = argv[++i];
+        else if (std::strcmp(argv[i], "--verbose") == 0)
+            settings.m_Verbose = true;
+        else if (argv[i][0] != '-' && pathsCount < 2)
+            paths[pathsCount++] = argv[i];
+        else
+        {
+            std::printf("%s", usage);
+            return 2;
+        }
+    }
+
+    if (pathsCount != 2)
+    {
+        std::printf("%s", usage);
+        return 2;
+    }
+
+    BENCH::ResultsFile baseline;
+    BENCH::ResultsFile candidate;
+    for (int i = 0; i < 2; i++)
+    {
+        if (!BENCH::ReadResultsFile(paths[i], i == 0 ? baseline : candidate))
+        {
+            std::printf("Failed to read %s\n", paths[i]);
+            return 2;
+        }
+    }
+
+    if (baseline.m_Unit != candidate.m_Unit)
+    {
+        std::printf("Units differ: %s is in %s, %s is in %s\n", paths[0], baseline.m_Unit.c_str(), paths[1], candidate.m_Unit.c_str());
+        return 2;
+    }
+
+    BENCH::CompareReport const report = BENCH::Compare(baseline, candidate, settings);
+    BENCH::PrintReport(report, settings, baseline.m_Unit);
+
+    return report.m_FailedCount > 0 ? 1 : 0;
+}
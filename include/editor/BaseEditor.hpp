@@ -29,6 +29,8 @@ public:
         SceneGraph,
         Stats,
         TextureInspector,
+        Profiler,
+        SyntheticScene,
         MAX
     };
 
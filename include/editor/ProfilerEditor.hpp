@@ -0,0 +1,46 @@
+#pragma once
+
+#include <foundation\Common.hpp>
+#include <foundation\container\Vector.hpp>
+#include <foundation\memory\Memory.hpp>
+#include <foundation\system\Profiler.hpp>
+
+#include <editor\BaseEditor.hpp>
+
+namespace EDITOR
+{
+
+class ProfilerEditor : public BaseEditor
+{
+public:
+    ProfilerEditor(BaseEditor* rootEditor, EditorFlags flags);
+    ProfilerEditor(ProfilerEditor&& rhs);
+
+    ProfilerEditor& operator=(ProfilerEditor&& rhs);
+
+    virtual ~ProfilerEditor() {}
+
+    virtual BaseEditor::Type GetType() const override { return BaseEditor::Type::Profiler; }
+
+    virtual void Render() override;
+
+private:
+    struct CapturedEvent
+    {
+        DRE::Profiler::Event    m_Event;
+        DRE::U32                m_ThreadIndex;
+    };
+
+    void CaptureLastFrame();
+    void RenderFlameView();
+
+private:
+    DRE::Vector<CapturedEvent, DRE::DefaultAllocator> m_Events;
+    DRE::U64    m_FrameStartTicks;
+    DRE::U64    m_FrameEndTicks;
+
+    bool        m_Paused;
+    double      m_ZoneOverheadNS;
+};
+
+}
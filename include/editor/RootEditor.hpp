@@ -13,6 +13,7 @@ class Context;
 namespace WORLD
 {
 class Scene;
+class SyntheticSceneGenerator;
 }
 
 namespace EDITOR
@@ -23,7 +24,7 @@ class CameraEditor;
 class RootEditor : public BaseEditor
 {
 public:
-    RootEditor(WORLD::Scene* mainScene);
+    RootEditor(WORLD::Scene* mainScene, WORLD::SyntheticSceneGenerator* syntheticSceneGenerator);
     RootEditor(RootEditor&& rhs);
 
     RootEditor& operator=(RootEditor&& rhs);
@@ -41,6 +42,7 @@ public:
 
 private:
     WORLD::Scene* m_MainScene;
+    WORLD::SyntheticSceneGenerator* m_SyntheticSceneGenerator;
 
     DRE::Vector<BaseEditor*, DRE::DefaultAllocator> m_Editors;
     DRE::Vector<BaseEditor*, DRE::DefaultAllocator> m_CloseQueue;
@@ -24,6 +24,13 @@ public:
     virtual BaseEditor::Type GetType() const override { return BaseEditor::Type::Stats; }
 
     virtual void Render() override;
+
+private:
+    void RenderFrameStats();
+    void RenderPassCounters();
+
+private:
+    int m_WindowSize;
 };
 
 }
\ No newline at end of file
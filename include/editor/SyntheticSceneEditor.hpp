@@ -0,0 +1,36 @@
+#pragma once
+
+#include <editor\BaseEditor.hpp>
+
+#include <engine\scene\SyntheticScene.hpp>
+
+namespace WORLD
+{
+class Scene;
+}
+
+
+namespace EDITOR
+{
+
+class SyntheticSceneEditor : public BaseEditor
+{
+public:
+    SyntheticSceneEditor(BaseEditor* rootEditor, EditorFlags flags, WORLD::Scene* scene, WORLD::SyntheticSceneGenerator* generator);
+    SyntheticSceneEditor(SyntheticSceneEditor&& rhs);
+
+    SyntheticSceneEditor& operator=(SyntheticSceneEditor&& rhs);
+
+    virtual ~SyntheticSceneEditor() {}
+
+    virtual BaseEditor::Type GetType() const override { return BaseEditor::Type::SyntheticScene; }
+
+    virtual void Render() override;
+
+private:
+    WORLD::Scene*                   m_Scene;
+    WORLD::SyntheticSceneGenerator* m_Generator;
+    WORLD::SyntheticSceneDesc       m_Desc;
+};
+
+}
@@ -27,6 +27,10 @@ struct ApplicationContext
 
     bool        m_PauseTime = false;
 
+    // Startup
+    DRE::U64    m_ProcessStartUS = 0;       // Stopwatch::GlobalTimeMicroseconds() at the top of main
+    DRE::U64    m_TimeToFirstFrameUS = 0;
+
     // Focused Object
     WORLD::ISceneNodeUser*  m_FocusedObject = nullptr;
     DRE::U32                m_MouseHoveredObjectID = 0;
@@ -23,6 +23,7 @@ public:
 
     bool IsInitialized() const;
     void ReadFromFile(char const* filePath, TextureChannelVariations channelVariations);
+    void InitFromMemory(char const* name, std::uint32_t width, std::uint32_t height, VKW::Format format, DRE::ByteBuffer&& data);
 
     VKW::Format GetFormat() const;
     DRE::ByteBuffer const& GetBuffer() const;
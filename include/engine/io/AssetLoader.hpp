@@ -0,0 +1,98 @@
+#pragma once
+
+#include <foundation\class_features\NonCopyable.hpp>
+#include <foundation\class_features\NonMovable.hpp>
+
+#include <foundation\container\InplaceVector.hpp>
+#include <foundation\system\ThreadPool.hpp>
+
+#include <engine\data\Texture2D.hpp>
+
+#include <glm\mat4x4.hpp>
+#include <glm\gtc\matrix_transform.hpp>
+
+#include <functional>
+#include <mutex>
+
+namespace WORLD
+{
+class Scene;
+class SceneNode;
+}
+
+namespace IO
+{
+
+class IOManager;
+
+using AssetRequestID = std::uint32_t;
+constexpr AssetRequestID INVALID_ASSET_REQUEST = DRE_U32_MAX;
+
+/*
+*
+* Asynchronous asset loading.
+*
+* Workers do file reading, assimp import, mesh conversion and texture decoding.
+* Everything touching engine state (libraries, scene, GPU) happens in PumpCompletions on the main thread,
+* right before the completion callback is called.
+*
+*/
+class AssetLoader
+    : public NonCopyable
+    , public NonMovable
+{
+public:
+    static constexpr std::uint32_t MAX_REQUESTS = 256;
+
+    using TextureCallback   = std::function<void(Data::Texture2D&&)>;
+    using ModelCallback     = std::function<void(WORLD::SceneNode*)>;
+
+    AssetLoader(IOManager* ioManager, std::uint32_t workerCount = DRE::ThreadPool::DefaultWorkerCount());
+    ~AssetLoader();
+
+    AssetRequestID  RequestTexture2D(char const* path, Data::TextureChannelVariations channels, DRE::TaskPriority priority, TextureCallback&& callback);
+    AssetRequestID  RequestModel(char const* path, WORLD::Scene& targetScene, char const* defaultShader, DRE::TaskPriority priority, ModelCallback&& callback,
+                        glm::mat4 baseTransform = glm::identity<glm::mat4>(), Data::TextureChannelVariations metalnessRoughnessOverride = Data::TEXTURE_VARIATION_INVALID);
+
+    // callback of the cancelled request is never called. Work already started on workers is finished and discarded
+    void            Cancel(AssetRequestID id);
+
+    // main thread only. Finalizes completed requests until budget is exceeded,
+    // model instantiation is resumed across calls so a single large model doesn't stall a frame
+    void            PumpCompletions(std::uint64_t budgetUS = DRE_U64_MAX);
+    void            WaitAll();
+
+    inline std::uint32_t GetPendingCount() const { return m_InFlightRequests.Size(); }
+    inline std::uint64_t GetMaxPumpTimeUS() const { return m_MaxPumpTimeUS; }
+    // pumps that overshot their budget, a single entity creation is the smallest slice
+    inline std::uint32_t GetOverBudgetPumpsCount() const { return m_OverBudgetPumpsCount; }
+
+private:
+    struct Request;
+
+    Request*        CreateRequest(char const* path, DRE::TaskPriority priority);
+    void            ReleaseRequest(Request* request);
+    // returns false if the request continues as an active model instantiation
+    bool            FinalizeRequest(Request* request);
+
+    void            ExecuteTextureDecode(Request* request, std::uint32_t textureIndex);
+    void            ExecuteModelImport(Request* request);
+    void            FinishJob(Request* request);
+
+private:
+    IOManager*                                      m_IOManager;
+    DRE::ThreadPool                                 m_ThreadPool;
+
+    AssetRequestID                                  m_NextRequestID;
+    DRE::InplaceVector<Request*, MAX_REQUESTS>      m_InFlightRequests;
+
+    std::mutex                                      m_CompletedMutex;
+    DRE::InplaceVector<Request*, MAX_REQUESTS>      m_CompletedRequests;
+
+    Request*                                        m_ActiveInstantiation;
+
+    std::uint64_t                                   m_MaxPumpTimeUS;
+    std::uint32_t                                   m_OverBudgetPumpsCount;
+};
+
+}
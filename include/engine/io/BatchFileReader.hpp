@@ -0,0 +1,49 @@
+#pragma once
+
+#include <foundation\class_features\NonCopyable.hpp>
+#include <foundation\class_features\NonMovable.hpp>
+
+#include <foundation\memory\ByteBuffer.hpp>
+#include <foundation\system\ThreadPool.hpp>
+
+namespace IO
+{
+
+/*
+*
+* Submits many file reads at once and reaps completions.
+* Native backends are Win32 overlapped IO on a completion port and io_uring on Linux, other platforms go through the thread pool.
+*
+*/
+class BatchFileReader
+    : public NonCopyable
+    , public NonMovable
+{
+public:
+    static constexpr std::uint32_t MAX_READS_IN_FLIGHT = 64;
+
+    struct ReadRequest
+    {
+        char const*         m_Path          = nullptr;
+        DRE::ByteBuffer*    m_Buffer        = nullptr;
+        bool                m_NullTerminate = false;
+
+        std::uint64_t       m_BytesRead     = 0; // 0 on failure
+    };
+
+    BatchFileReader(DRE::ThreadPool* fallbackPool);
+
+    // blocks until all requests are complete
+    void                    ReadBatch(ReadRequest* requests, std::uint32_t count);
+
+    static std::uint64_t    ReadSingle(char const* path, DRE::ByteBuffer* buffer, bool nullTerminate);
+
+private:
+    void                    ReadBatchNative(ReadRequest* requests, std::uint32_t count);
+    void                    ReadBatchFallback(ReadRequest* requests, std::uint32_t count);
+
+private:
+    DRE::ThreadPool*        m_FallbackPool;
+};
+
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <coroutine>
+#include <atomic>
+#include <memory>
+#include <exception>
+
+#include <foundation\memory\ByteBuffer.hpp>
+#include <foundation\string\InplaceString.hpp>
+
+namespace IO
+{
+
+class IOManager;
+
+/*
+*
+* Return type for IO coroutines. Starts eagerly and detaches, completion is observed through IsDone().
+*
+*   IO::AsyncTask LoadSomething(IO::IOManager& io, DRE::String256 path) // <- arguments by value, they're stored in the frame
+*   {
+*       DRE::ByteBuffer data = co_await io.ReadFile(path.GetData());    // resumes on IO worker
+*       ...decode...
+*       co_await io.SwitchToMainThread();                               // resumes in IOManager::ResumeMainThreadTasks
+*       ...upload...
+*   }
+*
+*/
+class AsyncTask
+{
+public:
+    struct promise_type
+    {
+        std::shared_ptr<std::atomic_bool> m_Done = std::make_shared<std::atomic_bool>(false);
+
+        AsyncTask           get_return_object() { return AsyncTask{ m_Done }; }
+        std::suspend_never  initial_suspend() noexcept { return {}; }
+        std::suspend_never  final_suspend() noexcept { return {}; }
+        void                return_void() { m_Done->store(true, std::memory_order_release); }
+        void                unhandled_exception() { std::terminate(); }
+    };
+
+    AsyncTask() = default;
+    explicit AsyncTask(std::shared_ptr<std::atomic_bool> const& done) : m_Done{ done } {}
+
+    inline bool IsDone() const { return m_Done == nullptr || m_Done->load(std::memory_order_acquire); }
+
+private:
+    std::shared_ptr<std::atomic_bool> m_Done;
+};
+
+/////////////////////////////////////
+class ReadFileAwaitable
+{
+public:
+    ReadFileAwaitable(IOManager* ioManager, char const* path);
+
+    bool            await_ready() const noexcept { return false; }
+    void            await_suspend(std::coroutine_handle<> handle);
+    DRE::ByteBuffer await_resume() { return DRE_MOVE(m_Buffer); }
+
+private:
+    IOManager*      m_IOManager;
+    DRE::String256  m_Path;
+    DRE::ByteBuffer m_Buffer;
+};
+
+/////////////////////////////////////
+class MainThreadAwaitable
+{
+public:
+    MainThreadAwaitable(IOManager* ioManager);
+
+    bool            await_ready() const noexcept;
+    void            await_suspend(std::coroutine_handle<> handle);
+    void            await_resume() {}
+
+private:
+    IOManager*      m_IOManager;
+};
+
+}
@@ -4,13 +4,18 @@
 #include <foundation\class_features\NonMovable.hpp>
 
 #include <foundation\memory\Memory.hpp>
+#include <foundation\memory\AllocatorSystem.hpp>
 #include <foundation\container\HashTable.hpp>
+#include <foundation\system\ThreadPool.hpp>
+#include <foundation\system\Time.hpp>
 
 #include <vk_wrapper\pipeline\ShaderModule.hpp>
 
 #include <engine\data\Texture2D.hpp>
 #include <engine\data\Material.hpp>
 #include <engine\data\Geometry.hpp>
+#include <engine\io\Coroutine.hpp>
+#include <engine\io\BatchFileReader.hpp>
 
 #include <glm\mat4x4.hpp>
 #include <glm\gtc\matrix_transform.hpp>
@@ -20,6 +25,9 @@
 #include <thread>
 #include <atomic>
 #include <mutex>
+#include <condition_variable>
+#include <coroutine>
+#include <vector>
 
 #define DEBUG_SHADER_COMPILATION
 
@@ -88,6 +96,45 @@ public:
         ShaderInterface m_Interface;
     };
 
+    // Thread-safe part of the model loading, filled by AssetLoader workers
+    struct PreparedModel
+    {
+        std::vector<Data::Geometry>     m_Geometries;   // [aiScene mesh id]
+        std::vector<Data::Texture2D>    m_Textures;     // [aiScene material id * Slot::MAX + slot]
+    };
+
+    // Resumable model instantiation state, see InstantiateModelStep
+    struct ModelInstantiation
+    {
+        enum Stage : std::uint8_t
+        {
+            STAGE_MESHES,
+            STAGE_MATERIALS,
+            STAGE_NODES,
+            STAGE_DONE
+        };
+
+        struct PendingNode
+        {
+            aiNode const*       m_Node;
+            WORLD::SceneNode*   m_Parent;
+        };
+
+        DRE::String256                  m_Path;
+        aiScene const*                  m_Scene = nullptr;
+        WORLD::Scene*                   m_TargetScene = nullptr;
+        DRE::String32                   m_DefaultShader;
+        Data::TextureChannelVariations  m_MetalnessRoughnessOverride = Data::TEXTURE_VARIATION_INVALID;
+        PreparedModel*                  m_Prepared = nullptr;
+
+        Stage                           m_Stage = STAGE_MESHES;
+        std::uint32_t                   m_NextItem = 0;         // mesh id, material id or mesh of m_CurrentNode
+        std::vector<PendingNode>        m_PendingNodes;         // DFS stack
+        aiNode const*                   m_CurrentNode = nullptr;
+        WORLD::SceneNode*               m_CurrentAggregator = nullptr;
+        WORLD::SceneNode*               m_RootNode = nullptr;
+    };
+
 public:
     IOManager(DRE::DefaultAllocator* allocator, Data::MaterialLibrary* materialLibrary, Data::GeometryLibrary* geometryLibrary);
     ~IOManager();
@@ -99,28 +146,52 @@ public:
     Data::Texture2D ReadTexture2D(char const* path, Data::TextureChannelVariations channels);
 
     WORLD::SceneNode* ParseModelFile(char const* path, WORLD::Scene& targetScene, char const* defaultShader, glm::mat4 baseTransform = glm::identity<glm::mat4>(), Data::TextureChannelVariations metalnessRoughnessOverride = Data::TEXTURE_VARIATION_INVALID);
+    WORLD::SceneNode* InstantiateModel(char const* path, aiScene const* scene, WORLD::Scene& targetScene, char const* defaultShader, glm::mat4 baseTransform, Data::TextureChannelVariations metalnessRoughnessOverride, PreparedModel* prepared);
+
+    // instantiation in slices: meshes, materials, then one entity at a time. Model root node is created right away, entities appear progressively
+    void BeginModelInstantiation(ModelInstantiation& state, char const* path, aiScene const* scene, WORLD::Scene& targetScene, char const* defaultShader, glm::mat4 baseTransform, Data::TextureChannelVariations metalnessRoughnessOverride, PreparedModel* prepared);
+    // does at least one item of work, then continues until budget is exceeded. Returns true when instantiation is complete
+    bool InstantiateModelStep(ModelInstantiation& state, DRE::Stopwatch const& stopwatch, std::uint64_t budgetUS);
+
+    static Data::Geometry                   ConvertAssimpMesh(aiMesh const* mesh);
+    static DRE::String256                   GetAssetFolderPath(char const* path);
+    static bool                             FindMaterialTexturePath(aiScene const* scene, aiMaterial const* aiMat, DRE::String256 const& assetFolderPath, Data::Material::TextureProperty::Slot slot, DRE::String256& result);
+    static Data::TextureChannelVariations   GetMaterialSlotChannels(Data::Material::TextureProperty::Slot slot, Data::TextureChannelVariations metalnessRoughnessOverride);
 
 
     static std::uint64_t    ReadFileToBuffer(char const* path, DRE::ByteBuffer* buffer);
+
+    // coroutine IO, see IO::AsyncTask
+    ReadFileAwaitable       ReadFile(char const* path) { return ReadFileAwaitable{ this, path }; }
+    MainThreadAwaitable     SwitchToMainThread() { return MainThreadAwaitable{ this }; }
+
+    void                    ScheduleOnMainThread(std::coroutine_handle<> handle);
+    void                    ResumeMainThreadTasks();
+    void                    WaitForTasks(AsyncTask const* tasks, std::uint32_t count);
+
+    inline bool             IsMainThread() const { return std::this_thread::get_id() == m_MainThreadID; }
+    inline DRE::ThreadPool& GetIOThreadPool() { return m_IOThreadPool; }
     static std::uint64_t    ReadFileStringToBuffer(char const* path, DRE::ByteBuffer* buffer);
     static void             WriteNewFile(char const* path, DRE::ByteBuffer const& buffer);
 
     DRE::ByteBuffer         CompileGLSL(char const* file);
-    std::mutex&             GetShaderIncluderMutex() { return m_ShaderIncluderMutex; }
+    DRE::ByteBuffer const*  FindCachedShaderSource(char const* path);
 
     inline bool                             NewShadersPending() { return IOManager::m_PendingChangesFlag.load(std::memory_order::acquire); }
     DRE::InplaceVector<DRE::String64, 12>   GetPendingShaders();
 
 private:
-    void ParseAssimpMeshes(VKW::Context& gfxContext, aiScene const* scene, char const* sceneName);
-    void ParseAssimpMaterials(aiScene const* scene, char const* sceneName, char const* path, char const* defaultShader, Data::TextureChannelVariations metalnessRoughnessOverride);
-    void ParseAssimpNodeRecursive(VKW::Context& gfxContext, char const* assetPath, aiScene const* scene, char const* sceneName, aiNode const* node, WORLD::Scene& targetScene, WORLD::SceneNode* parentNode);
+    void ParseAssimpMesh(aiScene const* scene, char const* sceneName, std::uint32_t meshID, PreparedModel* prepared);
+    void ParseAssimpMaterial(aiScene const* scene, char const* sceneName, DRE::String256 const& assetFolderPath, std::uint32_t materialID, char const* defaultShader, Data::TextureChannelVariations metalnessRoughnessOverride, PreparedModel* prepared);
 
     void BuildAssimpNodeAccelerationStructure(VKW::Context& gfxContext, char const* assetPath, aiScene const* scene, char const* sceneName, aiNode const* node, WORLD::Scene& targetScene, WORLD::SceneNode* parentNode, Data::Material* mat, Data::Geometry* geometry);
 
-    void ParseMaterialTexture(aiScene const* scene, aiMaterial const* aiMat, DRE::String256 const& assetFolderPath, Data::Material* material, Data::Material::TextureProperty::Slot slot, Data::TextureChannelVariations channels);
+    void ParseMaterialTexture(aiScene const* scene, aiMaterial const* aiMat, DRE::String256 const& assetFolderPath, Data::Material* material, Data::Material::TextureProperty::Slot slot, Data::TextureChannelVariations channels, Data::Texture2D* preloaded);
 
     void ShaderObserver();
+    void PrefetchShaderSources();
+
+    AsyncTask LoadShaderBinaryAsync(DRE::String256 path, DRE::String64 name);
 
 private:
     DRE::DefaultAllocator* m_Allocator;
@@ -130,16 +201,25 @@ private:
 
     DRE::HashTable<DRE::String64, ShaderData, DRE::DefaultAllocator> m_ShaderData;
 
-    std::mutex  m_ShaderIncluderMutex;
+    // filled only for the duration of CompileGLSLSources, read-only for compilation threads
+    // malloc backed, CompileGLSLSources may run off the main thread
+    DRE::AllocatorSystem m_ShaderSourceCacheAllocator;
+    DRE::HashTable<DRE::String64, DRE::ByteBuffer, DRE::AllocatorSystem> m_ShaderSourceCache;
 
     DRE::InplaceVector<DRE::String64, 12> m_PendingShaders;
     std::mutex  m_PendingShadersMutex;
     std::thread m_ShaderObserverThread;
     std::atomic_bool m_PendingChangesFlag;
 
-#ifdef DEBUG_SHADER_COMPILATION
-    std::mutex  m_DebugShaderCompilationMutex;
-#endif
+    std::thread::id                         m_MainThreadID;
+
+    std::mutex                              m_MainThreadTasksMutex;
+    std::condition_variable                 m_MainThreadTasksCondition;
+    std::vector<std::coroutine_handle<>>    m_MainThreadTasks;
+
+    // last, workers must be joined before anything they reference is destroyed
+    DRE::ThreadPool                         m_IOThreadPool;
+    BatchFileReader                         m_BatchReader;
 
 };
 
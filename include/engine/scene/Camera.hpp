@@ -17,7 +17,7 @@ public:
     void                    SetFOV(float fov);
 
     void                    SetCameraEuler(glm::vec3 euler);
-    glm::vec3 const&        GetCameraEuler(glm::vec3 euler) const;
+    glm::vec3 const&        GetCameraEuler() const;
 
     void                    RotateCamera(glm::vec3 euler);
 
@@ -40,6 +40,11 @@ public:
     using NodeID = std::uint32_t;
     using LightID = std::uint32_t;
 
+    // inplace tables hold about 1.5x their buckets (collision pool is half the buckets)
+    // every renderable owns an entity and a node, the extra room is for batch nodes, lights and the camera
+    static constexpr std::uint32_t ENTITY_BUCKETS_COUNT = 16384;
+    static constexpr std::uint32_t NODE_BUCKETS_COUNT = 16384;
+
     Scene(DRE::DefaultAllocator* allocator);
     ~Scene();
 
@@ -70,14 +75,14 @@ private:
     Camera                  m_MainCamera;
     Light*                  m_MainLight;
 
-    EntityID                                    m_EntityCounter;
-    DRE::InplaceHashTable<EntityID, Entity>     m_SceneEntities;
+    EntityID                                                        m_EntityCounter;
+    DRE::InplaceHashTable<EntityID, Entity, ENTITY_BUCKETS_COUNT>   m_SceneEntities;
 
-    LightID                                     m_LightsCounter;
-    DRE::InplaceHashTable<LightID, Light>       m_SceneLights;
+    LightID                                                         m_LightsCounter;
+    DRE::InplaceHashTable<LightID, Light>                           m_SceneLights;
 
-    NodeID                                      m_NodeCounter;
-    DRE::InplaceHashTable<NodeID, SceneNode>    m_Nodes;
+    NodeID                                                          m_NodeCounter;
+    DRE::InplaceHashTable<NodeID, SceneNode, NODE_BUCKETS_COUNT>    m_Nodes;
 
     SceneNode* m_RootNode;
 };
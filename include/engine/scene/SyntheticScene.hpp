@@ -0,0 +1,61 @@
+#pragma once
+
+#include <foundation\Common.hpp>
+#include <foundation\class_features\NonCopyable.hpp>
+
+namespace Data
+{
+class MaterialLibrary;
+class GeometryLibrary;
+}
+
+namespace VKW
+{
+class Context;
+}
+
+namespace WORLD
+{
+
+class Scene;
+class SceneNode;
+
+struct SyntheticSceneDesc
+{
+    DRE::U32    m_ObjectsCount      = 1024;
+    DRE::U32    m_MeshesCount       = 8;
+    DRE::U32    m_MaterialsCount    = 16;
+    DRE::U32    m_LightsCount       = 0;
+
+    // 1 is a flat list under the scene root, objects form trees of this depth otherwise
+    DRE::U32    m_HierarchyDepth    = 1;
+    DRE::U32    m_FanOut            = 4;
+
+    float       m_Spacing           = 1.5f;
+    DRE::U32    m_Seed              = 1;
+};
+
+/*
+*
+* Procedural content for scaling tests: every count of the desc can be dialed independently.
+* Meshes are UV spheres of increasing tessellation, materials get their own small albedo texture so each one takes a bindless slot.
+* Objects are laid out on a grid in world space whatever the hierarchy is, so the camera sees the same picture for any depth/fan-out.
+*
+*/
+class SyntheticSceneGenerator
+    : public NonCopyable
+{
+public:
+    SyntheticSceneGenerator(Data::MaterialLibrary* materialLibrary, Data::GeometryLibrary* geometryLibrary);
+
+    // every call adds a new batch under its own node, meshes and materials aren't shared between batches
+    SceneNode*  Generate(SyntheticSceneDesc const& desc, Scene& targetScene, VKW::Context& context);
+
+private:
+    Data::MaterialLibrary*  m_MaterialLibrary;
+    Data::GeometryLibrary*  m_GeometryLibrary;
+
+    DRE::U32                m_BatchesCount;
+};
+
+}
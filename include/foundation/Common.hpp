@@ -60,7 +60,6 @@ using UPtr      = std::uintptr_t;
 
     #define DRE_DEBUG_ARG(arg) , arg
 
-    #define DRE_LOG(...) { char str[512]; sprintf_s(str, 512, __VA_ARGS__); OutputDebugStringA(str); }
     #define DRE_ASSERT(condition, message) assert((condition) && (message))
     #define DRE_WARNING(condition, message)
     #define DRE_ERROR(condition, message)
@@ -71,7 +70,6 @@ using UPtr      = std::uintptr_t;
 
     #define DRE_DEBUG_ARG(arg)
 
-    #define DRE_LOG(...)
     #define DRE_ASSERT(condition, message) (condition)
     #define DRE_WARNING(condition, message) (condition)
     #define DRE_ERROR(condition, message) (condition)
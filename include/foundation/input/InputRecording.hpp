@@ -0,0 +1,59 @@
+#pragma once
+
+#include <foundation\Common.hpp>
+#include <foundation\class_features\NonCopyable.hpp>
+
+#include <foundation\container\Vector.hpp>
+#include <foundation\memory\Memory.hpp>
+#include <foundation\input\InputSystem.hpp>
+
+namespace SYS
+{
+
+struct InputFrame
+{
+    DRE::U64                    m_DeltaTimeUS;
+    InputSystem::MouseState     m_MouseState;
+    InputSystem::KeyboardState  m_KeyboardState;
+
+    // camera state after the frame's input was applied, so replays don't depend on how it was moved
+    float                       m_CameraPosition[3];
+    float                       m_CameraEuler[3];
+};
+
+/*
+*
+* Per-frame input and camera capture for deterministic replays.
+* Recording: AddFrame once per frame after the camera is final and fill it in, Write at the end.
+* Replay: Read, then ApplyNextFrame before InputSystem::Update every frame. Live raw input is ignored until the end of the recording.
+* Files are raw frames after a small header and are only valid for the build layout that wrote them (frame size is checked on read).
+*
+*/
+class InputRecording
+    : public NonCopyable
+{
+public:
+    InputRecording();
+
+    inline DRE::U32             GetFramesCount() const { return m_Frames.Size(); }
+    inline InputFrame const&    GetFrame(DRE::U32 index) const { return m_Frames[index]; }
+
+    void                        Clear();
+    InputFrame&                 AddFrame();
+
+    bool                        Write(char const* path) const;
+    bool                        Read(char const* path);
+
+    // replay
+    inline bool                 IsReplaying() const { return m_ReplayCursor < m_Frames.Size(); }
+    void                        StartReplay(InputSystem& inputSystem);
+
+    // nullptr once the recording is over, input system goes back to live input then
+    InputFrame const*           ApplyNextFrame(InputSystem& inputSystem);
+
+private:
+    DRE::Vector<InputFrame, DRE::DefaultAllocator>  m_Frames;
+    DRE::U32                                        m_ReplayCursor;
+};
+
+}
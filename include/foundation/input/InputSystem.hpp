@@ -41,6 +41,8 @@ private:
     KeyboardState prevKeyboardState_;
     KeyboardState keyboardState_;
 
+    // raw input is ignored while states are injected, so live devices can't leak into a replay
+    bool externalSource_;
 
 public:
     InputSystem();
@@ -55,6 +57,11 @@ public:
     void ProcessSystemInput(HWND handle, WPARAM wparam, LPARAM lparam);
 
     MouseState const& GetMouseState() const;
+    KeyboardState const& GetKeyboardState() const;
+
+    // states take effect on the next Update(), same as the ones coming from ProcessSystemInput
+    void SetExternalSource(bool external);
+    void InjectState(MouseState const& mouseState, KeyboardState const& keyboardState);
 
     bool GetLeftMouseButtonPressed() const;
     bool GetRightMouseButtonPressed() const;
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <foundation\Common.hpp>
+#include <foundation\class_features\NonCopyable.hpp>
+#include <foundation\class_features\NonMovable.hpp>
+
+DRE_BEGIN_NAMESPACE
+
+/*
+*
+* Rolling frame-time recorder.
+* Keeps the last MAX_SAMPLES frames of CPU, GPU and present wait time, percentiles are computed over a window of the latest frames.
+* Frames above the hitch threshold are remembered together with the main thread CPU zones that took the most time (needs DRE_PROFILER_ENABLED).
+*
+*/
+class FrameStats
+    : public NonCopyable
+    , public NonMovable
+{
+public:
+    static constexpr U32 MAX_SAMPLES    = 4096;
+    static constexpr U32 MAX_HITCHES    = 32;
+    static constexpr U32 HITCH_ZONES    = 3;
+
+    struct Sample
+    {
+        U64     m_Frame;
+        float   m_CPUMS;
+        float   m_GPUMS;
+        float   m_PresentWaitMS;
+        bool    m_Hitch;
+    };
+
+    struct Percentiles
+    {
+        float   m_P50;
+        float   m_P95;
+        float   m_P99;
+        float   m_Max;
+    };
+
+    struct Summary
+    {
+        Percentiles m_Frame;
+        Percentiles m_CPU;
+        Percentiles m_GPU;
+        Percentiles m_PresentWait;
+        U32         m_SamplesCount;
+    };
+
+    struct HitchZone
+    {
+        char const* m_Name;
+        float       m_SelfMS;
+    };
+
+    struct Hitch
+    {
+        U64         m_Frame;
+        float       m_FrameMS;
+        HitchZone   m_Zones[HITCH_ZONES];
+        U32         m_ZonesCount;
+    };
+
+    FrameStats();
+
+    // main thread, right after DRE_CPU_FRAME_MARK for the frame that just finished
+    void            AddFrame(U64 frame, float cpuMS, float gpuMS, float presentWaitMS);
+
+    // frame time is CPU + present wait, windowSize is clamped to the recorded frames count
+    Summary         ComputeSummary(U32 windowSize) const;
+
+    inline U32      GetSamplesCount() const { return m_SamplesCount < MAX_SAMPLES ? static_cast<U32>(m_SamplesCount) : MAX_SAMPLES; }
+
+    // offset 0 is the most recent frame
+    Sample const&   GetSample(U32 offset) const;
+
+    inline void     SetHitchThresholdMS(float threshold) { m_HitchThresholdMS = threshold; }
+    inline float    GetHitchThresholdMS() const { return m_HitchThresholdMS; }
+
+    inline U32      GetHitchesCount() const { return m_HitchesCount < MAX_HITCHES ? static_cast<U32>(m_HitchesCount) : MAX_HITCHES; }
+
+    // offset 0 is the most recent hitch
+    Hitch const&    GetHitch(U32 offset) const;
+
+    // every recorded sample, oldest first
+    bool            WriteCSV(char const* path) const;
+
+private:
+    void            CollectHitchZones(Hitch& hitch) const;
+
+private:
+    Sample  m_Samples[MAX_SAMPLES];
+    U64     m_SamplesCount;
+
+    Hitch   m_Hitches[MAX_HITCHES];
+    U64     m_HitchesCount;
+
+    float   m_HitchThresholdMS;
+};
+
+extern FrameStats g_FrameStats;
+
+DRE_END_NAMESPACE
@@ -0,0 +1,235 @@
+#pragma once
+
+#include <foundation\Common.hpp>
+#include <foundation\system\Profiler.hpp>
+
+#include <atomic>
+#include <cstring>
+#include <type_traits>
+
+DRE_BEGIN_NAMESPACE
+
+enum LogSeverity : U8
+{
+    LOG_SEVERITY_DEBUG,
+    LOG_SEVERITY_INFO,
+    LOG_SEVERITY_WARNING,
+    LOG_SEVERITY_ERROR,
+    LOG_SEVERITY_MAX
+};
+
+/*
+*
+* Asynchronous logger.
+* Calling thread only copies the format pointer and raw arguments into its own ring buffer, no locks and no formatting.
+* A background writer drains all rings, formats printf-style and writes to stdout and the optional file sink.
+* When a ring is full the message is dropped and counted, logging never blocks the caller.
+* Threads past MAX_THREADS get no ring, their messages are only counted.
+*
+* Format must be a string literal, it's read on the writer thread. String arguments are copied (up to MAX_STRING_ARG).
+* Every call site is rate limited to RATE_LIMIT_PER_SECOND messages, the next message that passes reports how many were skipped.
+*
+*   DRE_LOG_WARNING("Failed to read %s, %u bytes", path, size);
+*
+*/
+class Log
+{
+public:
+    static constexpr U32 MAX_THREADS            = 64;
+    static constexpr U32 RING_SIZE              = 1 << 16;
+    static constexpr U32 MAX_ARGS               = 12;
+    static constexpr U32 MAX_STRING_ARG         = 2048;
+    static constexpr U32 RATE_LIMIT_PER_SECOND  = 64;
+
+    enum ArgType : U8
+    {
+        ARG_SIGNED,
+        ARG_UNSIGNED,
+        ARG_FLOAT,
+        ARG_STRING,
+        ARG_POINTER
+    };
+
+    // one static instance per call site
+    struct Site
+    {
+        std::atomic<U64>    m_WindowStartTicks{ 0 };
+        std::atomic<U32>    m_WindowCount{ 0 };
+        std::atomic<U32>    m_Suppressed{ 0 };
+    };
+
+    struct RecordHeader
+    {
+        char const*     m_Format;       // nullptr marks padding up to the end of the ring
+        U64             m_Ticks;
+        U32             m_Size;         // header included, multiple of 8
+        U32             m_Suppressed;
+        LogSeverity     m_Severity;
+        U8              m_ArgsCount;
+        ArgType         m_ArgTypes[MAX_ARGS];
+    };
+
+    struct ThreadRing
+    {
+        alignas(8) U8       m_Data[RING_SIZE];
+        std::atomic<U64>    m_WriteOffset{ 0 };
+        std::atomic<U64>    m_ReadOffset{ 0 };
+        std::atomic<U64>    m_Dropped{ 0 };
+        U32                 m_ThreadID = 0;
+    };
+
+    static inline bool  IsEnabled(LogSeverity severity) { return severity >= s_MinSeverity.load(std::memory_order_relaxed); }
+    static inline void  SetMinSeverity(LogSeverity severity) { s_MinSeverity.store(severity, std::memory_order_relaxed); }
+
+    // file sink is appended to stdout, nullptr closes it. False if the file can't be opened
+    static bool         SetFileSink(char const* path);
+
+    // blocks until everything logged before the call is written to the sinks
+    static void         Flush();
+
+    template<typename... TArgs>
+    static void         Write(Site& site, LogSeverity severity, char const* format, TArgs const&... args)
+    {
+        static_assert(sizeof...(TArgs) <= MAX_ARGS, "Log: too many arguments.");
+
+        U64 const ticks = Profiler::Ticks();
+        U32 suppressed = 0;
+        if (!PassRateLimit(site, ticks, suppressed))
+            return;
+
+        U32 size = sizeof(RecordHeader);
+        ((size += ArgSize(args)), ...);
+
+        ThreadRing* ring = GetThreadRing();
+        if (ring == nullptr)
+        {
+            CountUnregisteredDrop();
+            return;
+        }
+
+        U8* data = BeginRecord(*ring, size);
+        if (data == nullptr)
+            return;
+
+        RecordHeader* header = reinterpret_cast<RecordHeader*>(data);
+        header->m_Format = format;
+        header->m_Ticks = ticks;
+        header->m_Size = AlignRecordSize(size);
+        header->m_Suppressed = suppressed;
+        header->m_Severity = severity;
+        header->m_ArgsCount = 0;
+
+        [[maybe_unused]] U8* argsData = data + sizeof(RecordHeader);
+        ((argsData = WriteArg(*header, argsData, args)), ...);
+
+        ring->m_WriteOffset.store(ring->m_WriteOffset.load(std::memory_order_relaxed) + header->m_Size, std::memory_order_release);
+    }
+
+private:
+    static inline U32   AlignRecordSize(U32 size) { return (size + 7) & ~7u; }
+
+    template<typename T>
+    static inline U32   ArgSize(T const& arg)
+    {
+        if constexpr (std::is_same_v<std::decay_t<T>, char const*> || std::is_same_v<std::decay_t<T>, char*>)
+        {
+            char const* const string = arg;
+            U32 const length = string != nullptr ? static_cast<U32>(strnlen(string, MAX_STRING_ARG - 1)) : 0;
+            return (sizeof(U32) + length + 8) & ~7u;
+        }
+        else
+        {
+            return sizeof(U64);
+        }
+    }
+
+    template<typename T>
+    static inline U8*   WriteArg(RecordHeader& header, U8* data, T const& arg)
+    {
+        using TArg = std::decay_t<T>;
+        ArgType& type = header.m_ArgTypes[header.m_ArgsCount++];
+
+        if constexpr (std::is_same_v<TArg, char const*> || std::is_same_v<TArg, char*>)
+        {
+            char const* const string = arg;
+            U32 const length = string != nullptr ? static_cast<U32>(strnlen(string, MAX_STRING_ARG - 1)) : 0;
+            type = ARG_STRING;
+            std::memcpy(data, &length, sizeof(length));
+            if (length > 0)
+                std::memcpy(data + sizeof(U32), string, length);
+            data[sizeof(U32) + length] = '\0';
+            return data + ((sizeof(U32) + length + 8) & ~7u);
+        }
+        else
+        {
+            U64 bits = 0;
+            if constexpr (std::is_floating_point_v<TArg>)
+            {
+                type = ARG_FLOAT;
+                double const value = static_cast<double>(arg);
+                std::memcpy(&bits, &value, sizeof(value));
+            }
+            else if constexpr (std::is_pointer_v<TArg>)
+            {
+                type = ARG_POINTER;
+                bits = reinterpret_cast<UPtr>(arg);
+            }
+            else if constexpr (std::is_enum_v<TArg>)
+            {
+                type = ARG_SIGNED;
+                bits = static_cast<U64>(static_cast<S64>(arg));
+            }
+            else
+            {
+                static_assert(std::is_integral_v<TArg>, "Log: unsupported argument type, pass numbers, pointers or C strings.");
+                type = std::is_signed_v<TArg> ? ARG_SIGNED : ARG_UNSIGNED;
+                bits = std::is_signed_v<TArg> ? static_cast<U64>(static_cast<S64>(arg)) : static_cast<U64>(arg);
+            }
+
+            std::memcpy(data, &bits, sizeof(bits));
+            return data + sizeof(U64);
+        }
+    }
+
+    static bool         PassRateLimit(Site& site, U64 ticks, U32& suppressed);
+
+    static void         CountUnregisteredDrop();
+
+    // nullptr if the ring has no room, the message is counted as dropped then
+    static U8*          BeginRecord(ThreadRing& ring, U32 size);
+
+    // nullptr if the thread didn't fit into MAX_THREADS
+    static inline ThreadRing* GetThreadRing()
+    {
+        if (!s_Registered)
+        {
+            s_ThreadRing = RegisterThread();
+            s_Registered = true;
+        }
+
+        return s_ThreadRing;
+    }
+
+    static ThreadRing*  RegisterThread();
+
+    inline static thread_local ThreadRing* s_ThreadRing = nullptr;
+    inline static thread_local bool        s_Registered = false;
+    inline static std::atomic<LogSeverity> s_MinSeverity{ DRE_DEBUG_OR_RELEASE(LOG_SEVERITY_DEBUG, LOG_SEVERITY_INFO) };
+};
+
+DRE_END_NAMESPACE
+
+#define DRE_LOG(severity, ...)                                          \
+    do                                                                  \
+    {                                                                   \
+        if (DRE::Log::IsEnabled(severity))                              \
+        {                                                               \
+            static DRE::Log::Site _DRE_LOG_SITE;                        \
+            DRE::Log::Write(_DRE_LOG_SITE, severity, __VA_ARGS__);      \
+        }                                                               \
+    } while (false)
+
+#define DRE_LOG_DEBUG(...)      DRE_LOG(DRE::LOG_SEVERITY_DEBUG, __VA_ARGS__)
+#define DRE_LOG_INFO(...)       DRE_LOG(DRE::LOG_SEVERITY_INFO, __VA_ARGS__)
+#define DRE_LOG_WARNING(...)    DRE_LOG(DRE::LOG_SEVERITY_WARNING, __VA_ARGS__)
+#define DRE_LOG_ERROR(...)      DRE_LOG(DRE::LOG_SEVERITY_ERROR, __VA_ARGS__)
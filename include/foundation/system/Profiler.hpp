@@ -0,0 +1,160 @@
+#pragma once
+
+#include <foundation\Common.hpp>
+
+#include <atomic>
+#include <intrin.h>
+
+DRE_BEGIN_NAMESPACE
+
+/*
+*
+* Instrumentation CPU profiler.
+* Zones record TSC ticks into a ring buffer owned by the calling thread, the hot path takes no locks and doesn't allocate.
+* Old events are overwritten, readers copy what they need (editor flame view, Chrome trace export).
+* Threads past MAX_THREADS get no buffer and their zones are skipped.
+*
+* Zones compile out unless DRE_PROFILER_ENABLED is defined (CMake option DRE_PROFILER).
+*
+*   void Foo()
+*   {
+*       DRE_CPU_SCOPE(Foo);
+*       ...
+*   }
+*
+*/
+class Profiler
+{
+public:
+    static constexpr U32 MAX_THREADS        = 64;
+    static constexpr U32 EVENTS_PER_THREAD  = 1 << 14;
+    static constexpr U32 MAX_FRAMES         = 128;
+
+    struct Event
+    {
+        char const* m_Name;
+        U64         m_StartTicks;
+        U64         m_EndTicks;
+        U32         m_Depth;
+    };
+
+    struct ThreadData
+    {
+        Event               m_Events[EVENTS_PER_THREAD];
+        std::atomic<U64>    m_WriteIndex{ 0 };
+        U32                 m_Depth = 0;
+        U32                 m_ThreadID = 0;
+        char                m_Name[32] = {};
+    };
+
+    static inline U64 Ticks() { return __rdtsc(); }
+
+    // nullptr if the thread didn't fit into MAX_THREADS
+    static inline ThreadData* GetThreadData()
+    {
+        if (!s_Registered)
+        {
+            s_ThreadData = RegisterThread();
+            s_Registered = true;
+        }
+
+        return s_ThreadData;
+    }
+
+    static void         SetThreadName(char const* name);
+
+    // main thread, once per frame
+    static void         MarkFrame();
+
+    static double       TicksToMicroseconds(U64 ticks);
+
+    static U32          GetThreadsCount();
+    static ThreadData const* GetThread(U32 index);
+
+    // ticks of the frame marks, frameOffset 0 is the most recent mark. Returns false if there's no such frame
+    static bool         GetFrameRange(U32 frameOffset, U64& startTicks, U64& endTicks);
+
+    // calls func for every event of the thread that ended inside [startTicks, endTicks)
+    // events are copied out, the ones the owner thread overwrote during the copy are skipped
+    template<typename TFunc>
+    static void         ForEachEvent(ThreadData const& thread, U64 startTicks, U64 endTicks, TFunc&& func)
+    {
+        U64 const writeIndex = thread.m_WriteIndex.load(std::memory_order_acquire);
+        U64 const firstIndex = writeIndex > EVENTS_PER_THREAD ? writeIndex - EVENTS_PER_THREAD : 0;
+        for (U64 i = firstIndex; i < writeIndex; i++)
+        {
+            Event const event = thread.m_Events[i & (EVENTS_PER_THREAD - 1)];
+
+            // slot i is rewritten once the writer reaches i + EVENTS_PER_THREAD
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (thread.m_WriteIndex.load(std::memory_order_relaxed) >= i + EVENTS_PER_THREAD)
+                continue;
+
+            if (event.m_EndTicks >= startTicks && event.m_EndTicks < endTicks)
+                func(event);
+        }
+    }
+
+    // Chrome/Perfetto "traceEvents" JSON with everything still in the ring buffers
+    static bool         WriteChromeTrace(char const* path);
+
+    // average cost of an empty zone, recorded into a throwaway buffer
+    static double       MeasureZoneOverheadNS();
+
+private:
+    static ThreadData*  RegisterThread();
+
+    inline static thread_local ThreadData* s_ThreadData = nullptr;
+    inline static thread_local bool        s_Registered = false;
+};
+
+class ProfilerScope
+{
+public:
+    inline ProfilerScope(char const* name)
+        : m_Name{ name }
+        , m_Thread{ Profiler::GetThreadData() }
+        , m_Depth{ m_Thread != nullptr ? m_Thread->m_Depth++ : 0 }
+        , m_StartTicks{ Profiler::Ticks() }
+    {
+    }
+
+    inline ~ProfilerScope()
+    {
+        if (m_Thread == nullptr)
+            return;
+
+        U64 const endTicks = Profiler::Ticks();
+        U64 const index = m_Thread->m_WriteIndex.load(std::memory_order_relaxed);
+
+        // keeps the slot writes after the previous index store, readers validate against it
+        std::atomic_thread_fence(std::memory_order_release);
+
+        Profiler::Event& event = m_Thread->m_Events[index & (Profiler::EVENTS_PER_THREAD - 1)];
+        event.m_Name = m_Name;
+        event.m_StartTicks = m_StartTicks;
+        event.m_EndTicks = endTicks;
+        event.m_Depth = m_Depth;
+
+        m_Thread->m_WriteIndex.store(index + 1, std::memory_order_release);
+        m_Thread->m_Depth--;
+    }
+
+private:
+    char const*             m_Name;
+    Profiler::ThreadData*   m_Thread;
+    U32                     m_Depth;
+    U64                     m_StartTicks;
+};
+
+DRE_END_NAMESPACE
+
+#if defined(DRE_PROFILER_ENABLED)
+    #define DRE_CPU_SCOPE(Name) DRE::ProfilerScope _##Name##_CPU_SCOPE{ #Name }
+    #define DRE_CPU_FRAME_MARK() DRE::Profiler::MarkFrame()
+    #define DRE_CPU_THREAD_NAME(name) DRE::Profiler::SetThreadName(name)
+#else
+    #define DRE_CPU_SCOPE(Name)
+    #define DRE_CPU_FRAME_MARK()
+    #define DRE_CPU_THREAD_NAME(name)
+#endif
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <foundation\Common.hpp>
+#include <foundation\class_features\NonCopyable.hpp>
+#include <foundation\class_features\NonMovable.hpp>
+
+#include <foundation\container\InplaceVector.hpp>
+#include <foundation\string\InplaceString.hpp>
+#include <foundation\system\ThreadPool.hpp>
+
+#include <initializer_list>
+
+DRE_BEGIN_NAMESPACE
+
+enum TaskAffinity : U8
+{
+    TASK_AFFINITY_MAIN_THREAD,  // graphics API, global allocators, anything not thread-safe
+    TASK_AFFINITY_WORKER
+};
+
+/*
+*
+* One-shot dependency graph of tasks.
+* Worker tasks go to the thread pool as soon as their dependencies are done, main thread tasks run inside Execute().
+*
+*   TaskGraph graph{ &pool };
+*   TaskGraph::TaskID const compile = graph.AddTask("compile", TASK_AFFINITY_WORKER, [](){ ... });
+*   graph.AddTask("load", TASK_AFFINITY_MAIN_THREAD, [](){ ... }, { compile });
+*   graph.Execute();
+*
+*/
+class TaskGraph
+    : public NonCopyable
+    , public NonMovable
+{
+public:
+    static constexpr U32 MAX_TASKS = 32;
+    static constexpr U32 MAX_DEPENDENTS = 16;
+
+    using TaskID = U32;
+    using TaskFunc = std::function<void()>;
+
+    TaskGraph(ThreadPool* threadPool);
+
+    TaskID  AddTask(char const* name, TaskAffinity affinity, TaskFunc&& func, std::initializer_list<TaskID> dependencies = {});
+
+    // blocks until every task is complete, must be called from the main thread
+    void    Execute();
+
+    inline U64 GetTotalTimeUS() const { return m_TotalTimeUS; }
+
+    // sum of all task durations, compare against total time to see how much ran in parallel
+    U64     GetSerialTimeUS() const;
+
+    void    PrintTimings() const;
+
+private:
+    struct Task
+    {
+        String32                            m_Name;
+        TaskAffinity                        m_Affinity = TASK_AFFINITY_MAIN_THREAD;
+        TaskFunc                            m_Func;
+        InplaceVector<TaskID, MAX_DEPENDENTS> m_Dependents;
+        U32                                 m_DependenciesCount = 0;
+        U32                                 m_PendingDependencies = 0;
+
+        U64                                 m_StartUS = 0;
+        U64                                 m_EndUS = 0;
+    };
+
+    void    RunTask(TaskID id);
+
+private:
+    ThreadPool*                     m_ThreadPool;
+    InplaceVector<Task, MAX_TASKS>  m_Tasks;
+
+    std::mutex                      m_CompletedMutex;
+    std::condition_variable         m_CompletedCondition;
+    InplaceVector<TaskID, MAX_TASKS> m_CompletedTasks;
+
+    U64                             m_StartUS;
+    U64                             m_TotalTimeUS;
+};
+
+DRE_END_NAMESPACE
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <foundation\Common.hpp>
+#include <foundation\class_features\NonCopyable.hpp>
+#include <foundation\class_features\NonMovable.hpp>
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <deque>
+
+DRE_BEGIN_NAMESPACE
+
+enum TaskPriority : U8
+{
+    TASK_PRIORITY_HIGH,
+    TASK_PRIORITY_NORMAL,
+    TASK_PRIORITY_LOW,
+    TASK_PRIORITY_MAX
+};
+
+/*
+*
+* Fixed set of worker threads pulling tasks from per-priority FIFO queues.
+* Higher priority queues are always drained first.
+* Tasks must not touch the global allocators (g_MainAllocator, g_FrameScratchAllocator), they are not thread-safe.
+*
+*/
+class ThreadPool
+    : public NonCopyable
+    , public NonMovable
+{
+public:
+    static constexpr U32 MAX_WORKERS = 16;
+
+    using Task = std::function<void()>;
+
+    ThreadPool(U32 workerCount);
+    ~ThreadPool();
+
+    inline U32  GetWorkerCount() const { return m_WorkerCount; }
+
+    void        Submit(Task&& task, TaskPriority priority = TASK_PRIORITY_NORMAL);
+
+    // blocks until all queues are empty and no task is executing
+    void        WaitIdle();
+
+    static U32  DefaultWorkerCount();
+
+private:
+    void        WorkerLoop();
+
+private:
+    std::thread             m_Workers[MAX_WORKERS];
+    U32                     m_WorkerCount;
+
+    std::mutex              m_QueueMutex;
+    std::condition_variable m_QueueCondition;
+    std::condition_variable m_IdleCondition;
+    std::deque<Task>        m_Queues[TASK_PRIORITY_MAX];
+    U32                     m_ActiveTasks;
+    bool                    m_Terminate;
+};
+
+DRE_END_NAMESPACE
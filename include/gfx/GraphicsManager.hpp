@@ -4,12 +4,14 @@
 #include <foundation\class_features\NonMovable.hpp>
 
 #include <foundation\system\Window.hpp>
+#include <foundation\system\ThreadPool.hpp>
 #include <foundation\container\ObjectPool.hpp>
 #include <foundation\container\InplaceHashTable.hpp>
 #include <foundation\container\HashTable.hpp>
 #include <foundation\container\Vector.hpp>
 
 #include <vk_wrapper\Device.hpp>
+#include <vk_wrapper\queue\TimestampQueries.hpp>
 
 #include <gfx\FrameID.hpp>
 #include <gfx\buffer\TransientArena.hpp>
@@ -22,6 +24,8 @@
 #include <gfx\view\RenderView.hpp>
 #include <gfx\renderer\LightsManager.hpp>
 #include <gfx\renderer\TransformsManager.hpp>
+#include <gfx\renderer\ParallelRecorder.hpp>
+#include <gfx\renderer\DynamicResolution.hpp>
 
 #include <engine\data\Geometry.hpp>
 #include <engine\data\Material.hpp>
@@ -32,6 +36,8 @@ constexpr float C_SHADOW_MAP_WORLD_EXTENT = 20.0f;
 constexpr std::uint32_t C_WATER_DIM = 256;
 constexpr std::uint32_t C_WATER_VERTEX_X = 100;
 constexpr std::uint32_t C_WATER_VERTEX_Z = 200;
+// headless --synthetic 10000 is the largest scene we run, rounded up to a power of two
+constexpr std::uint32_t C_MAX_RENDERABLE_OBJECTS = 16384;
 
 namespace VKW
 {
@@ -79,11 +85,33 @@ struct GraphicsSettings
     float           m_WindDirFactor         = 2.0f;
     float           m_GenericScalar         = 1.0f;
 
+    // secondary commandlists a draw-heavy pass is split into, 1 records everything on the main thread
+    std::uint32_t   m_RecordingJobs         = 1;
+
+    // transitions with passes between the producer and the consumer start right after the producer
+    bool            m_SplitBarriers         = true;
+
+    // passes get sets and layouts compiled with the graph, pass uniforms are rewritten only when their region moves
+    bool            m_GraphBindingsCache    = true;
+
+    // overlay passes on the final image, culled while off. A change recompiles the graph at the next frame start
+    bool            m_EditorOverlay         = true;
+    bool            m_DebugView             = false;
+
     std::uint32_t   m_ShadowMapWidth        = 1024;
     std::uint32_t   m_ShadowMapHeight       = 1024;
 
     std::uint32_t   m_RenderingWidth        = 0;
     std::uint32_t   m_RenderingHeight       = 0;
+
+    // render scale of the main view follows the GPU frame time, see DynamicResolution
+    bool            m_DynamicResolution     = false;
+    float           m_TargetGPUTimeMS       = 16.6f;
+    float           m_MinRenderScale        = 0.5f;
+    float           m_MaxRenderScale        = 1.0f;
+    float           m_RenderScaleStep       = 0.05f;
+    float           m_ResolutionHysteresis  = 0.1f;     // fraction of the target the time may drift before the scale changes
+    std::uint32_t   m_ResolutionChangeFrames = 8;       // between two changes, at least FRAMES_BUFFERING + 1
 };
 
 class GraphicsManager final
@@ -94,11 +122,16 @@ public:
     using ImGuiSyncQueue = DRE::Vector<Texture*, DRE::DefaultAllocator>;
 
     GraphicsManager(HINSTANCE hInstance, SYS::Window* window, IO::IOManager* ioManager, bool debug = false);
+
+    // offscreen, no window or swapchain: frames end with a plain submission instead of present, editor and ImGui passes are skipped
+    GraphicsManager(IO::IOManager* ioManager, std::uint32_t width, std::uint32_t height, bool debug = false);
+
     ~GraphicsManager();
 
     inline SYS::Window*                 GetMainWindow() { return m_MainWindow; }
 
     inline VKW::Device*                 GetMainDevice() { return &m_Device; }
+    inline bool                         IsHeadless() const { return m_Device.IsHeadless(); }
 
     inline VKW::ImportTable*            GetVulkanTable() const { return m_Device.GetFuncTable(); }
     inline VKW::Instance*               GetInstance() const { return m_Device.GetInstance(); }
@@ -110,12 +143,24 @@ public:
     inline VKW::Queue*                  GetPresentationQueue() const { return m_Device.GetMainQueue(); }
 
     inline VKW::Context&                GetMainContext() { return m_MainContext; }
+    // nullptr without a compute-only queue family, async compute passes stay on the main context then
+    inline VKW::Context*                GetAsyncComputeContext() { return m_AsyncComputeContext.get(); }
+    inline VKW::TimestampQueries&       GetTimestampQueries() { return m_TimestampQueries; }
+    // scopes recorded by async compute passes, nullptr with the async context
+    inline VKW::TimestampQueries*       GetAsyncTimestampQueries() { return m_AsyncTimestampQueries.get(); }
+    float                               GetGPUFrameTimeMS() const;
 
     inline std::uint64_t                GetCurrentGraphicsFrame() const { return m_GraphicsFrame; }
     inline FrameID                      GetCurrentFrameID() const { return FrameID{ std::uint8_t(m_GraphicsFrame % VKW::CONSTANTS::FRAMES_BUFFERING) }; }
     inline FrameID                      GetPrevFrameID() const { return FrameID{ std::uint8_t((m_GraphicsFrame - 1) % VKW::CONSTANTS::FRAMES_BUFFERING) }; }
     inline FrameID                      GetNextFrameID() const { return FrameID{ std::uint8_t((m_GraphicsFrame + 1) % VKW::CONSTANTS::FRAMES_BUFFERING) }; }
 
+    // frame completion wait + present of the last RenderFrame
+    inline std::uint64_t                GetPresentWaitUS() const { return m_PresentWaitUS; }
+
+    // everything recorded between the ends of the last two RenderFrame calls, loading in between included
+    inline RenderCounters const&        GetFrameCounters() const { return m_FrameCounters; }
+
     inline UploadArena&                 GetUploadArena() { return m_UploadArena; }
     inline UniformArena&                GetUniformArena() { return m_UniformArena; }
     inline ReadbackArena&               GetReadbackArena() { return m_ReadbackArena; }
@@ -124,7 +169,12 @@ public:
     inline PersistentStorage&           GetPersistentStorage() { return m_PersistentStorage; }
     inline LightsManager&               GetLightsManager() { return m_LightsManager; }
     inline DependencyManager&           GetDependencyManager() { return m_DependencyManager; }
+    inline ParallelRecorder&            GetParallelRecorder() { return m_ParallelRecorder; }
+    inline DynamicResolution const&     GetDynamicResolution() const { return m_DynamicResolution; }
+    // part of the rendering size the scene passes draw to, the targets themselves keep the full size
+    inline glm::uvec2                   GetScaledRenderingSize() const { return m_DynamicResolution.GetScaledSize(m_Settings.m_RenderingWidth, m_Settings.m_RenderingHeight); }
     inline RenderGraph&                 GetMainRenderGraph() { return m_RenderGraph; }
+    inline RenderGraph const&           GetMainRenderGraph() const { return m_RenderGraph; }
 
 #ifdef DRE_IMGUI_CUSTOM_TEXTURE
     inline ImGuiSyncQueue&              GetImGuiSyncQueue() { return m_ImGuiSyncQueue; }
@@ -147,9 +197,14 @@ public:
     void                                ReloadShaders();
     void                                RenderFrame(std::uint64_t frame, std::uint64_t deltaTimeUS, float globalTimeS);
     void                                WaitIdle();
+    void                                SubmitTransientUploads();
+
+    RenderCounters                      SampleRenderCounters(VKW::Context const& context) const;
+    static void                         AddContextCounters(RenderCounters& counters, VKW::ContextCounters const& contextCounters);
 
     RenderableObject*                   CreateRenderableObject(WORLD::SceneNode* sceneNode, VKW::Context& context, Data::Geometry* geometry, Data::Material* material);
     void                                FreeRenderableObject(RenderableObject* obj);
+    inline std::uint32_t                GetFreeRenderableObjectsCount() const { return C_MAX_RENDERABLE_OBJECTS - m_RenderableObjectsCount; }
 
     struct GeometryGPU
     {
@@ -159,6 +214,8 @@ public:
     GeometryGPU*                        FindOrLoadGPUGeometry(VKW::Context& context, Data::Geometry* geometry);
 
 private:
+    GraphicsManager(HINSTANCE hInstance, HWND hwnd, SYS::Window* window, IO::IOManager* ioManager, std::uint32_t width, std::uint32_t height, bool debug);
+
     void                                CreateAllPasses(EDITOR::ViewportInputManager* viewportInput);
 
     void                                PrepareGlobalData(VKW::Context& context, WORLD::Scene& scene, std::uint64_t deltaTimeUS, float globalTimeS);
@@ -172,9 +229,15 @@ private:
     VKW::Device                 m_Device;
 
     VKW::Context                m_MainContext;
+    std::unique_ptr<VKW::Context> m_AsyncComputeContext;
+    VKW::TimestampQueries       m_TimestampQueries;
+    std::unique_ptr<VKW::TimestampQueries> m_AsyncTimestampQueries;
 
     std::uint64_t               m_GraphicsFrame;
     VKW::QueueExecutionPoint    m_FrameProcessingCompletePoint[VKW::CONSTANTS::FRAMES_BUFFERING];
+    std::uint64_t               m_PresentWaitUS;
+    RenderCounters              m_FrameCounters;
+    RenderCounters              m_FrameEndCounters;
 
     UploadArena                 m_UploadArena;
     UniformArena                m_UniformArena;
@@ -195,14 +258,20 @@ private:
     TransformsManager           m_TransformsManager;
 
     RenderGraph                 m_RenderGraph;
+    TextureHandle               m_ShadowMap;    // read by the global uniform
     DependencyManager           m_DependencyManager;
 
+    DRE::ThreadPool             m_RecordingThreadPool;
+    ParallelRecorder            m_ParallelRecorder;
+    DynamicResolution           m_DynamicResolution;
+
 
     RenderView                  m_MainView;
     RenderView                  m_SunShadowView;
 
-    using RenderablePool        = DRE::InplaceObjectAllocator<RenderableObject, 2048>;
+    using RenderablePool        = DRE::InplaceObjectAllocator<RenderableObject, C_MAX_RENDERABLE_OBJECTS>;
     RenderablePool              m_RenderableObjectPool;
+    std::uint32_t               m_RenderableObjectsCount;
 
     using GeometryGPUMap        = DRE::InplaceHashTable<Data::Geometry*, GeometryGPU>;
     GeometryGPUMap              m_GeometryGPUMap;
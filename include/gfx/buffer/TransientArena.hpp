@@ -55,10 +55,13 @@ public:
 
     void ResetAllocations               (FrameID contextID);
 
+    // monotonic, bytes handed out by AllocateTransientRegion
+    inline std::uint64_t GetAllocatedBytes() const { return m_AllocatedBytes; }
 
 private:
     std::uint32_t m_TransientBuffersSize;
     std::uint8_t  m_TransientBuffersCount;
+    std::uint64_t m_AllocatedBytes;
 
     char const* ArenaName               ();
 
@@ -85,6 +88,7 @@ TransientArena<USAGE>::TransientArena(VKW::Device* device, std::uint32_t size)
     : DeviceChild(device)
     , m_TransientBuffersSize{ size }
     , m_TransientBuffersCount{ 0 }
+    , m_AllocatedBytes{ 0 }
 {
     std::uint8_t constexpr buffering = VKW::CONSTANTS::FRAMES_BUFFERING;
     m_TransientBuffersCount = buffering;
@@ -107,6 +111,7 @@ TransientArena<USAGE>::TransientArena(TransientArena<USAGE>&& rhs)
     : DeviceChild{ nullptr }
     , m_TransientBuffersSize{ 0 }
     , m_TransientBuffersCount{ 0 }
+    , m_AllocatedBytes{ 0 }
 {
     operator=(DRE_MOVE(rhs));
 }
@@ -118,6 +123,7 @@ TransientArena<USAGE>& TransientArena<USAGE>::operator=(TransientArena<USAGE>&&
 
     DRE_SWAP_MEMBER(m_TransientBuffersSize);
     DRE_SWAP_MEMBER(m_TransientBuffersCount);
+    DRE_SWAP_MEMBER(m_AllocatedBytes);
     DRE_SWAP_MEMBER(m_AllocationContexts);
 
     return *this;
@@ -155,6 +161,7 @@ typename TransientArena<USAGE>::Allocation TransientArena<USAGE>::AllocateTransi
 
 
     allocationContext.m_CurrentBufferPtr = DRE::PtrAdd(allocationContext.m_CurrentBufferPtr, allocationSize);
+    m_AllocatedBytes += size;
 
     return result;
 }
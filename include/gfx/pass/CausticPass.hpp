@@ -15,6 +15,8 @@ public:
     virtual void    Initialize          (RenderGraph& graph) override;
     virtual void    Render              (RenderGraph& graph, VKW::Context& context) override;
 
+private:
+    TextureHandle   m_CausticMap;
 };
 
 }
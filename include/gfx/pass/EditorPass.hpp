@@ -29,6 +29,8 @@ private:
 
     VKW::BufferResource* m_GizmoVertices = nullptr;
     Data::Geometry* m_GizmoGeometry = nullptr;
+
+    TextureHandle   m_ColorBuffer;
 };
 
 }
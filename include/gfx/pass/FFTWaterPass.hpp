@@ -53,6 +53,10 @@ public:
 private:
     DRE::InplaceVector<VKW::DescriptorSet, 24> m_StageSets0;
     DRE::InplaceVector<VKW::DescriptorSet, 24> m_StageSets1;
+
+    TextureHandle   m_Hxt;
+    TextureHandle   m_Butterfly;
+    TextureHandle   m_PingPong[2];
 };
 
 class FFTInvPermutationPass : public BasePass
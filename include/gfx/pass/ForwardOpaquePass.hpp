@@ -21,6 +21,11 @@ private:
 
 private:
     GFX::ReadbackFuture m_LastObjectIDsFuture;
+
+    TextureHandle       m_ForwardColor;
+    TextureHandle       m_Velocity;
+    TextureHandle       m_ObjectIDBuffer;
+    TextureHandle       m_MainDepth;
 };
 
 }
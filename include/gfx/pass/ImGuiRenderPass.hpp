@@ -27,6 +27,7 @@ public:
 private:
     Texture*            m_ImGuiAtlas;
     VKW::Pipeline*      m_GraphicsPipeline;
+    TextureHandle       m_RenderTarget;
 };
 
 }
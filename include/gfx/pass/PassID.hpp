@@ -23,4 +23,27 @@ enum class PassID
     MAX
 };
 
+inline char const* PassIDToString(PassID id)
+{
+    switch (id)
+    {
+    case PassID::BulletForward:     return "BulletForward";
+    case PassID::ForwardOpaque:     return "ForwardOpaque";
+    case PassID::Shadow:            return "Shadow";
+    case PassID::Caustic:           return "Caustic";
+    case PassID::Water:             return "Water";
+    case PassID::FFTButterflyGen:   return "FFTButterflyGen";
+    case PassID::FFTWaterH0Gen:     return "FFTWaterH0Gen";
+    case PassID::FFTWaterHxtGen:    return "FFTWaterHxtGen";
+    case PassID::FFTWaterHeightGen: return "FFTWaterHeightGen";
+    case PassID::FFTWaterInvPerm:   return "FFTWaterInvPerm";
+    case PassID::AntiAliasing:      return "AntiAliasing";
+    case PassID::ImGuiRender:       return "ImGuiRender";
+    case PassID::ColorEncoding:     return "ColorEncoding";
+    case PassID::Editor:            return "Editor";
+    case PassID::Debug:             return "Debug";
+    default:                        return "Unknown";
+    }
+}
+
 }
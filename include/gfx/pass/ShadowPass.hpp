@@ -15,6 +15,9 @@ public:
     virtual void    Initialize          (RenderGraph& graph) override;
     virtual void    Render              (RenderGraph& graph, VKW::Context& context) override;
 
+private:
+    TextureHandle   m_CausticEnvMap;
+    TextureHandle   m_ShadowMap;
 };
 
 }
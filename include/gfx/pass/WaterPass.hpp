@@ -15,6 +15,11 @@ public:
     virtual void    Initialize          (RenderGraph& graph) override;
     virtual void    Render              (RenderGraph& graph, VKW::Context& context) override;
 
+private:
+    TextureHandle   m_WaterColor;
+    TextureHandle   m_Velocity;
+    TextureHandle   m_MainDepth;
+    TextureHandle   m_ForwardColor;
 };
 
 }
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstdint>
+
+#include <foundation\class_features\NonCopyable.hpp>
+#include <foundation\class_features\NonMovable.hpp>
+
+#include <glm\vec2.hpp>
+
+namespace GFX
+{
+
+struct GraphicsSettings;
+
+/*
+*
+* Picks the render scale of the main view from the measured GPU frame time.
+* Scene passes render into the top-left part of the full size targets, AntiAliasingPass upscales it to the output.
+* Scale changes only when the time leaves the hysteresis band around the target and the previous change
+* had time to show up in the timings, which are FRAMES_BUFFERING frames late.
+*
+*/
+class DynamicResolution
+    : public NonCopyable
+    , public NonMovable
+{
+public:
+    DynamicResolution();
+
+    // gpuTimeMS of the latest resolved frame, 0 if it isn't known
+    void Update(GraphicsSettings const& settings, float gpuTimeMS);
+
+    inline float GetScale() const { return m_Scale; }
+
+    // never empty
+    glm::uvec2 GetScaledSize(std::uint32_t width, std::uint32_t height) const;
+
+private:
+    float           m_Scale;
+    std::uint32_t   m_FramesSinceChange;
+};
+
+}
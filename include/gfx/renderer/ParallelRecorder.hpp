@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+
+#include <foundation\class_features\NonCopyable.hpp>
+#include <foundation\class_features\NonMovable.hpp>
+
+#include <foundation\system\ThreadPool.hpp>
+
+namespace VKW
+{
+class   Context;
+struct  ImageResourceView;
+}
+
+namespace GFX
+{
+
+/*
+*
+* Records the draws of one rendering in parallel.
+* Draws are split in contiguous ranges, every range goes to its own secondary commandlist and the primary executes them in order.
+* The main thread records the first range itself, the rest run on the recording thread pool.
+* Small passes (less than MIN_DRAWS_PER_JOB draws per job) and GraphicsSettings::m_RecordingJobs == 1 record inline on the primary.
+*
+* The callback may run on a worker thread: only Cmd* calls on the context it gets, no global allocators, descriptor writes or uniform arena.
+* Barriers can't go into a secondary (no barrier allocator there, and not inside a rendering anyway), the pass transitions everything before.
+* Secondaries inherit nothing but the attachments and the global sets bound by the recorder,
+* so every range binds its own pass set and dynamic state. Job 0 is executed first, attachment clears go there.
+*
+*/
+class ParallelRecorder
+    : public NonCopyable
+    , public NonMovable
+{
+public:
+    static constexpr std::uint32_t MIN_DRAWS_PER_JOB    = 256;
+    static constexpr std::uint32_t MAX_JOBS             = DRE::ThreadPool::MAX_WORKERS + 1;
+
+    using RecordRangeFunc = std::function<void(VKW::Context& context, std::uint32_t job, std::uint32_t begin, std::uint32_t end)>;
+
+    ParallelRecorder(DRE::ThreadPool* threadPool);
+
+    // begins and ends the rendering on the primary context
+    void RecordRendering(VKW::Context& context,
+        std::uint32_t attachmentCount, VKW::ImageResourceView* const* attachments, VKW::ImageResourceView const* depthAttachment,
+        std::uint32_t drawsCount, RecordRangeFunc const& func);
+
+private:
+    DRE::ThreadPool*    m_ThreadPool;
+};
+
+}
+
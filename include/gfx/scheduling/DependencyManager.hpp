@@ -2,14 +2,20 @@
 
 #include <vulkan\vulkan.h>
 
+#include <memory>
+#include <mutex>
+#include <vector>
+
 #include <foundation\Container\InplaceVector.hpp>
-#include <foundation\Container\InplaceHashTable.hpp>
 
 #include <vk_wrapper\pipeline\Dependency.hpp>
 
 namespace VKW
 {
 class Context;
+class Queue;
+class EventPool;
+class ResourcesController;
 }
 
 namespace GFX
@@ -22,11 +28,31 @@ class Device;
 class GraphResourcesManager;
 
 /////////////////////////////////////
+/*
+*
+* Tracks the last access of every resource and turns "now I need access X" into barriers.
+* A read after a read in the same state emits nothing when the earlier barrier already covers the stages,
+* otherwise readers accumulate their stages so the next write waits for all of them.
+* Every resource remembers the queue family that used it last. Images change families through ReleaseOwnership
+* on the old queue and an acquire in the next ResourceBarrier on the new one, without a release the content is dropped.
+* Queues are ordered by semaphores, barriers only cover the work of their own queue.
+* A split barrier moves the image to its next state with an event set now and waited on later,
+* until the wait the image must not be used. Any barrier on it before that records the wait first.
+*
+* State lives in fixed size pages, every resource keeps its slot index (stateSlot_) from the first barrier until it's freed.
+* Only slot allocation is locked, different threads may track different resources at the same time.
+* Pages are added under the same lock when the free slots run out and never move, so entries in use stay valid.
+* Freed resources give the slot back through ResourcesController, reclaimed once per frame.
+*
+*/
 class DependencyManager
     : public NonCopyable
     , public NonMovable
 {
 public:
+    static constexpr std::uint32_t STATES_PAGE_SIZE     = 4096;
+    static constexpr std::uint32_t MAX_STATES_PAGES     = 256;
+
     DependencyManager();
 
     virtual ~DependencyManager();
@@ -34,22 +60,69 @@ public:
     void ResourceBarrier(VKW::Context& context, VKW::ImageResource* resource, VKW::ResourceAccess access, VKW::Stages stageFlags);
     void ResourceBarrier(VKW::Context& context, VKW::BufferResource* resource, VKW::ResourceAccess access, VKW::Stages stageFlags);
 
+    // previous content is dropped, the memory could be written through an aliased image since the last access
+    void DiscardBarrier(VKW::Context& context, VKW::ImageResource* resource, VKW::ResourceAccess access, VKW::Stages stageFlags);
+
+    // recorded on the queue that owns the image, access is what the first barrier on dstQueue will ask for.
+    // Does nothing if the image isn't owned by the context queue
+    void ReleaseOwnership(VKW::Context& context, VKW::ImageResource* resource, VKW::Queue* dstQueue, VKW::ResourceAccess access);
+
+    // signals the transition to access right after the last use, nothing is recorded if no barrier is needed or the pool is out of events
+    void SignalSplitBarrier(VKW::Context& context, VKW::ImageResource* resource, VKW::EventPool& events, VKW::ResourceAccess access, VKW::Stages stageFlags);
+    // false if nothing was signaled for the image, a regular ResourceBarrier is needed then
+    bool WaitSplitBarrier(VKW::Context& context, VKW::ImageResource* resource);
+
+    // no tracking may run during the call
+    void ReclaimStateSlots(VKW::ResourcesController& controller);
+
 
 private:
     struct TextureAccessEntry
     {
-        VKW::ResourceAccess access      = VKW::RESOURCE_ACCESS_UNDEFINED;
-        VKW::Stages         stage       = VKW::STAGE_UNDEFINED;
+        VKW::ResourceAccess access          = VKW::RESOURCE_ACCESS_UNDEFINED;
+        VKW::Stages         stage           = VKW::STAGE_UNDEFINED;
+        std::uint32_t       queueFamily     = VK_QUEUE_FAMILY_IGNORED;
+        std::uint32_t       releasedTo      = VK_QUEUE_FAMILY_IGNORED;
+        VKW::ResourceAccess releasedAccess  = VKW::RESOURCE_ACCESS_UNDEFINED;
+
+        // access and stage already hold the state after the wait
+        VkEvent             splitEvent      = VK_NULL_HANDLE;
+        VKW::ResourceAccess splitSrcAccess  = VKW::RESOURCE_ACCESS_UNDEFINED;
+        VKW::Stages         splitSrcStage   = VKW::STAGE_UNDEFINED;
     };
 
     struct BufferAccessEntry
     {
-        VKW::ResourceAccess  access;
-        VKW::Stages          stage;
+        VKW::ResourceAccess  access     = VKW::RESOURCE_ACCESS_UNDEFINED;
+        VKW::Stages          stage      = VKW::STAGE_UNDEFINED;
+        std::uint32_t        queueFamily = VK_QUEUE_FAMILY_IGNORED;
+    };
+
+    template<typename TEntry>
+    struct StatePages
+    {
+        std::unique_ptr<TEntry[]>   m_Pages[MAX_STATES_PAGES];
+        std::uint32_t               m_PagesCount = 0;
+        std::uint32_t               m_SlotsCount = 0;
+
+        TEntry& operator[](std::uint32_t slot) { return m_Pages[slot / STATES_PAGE_SIZE][slot % STATES_PAGE_SIZE]; }
     };
 
-    DRE::InplaceHashTable<VKW::ImageResource*,  TextureAccessEntry> m_TextureHistory;
-    DRE::InplaceHashTable<VKW::BufferResource*, BufferAccessEntry>  m_BufferHistory;
+    static void WaitPendingSplit(VKW::Context& context, VKW::ImageResource* resource, TextureAccessEntry& entry);
+
+    TextureAccessEntry& GetState(VKW::ImageResource* resource);
+    BufferAccessEntry&  GetState(VKW::BufferResource* resource);
+
+    template<typename TEntry>
+    std::uint32_t       AllocateSlot(StatePages<TEntry>& states, std::vector<std::uint32_t>& freeSlots);
+
+private:
+    StatePages<TextureAccessEntry>  m_TextureStates;
+    StatePages<BufferAccessEntry>   m_BufferStates;
+
+    std::mutex                      m_SlotsMutex;
+    std::vector<std::uint32_t>      m_FreeTextureSlots;
+    std::vector<std::uint32_t>      m_FreeBufferSlots;
 };
 
 }
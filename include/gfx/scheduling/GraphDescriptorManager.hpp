@@ -29,28 +29,35 @@ public:
     GraphDescriptorManager(VKW::Device* device, GraphResourcesManager* resourcesManager, PipelineDB* pipelineDB);
     virtual ~GraphDescriptorManager() {}
 
-    void RegisterTexture        (PassID pass, char const* id, VKW::ResourceAccess access, VKW::DescriptorStage stages, std::uint8_t binding);
-    void RegisterBuffer         (PassID pass, char const* id,  VKW::ResourceAccess access, VKW::DescriptorStage stages, std::uint8_t binding);
+    // invalid handle is a slot the pass writes itself
+    void RegisterTexture        (PassID pass, TextureHandle handle, VKW::ResourceAccess access, VKW::DescriptorStage stages, std::uint8_t binding);
+    void RegisterBuffer         (PassID pass, BufferHandle handle,  VKW::ResourceAccess access, VKW::DescriptorStage stages, std::uint8_t binding);
     void RegisterUniformBuffer  (PassID pass, VKW::DescriptorStage stages, std::uint8_t binding);
     void RegisterPushConstant   (PassID pass, std::uint32_t size, VKW::DescriptorStage stages);
 
     void InitDescriptors();
+    // points the pass sets at the current graph resources again, after the resources manager recreated some. GPU must be done with the sets
+    void WriteDescriptors();
     void DestroyDescriptors();
 
     VKW::DescriptorSet              GetPassDescriptorSet(PassID pass, FrameID frameID);
+    // one per FrameID
+    VKW::DescriptorSet const*       GetPassDescriptorSets(PassID pass);
     VKW::PipelineLayout*            GetPassPipelineLayout(PassID pass);
+    // a pass set can exist without a uniform, GetPassUniformBinding is only valid if this is true
+    bool                            HasPassUniform(PassID pass);
     std::uint32_t                   GetPassUniformBinding(PassID pass);
 
 private:
     struct DescriptorInfo
     {
-        DescriptorInfo(char const* resourceID,  VKW::ResourceAccess access, VKW::DescriptorStage stages, std::uint32_t size0, std::uint32_t size1, std::uint8_t isTexture, std::uint8_t binding)
-            : m_ResourceID{ resourceID }, m_Access{ access }, m_Stages{ stages }, m_Size0{ size0 }, m_Size1{ size1 }, m_IsTexture{ isTexture }, m_Binding{ binding } {}
+        DescriptorInfo(std::uint32_t resourceIndex,  VKW::ResourceAccess access, VKW::DescriptorStage stages, std::uint32_t size0, std::uint32_t size1, std::uint8_t isTexture, std::uint8_t binding)
+            : m_ResourceIndex{ resourceIndex }, m_Access{ access }, m_Stages{ stages }, m_Size0{ size0 }, m_Size1{ size1 }, m_IsTexture{ isTexture }, m_Binding{ binding } {}
 
         DescriptorInfo(VKW::DescriptorStage stages, std::uint8_t binding)
-            : m_ResourceID{ "" }, m_Access{VKW::RESOURCE_ACCESS_SHADER_UNIFORM}, m_Stages{stages}, m_Size0{0}, m_Size1{0}, m_IsTexture{false}, m_Binding{binding} {}
+            : m_ResourceIndex{ DRE_U32_MAX }, m_Access{VKW::RESOURCE_ACCESS_SHADER_UNIFORM}, m_Stages{stages}, m_Size0{0}, m_Size1{0}, m_IsTexture{false}, m_Binding{binding} {}
 
-        DRE::String32           m_ResourceID;
+        std::uint32_t           m_ResourceIndex;    // TextureHandle or BufferHandle
         VKW::ResourceAccess     m_Access;
         VKW::DescriptorStage    m_Stages;
         std::uint32_t           m_Size0;
@@ -69,6 +76,8 @@ private:
 
     DRE::InplaceHashTable<PassID, SetInfo> m_DescriptorsInfo;
 
+    void WritePassSets(SetInfo const& setInfo, VKW::DescriptorSet const* sets);
+
 private:
     struct PerPassDescriptors
     {
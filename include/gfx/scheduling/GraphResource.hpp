@@ -1,5 +1,6 @@
 #pragma once
 
+#include <foundation\Common.hpp>
 
 namespace GFX
 {
@@ -39,5 +40,27 @@ enum class BufferID
 
 #define RESOURCE_ID(id) #id
 
+//////////////////////////////////////
+// index of a graph resource, issued by GraphResourcesManager when the id is first registered.
+// Passes keep the handles they get in RegisterResources, names are left to registration and tooling
+struct TextureHandle
+{
+    inline bool IsValid() const { return m_Index != DRE_U32_MAX; }
+    inline bool operator==(TextureHandle const& rhs) const { return m_Index == rhs.m_Index; }
+    inline bool operator!=(TextureHandle const& rhs) const { return m_Index != rhs.m_Index; }
+
+    std::uint32_t m_Index = DRE_U32_MAX;
+};
+
+//////////////////////////////////////
+struct BufferHandle
+{
+    inline bool IsValid() const { return m_Index != DRE_U32_MAX; }
+    inline bool operator==(BufferHandle const& rhs) const { return m_Index == rhs.m_Index; }
+    inline bool operator!=(BufferHandle const& rhs) const { return m_Index != rhs.m_Index; }
+
+    std::uint32_t m_Index = DRE_U32_MAX;
+};
+
 }
 
@@ -1,10 +1,14 @@
 #pragma once
 
 #include <foundation\Container\InplaceHashTable.hpp>
+#include <foundation\Container\InplaceVector.hpp>
 #include <foundation\string\InplaceString.hpp>
 
 #include <vk_wrapper\Format.hpp>
 #include <vk_wrapper\pipeline\Dependency.hpp>
+#include <vk_wrapper\resources\ResourcesController.hpp>
+
+#include <limits>
 
 #include <gfx\pass\PassID.hpp>
 #include <gfx\scheduling\GraphResource.hpp>
@@ -54,35 +58,113 @@ public:
         AccumulatedInfo info;
     };
 
+    struct TextureLifetime
+    {
+        std::uint32_t   firstPass   = std::numeric_limits<std::uint32_t>::max();
+        std::uint32_t   lastPass    = 0;
+        bool            persistent  = false;
+    };
+
+    struct TransientMemoryStats
+    {
+        std::uint32_t   texturesCount   = 0;
+        std::uint64_t   dedicatedBytes  = 0;    // what transient textures would take with their own memory
+        std::uint64_t   heapBytes       = 0;    // what they take placed in the shared heap
+        std::uint64_t   persistentBytes = 0;
+    };
+
 
 public:
+    static constexpr std::uint32_t MAX_TEXTURES    = 32;
+    static constexpr std::uint32_t MAX_BUFFERS     = 16;
+
     GraphResourcesManager(VKW::Device* device);
 
     virtual ~GraphResourcesManager();
 
-    void RegisterTexture(char const* id, VKW::Format format, std::uint32_t width, std::uint32_t height, VKW::ResourceAccess access);
-    void RegisterBuffer(char const* id, std::uint32_t size, VKW::ResourceAccess access);
+    TextureHandle RegisterTexture(char const* id, VKW::Format format, std::uint32_t width, std::uint32_t height, VKW::ResourceAccess access);
+    BufferHandle  RegisterBuffer(char const* id, std::uint32_t size, VKW::ResourceAccess access);
+
+    // handle of the id, issued on the first call. Texture is only created if some call to RegisterTexture describes it
+    TextureHandle AcquireTextureHandle(char const* id);
+    BufferHandle  AcquireBufferHandle(char const* id);
+
+    // passIndex is the execution order, a texture that is overwritten by its first pass and not persistent is transient:
+    // it lives from its first to its last pass and shares memory with transient textures that don't overlap it
+    void RegisterTextureUse(TextureHandle handle, std::uint32_t passIndex, bool overwrites);
+    // content is needed across frames or outside of the graph
+    void MarkPersistent(TextureHandle handle);
+    // persistent regardless of the pass order, survives ResetTextureLifetimes
+    void MarkStandalone(TextureHandle handle);
+    // before the uses of a new pass order are registered
+    void ResetTextureLifetimes();
 
     void InitResources();
     void DestroyResources();
+    // placed textures and their heap, persistent textures keep their memory and content. GPU must be done with them
+    void DestroyTransientResources();
+
+    inline StorageBuffer*   GetBuffer    (BufferHandle handle) { return &m_Buffers[handle.m_Index].buffer; }
+    inline Texture*         GetTexture   (TextureHandle handle) { return &m_Textures[handle.m_Index].texture; }
+
+    inline TextureLifetime const& GetTextureLifetime(TextureHandle handle) const { return m_TextureLifetimes[handle.m_Index]; }
 
-    StorageBuffer*  GetBuffer    (char const* id);
-    Texture*        GetTexture   (char const* id);
+    // name lookups, for tooling and code outside of the graph passes
+    TextureHandle           FindTexture(char const* id);
+    BufferHandle            FindBuffer(char const* id);
+    StorageBuffer*          GetBuffer    (char const* id);
+    Texture*                GetTexture   (char const* id);
+    inline char const*      GetTextureName(TextureHandle handle) const { return m_TextureNames[handle.m_Index]; }
 
+    inline TransientMemoryStats const& GetTransientMemoryStats() const { return m_TransientStats; }
+
+    // created textures only
     template<typename TDelegate>
     void ForEachTexture(TDelegate func)
     {
-        m_StorageTextures.ForEach(func);
+        for (std::uint32_t i = 0, size = m_TextureNames.Size(); i < size; i++)
+        {
+            if (m_Textures[i].texture.GetResource() != nullptr)
+                func(m_Textures[i]);
+        }
     }
 
+private:
+    struct TransientTexture
+    {
+        TextureHandle           handle;
+        AccumulatedInfo         info;
+        TextureLifetime         lifetime;
+        VKW::ImageUsage         usage;
+        VkImageAspectFlags      aspect;
+        VkMemoryRequirements    requirements;
+        std::uint64_t           offset;
+    };
+
+    using TransientTextures = DRE::InplaceVector<TransientTexture, 32>;
+
+    void CreateTexture(TextureHandle handle, AccumulatedInfo const& info, VKW::ImageUsage usage, VkImageAspectFlags aspect, VKW::ImageResource* image);
+    void PlaceTransientTextures(TransientTextures& textures);
+
 private:
     VKW::Device*        m_Device;
 
-    DRE::InplaceHashTable<DRE::String32, GraphBuffer>  m_StorageBuffers;
-    DRE::InplaceHashTable<DRE::String32, GraphTexture> m_StorageTextures;
+    // name to handle, the rest is indexed by the handle
+    DRE::InplaceHashTable<DRE::String32, TextureHandle>    m_TextureHandles;
+    DRE::InplaceHashTable<DRE::String32, BufferHandle>     m_BufferHandles;
+    DRE::InplaceVector<DRE::String32, MAX_TEXTURES>         m_TextureNames;
+    DRE::InplaceVector<DRE::String32, MAX_BUFFERS>          m_BufferNames;
+
+    GraphBuffer         m_Buffers[MAX_BUFFERS];
+    GraphTexture        m_Textures[MAX_TEXTURES];
+
+    AccumulatedInfo     m_AccumulatedBufferInfo[MAX_BUFFERS];
+    AccumulatedInfo     m_AccumulatedTextureInfo[MAX_TEXTURES];
 
-    DRE::InplaceHashTable<DRE::String32, AccumulatedInfo> m_AccumulatedBufferInfo;
-    DRE::InplaceHashTable<DRE::String32, AccumulatedInfo> m_AccumulatedTextureInfo;
+    TextureLifetime     m_TextureLifetimes[MAX_TEXTURES];
+    std::uint32_t       m_StandaloneTextures;   // bit per TextureHandle
+    VKW::MemoryRegion       m_TransientHeap;
+    TransientMemoryStats    m_TransientStats;
 };
 
 }
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <foundation\Common.hpp>
+
+namespace GFX
+{
+
+/*
+*
+* What a pass or a frame recorded on the CPU side.
+* Every source keeps a monotonic counter (VKW::Context, VKW::DescriptorManager, transient arenas),
+* GraphicsManager::SampleRenderCounters reads them and the work between two samples is their difference.
+*
+*/
+struct RenderCounters
+{
+    std::uint64_t m_Draws               = 0;
+    std::uint64_t m_Dispatches          = 0;
+    std::uint64_t m_PipelineBinds       = 0;
+    std::uint64_t m_DescriptorWrites    = 0;
+    std::uint64_t m_Barriers            = 0;
+    std::uint64_t m_BarrierBatches      = 0;
+    std::uint64_t m_SplitBarriers       = 0;
+    std::uint64_t m_Flushes             = 0;
+    std::uint64_t m_UploadBytes         = 0;
+    std::uint64_t m_UniformBytes        = 0;
+
+    inline RenderCounters operator-(RenderCounters const& rhs) const
+    {
+        RenderCounters result;
+        result.m_Draws              = m_Draws - rhs.m_Draws;
+        result.m_Dispatches         = m_Dispatches - rhs.m_Dispatches;
+        result.m_PipelineBinds      = m_PipelineBinds - rhs.m_PipelineBinds;
+        result.m_DescriptorWrites   = m_DescriptorWrites - rhs.m_DescriptorWrites;
+        result.m_Barriers           = m_Barriers - rhs.m_Barriers;
+        result.m_BarrierBatches     = m_BarrierBatches - rhs.m_BarrierBatches;
+        result.m_SplitBarriers      = m_SplitBarriers - rhs.m_SplitBarriers;
+        result.m_Flushes            = m_Flushes - rhs.m_Flushes;
+        result.m_UploadBytes        = m_UploadBytes - rhs.m_UploadBytes;
+        result.m_UniformBytes       = m_UniformBytes - rhs.m_UniformBytes;
+        return result;
+    }
+};
+
+}
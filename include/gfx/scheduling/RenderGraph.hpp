@@ -3,13 +3,16 @@
 #include <foundation\Container\InplaceVector.hpp>
 
 #include <vk_wrapper\descriptor\Descriptor.hpp>
+#include <vk_wrapper\queue\EventPool.hpp>
 
 #include <gfx\scheduling\GraphResourcesManager.hpp>
 #include <gfx\scheduling\GraphDescriptorManager.hpp>
+#include <gfx\scheduling\RenderCounters.hpp>
 
 namespace VKW
 {
 class Context;
+class QueueExecutionPoint;
 }
 
 namespace GFX
@@ -35,18 +38,24 @@ public:
     }
 
 
-    void RegisterRenderTarget       (BasePass* pass, char const* id, VKW::Format format, std::uint32_t width, std::uint32_t height, std::uint32_t binding);
-    void RegisterDepthStencilTarget (BasePass* pass, char const* id, VKW::Format format, std::uint32_t width, std::uint32_t height);
-    void RegisterDepthOnlyTarget (BasePass* pass, char const* id, VKW::Format format, std::uint32_t width, std::uint32_t height);
+    // handles returned by Register* are what passes use to get their resources in Render
+    TextureHandle RegisterRenderTarget       (BasePass* pass, char const* id, VKW::Format format, std::uint32_t width, std::uint32_t height, std::uint32_t binding);
+    TextureHandle RegisterDepthStencilTarget (BasePass* pass, char const* id, VKW::Format format, std::uint32_t width, std::uint32_t height);
+    TextureHandle RegisterDepthOnlyTarget (BasePass* pass, char const* id, VKW::Format format, std::uint32_t width, std::uint32_t height);
 
-    void RegisterTexture            (BasePass* pass, char const* id, VKW::Format format, std::uint32_t width, std::uint32_t height, VKW::ResourceAccess access, VKW::Stages stage, std::uint32_t binding);
-    void RegisterStandaloneTexture  (char const* id, VKW::Format format, std::uint32_t width, std::uint32_t height, VKW::ResourceAccess access);
-    void RegisterTextureSlot        (BasePass* pass, VKW::ResourceAccess access, VKW::Stages stage, std::uint32_t binding);
+    TextureHandle RegisterTexture            (BasePass* pass, char const* id, VKW::Format format, std::uint32_t width, std::uint32_t height, VKW::ResourceAccess access, VKW::Stages stage, std::uint32_t binding);
+    TextureHandle RegisterStandaloneTexture  (char const* id, VKW::Format format, std::uint32_t width, std::uint32_t height, VKW::ResourceAccess access);
+    void          RegisterTextureSlot        (BasePass* pass, VKW::ResourceAccess access, VKW::Stages stage, std::uint32_t binding);
+    // access without a pass descriptor (copies, global descriptors), only used to transition the texture before the pass
+    TextureHandle RegisterTextureUsage       (BasePass* pass, char const* id, VKW::ResourceAccess access, VKW::Stages stage);
 
-    void RegisterStorageBuffer      (BasePass* pass, char const* id, std::uint32_t size, VKW::ResourceAccess access, VKW::Stages stage, std::uint32_t binding);
-    void RegisterUniformBuffer      (BasePass* pass, VKW::Stages stage, std::uint32_t binding);
+    BufferHandle  RegisterStorageBuffer      (BasePass* pass, char const* id, std::uint32_t size, VKW::ResourceAccess access, VKW::Stages stage, std::uint32_t binding);
+    void          RegisterUniformBuffer      (BasePass* pass, VKW::Stages stage, std::uint32_t binding);
 
-    void RegisterPushConstant       (BasePass* pass, std::uint32_t size, VKW::Stages stage);
+    void          RegisterPushConstant       (BasePass* pass, std::uint32_t size, VKW::Stages stage);
+
+    // pass only records compute and transfer work on resources it declared, the graph may run it on the compute queue
+    void          RegisterAsyncCompute       (BasePass* pass);
 
     VKW::DescriptorSet              GetPassDescriptorSet(PassID pass, FrameID frameID);
     VKW::PipelineLayout*            GetPassPipelineLayout(PassID pass);
@@ -54,28 +63,151 @@ public:
     std::uint32_t                   GetPassSetBinding();
     std::uint32_t                   GetUserSetBinding(PassID pass);
 
+    inline Texture*                 GetTexture(TextureHandle handle) { return m_ResourcesManager.GetTexture(handle); }
+    inline StorageBuffer*           GetBuffer(BufferHandle handle) { return m_ResourcesManager.GetBuffer(handle); }
+    // name lookups, outside of the passes only
     Texture*                        GetTexture(char const* id);
     StorageBuffer*                  GetBuffer(char const* id);
     UniformProxy                    GetPassUniform(PassID pass, VKW::Context& context, std::uint32_t size);
 
     GraphResourcesManager&          GetResourcesManager();
+    inline GraphResourcesManager const& GetResourcesManager() const { return m_ResourcesManager; }
+
+    // passes left after CompileGraph, indices are in the execution order
+    inline std::uint32_t            GetPassesCount() const { return m_ExecutionOrder.Size(); }
+    PassID                          GetPassID(std::uint32_t passIndex) const;
+
+    // work recorded by the pass during the last Render
+    inline RenderCounters const&    GetPassCounters(std::uint32_t passIndex) const { return m_PassCounters[passIndex]; }
+    // CPU time of the pass's Render call during the last Render, parallel recording included
+    inline std::uint64_t            GetPassRecordTimeUS(std::uint32_t passIndex) const { return m_PassRecordUS[passIndex]; }
+    // CPU time of the last Render outside of the passes' Render calls: transitions, split barriers, async fork and join
+    inline std::uint64_t            GetOverheadUS() const { return m_OverheadUS; }
 
 public:
     void ParseGraph();
+    // orders passes by declared reads and writes and culls those that don't contribute to the output,
+    // does nothing if the enabled pass set didn't change since the last compile.
+    // Targets are sized from GraphicsSettings in ParseGraph, the rendering resolution is fixed for the graph's lifetime
+    void CompileGraph();
+    // resolves descriptors and resources, compiled pass bindings live until UnloadGraphResources or the next compile
     void InitGraphResources();
     void UnloadGraphResources();
 
+    // an overlay was switched in GraphicsSettings since the last compile
+    bool NeedsCompile() const;
+    // compiles again and moves the resources to the new order, GPU must be idle.
+    // Transient textures are placed again, persistent ones keep their content
+    void RecompileGraph();
+
     // last access to texture should be VKW::RESOURCE_ACCESS_COLOR_ATTACHMENT
     Texture& Render(VKW::Context& context);
 
 
+private:
+    /*
+    *
+    * Resource access declared by the pass in RegisterResources.
+    * First declaration of a resource is the state the pass expects on entry, the graph transitions
+    * all of them before the pass records anything so they end up in one barrier batch.
+    * Later declarations with the same access only widen the stages, other accesses are transitions inside the pass.
+    * A pass that declares a write to a texture first must overwrite all of it, such textures are transient and share memory.
+    *
+    */
+    struct ResourceUsage
+    {
+        TextureHandle           m_TextureHandle;
+        BufferHandle            m_BufferHandle;
+        VKW::ResourceAccess     m_Access        = VKW::RESOURCE_ACCESS_UNDEFINED;
+        VKW::Stages             m_Stages        = VKW::STAGE_UNDEFINED;
+        bool                    m_IsTexture     = true;
+        bool                    m_Discard       = false;    // first use of a transient texture
+        bool                    m_SplitWait     = false;    // transition was signaled after the previous use
+        VKW::ImageResource*     m_Image         = nullptr;
+        VKW::BufferResource*    m_Buffer        = nullptr;
+    };
+
+    using PassUsages = DRE::InplaceVector<ResourceUsage, 16>;
+
+    /*
+    *
+    * What a pass asks the graph for every frame, resolved once in InitGraphResources.
+    * Steady-state frames only patch the pass uniform: the arena hands out the same regions every frame,
+    * so the descriptor is rewritten only when the region differs from the one the set already points to.
+    *
+    */
+    struct CompiledPass
+    {
+        struct UniformRegion
+        {
+            VKW::BufferResource*    m_Buffer    = nullptr;
+            std::uint32_t           m_Offset    = 0;
+            std::uint32_t           m_Size      = 0;
+        };
+
+        VKW::DescriptorSet      m_PassSet[VKW::CONSTANTS::FRAMES_BUFFERING];
+        UniformRegion           m_WrittenUniform[VKW::CONSTANTS::FRAMES_BUFFERING];
+        VKW::PipelineLayout*    m_PipelineLayout    = nullptr;
+        std::uint32_t           m_UniformBinding    = DRE_U32_MAX;
+        std::uint32_t           m_UserSetBinding    = 0;
+    };
+
+    // transition signaled right after a pass, waited on by the next pass using the image
+    struct SplitBarrier
+    {
+        VKW::ImageResource*     m_Image;
+        VKW::ResourceAccess     m_Access;
+        VKW::Stages             m_Stages;
+    };
+
+    void AddResourceUsage(BasePass* pass, TextureHandle texture, BufferHandle buffer, VKW::ResourceAccess access, VKW::Stages stage);
+    // overlays from GraphicsSettings, a disabled pass is culled even though it writes the graph output
+    bool IsPassEnabled(PassID pass) const;
+    std::uint32_t GetEnabledPassSet() const;
+    bool IsRootPass(PassID pass, PassUsages const& usages);
+    static bool HasDependency(PassUsages const& first, PassUsages const& second);
+    static bool ReadsOutputOf(PassUsages const& reader, PassUsages const& writer);
+    void RegisterTextureLifetimes();
+    void ResolveResourceUsages();
+    void PlanSplitBarriers();
+    void TransitionPassResources(PassID pass, VKW::Context& context);
+    void CompilePassBindings();
+    // passes are initialized the first time they're executed
+    void InitializePasses();
+    // nullptr before InitGraphResources or with GraphicsSettings::m_GraphBindingsCache off
+    CompiledPass* FindCompiledPass(PassID pass);
+
+    inline bool IsAsyncPass(std::uint32_t passIndex) const { return (m_AsyncPasses & (1u << passIndex)) != 0; }
+    VKW::QueueExecutionPoint ForkAsyncCompute(VKW::Context& context, VKW::Context& asyncContext);
+    void JoinAsyncCompute(VKW::Context& context, VKW::Context& asyncContext, VKW::QueueExecutionPoint const& forkPoint);
+
 private:
     GraphicsManager*        m_GraphicsManager;
     GraphResourcesManager   m_ResourcesManager;
     GraphDescriptorManager  m_DescriptorManager;
+    TextureHandle           m_OutputTexture;
 
 
     DRE::InplaceVector<BasePass*, 20>  m_Passes;
+    RenderCounters                     m_PassCounters[20];
+    std::uint64_t                      m_PassRecordUS[20];
+    std::uint64_t                      m_OverheadUS;
+    PassUsages                         m_PassUsages[std::uint32_t(PassID::MAX)];
+
+    VKW::EventPool                     m_SplitBarrierEvents;
+    DRE::InplaceVector<SplitBarrier, 16> m_SplitSignals[20];   // by execution position
+
+    DRE::InplaceVector<std::uint32_t, 20>   m_ExecutionOrder;   // indices into m_Passes
+    std::uint32_t                           m_CompiledPassSet;  // bit per PassID
+    std::uint32_t                           m_InitializedPasses;    // bit per PassID
+
+    DRE::InplaceVector<CompiledPass, 20>    m_CompiledPasses;   // by execution position
+    std::uint8_t                            m_CompiledPassIndex[std::uint32_t(PassID::MAX)];    // 0xFF if the pass isn't executed
+
+    std::uint32_t                           m_TextureSlotPasses;    // bit per PassID
+    std::uint32_t                           m_AsyncCandidates;      // bit per PassID
+    std::uint32_t                           m_AsyncPasses;          // bit per m_Passes index, none without a compute queue
+    std::uint32_t                           m_AsyncJoinPosition;    // first executed pass that waits for the async ones
 };
 
 }
@@ -30,6 +30,8 @@ public:
 
     void                LoadDefaultTextures ();
     Texture*            LoadTexture2DSync   (DRE::String128 const& name, std::uint32_t width, std::uint32_t height, VKW::Format format, DRE::ByteBuffer const& textureData);
+    // records the upload into context from the current frame's upload region, caller owns submission and fencing
+    Texture*            LoadTexture2D       (VKW::Context& context, DRE::String128 const& name, std::uint32_t width, std::uint32_t height, VKW::Format format, DRE::ByteBuffer const& textureData);
     Texture*            FindTexture         (DRE::String128 const& name);
 
     template<typename TDelegate>
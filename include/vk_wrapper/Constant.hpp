@@ -14,11 +14,15 @@ namespace CONSTANTS
 
 std::uint8_t constexpr FRAMES_BUFFERING             = 2;
 std::uint8_t constexpr MAX_COMMANDLIST_PER_QUEUE    = 20;
+std::uint8_t constexpr MAX_SECONDARY_PER_QUEUE      = 128;
+std::uint8_t constexpr MAX_SECONDARY_PER_PRIMARY    = 64;
 std::uint8_t constexpr MAX_COLOR_ATTACHMENTS        = 5;
 
 std::uint32_t constexpr MAX_ALLOCATIONS = 128;
 
 std::uint32_t constexpr TEXTURE_DESCRIPTOR_HEAP_SIZE = 1024;
+// 64K for a main and a shadow set per buffered frame of 16K renderables, 8K left for passes
+std::uint32_t constexpr MAX_STANDALONE_SETS         = 1024 * 72;
 
 std::uint16_t constexpr MAX_SET_LAYOUT_MEMBERS      = 6;
 std::uint16_t constexpr MAX_PIPELINE_LAYOUT_MEMBERS = 6;
@@ -25,6 +25,7 @@ class   RenderPass;
 class   Framebuffer;
 class   Dependency;
 class   DescriptorManager;
+class   TimestampQueries;
 
 enum class BindPoint
 {
@@ -51,6 +52,18 @@ enum PolygonModeBits
 
 using AttachmentMask = std::uint32_t;
 
+// monotonic, never reset: users keep a snapshot and subtract
+struct ContextCounters
+{
+    std::uint64_t m_Draws           = 0;
+    std::uint64_t m_Dispatches      = 0;
+    std::uint64_t m_PipelineBinds   = 0;
+    std::uint64_t m_Barriers        = 0;
+    std::uint64_t m_BarrierBatches  = 0; // vkCmdPipelineBarrier2 calls
+    std::uint64_t m_SplitBarriers   = 0; // signaled with an event, counted in m_Barriers as well
+    std::uint64_t m_Flushes         = 0; // command list submissions
+};
+
 ////////////////////////////////////////
 ////////////////////////////////////////
 ////////////////////////////////////////
@@ -61,12 +74,24 @@ class Context
 {
 public:
     Context(VKW::ImportTable* table, VKW::Queue* queue, DRE::AllocatorLinear* barrierAllocator);
+
+    // secondary commandlist continuing the rendering the primary has begun with secondary contents.
+    // Created on the thread that owns the primary, recorded on any thread, handed back with CmdExecuteCommands.
+    // Nothing is inherited besides the attachments: pipeline, sets and dynamic state have to be bound again, no barriers
+    Context(VKW::Context& primary);
+
     ~Context();
 
 public:
     inline VKW::Queue* GetParentQueue() const { return m_ParentQueue; }
+    inline bool IsSecondary() const { return m_IsSecondary; }
     inline VKW::CommandList* GetCurrentCommandList() { return m_CurrentCommandList; }
 
+    inline void SetTimestampQueries(VKW::TimestampQueries* queries) { m_TimestampQueries = queries; }
+    inline VKW::TimestampQueries* GetTimestampQueries() const { return m_TimestampQueries; }
+
+    inline ContextCounters const& GetCounters() const { return m_Counters; }
+
     void ResetDependenciesVectors(DRE::AllocatorLinear* allocator);
     
     void FlushAll();
@@ -79,6 +104,9 @@ public:
     VKW::QueueExecutionPoint SyncPoint(std::uint8_t waitCount = 0, VKW::QueueExecutionPoint const* waits = nullptr);
     VKW::QueueExecutionPoint SyncPoint(VKW::QueueExecutionPoint const& wait);
 
+    // next submission waits for the point on the GPU, submit before the call what shouldn't wait
+    void WaitOnNextSubmit(VKW::QueueExecutionPoint const& point);
+
 public:
     void CmdDraw(std::uint32_t vertexCount, std::uint32_t instanceCount = 1, std::uint32_t firstVertex = 0, std::uint32_t firstInstance = 0);
     void CmdDrawIndexed(std::uint32_t indexCount, std::uint32_t instanceCount = 1, std::uint32_t firstIndex = 0, std::int32_t vertexOffset = 0, std::uint32_t firstInstance = 0);
@@ -133,13 +161,33 @@ public:
         ResourceAccess srcAccess, Stages srcStage,
         ResourceAccess dstAccess, Stages dstStage);
 
+    // release or acquire half of a queue family ownership transfer, both halves use the same accesses
+    void CmdQueueOwnershipTransfer(VKW::ImageResource const* resource,
+        ResourceAccess srcAccess, Stages srcStage, std::uint32_t srcQueueFamily,
+        ResourceAccess dstAccess, Stages dstStage, std::uint32_t dstQueueFamily);
+
+    // split barrier: the set releases the src scope right away, the wait with the same accesses does the transition later.
+    // Work recorded in between overlaps with it, the image must not be touched there
+    void CmdSetEvent(VkEvent event, VKW::ImageResource const* resource,
+        ResourceAccess srcAccess, Stages srcStage,
+        ResourceAccess dstAccess, Stages dstStage);
 
-    void CmdBeginRendering(std::uint32_t attachmentCount, VKW::ImageResourceView* const* attachments, VKW::ImageResourceView const* depthAttachment, VKW::ImageResourceView const* stencilAttachment);
+    void CmdWaitEvent(VkEvent event, VKW::ImageResource const* resource,
+        ResourceAccess srcAccess, Stages srcStage,
+        ResourceAccess dstAccess, Stages dstStage);
+
+    void CmdResetEvent(VkEvent event, VkPipelineStageFlags2 stages);
+
+    // with secondaryContents the rendering may only contain CmdExecuteCommands
+    void CmdBeginRendering(std::uint32_t attachmentCount, VKW::ImageResourceView* const* attachments, VKW::ImageResourceView const* depthAttachment, VKW::ImageResourceView const* stencilAttachment, bool secondaryContents = false);
     void CmdClearAttachments(AttachmentMask attachments, float* color);
     void CmdClearAttachments(AttachmentMask attachments, std::uint32_t* value);
     void CmdClearAttachments(AttachmentMask attachments, float depth, std::uint32_t stencil);
     void CmdEndRendering();
 
+    // executes in order and takes the secondaries' counters, they can't be recorded to afterwards
+    void CmdExecuteCommands(std::uint32_t count, VKW::Context* const* secondaries);
+
     void CmdBindVertexBuffer(VKW::BufferResource* vertexBuffer, std::uint32_t offset);
     void CmdBindIndexBuffer(VKW::BufferResource* indexBuffer, std::uint32_t offset, std::uint8_t indexSize = 32);
 
@@ -155,6 +203,9 @@ public:
     void CmdEndDebugLabel();
     void CmdInsertDebugLabel(char const* label);
 
+    std::uint32_t CmdBeginTimestampScope(char const* name);
+    void CmdEndTimestampScope(std::uint32_t scope);
+
     void WaitIdle();
 
 private:
@@ -164,8 +215,24 @@ private:
 
     VkRect2D                m_RenderingRect;
 
+    // secondaries inherit the attachment formats of the current rendering
+    struct RenderingFormats
+    {
+        VkFormat            m_Color[VKW::CONSTANTS::MAX_COLOR_ATTACHMENTS];
+        std::uint32_t       m_ColorCount;
+        VkFormat            m_Depth;
+        VkFormat            m_Stencil;
+    };
+    RenderingFormats        m_RenderingFormats;
+    bool                    m_IsSecondary;
+
     VKW::Dependency         m_PendingDependency;
 
+    DRE::InplaceVector<VKW::QueueExecutionPoint, VKW::Queue::WAIT_COUNT_MAX> m_PendingWaits;
+
+    VKW::TimestampQueries*  m_TimestampQueries;
+
+    ContextCounters         m_Counters;
 };
 
 
@@ -177,15 +244,18 @@ public:
         : m_Context{ &context }
     {
         m_Context->CmdBeginDebugLabel(name);
+        m_TimestampScope = m_Context->CmdBeginTimestampScope(name);
     }
 
     ~_GPU_DEBUG_SCOPE_()
     {
+        m_Context->CmdEndTimestampScope(m_TimestampScope);
         m_Context->CmdEndDebugLabel();
     }
 
 private:
-    Context* m_Context;
+    Context*        m_Context;
+    std::uint32_t   m_TimestampScope;
 };
 #define DRE_GPU_SCOPE(Name) VKW::_GPU_DEBUG_SCOPE_ _##Name##_GPU_SCOPE{ context, #Name }
 #define DRE_GPU_EVENT(Name) context.CmdInsertDebugLabel(#Name)
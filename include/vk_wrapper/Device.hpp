@@ -28,6 +28,7 @@ class Device final
     : public NonCopyable
 {
 public:
+    // hwnd == NULL creates a headless device: no surface, swapchain or presentation controller
     Device(HINSTANCE hInstance,HWND hwnd, bool debug = false);
 
     Device(Device&& rhs) = default;
@@ -40,10 +41,16 @@ public:
     VKW::LogicalDevice*             GetLogicalDevice() const{ return device_.get(); }
     VKW::Swapchain*                 GetSwapchain() const { return swapchain_.get(); }
     VKW::Queue*                     GetMainQueue() const { return queueProvider_->GetMainQueue(); }
+    VKW::Queue*                     GetComputeQueue() const { return queueProvider_->GetComputeQueue(); }
     VKW::PresentationController*    GetPresentationController() const { return presentationController_.get(); }
     VKW::ResourcesController*       GetResourcesController() const { return resourcesController_.get(); }
     VKW::DescriptorManager*         GetDescriptorManager() const { return descriptorManager_.get(); }
 
+    bool                            IsHeadless() const { return device_->IsHeadless(); }
+
+
+private:
+    void CreatePresentation(HINSTANCE hInstance, HWND hwnd);
 
 private:
     std::unique_ptr<DynamicLibrary> vulkanLibrary_;
@@ -178,6 +178,12 @@ public:
     PFN_vkCmdPipelineBarrier vkCmdPipelineBarrier = nullptr;
     PFN_vkCmdPipelineBarrier2 vkCmdPipelineBarrier2 = nullptr;
 
+    PFN_vkCreateEvent vkCreateEvent = nullptr;
+    PFN_vkDestroyEvent vkDestroyEvent = nullptr;
+    PFN_vkCmdSetEvent2 vkCmdSetEvent2 = nullptr;
+    PFN_vkCmdWaitEvents2 vkCmdWaitEvents2 = nullptr;
+    PFN_vkCmdResetEvent2 vkCmdResetEvent2 = nullptr;
+
     PFN_vkCmdBeginRenderPass vkCmdBeginRenderPass = nullptr;
     PFN_vkCmdEndRenderPass vkCmdEndRenderPass = nullptr;
     PFN_vkCmdNextSubpass vkCmdNextSubpass = nullptr;
@@ -186,9 +192,14 @@ public:
     PFN_vkCmdClearAttachments vkCmdClearAttachments = nullptr;
     PFN_vkCmdDraw vkCmdDraw = nullptr;
     PFN_vkCmdDrawIndexed vkCmdDrawIndexed = nullptr;
+    PFN_vkCmdExecuteCommands vkCmdExecuteCommands = nullptr;
 
     PFN_vkCreateQueryPool vkCreateQueryPool = nullptr;
     PFN_vkResetQueryPool vkResetQueryPool = nullptr;
+    PFN_vkDestroyQueryPool vkDestroyQueryPool = nullptr;
+    PFN_vkGetQueryPoolResults vkGetQueryPoolResults = nullptr;
+    PFN_vkCmdResetQueryPool vkCmdResetQueryPool = nullptr;
+    PFN_vkCmdWriteTimestamp2 vkCmdWriteTimestamp2 = nullptr;
 
     PFN_vkGetAccelerationStructureDeviceAddressKHR vkGetAccelerationStructureDeviceAddressKHR = nullptr;
     PFN_vkGetAccelerationStructureBuildSizesKHR vkGetAccelerationStructureBuildSizesKHR = nullptr;
@@ -37,6 +37,8 @@ struct DeviceDesc
     std::uint32_t computeQueueCount_;
     std::uint32_t transferQueueCount_;
 
+    // no surface: presentation support isn't required from queues, ray tracing extensions aren't requested
+    bool headless_ = false;
 };
 
 class LogicalDevice
@@ -88,6 +90,7 @@ public:
     operator bool() const;
 
     bool IsAPI13Supported() const;
+    bool IsHeadless() const { return headless_; }
     void PrintPhysicalDeviceFormatProperties(VkFormat format);
 
 private:
@@ -116,6 +119,8 @@ private:
     VKW::LogicalDevice::PhysicalDeviceProperties physicalDeviceProperties_;
 
     std::vector<DeviceQueueFamilyInfo> queueInfo_;
+
+    bool headless_;
 };
 
 }
\ No newline at end of file
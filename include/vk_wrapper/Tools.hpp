@@ -4,13 +4,16 @@
 #include <cstdint>
 #include <limits>
 
+#include <foundation\system\Log.hpp>
+
 #define VK_FLAGS_NONE 0
 
 #define VK_ASSERT(result)                           \
 {                                                   \
     VkResult r = result;                            \
     if (r != VK_SUCCESS) {                     \
-        std::cerr << "Fatal: VkResult is " << static_cast<int>(r) << std::endl << "FILE: " << __FILE__ << ", line: " << __LINE__ << std::endl; \
+        DRE_LOG_ERROR("Fatal: VkResult is %d, FILE: %s, line: %d", static_cast<int>(r), __FILE__, __LINE__); \
+        DRE::Log::Flush();                          \
         assert(r == VK_SUCCESS);                    \
     }                                               \
 }
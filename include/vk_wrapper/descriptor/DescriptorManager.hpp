@@ -110,6 +110,9 @@ public:
 
     void                        WriteDescriptorSet(DescriptorSet set, WriteDesc& desc);
 
+    // monotonic count of WriteDescriptorSet calls
+    std::uint64_t               GetSetWritesCount() const { return setWritesCount_; }
+
 private:
     void CreateGlobalDescriptorLayouts();
     void WriteTextureDescriptor(VkDescriptorSet set, std::uint16_t descriptorID, ImageResourceView const* view);
@@ -138,6 +141,8 @@ private:
 
     VkDescriptorPool            standalonePool_;
 
+    std::uint64_t               setWritesCount_;
+
 };
 
 }
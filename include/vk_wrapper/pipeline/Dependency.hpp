@@ -63,6 +63,11 @@ VkAccessFlags2KHR       AccessToFlags(ResourceAccess access);
 VkImageLayout           AccessToLayout(ResourceAccess access);
 VkPipelineStageFlags2   StagesToFlags(Stages stage);
 
+// families differ only for ownership transfers
+VkImageMemoryBarrier2KHR ImageBarrier(VKW::ImageResource const* resource,
+    ResourceAccess srcAccess, Stages srcStage, std::uint32_t srcQueueFamily,
+    ResourceAccess dstAccess, Stages dstStage, std::uint32_t dstQueueFamily);
+
 
 //bool BarrierRequirements(VKW::ResourceAccess prevAccess, VKW::ResourceAccess access, bool& requireExecutionDependency, bool& requireMemoryDependency, bool& requireTransition);
 //bool BarrierRequirements(VKW::ResourceAccess prevAccess, VKW::ResourceAccess access, bool& requireExecutionDependency, bool& requireMemoryDependency);
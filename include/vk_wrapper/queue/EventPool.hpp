@@ -0,0 +1,51 @@
+#pragma once
+
+#include <vulkan\vulkan.h>
+
+#include <foundation\Common.hpp>
+#include <foundation\class_features\NonCopyable.hpp>
+#include <foundation\class_features\NonMovable.hpp>
+
+#include <vk_wrapper\Constant.hpp>
+
+namespace VKW
+{
+
+class ImportTable;
+class LogicalDevice;
+class Context;
+
+/*
+*
+* Device only events for split barriers, one set per buffered frame.
+* Events of a frame are reset on the GPU when its frame ID comes around again,
+* by then the frame's completion point was already waited on so nothing still waits on them.
+*
+*/
+class EventPool
+    : public NonCopyable
+    , public NonMovable
+{
+public:
+    static constexpr std::uint32_t MAX_EVENTS_PER_FRAME = 32;
+
+    EventPool(ImportTable* table, LogicalDevice* device);
+    ~EventPool();
+
+    // call after the frame's completion point was waited on
+    void BeginFrame(Context& context, std::uint8_t frameID);
+
+    // VK_NULL_HANDLE if the frame ran out of events, use a regular barrier then
+    VkEvent Allocate();
+
+private:
+    ImportTable*    m_Table;
+    LogicalDevice*  m_Device;
+
+    VkEvent         m_Events[CONSTANTS::FRAMES_BUFFERING][MAX_EVENTS_PER_FRAME];
+    std::uint32_t   m_UsedCount[CONSTANTS::FRAMES_BUFFERING];
+
+    std::uint8_t    m_CurrentFrameID;
+};
+
+}
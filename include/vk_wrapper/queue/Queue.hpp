@@ -39,7 +39,7 @@ class CommandList
     : public NonCopyable
 {
 public:
-    CommandList(ImportTable* table, LogicalDevice* device, Queue* parentQueue);
+    CommandList(ImportTable* table, LogicalDevice* device, Queue* parentQueue, bool secondary = false);
 
     CommandList(CommandList&& rhs);
     CommandList& operator=(CommandList&& rhs);
@@ -48,14 +48,21 @@ public:
 
     inline operator VkCommandBuffer() const { return commandBuffer_; }
     Queue* GetQueue() const { return parentQueue_; }
+    inline bool IsSecondary() const { return secondary_; }
 
     void Begin();
+    void Begin(VkCommandBufferInheritanceInfo const& inheritance); // secondary, continues the primary's rendering
     void End();
     void Reset();
-    void SetFinishExecutionPoint(QueueExecutionPoint& point);
+    void SetFinishExecutionPoint(QueueExecutionPoint const& point);
     void WaitForPendingExecution();
 
+    // executed secondaries go back to the queue when this list is submitted
+    void AddExecutedSecondary(CommandList* secondary);
+
 private:
+    friend class Queue;
+
     ImportTable* table_;
     LogicalDevice* device_;
 
@@ -65,6 +72,9 @@ private:
     QueueExecutionPoint executionFinishPoint_;
 
     Queue*    parentQueue_;
+    bool      secondary_;
+
+    DRE::InplaceVector<CommandList*, VKW::CONSTANTS::MAX_SECONDARY_PER_PRIMARY> executedSecondaries_;
 
     DRE_DEBUG_ONLY(bool isOpened_;)
 };
@@ -86,9 +96,12 @@ public:
 
     inline VkQueue          GetHardwareQueue() const { return queue_; }
     inline std::uint32_t    GetQueueFamily() const { return queueFamily_; }
+    inline bool             SupportsGraphics() const { return supportsGraphics_; }
     inline VkSemaphore      GetTimelineSemaphore() const { return timelineSemaphore_; }
 
     CommandList*        GetFreeCommandList();
+    // not begun, the inheritance comes from the recording context
+    CommandList*        GetFreeSecondaryCommandList();
 
     QueueExecutionPoint ScheduleExecute(CommandList* commandList, QueueExecutionPoint const& waitExecutionPoint);
     QueueExecutionPoint ScheduleExecute(CommandList* commandList, std::uint8_t waitPointCount = 0, QueueExecutionPoint const* waitExecutionPoints = nullptr);
@@ -110,6 +123,7 @@ public:
 
 private:
     QueueExecutionPoint ExecuteInternal(CommandList* commandList, std::uint8_t waitPointCount, QueueExecutionPoint const* waitExecutionPoints, std::uint64_t signalValue, PresentationContext* presentationContext);
+    void                ReturnExecutedSecondaries(CommandList* commandList, QueueExecutionPoint const& finishPoint);
 
 private:
     ImportTable* table_;
@@ -118,11 +132,13 @@ private:
     VkQueue queue_;
     std::uint32_t queueFamily_;
     std::uint32_t queueIndex_;
+    bool          supportsGraphics_;
 
     VkSemaphore     timelineSemaphore_;
     std::uint64_t   submitCounter_;
 
     DRE::ObjectPoolQueue<CommandList>        commandListPool_;
+    DRE::ObjectPoolQueue<CommandList>        secondaryCommandListPool_;
 
 
     struct PendingCommandList
@@ -29,6 +29,9 @@ public:
     Queue* GetMainQueue();
     Queue* GetPresentationQueue();
 
+    // nullptr if the device has no compute-only queue family
+    Queue* GetComputeQueue();
+
 private:
     static std::uint32_t FindFamilyIndex(LogicalDevice const* device, DeviceQueueType type, std::uint32_t requiredCount);
 
@@ -37,6 +40,7 @@ private:
     LogicalDevice* device_;
     
     Queue mainQueue_;
+    std::unique_ptr<Queue> computeQueue_; // command lists keep a pointer to their queue, can't be moved in
 };
 
 }
\ No newline at end of file
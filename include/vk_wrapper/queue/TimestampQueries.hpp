@@ -0,0 +1,89 @@
+#pragma once
+
+#include <vulkan\vulkan.h>
+
+#include <foundation\Common.hpp>
+#include <foundation\class_features\NonCopyable.hpp>
+#include <foundation\class_features\NonMovable.hpp>
+#include <foundation\Container\InplaceVector.hpp>
+
+#include <vk_wrapper\Constant.hpp>
+
+namespace VKW
+{
+
+class ImportTable;
+class LogicalDevice;
+class Context;
+
+/*
+*
+* GPU timestamp pairs written by DRE_GPU_SCOPE.
+* One query pool per buffered frame, results of a frame are read when its frame ID comes around again.
+* By then the frame's completion point was already waited on, so reading never stalls.
+*
+*/
+class TimestampQueries
+    : public NonCopyable
+    , public NonMovable
+{
+public:
+    static constexpr std::uint32_t MAX_SCOPES       = 64;
+    static constexpr std::uint32_t INVALID_SCOPE    = DRE_U32_MAX;
+
+    struct ScopeResult
+    {
+        char const*     m_Name;
+        std::uint32_t   m_Depth;
+        float           m_TimeMS;
+    };
+
+    TimestampQueries(ImportTable* table, LogicalDevice* device, std::uint32_t queueFamily);
+    ~TimestampQueries();
+
+    inline bool IsSupported() const { return m_Supported; }
+
+    // call after the frame's completion point was waited on
+    void BeginFrame(Context& context, std::uint8_t frameID);
+    void EndFrame();
+
+    std::uint32_t BeginScope(Context& context, char const* name);
+    void EndScope(Context& context, std::uint32_t scope);
+
+    // scopes of the latest resolved frame, in begin order
+    inline ScopeResult const*   GetResults() const { return m_Results.Data(); }
+    inline std::uint32_t        GetResultsCount() const { return m_Results.Size(); }
+
+    // sum of the top level scopes of the latest resolved frame
+    float GetFrameTimeMS() const;
+
+    bool WriteResults(char const* path) const;
+
+private:
+    void ResolveFrame(std::uint8_t frameID);
+
+private:
+    struct Scope
+    {
+        char const*     m_Name;
+        std::uint32_t   m_Depth;
+        bool            m_Closed;
+    };
+
+    ImportTable*    m_Table;
+    LogicalDevice*  m_Device;
+    bool            m_Supported;
+    float           m_TimestampPeriodNS;
+    std::uint64_t   m_TimestampMask;
+
+    VkQueryPool     m_QueryPools[CONSTANTS::FRAMES_BUFFERING];
+    DRE::InplaceVector<Scope, MAX_SCOPES> m_FrameScopes[CONSTANTS::FRAMES_BUFFERING];
+
+    std::uint8_t    m_CurrentFrameID;
+    bool            m_FrameActive;
+    std::uint32_t   m_Depth;
+
+    DRE::InplaceVector<ScopeResult, MAX_SCOPES> m_Results;
+};
+
+}
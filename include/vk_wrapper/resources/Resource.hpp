@@ -19,6 +19,7 @@ struct BufferResource
     std::uint32_t   size_       = 0;
     MemoryRegion    memory_;
     std::uint64_t   gpuAddress_ = 0;
+    std::uint32_t   stateSlot_  = DRE_U32_MAX;  // GFX::DependencyManager state, assigned on the first barrier
 
     DRE::String128  name_;
 
@@ -44,6 +45,8 @@ struct ImageResource
     std::uint32_t       height_ = 0;
     MemoryRegion        memory_;
     VkImageCreateInfo   createInfo_;
+    bool                placed_ = false;    // memory belongs to a heap, see ResourcesController::CreatePlacedImage
+    std::uint32_t       stateSlot_ = DRE_U32_MAX;   // GFX::DependencyManager state, assigned on the first barrier
 
     DRE::String128      name_;
 
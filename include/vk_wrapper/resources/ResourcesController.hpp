@@ -6,6 +6,7 @@
 #include <vulkan\vulkan.h>
 #include <unordered_set>
 #include <unordered_map>
+#include <vector>
 
 namespace VKW
 {
@@ -52,6 +53,12 @@ public:
     ImageResource* CreateImage(std::uint32_t width, std::uint32_t height, Format format, ImageUsage usage, char const* name);
     void FreeImage(ImageResource* handle);
 
+    // placed images don't own memory, images placed in the same heap may alias, heap outlives all of them
+    VkMemoryRequirements GetImageMemoryRequirements(std::uint32_t width, std::uint32_t height, Format format, ImageUsage usage);
+    MemoryRegion AllocateImageHeap(std::uint64_t size, std::uint64_t alignment, std::uint32_t memoryTypeBits);
+    void FreeImageHeap(MemoryRegion& heap);
+    ImageResource* CreatePlacedImage(std::uint32_t width, std::uint32_t height, Format format, ImageUsage usage, char const* name, MemoryRegion const& heap, std::uint64_t offset);
+
     ImageResourceView* ViewImageAs(
         ImageResource* resource,
         VkImageSubresourceRange const* subresource = nullptr, 
@@ -61,12 +68,19 @@ public:
     );
     void FreeImageView(ImageResourceView* view);
 
+    // state slots of freed resources, the dependency tracking that assigned them takes them back
+    inline std::vector<std::uint32_t>& GetReleasedImageStateSlots() { return releasedImageStateSlots_; }
+    inline std::vector<std::uint32_t>& GetReleasedBufferStateSlots() { return releasedBufferStateSlots_; }
+
     ~ResourcesController();
 
 public:
     static VkImageViewType         ImageTypeToViewType(VkImageType type, std::uint32_t arrayLayers);
     static VkComponentMapping      DefaultComponentMapping();
 
+private:
+    void SetImageDebugName(VkImage image, char const* name);
+
 private:
     ImportTable* table_;
     LogicalDevice* device_;
@@ -77,6 +91,9 @@ private:
     std::unordered_set<ImageResource*> images_;
     std::unordered_multimap<ImageResource*, ImageResourceView*> imageViewMap_;
 
+    std::vector<std::uint32_t> releasedImageStateSlots_;
+    std::vector<std::uint32_t> releasedBufferStateSlots_;
+
 
 };
 
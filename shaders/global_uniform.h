@@ -11,6 +11,7 @@ BEGIN_CONSTANT_BUFFER(GlobalUniforms, g_GlobalUniforms, 2, 0)
     vec4 main_CameraPos_GenericScalar;
     vec4 main_CameraDir;
     vec4 main_Jitter;
+    vec4 main_RenderScale; // xy: part of the render targets the viewport covers, zw: render target size
 
     mat4 main_ViewM;
     mat4 main_iViewM;
@@ -45,6 +46,7 @@ END_CONSTANT_BUFFER(GlobalUniforms, g_GlobalUniforms, 2, 0)
 #ifndef __cplusplus
 
 // Global uniform values
+// scaled main view size, gl_FragCoord / GetViewportSize() is only a uv in passes drawing the main view
 vec2    GetViewportSize() { return g_GlobalUniforms.viewportSize_deltaMS_timeS.xy; }
 float   GetDeltaTime() { return g_GlobalUniforms.viewportSize_deltaMS_timeS.z; }
 float   GetTimeS() { return g_GlobalUniforms.viewportSize_deltaMS_timeS.w; }
@@ -52,6 +54,15 @@ vec3    GetCameraPos() { return g_GlobalUniforms.main_CameraPos_GenericScalar.xy
 float   GetGenericScalar() { return g_GlobalUniforms.main_CameraPos_GenericScalar.w; }
 vec3    GetCameraDir() { return g_GlobalUniforms.main_CameraDir.xyz; }
 vec2    GetJitter() { return g_GlobalUniforms.main_Jitter.xy; }
+vec2    GetRenderScale() { return g_GlobalUniforms.main_RenderScale.xy; }
+vec2    GetRenderTargetSize() { return g_GlobalUniforms.main_RenderScale.zw; }
+
+// viewport uv to uv in the full size render targets, kept half a texel inside the rendered part
+vec2    ViewportToTargetUV(vec2 uv)
+{
+    vec2 half_texel = 0.5 / GetRenderTargetSize();
+    return clamp(uv * GetRenderScale(), half_texel, GetRenderScale() - half_texel);
+}
 
 mat4    GetCameraViewM() { return g_GlobalUniforms.main_ViewM; }
 mat4    GetCameraiViewM() { return g_GlobalUniforms.main_iViewM; }
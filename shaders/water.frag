@@ -80,7 +80,7 @@ float RaymarchWaterDepth(in vec3 wpos, float currentDepth)
 		vec4 test_viewpos = GetCameraViewProjM() * vec4(test_wpos, 1.0);
 		vec3 test_ndc = test_viewpos.xyz / test_viewpos.w;
 		vec2 test_uv = test_ndc.xy * 0.5 + 0.5;
-		float depth_sample = SampleTexture(depthMap, GetSamplerLinearClamp(), test_uv).r;
+		float depth_sample = SampleTexture(depthMap, GetSamplerLinearClamp(), ViewportToTargetUV(test_uv)).r;
 		if(depth_sample < currentDepth)
 		{
 			float delta = (currentDepth - depth_sample); // ndc space
@@ -153,7 +153,7 @@ void main()
 	
 	vec3 specular = WaterSpecular(NdotH, NdotV, NdotL, F0, 0.05);
 	
-	float sampledDepthLinear = LinearizeDepth(SampleTexture(depthMap, GetSamplerLinearClamp(), pixel_pos_uv).r, 0.1, 100);
+	float sampledDepthLinear = LinearizeDepth(SampleTexture(depthMap, GetSamplerLinearClamp(), ViewportToTargetUV(pixel_pos_uv)).r, 0.1, 100);
 	float currentDepthLinear = LinearizeDepth(gl_FragCoord.z, 0.1, 100);
 	float waterEyeDepth = SimpleWaterDepth(currentDepthLinear, sampledDepthLinear);
 	
@@ -161,14 +161,14 @@ void main()
 	vec2 refracted_sample_pos = pixel_pos_uv;
 	refracted_sample_pos += normalMap.xy * 0.1 * clamp(waterEyeDepth * 50, 0.0, 1.5); // normal-based + depth-based
 	
-	float depthSampleRefractedLinear = LinearizeDepth(SampleTexture(depthMap, GetSamplerLinear(), refracted_sample_pos).r, 0.1, 100);
+	float depthSampleRefractedLinear = LinearizeDepth(SampleTexture(depthMap, GetSamplerLinear(), ViewportToTargetUV(refracted_sample_pos)).r, 0.1, 100);
 	if((currentDepthLinear - depthSampleRefractedLinear) > 0 )
 	{
 		refracted_sample_pos = pixel_pos_uv;
 		depthSampleRefractedLinear = sampledDepthLinear;
 	}
 	
-	vec3 worldSampleRefracted = SampleTexture(forwardColorMap, GetSamplerLinear(), refracted_sample_pos).rgb;
+	vec3 worldSampleRefracted = SampleTexture(forwardColorMap, GetSamplerLinear(), ViewportToTargetUV(refracted_sample_pos)).rgb;
 	vec3 worldSample = worldSampleRefracted;
 	
 	float refractedWaterDepth = SimpleWaterDepth(currentDepthLinear, depthSampleRefractedLinear);
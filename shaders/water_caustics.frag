@@ -29,7 +29,8 @@ layout(set = 4, binding = 0, std140) uniform InstanceUniform
 
 void main()
 {
-	vec2 pixel_pos_uv = gl_FragCoord.xy / GetViewportSize();
+	// unscaled target size, the same divisor as before render scale existed
+	vec2 pixel_pos_uv = gl_FragCoord.xy / GetRenderTargetSize();
 	
 	//vec3 normalMap0 = sRGB2Linear(SampleGlobalTextureLinear(NormalTextureID, in_ray_start.xz / 10 + GetTimeS() / 48).rgb);
 	//vec3 normalMap1 = sRGB2Linear(SampleGlobalTextureLinear(NormalTextureID, in_ray_start.zx / 4 + GetTimeS() / 44).rgb);
@@ -93,7 +93,8 @@ void main()
 	
 	vec3 world_norm = vec3(instanceUniform.model_mat * vec4(norm, 0.0));
 	vec3 refracted_light = refract(GetSunLightDir(), world_norm, REF_INDEX);
-	vec2 uv_refract_dir = ((passUniform.light_ViewProjM * vec4(refracted_light, 0.0)).xy) / GetViewportSize();
+	// unscaled target size, render scale must not change the refraction step
+	vec2 uv_refract_dir = ((passUniform.light_ViewProjM * vec4(refracted_light, 0.0)).xy) / GetRenderTargetSize();
 	vec3 ray_pos = env_map_sample.xyz;
 	vec2 sample_uv = uv;
 	for(int i = 0; i < 3; i++)
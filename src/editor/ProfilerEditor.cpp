@@ -0,0 +1,176 @@
+#include <editor\ProfilerEditor.hpp>
+
+#include <foundation\math\SimpleMath.hpp>
+
+#include <editor\RootEditor.hpp>
+
+#include <imgui.h>
+
+namespace EDITOR
+{
+
+ProfilerEditor::ProfilerEditor(BaseEditor* rootEditor, EditorFlags flags)
+    : BaseEditor{ rootEditor, flags }
+    , m_Events{ &DRE::g_MainAllocator }
+    , m_FrameStartTicks{ 0 }
+    , m_FrameEndTicks{ 0 }
+    , m_Paused{ false }
+    , m_ZoneOverheadNS{ 0.0 }
+{}
+
+ProfilerEditor::ProfilerEditor(ProfilerEditor&& rhs)
+    : BaseEditor{ DRE_MOVE(rhs) }
+    , m_FrameStartTicks{ 0 }
+    , m_FrameEndTicks{ 0 }
+    , m_Paused{ false }
+    , m_ZoneOverheadNS{ 0.0 }
+{
+    operator=(DRE_MOVE(rhs));
+}
+
+ProfilerEditor& ProfilerEditor::operator=(ProfilerEditor&& rhs)
+{
+    BaseEditor::operator=(DRE_MOVE(rhs));
+
+    DRE_SWAP_MEMBER(m_Events);
+    DRE_SWAP_MEMBER(m_FrameStartTicks);
+    DRE_SWAP_MEMBER(m_FrameEndTicks);
+    DRE_SWAP_MEMBER(m_Paused);
+    DRE_SWAP_MEMBER(m_ZoneOverheadNS);
+
+    return *this;
+}
+
+void ProfilerEditor::CaptureLastFrame()
+{
+    DRE::U64 startTicks = 0;
+    DRE::U64 endTicks = 0;
+    if (!DRE::Profiler::GetFrameRange(0, startTicks, endTicks))
+        return;
+
+    m_FrameStartTicks = startTicks;
+    m_FrameEndTicks = endTicks;
+    m_Events.Clear();
+
+    for (DRE::U32 i = 0, size = DRE::Profiler::GetThreadsCount(); i < size; i++)
+    {
+        DRE::Profiler::ForEachEvent(*DRE::Profiler::GetThread(i), startTicks, endTicks, [this, i](DRE::Profiler::Event const& event)
+            {
+                m_Events.EmplaceBack(CapturedEvent{ event, i });
+            });
+    }
+}
+
+void ProfilerEditor::RenderFlameView()
+{
+    float constexpr rowHeight = 18.0f;
+    float constexpr threadGap = 8.0f;
+
+    ImDrawList* drawList = ImGui::GetWindowDrawList();
+    ImVec2 const origin = ImGui::GetCursorScreenPos();
+    float const width = DRE::Max(ImGui::GetContentRegionAvail().x, 1.0f);
+    double const frameTicks = static_cast<double>(m_FrameEndTicks - m_FrameStartTicks);
+
+    float y = origin.y;
+    for (DRE::U32 thread = 0, threadsCount = DRE::Profiler::GetThreadsCount(); thread < threadsCount; thread++)
+    {
+        DRE::U32 maxDepth = 0;
+        bool hasEvents = false;
+        for (DRE::U32 i = 0, size = m_Events.Size(); i < size; i++)
+        {
+            if (m_Events[i].m_ThreadIndex != thread)
+                continue;
+
+            hasEvents = true;
+            maxDepth = DRE::Max(maxDepth, m_Events[i].m_Event.m_Depth);
+        }
+
+        if (!hasEvents)
+            continue;
+
+        drawList->AddText(ImVec2{ origin.x, y }, IM_COL32(200, 200, 200, 255), DRE::Profiler::GetThread(thread)->m_Name);
+        y += rowHeight;
+
+        for (DRE::U32 i = 0, size = m_Events.Size(); i < size; i++)
+        {
+            if (m_Events[i].m_ThreadIndex != thread)
+                continue;
+
+            DRE::Profiler::Event const& event = m_Events[i].m_Event;
+            DRE::U64 const startTicks = DRE::Max(event.m_StartTicks, m_FrameStartTicks);
+
+            float const x0 = origin.x + static_cast<float>(static_cast<double>(startTicks - m_FrameStartTicks) / frameTicks * width);
+            float const x1 = DRE::Max(origin.x + static_cast<float>(static_cast<double>(event.m_EndTicks - m_FrameStartTicks) / frameTicks * width), x0 + 1.0f);
+            float const y0 = y + event.m_Depth * rowHeight;
+
+            // same zone, same color across frames
+            float const hue = static_cast<float>((reinterpret_cast<DRE::UPtr>(event.m_Name) * 2654435761u) % 360) / 360.0f;
+            ImVec2 const min{ x0, y0 };
+            ImVec2 const max{ x1, y0 + rowHeight - 1.0f };
+
+            drawList->AddRectFilled(min, max, ImColor::HSV(hue, 0.5f, 0.7f));
+            drawList->PushClipRect(min, max, true);
+            drawList->AddText(ImVec2{ x0 + 2.0f, y0 + 1.0f }, IM_COL32(0, 0, 0, 255), event.m_Name);
+            drawList->PopClipRect();
+
+            if (ImGui::IsMouseHoveringRect(min, max))
+            {
+                ImGui::SetTooltip("%s: %.3f ms", event.m_Name, DRE::Profiler::TicksToMicroseconds(event.m_EndTicks - event.m_StartTicks) / 1000.0);
+            }
+        }
+
+        y += (maxDepth + 1) * rowHeight + threadGap;
+    }
+
+    ImGui::Dummy(ImVec2{ width, y - origin.y });
+}
+
+void ProfilerEditor::Render()
+{
+    ImGui::SetNextWindowSize(ImVec2(900, 400), ImGuiCond_FirstUseEver);
+
+    bool isOpen = true;
+    if (ImGui::Begin("Profiler", &isOpen))
+    {
+#if !defined(DRE_PROFILER_ENABLED)
+        ImGui::Text("CPU zones are compiled out, configure with DRE_PROFILER=ON.");
+#endif
+        ImGui::Checkbox("Pause", &m_Paused);
+        ImGui::SameLine();
+        if (ImGui::Button("Save Chrome trace"))
+        {
+            DRE::Profiler::WriteChromeTrace("profile_trace.json");
+        }
+        ImGui::SameLine();
+        if (ImGui::Button("Measure zone overhead"))
+        {
+            m_ZoneOverheadNS = DRE::Profiler::MeasureZoneOverheadNS();
+        }
+        ImGui::SameLine();
+        ImGui::Text("Zone overhead: %.1f ns", m_ZoneOverheadNS);
+
+        if (!m_Paused)
+        {
+            CaptureLastFrame();
+        }
+
+        ImGui::Text("Frame: %.3f ms, %u zones", DRE::Profiler::TicksToMicroseconds(m_FrameEndTicks - m_FrameStartTicks) / 1000.0, m_Events.Size());
+
+        if (m_FrameEndTicks > m_FrameStartTicks)
+        {
+            if (ImGui::BeginChild("flame_view", ImVec2(0, 0), ImGuiChildFlags_Border))
+            {
+                RenderFlameView();
+            }
+            ImGui::EndChild();
+        }
+    }
+    ImGui::End();
+
+    if (!isOpen)
+    {
+        Close();
+    }
+}
+
+}
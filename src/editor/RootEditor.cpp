@@ -4,8 +4,10 @@
 #include <engine\scene\Camera.hpp>
 #include <engine\scene\Scene.hpp>
 #include <editor\CameraEditor.hpp>
+#include <editor\ProfilerEditor.hpp>
 #include <editor\SceneGraphEditor.hpp>
 #include <editor\StatsEditor.hpp>
+#include <editor\SyntheticSceneEditor.hpp>
 #include <editor\TextureInspector.hpp>
 
 #include <gfx\GraphicsManager.hpp>
@@ -15,9 +17,10 @@
 namespace EDITOR
 {
 
-RootEditor::RootEditor(WORLD::Scene* mainScene)
+RootEditor::RootEditor(WORLD::Scene* mainScene, WORLD::SyntheticSceneGenerator* syntheticSceneGenerator)
     : BaseEditor{ nullptr, EDITOR_FLAGS_STATIC }
     , m_MainScene{ mainScene }
+    , m_SyntheticSceneGenerator{ syntheticSceneGenerator }
     , m_Editors{ &DRE::g_MainAllocator }
     , m_CloseQueue{ &DRE::g_MainAllocator }
 {}
@@ -25,6 +28,7 @@ RootEditor::RootEditor(WORLD::Scene* mainScene)
 RootEditor::RootEditor(RootEditor&& rhs)
     : BaseEditor{ DRE_MOVE(rhs) }
     , m_MainScene{ nullptr }
+    , m_SyntheticSceneGenerator{ nullptr }
 {
     operator=(DRE_MOVE(rhs));
 }
@@ -34,6 +38,7 @@ RootEditor& RootEditor::operator=(RootEditor&& rhs)
     BaseEditor::operator=(DRE_MOVE(rhs));
 
     DRE_SWAP_MEMBER(m_MainScene);
+    DRE_SWAP_MEMBER(m_SyntheticSceneGenerator);
     DRE_SWAP_MEMBER(m_Editors);
     DRE_SWAP_MEMBER(m_CloseQueue);
 
@@ -75,6 +80,15 @@ void RootEditor::Render()
             }
         }
 
+        if (ImGui::MenuItem("Profiler"))
+        {
+            if (GetEditorByType(BaseEditor::Type::Profiler) == nullptr)
+            {
+                ProfilerEditor* profilerEditor = DRE::g_MainAllocator.Alloc<ProfilerEditor>(this, EDITOR_FLAGS_NONE);
+                m_Editors.EmplaceBack(profilerEditor);
+            }
+        }
+
         if (ImGui::MenuItem("Texture Inspector"))
         {
             if (GetEditorByType(BaseEditor::Type::TextureInspector) == nullptr)
@@ -104,6 +118,15 @@ void RootEditor::Render()
                 }
             }
 
+            if (ImGui::MenuItem("Synthetic Scene"))
+            {
+                if (GetEditorByType(BaseEditor::Type::SyntheticScene) == nullptr)
+                {
+                    SyntheticSceneEditor* syntheticEditor = DRE::g_MainAllocator.Alloc<SyntheticSceneEditor>(this, EDITOR_FLAGS_NONE, m_MainScene, m_SyntheticSceneGenerator);
+                    m_Editors.EmplaceBack(syntheticEditor);
+                }
+            }
+
             ImGui::EndMenu();
         }
 
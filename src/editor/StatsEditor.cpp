@@ -2,7 +2,10 @@
 
 #include <editor\RootEditor.hpp>
 #include <foundation\Common.hpp>
+#include <foundation\system\FrameStats.hpp>
 #include <engine\ApplicationContext.hpp>
+#include <gfx\GraphicsManager.hpp>
+#include <vk_wrapper\queue\TimestampQueries.hpp>
 
 #include <imgui.h>
 
@@ -11,6 +14,7 @@ namespace EDITOR
 
 StatsEditor::StatsEditor(BaseEditor* rootEditor, EditorFlags flags)
     : BaseEditor{ rootEditor, flags }
+    , m_WindowSize{ 300 }
 {}
 
 StatsEditor::StatsEditor(StatsEditor&& rhs)
@@ -23,6 +27,8 @@ StatsEditor& StatsEditor::operator=(StatsEditor&& rhs)
 {
     BaseEditor::operator=(DRE_MOVE(rhs));
 
+    DRE_SWAP_MEMBER(m_WindowSize);
+
     return *this;
 }
 
@@ -34,6 +40,40 @@ void StatsEditor::Render()
         ImGui::Text("DT: %f ms", static_cast<double>(DRE::g_AppContext.m_DeltaTimeUS) / 1000);
         ImGui::Text("FPS: %f", 1.0 / (static_cast<double>(DRE::g_AppContext.m_DeltaTimeUS) / 1000000));
         ImGui::Text("Global T(s): %f", static_cast<double>(DRE::g_AppContext.m_TimeSinceStartUS) / 1000000);
+        ImGui::Text("Time to first frame: %f ms", static_cast<double>(DRE::g_AppContext.m_TimeToFirstFrameUS) / 1000);
+
+        RenderFrameStats();
+        RenderPassCounters();
+
+        VKW::TimestampQueries const& timestamps = GFX::g_GraphicsManager->GetTimestampQueries();
+        if (!timestamps.IsSupported())
+        {
+            ImGui::Text("GPU timestamps are not supported by the main queue.");
+        }
+        else if (ImGui::CollapsingHeader("GPU passes", ImGuiTreeNodeFlags_DefaultOpen))
+        {
+            VKW::TimestampQueries::ScopeResult const* results = timestamps.GetResults();
+            for (std::uint32_t i = 0, size = timestamps.GetResultsCount(); i < size; i++)
+            {
+                ImGui::Text("%*s%s: %.3f ms", results[i].m_Depth * 2, "", results[i].m_Name, results[i].m_TimeMS);
+            }
+
+            if (ImGui::Button("Dump GPU timings"))
+                timestamps.WriteResults("gpu_timings.csv");
+        }
+
+        VKW::TimestampQueries const* asyncTimestamps = GFX::g_GraphicsManager->GetAsyncTimestampQueries();
+        if (asyncTimestamps != nullptr && asyncTimestamps->IsSupported() && ImGui::CollapsingHeader("GPU async compute passes", ImGuiTreeNodeFlags_DefaultOpen))
+        {
+            VKW::TimestampQueries::ScopeResult const* results = asyncTimestamps->GetResults();
+            for (std::uint32_t i = 0, size = asyncTimestamps->GetResultsCount(); i < size; i++)
+            {
+                ImGui::Text("%*s%s: %.3f ms", results[i].m_Depth * 2, "", results[i].m_Name, results[i].m_TimeMS);
+            }
+
+            if (ImGui::Button("Dump GPU async timings"))
+                asyncTimestamps->WriteResults("gpu_async_timings.csv");
+        }
     }
     ImGui::End();
 
@@ -43,4 +83,116 @@ void StatsEditor::Render()
     }
 }
 
-}
\ No newline at end of file
+void StatsEditor::RenderFrameStats()
+{
+    if (!ImGui::CollapsingHeader("Frame times", ImGuiTreeNodeFlags_DefaultOpen))
+        return;
+
+    DRE::FrameStats& stats = DRE::g_FrameStats;
+
+    ImGui::SliderInt("Window (frames)", &m_WindowSize, 10, static_cast<int>(DRE::FrameStats::MAX_SAMPLES));
+
+    float threshold = stats.GetHitchThresholdMS();
+    if (ImGui::SliderFloat("Hitch threshold (ms)", &threshold, 5.0f, 200.0f))
+        stats.SetHitchThresholdMS(threshold);
+
+    DRE::FrameStats::Summary const summary = stats.ComputeSummary(static_cast<DRE::U32>(m_WindowSize));
+    if (ImGui::BeginTable("frame_percentiles", 5, ImGuiTableFlags_Borders))
+    {
+        ImGui::TableSetupColumn("ms");
+        ImGui::TableSetupColumn("p50");
+        ImGui::TableSetupColumn("p95");
+        ImGui::TableSetupColumn("p99");
+        ImGui::TableSetupColumn("max");
+        ImGui::TableHeadersRow();
+
+        auto row = [](char const* name, DRE::FrameStats::Percentiles const& percentiles)
+        {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn(); ImGui::TextUnformatted(name);
+            ImGui::TableNextColumn(); ImGui::Text("%.2f", percentiles.m_P50);
+            ImGui::TableNextColumn(); ImGui::Text("%.2f", percentiles.m_P95);
+            ImGui::TableNextColumn(); ImGui::Text("%.2f", percentiles.m_P99);
+            ImGui::TableNextColumn(); ImGui::Text("%.2f", percentiles.m_Max);
+        };
+        row("Frame", summary.m_Frame);
+        row("CPU", summary.m_CPU);
+        row("GPU", summary.m_GPU);
+        row("Present wait", summary.m_PresentWait);
+
+        ImGui::EndTable();
+    }
+
+    // oldest first, left to right
+    float frameTimes[DRE::FrameStats::MAX_SAMPLES];
+    for (DRE::U32 i = 0; i < summary.m_SamplesCount; i++)
+    {
+        DRE::FrameStats::Sample const& sample = stats.GetSample(summary.m_SamplesCount - 1 - i);
+        frameTimes[i] = sample.m_CPUMS + sample.m_PresentWaitMS;
+    }
+    ImGui::PlotHistogram("##frame_times", frameTimes, static_cast<int>(summary.m_SamplesCount), 0, nullptr, 0.0f, summary.m_Frame.m_Max, ImVec2{ 0.0f, 80.0f });
+
+    if (ImGui::Button("Export CSV"))
+        stats.WriteCSV("frame_stats.csv");
+
+    if (ImGui::TreeNode("Hitches", "Hitches (%u)", stats.GetHitchesCount()))
+    {
+        for (DRE::U32 i = 0, size = stats.GetHitchesCount(); i < size; i++)
+        {
+            DRE::FrameStats::Hitch const& hitch = stats.GetHitch(i);
+            ImGui::Text("frame %llu: %.2f ms", static_cast<unsigned long long>(hitch.m_Frame), hitch.m_FrameMS);
+            for (DRE::U32 j = 0; j < hitch.m_ZonesCount; j++)
+            {
+                ImGui::Text("    %s: %.2f ms", hitch.m_Zones[j].m_Name, hitch.m_Zones[j].m_SelfMS);
+            }
+        }
+        ImGui::TreePop();
+    }
+}
+
+void StatsEditor::RenderPassCounters()
+{
+    if (!ImGui::CollapsingHeader("Render counters", ImGuiTreeNodeFlags_DefaultOpen))
+        return;
+
+    GFX::RenderGraph const& graph = GFX::g_GraphicsManager->GetMainRenderGraph();
+
+    if (ImGui::BeginTable("render_counters", 8, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg))
+    {
+        ImGui::TableSetupColumn("Pass");
+        ImGui::TableSetupColumn("Draws");
+        ImGui::TableSetupColumn("Dispatches");
+        ImGui::TableSetupColumn("Pipelines");
+        ImGui::TableSetupColumn("Set writes");
+        ImGui::TableSetupColumn("Barriers");
+        ImGui::TableSetupColumn("Uniform KB");
+        ImGui::TableSetupColumn("Upload KB");
+        ImGui::TableHeadersRow();
+
+        auto row = [](char const* name, GFX::RenderCounters const& counters)
+        {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn(); ImGui::TextUnformatted(name);
+            ImGui::TableNextColumn(); ImGui::Text("%llu", static_cast<unsigned long long>(counters.m_Draws));
+            ImGui::TableNextColumn(); ImGui::Text("%llu", static_cast<unsigned long long>(counters.m_Dispatches));
+            ImGui::TableNextColumn(); ImGui::Text("%llu", static_cast<unsigned long long>(counters.m_PipelineBinds));
+            ImGui::TableNextColumn(); ImGui::Text("%llu", static_cast<unsigned long long>(counters.m_DescriptorWrites));
+            ImGui::TableNextColumn(); ImGui::Text("%llu (%llu)", static_cast<unsigned long long>(counters.m_Barriers), static_cast<unsigned long long>(counters.m_BarrierBatches));
+            ImGui::TableNextColumn(); ImGui::Text("%.1f", static_cast<double>(counters.m_UniformBytes) / 1024);
+            ImGui::TableNextColumn(); ImGui::Text("%.1f", static_cast<double>(counters.m_UploadBytes) / 1024);
+        };
+
+        for (std::uint32_t i = 0, size = graph.GetPassesCount(); i < size; i++)
+        {
+            row(GFX::PassIDToString(graph.GetPassID(i)), graph.GetPassCounters(i));
+        }
+
+        row("Frame", GFX::g_GraphicsManager->GetFrameCounters());
+
+        ImGui::EndTable();
+    }
+
+    ImGui::Text("Flushes: %llu, barriers are shown as total (batches)", static_cast<unsigned long long>(GFX::g_GraphicsManager->GetFrameCounters().m_Flushes));
+}
+
+}
@@ -0,0 +1,72 @@
+#include <editor\SyntheticSceneEditor.hpp>
+
+#include <foundation\Common.hpp>
+#include <engine\scene\Scene.hpp>
+
+#include <gfx\GraphicsManager.hpp>
+
+#include <imgui.h>
+
+namespace EDITOR
+{
+
+SyntheticSceneEditor::SyntheticSceneEditor(BaseEditor* rootEditor, EditorFlags flags, WORLD::Scene* scene, WORLD::SyntheticSceneGenerator* generator)
+    : BaseEditor{ rootEditor, flags }
+    , m_Scene{ scene }
+    , m_Generator{ generator }
+    , m_Desc{}
+{}
+
+SyntheticSceneEditor::SyntheticSceneEditor(SyntheticSceneEditor&& rhs)
+    : BaseEditor{ DRE_MOVE(rhs) }
+    , m_Scene{ nullptr }
+    , m_Generator{ nullptr }
+    , m_Desc{}
+{
+    operator=(DRE_MOVE(rhs));
+}
+
+SyntheticSceneEditor& SyntheticSceneEditor::operator=(SyntheticSceneEditor&& rhs)
+{
+    BaseEditor::operator=(DRE_MOVE(rhs));
+
+    DRE_SWAP_MEMBER(m_Scene);
+    DRE_SWAP_MEMBER(m_Generator);
+    DRE_SWAP_MEMBER(m_Desc);
+
+    return *this;
+}
+
+void SyntheticSceneEditor::Render()
+{
+    bool isOpen = true;
+    if (ImGui::Begin("Synthetic Scene", &isOpen))
+    {
+        int const stepSlow = 1;
+        int const stepFast = 64;
+
+        ImGui::InputScalar("Objects", ImGuiDataType_U32, &m_Desc.m_ObjectsCount, &stepSlow, &stepFast);
+        ImGui::InputScalar("Meshes", ImGuiDataType_U32, &m_Desc.m_MeshesCount, &stepSlow, &stepFast);
+        ImGui::InputScalar("Materials", ImGuiDataType_U32, &m_Desc.m_MaterialsCount, &stepSlow, &stepFast);
+        ImGui::InputScalar("Lights", ImGuiDataType_U32, &m_Desc.m_LightsCount, &stepSlow, &stepFast);
+        ImGui::InputScalar("Hierarchy depth", ImGuiDataType_U32, &m_Desc.m_HierarchyDepth, &stepSlow);
+        ImGui::InputScalar("Fan-out", ImGuiDataType_U32, &m_Desc.m_FanOut, &stepSlow);
+        ImGui::SliderFloat("Spacing", &m_Desc.m_Spacing, 0.5f, 10.0f);
+        ImGui::InputScalar("Seed", ImGuiDataType_U32, &m_Desc.m_Seed, &stepSlow);
+
+        // adds on top of what's already in the scene, nothing gets removed
+        if (ImGui::Button("Generate"))
+        {
+            m_Generator->Generate(m_Desc, *m_Scene, GFX::g_GraphicsManager->GetMainContext());
+        }
+    }
+
+    ImGui::End();
+
+    if (!isOpen)
+    {
+        Close();
+    }
+}
+
+}
@@ -80,7 +80,7 @@ void TextureInspector::Render()
             {
                 m_GraphResources->ForEachTexture([&TextureInList](auto& texture)
                 {
-                    TextureInList(texture.value->texture);
+                    TextureInList(texture.texture);
                 });
             }
 
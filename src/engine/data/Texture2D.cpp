@@ -60,6 +60,15 @@ void Texture2D::ReadFromFile(char const* filePath, TextureChannelVariations chan
     stbi_image_free(stbiData);
 }
 
+void Texture2D::InitFromMemory(char const* name, std::uint32_t width, std::uint32_t height, VKW::Format format, DRE::ByteBuffer&& data)
+{
+    name_ = name;
+    format_ = format;
+    textureData_ = DRE_MOVE(data);
+    width_ = width;
+    height_ = height;
+}
+
 VKW::Format Texture2D::GetFormat() const
 {
     return format_;
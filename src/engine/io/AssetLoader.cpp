@@ -0,0 +1,322 @@
+#include <engine\io\AssetLoader.hpp>
+
+#include <atomic>
+#include <vector>
+
+#include <foundation\math\SimpleMath.hpp>
+#include <foundation\memory\Memory.hpp>
+#include <foundation\system\Log.hpp>
+#include <foundation\system\Profiler.hpp>
+#include <foundation\system\Time.hpp>
+
+#include <assimp\Importer.hpp>
+#include <assimp\postprocess.h>
+#include <assimp\scene.h>
+
+#include <engine\io\IOManager.hpp>
+#include <engine\scene\Scene.hpp>
+
+namespace IO
+{
+
+struct AssetLoader::Request
+{
+    enum Type
+    {
+        TYPE_TEXTURE,
+        TYPE_MODEL
+    };
+
+    AssetRequestID                              m_ID = INVALID_ASSET_REQUEST;
+    Type                                        m_Type = TYPE_TEXTURE;
+    DRE::TaskPriority                           m_Priority = DRE::TASK_PRIORITY_NORMAL;
+    DRE::String256                              m_Path;
+
+    std::atomic_bool                            m_Cancelled{ false };
+    std::atomic<std::uint32_t>                  m_PendingJobs{ 1 };
+
+    // decoded textures are stored in m_Prepared.m_Textures
+    std::vector<DRE::String256>                 m_TexturePaths;
+    std::vector<Data::TextureChannelVariations> m_TextureChannels;
+
+    Assimp::Importer                            m_Importer;
+    aiScene const*                              m_Scene = nullptr;
+    WORLD::Scene*                               m_TargetScene = nullptr;
+    DRE::String32                               m_DefaultShader;
+    glm::mat4                                   m_BaseTransform = glm::identity<glm::mat4>();
+    Data::TextureChannelVariations              m_MetalnessRoughnessOverride = Data::TEXTURE_VARIATION_INVALID;
+    IOManager::PreparedModel                    m_Prepared;
+    IOManager::ModelInstantiation               m_Instantiation;
+
+    TextureCallback                             m_TextureCallback;
+    ModelCallback                               m_ModelCallback;
+};
+
+AssetLoader::AssetLoader(IOManager* ioManager, std::uint32_t workerCount)
+    : m_IOManager{ ioManager }
+    , m_ThreadPool{ workerCount }
+    , m_NextRequestID{ 0 }
+    , m_ActiveInstantiation{ nullptr }
+    , m_MaxPumpTimeUS{ 0 }
+    , m_OverBudgetPumpsCount{ 0 }
+{
+}
+
+AssetLoader::~AssetLoader()
+{
+    for (std::uint32_t i = 0, size = m_InFlightRequests.Size(); i < size; i++)
+    {
+        m_InFlightRequests[i]->m_Cancelled.store(true, std::memory_order_relaxed);
+    }
+
+    m_ThreadPool.WaitIdle();
+
+    for (std::uint32_t i = 0, size = m_InFlightRequests.Size(); i < size; i++)
+    {
+        DRE::g_MainAllocator.FreeObject(m_InFlightRequests[i]);
+    }
+    m_InFlightRequests.Clear();
+    m_CompletedRequests.Clear();
+    m_ActiveInstantiation = nullptr;
+}
+
+AssetLoader::Request* AssetLoader::CreateRequest(char const* path, DRE::TaskPriority priority)
+{
+    DRE_ASSERT(m_InFlightRequests.Size() < MAX_REQUESTS, "Too many asset requests in flight.");
+
+    Request* request = DRE::g_MainAllocator.Alloc<Request>();
+    request->m_ID = m_NextRequestID++;
+    request->m_Priority = priority;
+    request->m_Path = path;
+
+    m_InFlightRequests.EmplaceBack(request);
+
+    return request;
+}
+
+void AssetLoader::ReleaseRequest(Request* request)
+{
+    m_InFlightRequests.RemoveValue(request);
+    DRE::g_MainAllocator.FreeObject(request);
+}
+
+AssetRequestID AssetLoader::RequestTexture2D(char const* path, Data::TextureChannelVariations channels, DRE::TaskPriority priority, TextureCallback&& callback)
+{
+    Request* request = CreateRequest(path, priority);
+    request->m_Type = Request::TYPE_TEXTURE;
+    request->m_TextureCallback = DRE_MOVE(callback);
+    request->m_TexturePaths.emplace_back(path);
+    request->m_TextureChannels.emplace_back(channels);
+    request->m_Prepared.m_Textures.resize(1);
+
+    m_ThreadPool.Submit([this, request]() { ExecuteTextureDecode(request, 0); }, priority);
+
+    return request->m_ID;
+}
+
+AssetRequestID AssetLoader::RequestModel(char const* path, WORLD::Scene& targetScene, char const* defaultShader, DRE::TaskPriority priority, ModelCallback&& callback,
+    glm::mat4 baseTransform, Data::TextureChannelVariations metalnessRoughnessOverride)
+{
+    Request* request = CreateRequest(path, priority);
+    request->m_Type = Request::TYPE_MODEL;
+    request->m_ModelCallback = DRE_MOVE(callback);
+    request->m_TargetScene = &targetScene;
+    request->m_DefaultShader = defaultShader;
+    request->m_BaseTransform = baseTransform;
+    request->m_MetalnessRoughnessOverride = metalnessRoughnessOverride;
+
+    m_ThreadPool.Submit([this, request]() { ExecuteModelImport(request); }, priority);
+
+    return request->m_ID;
+}
+
+void AssetLoader::Cancel(AssetRequestID id)
+{
+    std::uint32_t const index = m_InFlightRequests.FindIf([id](Request* request) { return request->m_ID == id; });
+    if (index == m_InFlightRequests.Size())
+        return;
+
+    m_InFlightRequests[index]->m_Cancelled.store(true, std::memory_order_relaxed);
+}
+
+void AssetLoader::ExecuteTextureDecode(Request* request, std::uint32_t textureIndex)
+{
+    DRE_CPU_SCOPE(AssetLoader_TextureDecode);
+
+    if (!request->m_Cancelled.load(std::memory_order_relaxed))
+    {
+        request->m_Prepared.m_Textures[textureIndex].ReadFromFile(request->m_TexturePaths[textureIndex].GetData(), request->m_TextureChannels[textureIndex]);
+    }
+
+    FinishJob(request);
+}
+
+void AssetLoader::ExecuteModelImport(Request* request)
+{
+    DRE_CPU_SCOPE(AssetLoader_ModelImport);
+
+    if (!request->m_Cancelled.load(std::memory_order_relaxed))
+    {
+        request->m_Scene = request->m_Importer.ReadFile(request->m_Path.GetData(), aiProcessPreset_TargetRealtime_Fast | aiProcess_FlipUVs);
+    }
+
+    aiScene const* scene = request->m_Scene;
+    if (scene != nullptr)
+    {
+        IOManager::PreparedModel& prepared = request->m_Prepared;
+
+        prepared.m_Geometries.reserve(scene->mNumMeshes);
+        for (std::uint32_t i = 0, size = scene->mNumMeshes; i < size; i++)
+        {
+            prepared.m_Geometries.emplace_back(IOManager::ConvertAssimpMesh(scene->mMeshes[i]));
+        }
+
+        std::uint32_t const textureSlotsCount = scene->mNumMaterials * Data::Material::TextureProperty::MAX;
+        prepared.m_Textures.resize(textureSlotsCount);
+        request->m_TexturePaths.resize(textureSlotsCount);
+        request->m_TextureChannels.resize(textureSlotsCount, Data::TEXTURE_VARIATION_INVALID);
+
+        DRE::String256 const assetFolderPath = IOManager::GetAssetFolderPath(request->m_Path.GetData());
+        for (std::uint32_t i = 0, size = scene->mNumMaterials; i < size; i++)
+        {
+            for (std::uint32_t slot = 0; slot < Data::Material::TextureProperty::MAX; slot++)
+            {
+                Data::Material::TextureProperty::Slot const slotID = Data::Material::TextureProperty::Slot(slot);
+                std::uint32_t const textureIndex = i * Data::Material::TextureProperty::MAX + slot;
+
+                Data::TextureChannelVariations const channels = IOManager::GetMaterialSlotChannels(slotID, request->m_MetalnessRoughnessOverride);
+                if (channels == Data::TEXTURE_VARIATION_INVALID)
+                    continue;
+
+                if (IOManager::FindMaterialTexturePath(scene, scene->mMaterials[i], assetFolderPath, slotID, request->m_TexturePaths[textureIndex]))
+                {
+                    request->m_TextureChannels[textureIndex] = channels;
+                }
+            }
+        }
+
+        // decode textures in parallel, last finished job sends request to completion
+        for (std::uint32_t i = 0; i < textureSlotsCount; i++)
+        {
+            if (request->m_TextureChannels[i] == Data::TEXTURE_VARIATION_INVALID)
+                continue;
+
+            request->m_PendingJobs.fetch_add(1, std::memory_order_relaxed);
+            m_ThreadPool.Submit([this, request, i]() { ExecuteTextureDecode(request, i); }, request->m_Priority);
+        }
+    }
+
+    FinishJob(request);
+}
+
+void AssetLoader::FinishJob(Request* request)
+{
+    if (request->m_PendingJobs.fetch_sub(1, std::memory_order_acq_rel) != 1)
+        return;
+
+    std::lock_guard<std::mutex> lock{ m_CompletedMutex };
+    m_CompletedRequests.EmplaceBack(request);
+}
+
+bool AssetLoader::FinalizeRequest(Request* request)
+{
+    if (request->m_Cancelled.load(std::memory_order_relaxed))
+        return true;
+
+    switch (request->m_Type)
+    {
+    case Request::TYPE_TEXTURE:
+        if (request->m_TextureCallback)
+            request->m_TextureCallback(DRE_MOVE(request->m_Prepared.m_Textures[0]));
+        return true;
+
+    case Request::TYPE_MODEL:
+        if (request->m_Scene != nullptr)
+        {
+            m_IOManager->BeginModelInstantiation(request->m_Instantiation, request->m_Path.GetData(), request->m_Scene, *request->m_TargetScene,
+                request->m_DefaultShader.GetData(), request->m_BaseTransform, request->m_MetalnessRoughnessOverride, &request->m_Prepared);
+            return false;
+        }
+
+        DRE_LOG_ERROR("AssetLoader: failed to load a model file %s", request->m_Path.GetData());
+        if (request->m_ModelCallback)
+            request->m_ModelCallback(nullptr);
+        return true;
+
+    default:
+        DRE_ASSERT(false, "Invalid asset request type.");
+        return true;
+    }
+}
+
+void AssetLoader::PumpCompletions(std::uint64_t budgetUS)
+{
+    DRE_CPU_SCOPE(AssetLoader_PumpCompletions);
+
+    DRE::Stopwatch stopwatch;
+
+    while (stopwatch.CurrentMicroseconds() < budgetUS)
+    {
+        // models are instantiated in slices, one at a time. Cancelling doesn't interrupt an instantiation that already started
+        if (m_ActiveInstantiation != nullptr)
+        {
+            Request* request = m_ActiveInstantiation;
+            if (!m_IOManager->InstantiateModelStep(request->m_Instantiation, stopwatch, budgetUS))
+                break;
+
+            if (request->m_ModelCallback && !request->m_Cancelled.load(std::memory_order_relaxed))
+                request->m_ModelCallback(request->m_Instantiation.m_RootNode);
+
+            m_ActiveInstantiation = nullptr;
+            ReleaseRequest(request);
+            continue;
+        }
+
+        Request* request = nullptr;
+        {
+            std::lock_guard<std::mutex> lock{ m_CompletedMutex };
+            if (m_CompletedRequests.Size() == 0)
+                break;
+
+            // highest priority first, completion order within a priority
+            std::uint32_t next = 0;
+            for (std::uint32_t i = 1, size = m_CompletedRequests.Size(); i < size; i++)
+            {
+                if (m_CompletedRequests[i]->m_Priority < m_CompletedRequests[next]->m_Priority)
+                    next = i;
+            }
+
+            request = m_CompletedRequests[next];
+            for (std::uint32_t i = next + 1, size = m_CompletedRequests.Size(); i < size; i++)
+            {
+                m_CompletedRequests[i - 1] = m_CompletedRequests[i];
+            }
+            m_CompletedRequests.RemoveIndex(m_CompletedRequests.Size() - 1);
+        }
+
+        if (FinalizeRequest(request))
+        {
+            ReleaseRequest(request);
+        }
+        else
+        {
+            m_ActiveInstantiation = request;
+        }
+    }
+
+    std::uint64_t const pumpTimeUS = stopwatch.CurrentMicroseconds();
+    m_MaxPumpTimeUS = DRE::Max(m_MaxPumpTimeUS, pumpTimeUS);
+    if (pumpTimeUS > budgetUS)
+        m_OverBudgetPumpsCount++;
+}
+
+void AssetLoader::WaitAll()
+{
+    while (m_InFlightRequests.Size() > 0)
+    {
+        m_ThreadPool.WaitIdle();
+        PumpCompletions();
+    }
+}
+
+}
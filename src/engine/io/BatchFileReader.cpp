@@ -0,0 +1,496 @@
+#include <engine\io\BatchFileReader.hpp>
+
+#include <foundation\system\Log.hpp>
+
+#include <fstream>
+#include <latch>
+
+#ifdef __linux__
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#endif
+
+namespace IO
+{
+
+BatchFileReader::BatchFileReader(DRE::ThreadPool* fallbackPool)
+    : m_FallbackPool{ fallbackPool }
+{
+}
+
+void BatchFileReader::ReadBatch(ReadRequest* requests, std::uint32_t count)
+{
+    if (count == 0)
+        return;
+
+#if defined(_WIN32) || defined(__linux__)
+    ReadBatchNative(requests, count);
+#else
+    ReadBatchFallback(requests, count);
+#endif
+}
+
+void BatchFileReader::ReadBatchFallback(ReadRequest* requests, std::uint32_t count)
+{
+    std::latch readsComplete{ count };
+    for (std::uint32_t i = 0; i < count; i++)
+    {
+        m_FallbackPool->Submit([&readsComplete, request = requests + i]()
+            {
+                request->m_BytesRead = ReadSingle(request->m_Path, request->m_Buffer, request->m_NullTerminate);
+                readsComplete.count_down();
+            });
+    }
+    readsComplete.wait();
+}
+
+#ifdef _WIN32
+void BatchFileReader::ReadBatchNative(ReadRequest* requests, std::uint32_t count)
+{
+    HANDLE completionPort = CreateIoCompletionPort(INVALID_HANDLE_VALUE, NULL, 0, 0);
+    if (completionPort == NULL)
+    {
+        DRE_LOG_ERROR("BatchFileReader: failed to create completion port, falling back to thread pool.");
+        ReadBatchFallback(requests, count);
+        return;
+    }
+
+    struct InFlightRead
+    {
+        OVERLAPPED      m_Overlapped;
+        HANDLE          m_File;
+        std::uint32_t   m_RequestID;
+        std::uint64_t   m_Size;
+    };
+
+    InFlightRead    inFlightReads[MAX_READS_IN_FLIGHT];
+    std::uint32_t   freeSlots[MAX_READS_IN_FLIGHT];
+    std::uint32_t   freeSlotsCount = MAX_READS_IN_FLIGHT;
+    for (std::uint32_t i = 0; i < MAX_READS_IN_FLIGHT; i++)
+    {
+        freeSlots[i] = i;
+    }
+
+    std::uint32_t nextRequest = 0;
+    std::uint32_t activeReads = 0;
+
+    while (nextRequest < count || activeReads > 0)
+    {
+        // 1. fill the submission window
+        while (nextRequest < count && freeSlotsCount > 0)
+        {
+            std::uint32_t const requestID = nextRequest++;
+            ReadRequest& request = requests[requestID];
+            request.m_BytesRead = 0;
+
+            HANDLE file = CreateFileA(request.m_Path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_OVERLAPPED | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+            if (file == INVALID_HANDLE_VALUE)
+            {
+                DRE_LOG_ERROR("Error opening file in path: %s", request.m_Path);
+                continue;
+            }
+
+            LARGE_INTEGER fileSize;
+            if (GetFileSizeEx(file, &fileSize) == 0 || fileSize.QuadPart >= DRE_U32_MAX)
+            {
+                DRE_LOG_ERROR("Error measuring file size: %s", request.m_Path);
+                CloseHandle(file);
+                continue;
+            }
+
+            std::uint64_t const size = static_cast<std::uint64_t>(fileSize.QuadPart);
+            request.m_Buffer->Resize(request.m_NullTerminate ? size + 1 : size);
+            if (request.m_NullTerminate)
+                request.m_Buffer->As<char*>()[size] = '\0';
+
+            if (size == 0)
+            {
+                CloseHandle(file);
+                continue;
+            }
+
+            if (CreateIoCompletionPort(file, completionPort, 0, 0) == NULL)
+            {
+                DRE_LOG_ERROR("BatchFileReader: failed to associate %s with the completion port, reading it synchronously.", request.m_Path);
+                CloseHandle(file);
+                request.m_BytesRead = ReadSingle(request.m_Path, request.m_Buffer, request.m_NullTerminate);
+                continue;
+            }
+
+            std::uint32_t const slot = freeSlots[--freeSlotsCount];
+            InFlightRead& read = inFlightReads[slot];
+            std::memset(&read.m_Overlapped, 0, sizeof(read.m_Overlapped));
+            read.m_File = file;
+            read.m_RequestID = requestID;
+            read.m_Size = size;
+
+            if (ReadFile(file, request.m_Buffer->Data(), static_cast<DWORD>(size), NULL, &read.m_Overlapped) == 0 && GetLastError() != ERROR_IO_PENDING)
+            {
+                DRE_LOG_ERROR("Error reading file: %s", request.m_Path);
+                CloseHandle(file);
+                freeSlots[freeSlotsCount++] = slot;
+                continue;
+            }
+
+            activeReads++;
+        }
+
+        if (activeReads == 0)
+            continue;
+
+        // 2. reap everything that's complete
+        OVERLAPPED_ENTRY completions[MAX_READS_IN_FLIGHT];
+        ULONG completionsCount = 0;
+        if (GetQueuedCompletionStatusEx(completionPort, completions, MAX_READS_IN_FLIGHT, &completionsCount, INFINITE, FALSE) == 0)
+        {
+            DRE_ASSERT(false, "BatchFileReader: GetQueuedCompletionStatusEx failed.");
+            break;
+        }
+
+        for (ULONG i = 0; i < completionsCount; i++)
+        {
+            InFlightRead* read = CONTAINING_RECORD(completions[i].lpOverlapped, InFlightRead, m_Overlapped);
+            ReadRequest& request = requests[read->m_RequestID];
+
+            if (completions[i].dwNumberOfBytesTransferred == read->m_Size)
+            {
+                request.m_BytesRead = read->m_Size;
+            }
+            else
+            {
+                DRE_LOG_ERROR("Error reading file: %s", request.m_Path);
+            }
+
+            CloseHandle(read->m_File);
+            freeSlots[freeSlotsCount++] = static_cast<std::uint32_t>(read - inFlightReads);
+            activeReads--;
+        }
+    }
+
+    CloseHandle(completionPort);
+}
+
+std::uint64_t BatchFileReader::ReadSingle(char const* path, DRE::ByteBuffer* buffer, bool nullTerminate)
+{
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        DRE_LOG_ERROR("Error opening file in path: %s", path);
+        return 0;
+    }
+
+    LARGE_INTEGER fileSize;
+    if (GetFileSizeEx(file, &fileSize) == 0 || fileSize.QuadPart >= DRE_U32_MAX)
+    {
+        DRE_LOG_ERROR("Error measuring file size: %s", path);
+        CloseHandle(file);
+        return 0;
+    }
+
+    std::uint64_t const size = static_cast<std::uint64_t>(fileSize.QuadPart);
+    if (buffer == nullptr)
+    {
+        CloseHandle(file);
+        return size;
+    }
+
+    buffer->Resize(nullTerminate ? size + 1 : size);
+    if (nullTerminate)
+        buffer->As<char*>()[size] = '\0';
+
+    DWORD bytesRead = 0;
+    if (size > 0 && (ReadFile(file, buffer->Data(), static_cast<DWORD>(size), &bytesRead, NULL) == 0 || bytesRead != size))
+    {
+        DRE_LOG_ERROR("Error reading file: %s", path);
+        CloseHandle(file);
+        return 0;
+    }
+
+    CloseHandle(file);
+    return size;
+}
+#else
+#ifdef __linux__
+namespace
+{
+
+/*
+*
+* Bare io_uring through raw syscalls, one ring per batch.
+* Only one thread touches the ring, so the SQ tail and CQ head are written without contention,
+* the acquire/release pairs order them against the kernel.
+*
+*/
+class IoUring
+{
+public:
+    ~IoUring()
+    {
+        if (m_Sqes != MAP_FAILED)
+            munmap(m_Sqes, m_SqesSize);
+        if (m_CqRing != MAP_FAILED)
+            munmap(m_CqRing, m_CqRingSize);
+        if (m_SqRing != MAP_FAILED)
+            munmap(m_SqRing, m_SqRingSize);
+        if (m_Ring >= 0)
+            close(m_Ring);
+    }
+
+    bool Init(std::uint32_t entries)
+    {
+        io_uring_params params;
+        std::memset(&params, 0, sizeof(params));
+
+        m_Ring = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+        if (m_Ring < 0)
+            return false;
+
+        m_SqRingSize = params.sq_off.array + params.sq_entries * sizeof(std::uint32_t);
+        m_CqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        m_SqesSize = params.sq_entries * sizeof(io_uring_sqe);
+
+        m_SqRing = mmap(nullptr, m_SqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_Ring, IORING_OFF_SQ_RING);
+        m_CqRing = mmap(nullptr, m_CqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_Ring, IORING_OFF_CQ_RING);
+        m_Sqes = mmap(nullptr, m_SqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_Ring, IORING_OFF_SQES);
+        if (m_SqRing == MAP_FAILED || m_CqRing == MAP_FAILED || m_Sqes == MAP_FAILED)
+            return false;
+
+        char* const sqRing = static_cast<char*>(m_SqRing);
+        m_SqTail = reinterpret_cast<std::uint32_t*>(sqRing + params.sq_off.tail);
+        m_SqMask = *reinterpret_cast<std::uint32_t*>(sqRing + params.sq_off.ring_mask);
+        m_SqArray = reinterpret_cast<std::uint32_t*>(sqRing + params.sq_off.array);
+
+        char* const cqRing = static_cast<char*>(m_CqRing);
+        m_CqHead = reinterpret_cast<std::uint32_t*>(cqRing + params.cq_off.head);
+        m_CqTail = reinterpret_cast<std::uint32_t*>(cqRing + params.cq_off.tail);
+        m_CqMask = *reinterpret_cast<std::uint32_t*>(cqRing + params.cq_off.ring_mask);
+        m_Cqes = reinterpret_cast<io_uring_cqe*>(cqRing + params.cq_off.cqes);
+
+        return true;
+    }
+
+    void QueueReadv(int file, iovec const* vector, std::uint64_t userData)
+    {
+        std::uint32_t const tail = *m_SqTail;
+        std::uint32_t const index = tail & m_SqMask;
+
+        io_uring_sqe* sqe = static_cast<io_uring_sqe*>(m_Sqes) + index;
+        std::memset(sqe, 0, sizeof(*sqe));
+        sqe->opcode = IORING_OP_READV;
+        sqe->fd = file;
+        sqe->addr = reinterpret_cast<std::uint64_t>(vector);
+        sqe->len = 1;
+        sqe->off = 0;
+        sqe->user_data = userData;
+
+        m_SqArray[index] = index;
+        __atomic_store_n(m_SqTail, tail + 1, __ATOMIC_RELEASE);
+        m_Queued++;
+    }
+
+    // submits everything queued and blocks until at least one completion is available
+    bool SubmitAndWait()
+    {
+        int const result = static_cast<int>(syscall(__NR_io_uring_enter, m_Ring, m_Queued, 1, IORING_ENTER_GETEVENTS, nullptr, 0));
+        if (result < 0)
+            return errno == EINTR;
+
+        m_Queued -= static_cast<std::uint32_t>(result);
+        return true;
+    }
+
+    template<typename TFunc>
+    void ReapCompletions(TFunc&& func)
+    {
+        std::uint32_t head = *m_CqHead;
+        std::uint32_t const tail = __atomic_load_n(m_CqTail, __ATOMIC_ACQUIRE);
+        while (head != tail)
+        {
+            io_uring_cqe const& cqe = m_Cqes[head & m_CqMask];
+            func(cqe.user_data, cqe.res);
+            head++;
+        }
+        __atomic_store_n(m_CqHead, head, __ATOMIC_RELEASE);
+    }
+
+private:
+    int             m_Ring          = -1;
+
+    void*           m_SqRing        = MAP_FAILED;
+    void*           m_CqRing        = MAP_FAILED;
+    void*           m_Sqes          = MAP_FAILED;
+    std::size_t     m_SqRingSize    = 0;
+    std::size_t     m_CqRingSize    = 0;
+    std::size_t     m_SqesSize      = 0;
+
+    std::uint32_t*  m_SqTail        = nullptr;
+    std::uint32_t*  m_SqArray       = nullptr;
+    std::uint32_t   m_SqMask        = 0;
+
+    std::uint32_t*  m_CqHead        = nullptr;
+    std::uint32_t*  m_CqTail        = nullptr;
+    io_uring_cqe*   m_Cqes          = nullptr;
+    std::uint32_t   m_CqMask        = 0;
+
+    std::uint32_t   m_Queued        = 0;
+};
+
+}
+
+void BatchFileReader::ReadBatchNative(ReadRequest* requests, std::uint32_t count)
+{
+    IoUring ring;
+    if (!ring.Init(MAX_READS_IN_FLIGHT))
+    {
+        DRE_LOG_ERROR("BatchFileReader: failed to set up io_uring, falling back to thread pool.");
+        ReadBatchFallback(requests, count);
+        return;
+    }
+
+    struct InFlightRead
+    {
+        iovec           m_Vector;
+        int             m_File;
+        std::uint32_t   m_RequestID;
+        std::uint64_t   m_Size;
+    };
+
+    InFlightRead    inFlightReads[MAX_READS_IN_FLIGHT];
+    std::uint32_t   freeSlots[MAX_READS_IN_FLIGHT];
+    std::uint32_t   freeSlotsCount = MAX_READS_IN_FLIGHT;
+    for (std::uint32_t i = 0; i < MAX_READS_IN_FLIGHT; i++)
+    {
+        freeSlots[i] = i;
+    }
+
+    std::uint32_t nextRequest = 0;
+    std::uint32_t activeReads = 0;
+
+    while (nextRequest < count || activeReads > 0)
+    {
+        // 1. fill the submission window
+        while (nextRequest < count && freeSlotsCount > 0)
+        {
+            std::uint32_t const requestID = nextRequest++;
+            ReadRequest& request = requests[requestID];
+            request.m_BytesRead = 0;
+
+            int const file = open(request.m_Path, O_RDONLY | O_CLOEXEC);
+            if (file < 0)
+            {
+                DRE_LOG_ERROR("Error opening file in path: %s", request.m_Path);
+                continue;
+            }
+
+            struct stat fileStat;
+            if (fstat(file, &fileStat) != 0 || static_cast<std::uint64_t>(fileStat.st_size) >= DRE_U32_MAX)
+            {
+                DRE_LOG_ERROR("Error measuring file size: %s", request.m_Path);
+                close(file);
+                continue;
+            }
+
+            std::uint64_t const size = static_cast<std::uint64_t>(fileStat.st_size);
+            request.m_Buffer->Resize(request.m_NullTerminate ? size + 1 : size);
+            if (request.m_NullTerminate)
+                request.m_Buffer->As<char*>()[size] = '\0';
+
+            if (size == 0)
+            {
+                close(file);
+                continue;
+            }
+
+            std::uint32_t const slot = freeSlots[--freeSlotsCount];
+            InFlightRead& read = inFlightReads[slot];
+            read.m_Vector.iov_base = request.m_Buffer->Data();
+            read.m_Vector.iov_len = size;
+            read.m_File = file;
+            read.m_RequestID = requestID;
+            read.m_Size = size;
+
+            ring.QueueReadv(file, &read.m_Vector, slot);
+            activeReads++;
+        }
+
+        if (activeReads == 0)
+            continue;
+
+        // 2. submit and reap everything that's complete
+        if (!ring.SubmitAndWait())
+        {
+            DRE_ASSERT(false, "BatchFileReader: io_uring_enter failed.");
+            break;
+        }
+
+        ring.ReapCompletions([&](std::uint64_t slot, std::int32_t result)
+            {
+                InFlightRead& read = inFlightReads[slot];
+                ReadRequest& request = requests[read.m_RequestID];
+
+                if (result >= 0 && static_cast<std::uint64_t>(result) == read.m_Size)
+                {
+                    request.m_BytesRead = read.m_Size;
+                }
+                else
+                {
+                    DRE_LOG_ERROR("Error reading file: %s", request.m_Path);
+                }
+
+                close(read.m_File);
+                freeSlots[freeSlotsCount++] = static_cast<std::uint32_t>(slot);
+                activeReads--;
+            });
+    }
+}
+#else
+void BatchFileReader::ReadBatchNative(ReadRequest* requests, std::uint32_t count)
+{
+    ReadBatchFallback(requests, count);
+}
+#endif // __linux__
+
+std::uint64_t BatchFileReader::ReadSingle(char const* path, DRE::ByteBuffer* buffer, bool nullTerminate)
+{
+    std::ifstream istream{ path, std::ios_base::binary | std::ios_base::beg };
+    if (!istream) {
+        DRE_LOG_ERROR("Error opening file in path: %s", path);
+        return 0;
+    }
+
+    auto const fileSize = istream.seekg(0, std::ios_base::end).tellg();
+    if (!istream) {
+        DRE_LOG_ERROR("Error measuring file size: %s", path);
+        return 0;
+    }
+
+    if (buffer == nullptr)
+        return fileSize;
+
+    std::uint64_t const size = static_cast<std::uint64_t>(fileSize);
+    buffer->Resize(nullTerminate ? size + 1 : size);
+
+    istream.seekg(0, std::ios_base::beg);
+    istream.read(buffer->As<char*>(), size);
+    if (!istream || static_cast<std::uint64_t>(istream.gcount()) != size)
+    {
+        DRE_LOG_ERROR("Error reading file: %s", path);
+        return 0;
+    }
+    istream.close();
+
+    if (nullTerminate)
+        buffer->As<char*>()[size] = '\0';
+
+    return size;
+}
+#endif // _WIN32
+
+}
@@ -0,0 +1,40 @@
+#include <engine\io\Coroutine.hpp>
+
+#include <engine\io\IOManager.hpp>
+
+namespace IO
+{
+
+ReadFileAwaitable::ReadFileAwaitable(IOManager* ioManager, char const* path)
+    : m_IOManager{ ioManager }
+    , m_Path{ path }
+    , m_Buffer{}
+{
+}
+
+void ReadFileAwaitable::await_suspend(std::coroutine_handle<> handle)
+{
+    // awaitable lives in the suspended coroutine frame, safe to reference until resume
+    m_IOManager->GetIOThreadPool().Submit([this, handle]()
+        {
+            IOManager::ReadFileToBuffer(m_Path.GetData(), &m_Buffer);
+            handle.resume();
+        });
+}
+
+MainThreadAwaitable::MainThreadAwaitable(IOManager* ioManager)
+    : m_IOManager{ ioManager }
+{
+}
+
+bool MainThreadAwaitable::await_ready() const noexcept
+{
+    return m_IOManager->IsMainThread();
+}
+
+void MainThreadAwaitable::await_suspend(std::coroutine_handle<> handle)
+{
+    m_IOManager->ScheduleOnMainThread(handle);
+}
+
+}
@@ -2,7 +2,6 @@
 
 #include <algorithm>
 #include <fstream>
-#include <iostream>
 #include <utility>
 #include <charconv>
 #include <filesystem>
@@ -11,6 +10,8 @@
 #include <foundation\memory\Memory.hpp>
 #include <foundation\memory\ByteBuffer.hpp>
 #include <foundation\Container\HashTable.hpp>
+#include <foundation\system\Log.hpp>
+#include <foundation\system\Profiler.hpp>
 #include <foundation\system\Time.hpp>
 #include <foundation\util\Hash.hpp>
 
@@ -32,12 +33,20 @@
 namespace IO
 {
 
+// reads are blocking, keep more threads than cores are usually busy with decoding
+static constexpr std::uint32_t C_IO_WORKER_COUNT = 4;
+
 IOManager::IOManager(DRE::DefaultAllocator* allocator, Data::MaterialLibrary* materialLibrary, Data::GeometryLibrary* geometryLibrary)
     : m_Allocator{ allocator }
     , m_MaterialLibrary{ materialLibrary }
     , m_GeometryLibrary{ geometryLibrary }
     , m_ShaderData{ allocator }
+    , m_ShaderSourceCacheAllocator{}
+    , m_ShaderSourceCache{ &m_ShaderSourceCacheAllocator }
     , m_PendingChangesFlag{ false }
+    , m_MainThreadID{ std::this_thread::get_id() }
+    , m_IOThreadPool{ C_IO_WORKER_COUNT }
+    , m_BatchReader{ &m_IOThreadPool }
 {
 }
 
@@ -49,69 +58,71 @@ IOManager::~IOManager()
 
 std::uint64_t IOManager::ReadFileToBuffer(char const* path, DRE::ByteBuffer* buffer)
 {
-    std::ifstream istream{ path, std::ios_base::binary | std::ios_base::beg };
-    if (!istream) {
-        std::cerr << "Error opening file in path: " << path << std::endl;
-        return 0;
-    }
-
-    auto const fileSize = istream.seekg(0, std::ios_base::end).tellg();
-    if (!istream) {
-        std::cerr << "Error measuring file size: " << path << std::endl;
-        return 0;
-    }
-
-    if (buffer == nullptr)
-        return fileSize;
-
-    buffer->Resize(fileSize);
-
-    istream.seekg(0, std::ios_base::beg);
-    istream.read(buffer->As<char*>(), static_cast<std::uint64_t>(fileSize));
-    istream.close();
-
-    return fileSize;
+    return BatchFileReader::ReadSingle(path, buffer, false);
 }
 
 std::uint64_t IOManager::ReadFileStringToBuffer(char const* path, DRE::ByteBuffer* buffer)
 {
-    std::ifstream istream{ path, std::ios_base::binary | std::ios_base::beg };
-    if (!istream) {
-        std::cerr << "Error opening file in path: " << path << std::endl;
-        return 0;
+    return BatchFileReader::ReadSingle(path, buffer, true);
+}
+
+void IOManager::ScheduleOnMainThread(std::coroutine_handle<> handle)
+{
+    {
+        std::lock_guard<std::mutex> lock{ m_MainThreadTasksMutex };
+        m_MainThreadTasks.emplace_back(handle);
     }
+    m_MainThreadTasksCondition.notify_one();
+}
 
-    auto const fileSize = istream.seekg(0, std::ios_base::end).tellg();
-    if (!istream) {
-        std::cerr << "Error measuring file size: " << path << std::endl;
-        return 0;
+void IOManager::ResumeMainThreadTasks()
+{
+    DRE_ASSERT(IsMainThread(), "IOManager::ResumeMainThreadTasks must be called from the main thread.");
+
+    std::vector<std::coroutine_handle<>> tasks;
+    {
+        std::lock_guard<std::mutex> lock{ m_MainThreadTasksMutex };
+        tasks.swap(m_MainThreadTasks);
     }
 
-    if (buffer == nullptr)
-        return fileSize;
+    for (std::coroutine_handle<> handle : tasks)
+    {
+        handle.resume();
+    }
+}
 
-    buffer->Resize(static_cast<std::uint64_t>(fileSize) + 1);
+void IOManager::WaitForTasks(AsyncTask const* tasks, std::uint32_t count)
+{
+    while (true)
+    {
+        ResumeMainThreadTasks();
 
-    istream.seekg(0, std::ios_base::beg);
-    istream.read(buffer->As<char*>(), static_cast<std::uint64_t>(fileSize));
-    istream.close();
+        bool allDone = true;
+        for (std::uint32_t i = 0; i < count; i++)
+        {
+            allDone &= tasks[i].IsDone();
+        }
 
-    buffer->As<char*>()[static_cast<std::uint64_t>(fileSize)] = '\0';
+        if (allDone)
+            return;
 
-    return fileSize;
+        // tasks finishing on workers don't notify, so don't sleep for too long
+        std::unique_lock<std::mutex> lock{ m_MainThreadTasksMutex };
+        m_MainThreadTasksCondition.wait_for(lock, std::chrono::milliseconds{ 1 }, [this]() { return !m_MainThreadTasks.empty(); });
+    }
 }
 
 void IOManager::WriteNewFile(char const* path, DRE::ByteBuffer const& buffer)
 {
     std::ofstream ostream{ path, std::ios_base::binary };
     if (!ostream) {
-        std::cerr << "Error writing file in path: " << path << std::endl;
+        DRE_LOG_ERROR("Error writing file in path: %s", path);
     }
 
     ostream.write(buffer.As<char const*>(), buffer.Size());
 
     if (!ostream) {
-        std::cerr << "Failed to write " << buffer.Size() << " bytes to file " << path << std::endl;
+        DRE_LOG_ERROR("Failed to write %llu bytes to file %s", buffer.Size(), path);
     }
 
     ostream.close();
@@ -136,23 +147,26 @@ public:
         const char* requesting_source,
         size_t include_depth) override
     {
-        std::mutex& m = m_IOManager->GetShaderIncluderMutex();
-        m.lock();
-        shaderc_include_result* result = DRE::g_FrameScratchAllocator.Alloc<shaderc_include_result>();
-        DREIncludeData* data = DRE::g_FrameScratchAllocator.Alloc<DREIncludeData>();
-        m.unlock();
+        // heap, includes are requested from compilation threads
+        shaderc_include_result* result = new shaderc_include_result{};
+        DREIncludeData* data = new DREIncludeData{};
 
         data->contentName = "shaders\\";
         data->contentName.Append(requested_source);
 
         data->targetName = requesting_source;
-        
-        std::uint64_t const bytesRead = IOManager::ReadFileToBuffer(data->contentName.GetData(), &data->content);
-        DRE_ASSERT(bytesRead != 0, "Failed to read requested include for GLSL.");
+
+        DRE::ByteBuffer const* content = m_IOManager->FindCachedShaderSource(data->contentName.GetData());
+        if (content == nullptr)
+        {
+            std::uint64_t const bytesRead = IOManager::ReadFileToBuffer(data->contentName.GetData(), &data->content);
+            DRE_ASSERT(bytesRead != 0, "Failed to read requested include for GLSL.");
+            content = &data->content;
+        }
 
         result->source_name = data->contentName.GetData();
-        result->content_length = data->content.Size();
-        result->content = data->content.As<char*>();
+        result->content_length = content->Size();
+        result->content = content->As<char*>();
         result->source_name = data->targetName.GetData();
         result->source_name_length = data->targetName.GetSize();
         result->user_data = data;
@@ -164,7 +178,8 @@ public:
     virtual void ReleaseInclude(shaderc_include_result* result) override
     {
         DREIncludeData* data = (DREIncludeData*)result->user_data;
-        data->~DREIncludeData();
+        delete data;
+        delete result;
     }
 
     virtual ~DREIncluder() = default;
@@ -173,11 +188,23 @@ private:
     IOManager* m_IOManager;
 };
 
+// compiler output can be longer than a single log argument
+static void LogLongText(DRE::LogSeverity severity, char const* text)
+{
+    for (std::size_t length = std::strlen(text); length > 0; )
+    {
+        std::size_t const chunk = std::min<std::size_t>(length, DRE::Log::MAX_STRING_ARG - 1);
+        DRE_LOG(severity, "%s", text);
+        text += chunk;
+        length -= chunk;
+    }
+}
+
 DRE::ByteBuffer IOManager::CompileGLSL(char const* path)
 {
     std::filesystem::path filePath{ path };
 
-    std::cout << "Compiling shader " << path << std::endl;
+    DRE_LOG_INFO("Compiling shader %s", path);
 
     shaderc_shader_kind kind = (shaderc_shader_kind)0;
 
@@ -192,18 +219,23 @@ DRE::ByteBuffer IOManager::CompileGLSL(char const* path)
         DRE_ASSERT(false, "Attempt to compile unsupported shader type. See file extension.");
 
     DRE::ByteBuffer sourceBlob{};
-    std::uint64_t const bytesRead = ReadFileToBuffer(path, &sourceBlob);
-    DRE_ASSERT(bytesRead != 0, "Failed to read GLSL source.");
+    DRE::ByteBuffer const* source = FindCachedShaderSource(path);
+    if (source == nullptr)
+    {
+        std::uint64_t const bytesRead = ReadFileToBuffer(path, &sourceBlob);
+        DRE_ASSERT(bytesRead != 0, "Failed to read GLSL source.");
+        source = &sourceBlob;
+    }
 
     shaderc::Compiler compiler;
     shaderc::CompileOptions options;
     options.SetTargetEnvironment(shaderc_target_env::shaderc_target_env_vulkan, shaderc_env_version_vulkan_1_3);
     options.SetIncluder(std::make_unique<DREIncluder>(this));
 
-    shaderc::PreprocessedSourceCompilationResult preprocess = compiler.PreprocessGlsl(sourceBlob.As<char*>(), sourceBlob.Size(), kind, path, options);
+    shaderc::PreprocessedSourceCompilationResult preprocess = compiler.PreprocessGlsl(source->As<char*>(), source->Size(), kind, path, options);
     if (preprocess.GetCompilationStatus() != shaderc_compilation_status_success)
     {
-        std::cout << preprocess.GetErrorMessage();
+        LogLongText(DRE::LOG_SEVERITY_ERROR, preprocess.GetErrorMessage().c_str());
         return DRE::ByteBuffer{};
     }
 
@@ -212,12 +244,11 @@ DRE::ByteBuffer IOManager::CompileGLSL(char const* path)
 
     if (compile.GetCompilationStatus() != shaderc_compilation_status_success) 
     {
+        DRE_LOG_ERROR("Failed compiling shader %s", path);
 #ifdef DEBUG_SHADER_COMPILATION
-        std::lock_guard<std::mutex> lock{ m_DebugShaderCompilationMutex };
-        std::cout << "FAILED COMPILING SHADER " << filePath << std::endl << "SOURCE: " << std::endl;
-        std::cout << preprocess.begin();
+        LogLongText(DRE::LOG_SEVERITY_DEBUG, preprocess.begin());
 #endif
-        std::cout << compile.GetErrorMessage();
+        LogLongText(DRE::LOG_SEVERITY_ERROR, compile.GetErrorMessage().c_str());
 
         return DRE::ByteBuffer{};
     }
@@ -226,6 +257,57 @@ DRE::ByteBuffer IOManager::CompileGLSL(char const* path)
     return DRE::ByteBuffer{ (void*)compile.begin(), moduleSize };
 }
 
+static DRE::String64 ShaderSourceCacheKey(char const* path)
+{
+    // includer builds paths with '\\', directory iteration gives '/'
+    char key[64];
+    std::uint32_t i = 0;
+    for (; path[i] != '\0' && i < sizeof(key) - 1; i++)
+    {
+        key[i] = path[i] == '\\' ? '/' : path[i];
+    }
+    key[i] = '\0';
+
+    return DRE::String64{ key };
+}
+
+DRE::ByteBuffer const* IOManager::FindCachedShaderSource(char const* path)
+{
+    return m_ShaderSourceCache.Find(ShaderSourceCacheKey(path)).value;
+}
+
+void IOManager::PrefetchShaderSources()
+{
+    std::filesystem::recursive_directory_iterator dir_iterator{ "shaders", std::filesystem::directory_options::follow_directory_symlink };
+
+    std::vector<std::string> paths;
+    for (auto const& entry : dir_iterator)
+    {
+        if (entry.is_regular_file() && entry.path().extension() != ".spv")
+        {
+            paths.emplace_back(entry.path().generic_string());
+        }
+    }
+
+    std::vector<DRE::ByteBuffer> buffers(paths.size());
+    std::vector<BatchFileReader::ReadRequest> requests(paths.size());
+    for (std::uint32_t i = 0, size = std::uint32_t(paths.size()); i < size; i++)
+    {
+        requests[i].m_Path = paths[i].c_str();
+        requests[i].m_Buffer = &buffers[i];
+    }
+
+    m_BatchReader.ReadBatch(requests.data(), std::uint32_t(requests.size()));
+
+    for (std::uint32_t i = 0, size = std::uint32_t(paths.size()); i < size; i++)
+    {
+        if (requests[i].m_BytesRead == 0)
+            continue;
+
+        m_ShaderSourceCache.Emplace(ShaderSourceCacheKey(paths[i].c_str()), DRE_MOVE(buffers[i]));
+    }
+}
+
 DRE::InplaceVector<DRE::String64, 12> IOManager::GetPendingShaders()
 {
     std::lock_guard guard{ m_PendingShadersMutex };
@@ -247,7 +329,7 @@ void WriteMemorySequence(void*& memory, T& data)
     memory = DRE::PtrAdd(memory, sizeof(data));
 }
 
-void IOManager::ParseMaterialTexture(aiScene const* scene, aiMaterial const* aiMat, DRE::String256 const& assetFolderPath, Data::Material* material, Data::Material::TextureProperty::Slot slot, Data::TextureChannelVariations channels)
+bool IOManager::FindMaterialTexturePath(aiScene const* scene, aiMaterial const* aiMat, DRE::String256 const& assetFolderPath, Data::Material::TextureProperty::Slot slot, DRE::String256& result)
 {
     aiString aiTexturePath;
     aiTextureType aiType = aiTextureType_NONE;
@@ -272,56 +354,58 @@ void IOManager::ParseMaterialTexture(aiScene const* scene, aiMaterial const* aiM
 
     if (aiMat->GetTexture(aiType, 0, &aiTexturePath) != aiReturn_SUCCESS)
     {
-        std::cout << "Warning: failed to find material texture flor slot " << slot << std::endl;
-        return;
+        DRE_LOG_WARNING("Failed to find material texture for slot %u", slot);
+        return false;
     }
 
     aiTexture const* tex = scene->GetEmbeddedTexture(aiTexturePath.C_Str());
-    if (tex == nullptr)
-    {
-        DRE::String256 textureFilePath = assetFolderPath;
-        char const separator[2] = { std::filesystem::path::preferred_separator, '\0' };
-        textureFilePath.Append(separator);
-        textureFilePath.Append(aiTexturePath.C_Str(), DRE::U16(aiTexturePath.length));
-
-        Data::Texture2D dataTexture = ReadTexture2D(textureFilePath.GetData(), channels);
-        material->AssignTextureToSlot(slot, DRE_MOVE(dataTexture));
-    }
-    else
+    if (tex != nullptr)
     {
         // process aiTexture
         // fuck this for now
         DRE_ASSERT(false, "assimp embedded textures are not yet supported");
+        return false;
     }
-}
 
-void IOManager::ParseAssimpNodeRecursive(VKW::Context& gfxContext, char const* assetPath, aiScene const* scene, char const* sceneName, aiNode const* node, WORLD::Scene& targetScene, WORLD::SceneNode* parentNode)
-{
-    aiMatrix4x4 const t = node->mTransformation;
-    glm::mat4 const transform {
-            t.a1, t.a2, t.a3, t.a4,
-            t.b1, t.b2, t.b3, t.b4,
-            t.c1, t.c2, t.c3, t.c4,
-            t.d1, t.d2, t.d3, t.d4
-    };
+    result = assetFolderPath;
+    char const separator[2] = { std::filesystem::path::preferred_separator, '\0' };
+    result.Append(separator);
+    result.Append(aiTexturePath.C_Str(), DRE::U16(aiTexturePath.length));
 
-    WORLD::SceneNode* aggregatorNode = targetScene.CreateSceneNode(nullptr, parentNode);
-    aggregatorNode->SetMatrix(transform);
+    return true;
+}
 
-    for (std::uint32_t i = 0, count = node->mNumMeshes; i < count; i++)
+Data::TextureChannelVariations IOManager::GetMaterialSlotChannels(Data::Material::TextureProperty::Slot slot, Data::TextureChannelVariations metalnessRoughnessOverride)
+{
+    switch (slot)
     {
-        aiMesh* mesh = scene->mMeshes[node->mMeshes[i]];
-
-        Data::Material* material = m_MaterialLibrary->GetMaterial(mesh->mMaterialIndex, sceneName);
-        Data::Geometry* geometry = m_GeometryLibrary->GetGeometry(node->mMeshes[i], sceneName);
-
-        WORLD::Entity* entity = targetScene.CreateOpaqueEntity(gfxContext, geometry, material, aggregatorNode);
+    case Data::Material::TextureProperty::DIFFUSE:
+    case Data::Material::TextureProperty::NORMAL:
+        return Data::TEXTURE_VARIATION_RGBA;
+    case Data::Material::TextureProperty::METALNESS:
+        // with override we have texture with merged metalness and roughness attributes. Let it lie in metalness
+        return metalnessRoughnessOverride == Data::TEXTURE_VARIATION_INVALID ? Data::TEXTURE_VARIATION_GRAY : metalnessRoughnessOverride;
+    case Data::Material::TextureProperty::ROUGHNESS:
+        return metalnessRoughnessOverride == Data::TEXTURE_VARIATION_INVALID ? Data::TEXTURE_VARIATION_GRAY : Data::TEXTURE_VARIATION_INVALID;
+    default:
+        return Data::TEXTURE_VARIATION_INVALID;
     }
+}
 
-    for (std::uint32_t i = 0; i < node->mNumChildren; i++)
+void IOManager::ParseMaterialTexture(aiScene const* scene, aiMaterial const* aiMat, DRE::String256 const& assetFolderPath, Data::Material* material, Data::Material::TextureProperty::Slot slot, Data::TextureChannelVariations channels, Data::Texture2D* preloaded)
+{
+    if (preloaded != nullptr && preloaded->IsInitialized())
     {
-        ParseAssimpNodeRecursive(gfxContext, assetPath, scene, sceneName, node->mChildren[i], targetScene, aggregatorNode);
+        material->AssignTextureToSlot(slot, DRE_MOVE(*preloaded));
+        return;
     }
+
+    DRE::String256 textureFilePath;
+    if (!FindMaterialTexturePath(scene, aiMat, assetFolderPath, slot, textureFilePath))
+        return;
+
+    Data::Texture2D dataTexture = ReadTexture2D(textureFilePath.GetData(), channels);
+    material->AssignTextureToSlot(slot, DRE_MOVE(dataTexture));
 }
 
 void IOManager::BuildAssimpNodeAccelerationStructure(VKW::Context& gfxContext, char const* assetPath, aiScene const* scene, char const* sceneName, aiNode const* node, WORLD::Scene& targetScene, WORLD::SceneNode* parentNode, Data::Material* mat, Data::Geometry* geometry)
@@ -373,110 +457,228 @@ WORLD::SceneNode* IOManager::ParseModelFile(char const* path, WORLD::Scene& targ
     Assimp::Importer importer = Assimp::Importer();
 
     aiScene const* scene = importer.ReadFile(path, aiProcessPreset_TargetRealtime_Fast | aiProcess_FlipUVs);
-    char const* sceneName = aiScene::GetShortFilename(path);
 
     DRE_ASSERT(scene != nullptr, "Failed to load a model file.");
     if (scene == nullptr)
         return nullptr;
 
-    ParseAssimpMeshes(GFX::g_GraphicsManager->GetMainContext(), scene, sceneName);
-    ParseAssimpMaterials(scene, sceneName, path, defaultShader, metalnessRoughnessOverride);
+    return InstantiateModel(path, scene, targetScene, defaultShader, baseTransform, metalnessRoughnessOverride, nullptr);
+}
 
-    WORLD::SceneNode* parentNode = targetScene.CreateSceneNode(nullptr, targetScene.GetRootNode());
-    parentNode->SetMatrix(baseTransform);
-    parentNode->SetName(sceneName);
+WORLD::SceneNode* IOManager::InstantiateModel(char const* path, aiScene const* scene, WORLD::Scene& targetScene, char const* defaultShader, glm::mat4 baseTransform, Data::TextureChannelVariations metalnessRoughnessOverride, PreparedModel* prepared)
+{
+    ModelInstantiation state;
+    BeginModelInstantiation(state, path, scene, targetScene, defaultShader, baseTransform, metalnessRoughnessOverride, prepared);
 
-    ParseAssimpNodeRecursive(GFX::g_GraphicsManager->GetMainContext(), path, scene, sceneName, scene->mRootNode, targetScene, parentNode);
-    GFX::g_GraphicsManager->GetMainContext().FlushAll();
+    DRE::Stopwatch stopwatch;
+    while (!InstantiateModelStep(state, stopwatch, DRE_U64_MAX));
 
-    return parentNode;
+    return state.m_RootNode;
 }
 
-void IOManager::ParseAssimpMaterials(aiScene const* scene, char const* sceneName, char const* path, char const* defaultShader, Data::TextureChannelVariations metalnessRoughnessOverride)
+void IOManager::BeginModelInstantiation(ModelInstantiation& state, char const* path, aiScene const* scene, WORLD::Scene& targetScene, char const* defaultShader, glm::mat4 baseTransform, Data::TextureChannelVariations metalnessRoughnessOverride, PreparedModel* prepared)
 {
-    // get folder with texture files
-    DRE::String256 textureFilePath = path;
-    std::uint8_t folderEnd = textureFilePath.GetSize() - 1;
-    while (textureFilePath[folderEnd] != '\\' && textureFilePath[folderEnd] != '/')
-    {
-        DRE_ASSERT(folderEnd != 0, "Unable to find file path separator!");
-        --folderEnd;
-    }
-    textureFilePath.Shrink(folderEnd);
+    state.m_Path = path;
+    state.m_Scene = scene;
+    state.m_TargetScene = &targetScene;
+    state.m_DefaultShader = defaultShader;
+    state.m_MetalnessRoughnessOverride = metalnessRoughnessOverride;
+    state.m_Prepared = prepared;
+
+    state.m_Stage = ModelInstantiation::STAGE_MESHES;
+    state.m_NextItem = 0;
+    state.m_PendingNodes.clear();
+    state.m_CurrentNode = nullptr;
+    state.m_CurrentAggregator = nullptr;
+
+    state.m_RootNode = targetScene.CreateSceneNode(nullptr, targetScene.GetRootNode());
+    state.m_RootNode->SetMatrix(baseTransform);
+    state.m_RootNode->SetName(aiScene::GetShortFilename(path));
+}
+
+bool IOManager::InstantiateModelStep(ModelInstantiation& state, DRE::Stopwatch const& stopwatch, std::uint64_t budgetUS)
+{
+    DRE_CPU_SCOPE(InstantiateModelStep);
 
-    for (std::uint32_t i = 0, size = scene->mNumMaterials; i < size; i++)
+    VKW::Context& gfxContext = GFX::g_GraphicsManager->GetMainContext();
+    aiScene const* scene = state.m_Scene;
+    char const* sceneName = aiScene::GetShortFilename(state.m_Path.GetData());
+
+    // at least one item per step, otherwise a tight budget would never finish
+    bool progressed = false;
+    while (state.m_Stage != ModelInstantiation::STAGE_DONE && (!progressed || stopwatch.CurrentMicroseconds() < budgetUS))
     {
-        aiMaterial* aiMat = scene->mMaterials[i];
-        Data::Material* material = m_MaterialLibrary->CreateMaterial(i, sceneName, aiMat->GetName().C_Str());
+        progressed = true;
 
-        DRE_ASSERT(aiMat->GetTextureCount(aiTextureType_DIFFUSE) <= 1, "We don't support multiple textures of the same type per material (DIFFUSE).");
-        DRE_ASSERT(aiMat->GetTextureCount(aiTextureType_NORMALS) <= 1, "We don't support multiple textures of the same type per material (NORMALS)");
-        DRE_ASSERT(aiMat->GetTextureCount(aiTextureType_METALNESS) <= 1, "We don't support multiple textures of the same type per material (METALNESS)");
-        DRE_ASSERT(aiMat->GetTextureCount(aiTextureType_DIFFUSE_ROUGHNESS) <= 1, "We don't support multiple textures of the same type per material (DIFFUSE_ROUGHNESS)");
-        DRE_ASSERT(aiMat->GetTextureCount(aiTextureType_AMBIENT_OCCLUSION) <= 1, "We don't support multiple textures of the same type per material (AMBIENT_OCCLUSION)");
+        switch (state.m_Stage)
+        {
+        case ModelInstantiation::STAGE_MESHES:
+            if (state.m_NextItem < scene->mNumMeshes)
+            {
+                ParseAssimpMesh(scene, sceneName, state.m_NextItem++, state.m_Prepared);
+                break;
+            }
+            state.m_Stage = ModelInstantiation::STAGE_MATERIALS;
+            state.m_NextItem = 0;
+            break;
 
-        // PROCESS TEXTURES
-        ParseMaterialTexture(scene, aiMat, textureFilePath, material, Data::Material::TextureProperty::DIFFUSE, Data::TEXTURE_VARIATION_RGBA);
-        ParseMaterialTexture(scene, aiMat, textureFilePath, material, Data::Material::TextureProperty::NORMAL, Data::TEXTURE_VARIATION_RGBA);
+        case ModelInstantiation::STAGE_MATERIALS:
+            if (state.m_NextItem < scene->mNumMaterials)
+            {
+                ParseAssimpMaterial(scene, sceneName, GetAssetFolderPath(state.m_Path.GetData()), state.m_NextItem++, state.m_DefaultShader.GetData(), state.m_MetalnessRoughnessOverride, state.m_Prepared);
+                break;
+            }
+            state.m_Stage = ModelInstantiation::STAGE_NODES;
+            state.m_NextItem = 0;
+            state.m_PendingNodes.emplace_back(ModelInstantiation::PendingNode{ scene->mRootNode, state.m_RootNode });
+            break;
 
-        if (metalnessRoughnessOverride == Data::TEXTURE_VARIATION_INVALID)
+        case ModelInstantiation::STAGE_NODES:
         {
-            ParseMaterialTexture(scene, aiMat, textureFilePath, material, Data::Material::TextureProperty::METALNESS, Data::TEXTURE_VARIATION_GRAY);
-            ParseMaterialTexture(scene, aiMat, textureFilePath, material, Data::Material::TextureProperty::ROUGHNESS, Data::TEXTURE_VARIATION_GRAY);
+            aiNode const* node = state.m_CurrentNode;
+            if (node != nullptr && state.m_NextItem < node->mNumMeshes)
+            {
+                std::uint32_t const meshID = node->mMeshes[state.m_NextItem++];
+                aiMesh const* mesh = scene->mMeshes[meshID];
+
+                Data::Material* material = m_MaterialLibrary->GetMaterial(mesh->mMaterialIndex, sceneName);
+                Data::Geometry* geometry = m_GeometryLibrary->GetGeometry(meshID, sceneName);
+
+                state.m_TargetScene->CreateOpaqueEntity(gfxContext, geometry, material, state.m_CurrentAggregator);
+                break;
+            }
+
+            if (state.m_PendingNodes.empty())
+            {
+                state.m_Stage = ModelInstantiation::STAGE_DONE;
+                break;
+            }
+
+            ModelInstantiation::PendingNode const pending = state.m_PendingNodes.back();
+            state.m_PendingNodes.pop_back();
+
+            aiMatrix4x4 const t = pending.m_Node->mTransformation;
+            glm::mat4 const transform {
+                    t.a1, t.a2, t.a3, t.a4,
+                    t.b1, t.b2, t.b3, t.b4,
+                    t.c1, t.c2, t.c3, t.c4,
+                    t.d1, t.d2, t.d3, t.d4
+            };
+
+            WORLD::SceneNode* aggregatorNode = state.m_TargetScene->CreateSceneNode(nullptr, pending.m_Parent);
+            aggregatorNode->SetMatrix(transform);
+
+            // reversed, so children are visited in the same order as recursive traversal would
+            for (std::uint32_t i = pending.m_Node->mNumChildren; i > 0; i--)
+            {
+                state.m_PendingNodes.emplace_back(ModelInstantiation::PendingNode{ pending.m_Node->mChildren[i - 1], aggregatorNode });
+            }
+
+            state.m_CurrentNode = pending.m_Node;
+            state.m_CurrentAggregator = aggregatorNode;
+            state.m_NextItem = 0;
+            break;
         }
-        else
-        {
-            // it means we have texture with merged metalness and roughness attributes. Let it lie in metalness
-            ParseMaterialTexture(scene, aiMat, textureFilePath, material, Data::Material::TextureProperty::METALNESS, metalnessRoughnessOverride);
+        default:
+            DRE_ASSERT(false, "Invalid model instantiation stage.");
         }
-        // TODO: load rgb here
+    }
 
-        material->GetRenderingProperties().SetMaterialType(Data::Material::RenderingProperties::MATERIAL_TYPE_OPAQUE);
-        material->GetRenderingProperties().SetShader(defaultShader);
+    GFX::g_GraphicsManager->SubmitTransientUploads();
+
+    return state.m_Stage == ModelInstantiation::STAGE_DONE;
+}
+
+DRE::String256 IOManager::GetAssetFolderPath(char const* path)
+{
+    DRE::String256 folderPath = path;
+    std::uint8_t folderEnd = folderPath.GetSize() - 1;
+    while (folderPath[folderEnd] != '\\' && folderPath[folderEnd] != '/')
+    {
+        DRE_ASSERT(folderEnd != 0, "Unable to find file path separator!");
+        --folderEnd;
     }
+    folderPath.Shrink(folderEnd);
+
+    return folderPath;
 }
 
-void IOManager::ParseAssimpMeshes(VKW::Context& gfxContext, aiScene const* scene, char const* sceneName)
+void IOManager::ParseAssimpMaterial(aiScene const* scene, char const* sceneName, DRE::String256 const& assetFolderPath, std::uint32_t materialID, char const* defaultShader, Data::TextureChannelVariations metalnessRoughnessOverride, PreparedModel* prepared)
 {
-    for (std::uint32_t i = 0, size = scene->mNumMeshes; i < size; i++)
+    aiMaterial* aiMat = scene->mMaterials[materialID];
+    Data::Material* material = m_MaterialLibrary->CreateMaterial(materialID, sceneName, aiMat->GetName().C_Str());
+
+    DRE_ASSERT(aiMat->GetTextureCount(aiTextureType_DIFFUSE) <= 1, "We don't support multiple textures of the same type per material (DIFFUSE).");
+    DRE_ASSERT(aiMat->GetTextureCount(aiTextureType_NORMALS) <= 1, "We don't support multiple textures of the same type per material (NORMALS)");
+    DRE_ASSERT(aiMat->GetTextureCount(aiTextureType_METALNESS) <= 1, "We don't support multiple textures of the same type per material (METALNESS)");
+    DRE_ASSERT(aiMat->GetTextureCount(aiTextureType_DIFFUSE_ROUGHNESS) <= 1, "We don't support multiple textures of the same type per material (DIFFUSE_ROUGHNESS)");
+    DRE_ASSERT(aiMat->GetTextureCount(aiTextureType_AMBIENT_OCCLUSION) <= 1, "We don't support multiple textures of the same type per material (AMBIENT_OCCLUSION)");
+
+    // PROCESS TEXTURES
+    for (std::uint32_t slot = 0; slot < Data::Material::TextureProperty::MAX; slot++)
     {
-        aiMesh* mesh = scene->mMeshes[i];
+        Data::Material::TextureProperty::Slot const slotID = Data::Material::TextureProperty::Slot(slot);
+        Data::TextureChannelVariations const channels = GetMaterialSlotChannels(slotID, metalnessRoughnessOverride);
+        if (channels == Data::TEXTURE_VARIATION_INVALID)
+            continue;
 
-        Data::Geometry geometry{ sizeof(Data::DREVertex), sizeof(Data::DREIndex) };
-        geometry.ResizeVertexStorage(mesh->mNumVertices);
-        geometry.ResizeIndexStorage(mesh->mNumFaces * 3);
+        Data::Texture2D* preloaded = prepared != nullptr ? &prepared->m_Textures[materialID * Data::Material::TextureProperty::MAX + slot] : nullptr;
+        ParseMaterialTexture(scene, aiMat, assetFolderPath, material, slotID, channels, preloaded);
+    }
+    // TODO: load rgb here
 
-        for (std::uint32_t j = 0, jSize = mesh->mNumVertices; j < jSize; j++)
-        {
-            Data::DREVertex& v = geometry.GetVertex<Data::DREVertex>(j);
-            v.pos[0] = mesh->mVertices[j].x;
-            v.pos[1] = mesh->mVertices[j].y;
-            v.pos[2] = mesh->mVertices[j].z;
+    material->GetRenderingProperties().SetMaterialType(Data::Material::RenderingProperties::MATERIAL_TYPE_OPAQUE);
+    material->GetRenderingProperties().SetShader(defaultShader);
+}
+
+Data::Geometry IOManager::ConvertAssimpMesh(aiMesh const* mesh)
+{
+    Data::Geometry geometry{ sizeof(Data::DREVertex), sizeof(Data::DREIndex) };
+    geometry.ResizeVertexStorage(mesh->mNumVertices);
+    geometry.ResizeIndexStorage(mesh->mNumFaces * 3);
 
-            v.norm[0] = mesh->mNormals[j].x;
-            v.norm[1] = mesh->mNormals[j].y;
-            v.norm[2] = mesh->mNormals[j].z;
+    for (std::uint32_t j = 0, jSize = mesh->mNumVertices; j < jSize; j++)
+    {
+        Data::DREVertex& v = geometry.GetVertex<Data::DREVertex>(j);
+        v.pos[0] = mesh->mVertices[j].x;
+        v.pos[1] = mesh->mVertices[j].y;
+        v.pos[2] = mesh->mVertices[j].z;
 
-            v.tan[0] = mesh->mTangents[j].x;
-            v.tan[1] = mesh->mTangents[j].y;
-            v.tan[2] = mesh->mTangents[j].z;
+        v.norm[0] = mesh->mNormals[j].x;
+        v.norm[1] = mesh->mNormals[j].y;
+        v.norm[2] = mesh->mNormals[j].z;
 
-            v.btan[0] = mesh->mBitangents[j].x;
-            v.btan[1] = mesh->mBitangents[j].y;
-            v.btan[2] = mesh->mBitangents[j].z;
+        v.tan[0] = mesh->mTangents[j].x;
+        v.tan[1] = mesh->mTangents[j].y;
+        v.tan[2] = mesh->mTangents[j].z;
 
-            v.uv0[0] = mesh->mTextureCoords[0][j].x;
-            v.uv0[1] = mesh->mTextureCoords[0][j].y;
-        }
+        v.btan[0] = mesh->mBitangents[j].x;
+        v.btan[1] = mesh->mBitangents[j].y;
+        v.btan[2] = mesh->mBitangents[j].z;
 
-        for (std::uint32_t j = 0, jSize = mesh->mNumFaces; j < jSize; j++)
-        {
-            geometry.GetIndex<Data::DREIndex>(j*3 + 0) = mesh->mFaces[j].mIndices[0];
-            geometry.GetIndex<Data::DREIndex>(j*3 + 1) = mesh->mFaces[j].mIndices[1];
-            geometry.GetIndex<Data::DREIndex>(j*3 + 2) = mesh->mFaces[j].mIndices[2];
-        }
+        v.uv0[0] = mesh->mTextureCoords[0][j].x;
+        v.uv0[1] = mesh->mTextureCoords[0][j].y;
+    }
+
+    for (std::uint32_t j = 0, jSize = mesh->mNumFaces; j < jSize; j++)
+    {
+        geometry.GetIndex<Data::DREIndex>(j*3 + 0) = mesh->mFaces[j].mIndices[0];
+        geometry.GetIndex<Data::DREIndex>(j*3 + 1) = mesh->mFaces[j].mIndices[1];
+        geometry.GetIndex<Data::DREIndex>(j*3 + 2) = mesh->mFaces[j].mIndices[2];
+    }
+
+    return geometry;
+}
 
-        m_GeometryLibrary->AddGeometry(i, sceneName, DRE_MOVE(geometry));
+void IOManager::ParseAssimpMesh(aiScene const* scene, char const* sceneName, std::uint32_t meshID, PreparedModel* prepared)
+{
+    if (prepared != nullptr)
+    {
+        m_GeometryLibrary->AddGeometry(meshID, sceneName, DRE_MOVE(prepared->m_Geometries[meshID]));
+    }
+    else
+    {
+        m_GeometryLibrary->AddGeometry(meshID, sceneName, ConvertAssimpMesh(scene->mMeshes[meshID]));
     }
 }
 
@@ -587,20 +789,26 @@ void ParseShaderInterface(spirv_cross::Compiler& compiler, IOManager::ShaderInte
 
 void IOManager::CompileGLSLSources()
 {
+    DRE_CPU_SCOPE(CompileGLSLSources);
+
+    // all sources and includes are read in one batch, compilation threads don't touch the disk
+    PrefetchShaderSources();
+
     std::filesystem::recursive_directory_iterator dir_iterator{ "shaders", std::filesystem::directory_options::follow_directory_symlink };
-    DRE::Vector<DRE::String64, DRE::AllocatorLinear> fileNames{ &DRE::g_FrameScratchAllocator };
+    // not the scratch allocator, this can run on a startup worker
+    std::vector<DRE::String64> fileNames;
     
     for (auto const& entry : dir_iterator)
     {
         if (entry.path().has_extension() &&
             (entry.path().extension() == ".vert" || entry.path().extension() == ".frag" || entry.path().extension() == ".comp"))
         {
-            fileNames.EmplaceBack(entry.path().generic_string().c_str());
+            fileNames.emplace_back(entry.path().generic_string().c_str());
         }
     }
 
     std::uint32_t constexpr parallelFactor = 4;
-    std::uint32_t const parallelChunkSize = fileNames.Size() / parallelFactor + 1;
+    std::uint32_t const parallelChunkSize = std::uint32_t(fileNames.size()) / parallelFactor + 1;
 
     DRE::InplaceVector<std::future<void>, parallelFactor> parallelCompilations;
     for (std::uint32_t i = 0; i < parallelFactor; i++)
@@ -608,7 +816,7 @@ void IOManager::CompileGLSLSources()
         parallelCompilations.EmplaceBack(std::async(std::launch::async, [parallelChunkSize, &parallelCompilations, &fileNames, this](std::uint32_t chunkID) 
             {
                 std::uint32_t chunkStart = chunkID * parallelChunkSize;
-                std::uint32_t chunkEnd = DRE::Min((chunkID + 1) * parallelChunkSize, fileNames.Size());
+                std::uint32_t chunkEnd = DRE::Min((chunkID + 1) * parallelChunkSize, std::uint32_t(fileNames.size()));
 
                 for (std::uint32_t j = chunkStart; j < chunkEnd; j++)
                 {
@@ -626,30 +834,47 @@ void IOManager::CompileGLSLSources()
     {
         parallelCompilations[i].wait();
     }
+
+    // sources can change after this point, hot reload reads them from disk
+    m_ShaderSourceCache.Clear();
+}
+
+AsyncTask IOManager::LoadShaderBinaryAsync(DRE::String256 path, DRE::String64 name)
+{
+    DRE::ByteBuffer moduleBuffer = co_await ReadFile(path.GetData());
+
+    // reflection runs on the IO worker
+    ShaderData shaderData{};
+    shaderData.m_Binary = DRE_MOVE(moduleBuffer);
+
+    spirv_cross::Compiler compiler{ reinterpret_cast<std::uint32_t const*>(shaderData.m_Binary.Data()), shaderData.m_Binary.Size() / sizeof(std::uint32_t) };
+    shaderData.m_ModuleType = SPVExecutionModelToVKWModuleType(compiler.get_execution_model());
+
+    ParseShaderInterface(compiler, shaderData.m_Interface);
+
+    // m_ShaderData uses main allocator
+    co_await SwitchToMainThread();
+    m_ShaderData.Emplace(name.GetData()) = DRE_MOVE(shaderData);
 }
 
 void IOManager::LoadShaderBinaries()
 {
+    DRE_CPU_SCOPE(LoadShaderBinaries);
+
     std::filesystem::recursive_directory_iterator dir_iterator{ "shaders", std::filesystem::directory_options::follow_directory_symlink };
+    DRE::Vector<AsyncTask, DRE::AllocatorLinear> loadTasks{ &DRE::g_FrameScratchAllocator };
 
     for (auto const& entry : dir_iterator)
     {
         if (entry.path().has_extension() && entry.path().extension() == ".spv")
         {
             // .stem() is a filename without extension
-            ShaderData& shaderData = m_ShaderData.Emplace(entry.path().stem().generic_string().c_str());
-
-            DRE::ByteBuffer moduleBuffer{ static_cast<std::uint64_t>(entry.file_size()) };
-            ReadFileToBuffer(entry.path().generic_string().c_str(), &moduleBuffer);
-            shaderData.m_Binary = DRE_MOVE(moduleBuffer);
-            
-            spirv_cross::Compiler compiler{ reinterpret_cast<std::uint32_t const*>(shaderData.m_Binary.Data()), shaderData.m_Binary.Size() / sizeof(std::uint32_t) };
-            shaderData.m_ModuleType = SPVExecutionModelToVKWModuleType(compiler.get_execution_model());
-
-            ParseShaderInterface(compiler, shaderData.m_Interface); 
+            loadTasks.EmplaceBack(LoadShaderBinaryAsync(entry.path().generic_string().c_str(), entry.path().stem().generic_string().c_str()));
         }
     }
 
+    WaitForTasks(loadTasks.Data(), loadTasks.Size());
+
     m_ShaderObserverThread = std::thread{ &IOManager::ShaderObserver, this };
 }
 
@@ -659,7 +884,7 @@ void IOManager::ShaderObserver()
     HANDLE directoryHandle = CreateFileA("shaders", GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS, NULL);
     if (directoryHandle == INVALID_HANDLE_VALUE)
     {
-        std::cout << "IOManager::ShaderObserver: Failed to create directory handle. Terminating thread." << std::endl;
+        DRE_LOG_ERROR("IOManager::ShaderObserver: Failed to create directory handle. Terminating thread.");
         return;
     }
 
@@ -670,7 +895,7 @@ void IOManager::ShaderObserver()
         DWORD bytesReturned = 0;
         if (ReadDirectoryChangesW(directoryHandle, bufferPtr, 1024, FALSE, FILE_NOTIFY_CHANGE_LAST_WRITE, &bytesReturned, NULL, NULL) == 0)
         {
-            std::cout << "IOManager::ShaderObserver: Failed to get directory changes." << std::endl;
+            DRE_LOG_ERROR("IOManager::ShaderObserver: Failed to get directory changes.");
         }
         
         FILE_NOTIFY_INFORMATION* infoPtr = reinterpret_cast<FILE_NOTIFY_INFORMATION*>(bufferPtr);
@@ -678,7 +903,7 @@ void IOManager::ShaderObserver()
         {
             if (infoPtr->Action != FILE_ACTION_MODIFIED)
             {
-                std::cout << "IOManager::ShaderObserver: Unsupported file event. Terminating thread." << std::endl;
+                DRE_LOG_ERROR("IOManager::ShaderObserver: Unsupported file event. Terminating thread.");
                 return;
             }
 
@@ -686,7 +911,7 @@ void IOManager::ShaderObserver()
             int const length = WideCharToMultiByte(CP_UTF8, 0, infoPtr->FileName, infoPtr->FileNameLength / sizeof(WCHAR), fileName, 64, NULL, NULL);
             if (length == 0)
             {
-                std::cout << "IOManager::ShaderObserver: Failed to get ASCII file name from the event." << std::endl;
+                DRE_LOG_ERROR("IOManager::ShaderObserver: Failed to get ASCII file name from the event.");
             }
             fileName[length] = '\0';
 
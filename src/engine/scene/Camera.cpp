@@ -24,7 +24,7 @@ void Camera::SetCameraEuler(glm::vec3 euler)
     m_SceneNode->SetEulerOrientation(m_CameraEuler);
 }
 
-glm::vec3 const& Camera::GetCameraEuler(glm::vec3 euler) const
+glm::vec3 const& Camera::GetCameraEuler() const
 {
     return m_CameraEuler;
 }
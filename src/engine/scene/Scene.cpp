@@ -10,6 +10,8 @@ namespace WORLD
 
 Scene* g_MainScene = nullptr;
 
+static_assert(Scene::ENTITY_BUCKETS_COUNT >= C_MAX_RENDERABLE_OBJECTS, "Scene must fit every renderable GraphicsManager can hand out.");
+
 Scene::Scene(DRE::DefaultAllocator* allocator)
     : m_SceneEntities{}
     , m_EntityCounter{ 0u }
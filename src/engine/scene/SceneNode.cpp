@@ -1,8 +1,9 @@
 #include <engine\scene\SceneNode.hpp>
 
+#include <glm\geometric.hpp>
+#include <glm\trigonometric.hpp>
+
 #include <foundation\memory\Memory.hpp>
-#include <gfx\GraphicsManager.hpp>
-#include <engine\data\Material.hpp>
 
 
 namespace WORLD
@@ -0,0 +1,238 @@
+#include <engine\scene\SyntheticScene.hpp>
+
+#include <foundation\memory\ByteBuffer.hpp>
+#include <foundation\container\Vector.hpp>
+#include <foundation\string\InplaceString.hpp>
+#include <foundation\system\Log.hpp>
+
+#include <engine\data\Geometry.hpp>
+#include <engine\data\GeometryLibrary.hpp>
+#include <engine\data\Material.hpp>
+#include <engine\data\MaterialLibrary.hpp>
+#include <engine\scene\Scene.hpp>
+
+#include <gfx\GraphicsManager.hpp>
+
+#include <glm\geometric.hpp>
+#include <glm\trigonometric.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+namespace WORLD
+{
+
+namespace
+{
+
+struct XorShift32
+{
+    DRE::U32 m_State;
+
+    DRE::U32 Next()
+    {
+        m_State ^= m_State << 13;
+        m_State ^= m_State >> 17;
+        m_State ^= m_State << 5;
+        return m_State;
+    }
+
+    float NextFloat() { return static_cast<float>(Next() >> 8) / static_cast<float>(1 << 24); }
+};
+
+Data::Geometry GenerateSphere(DRE::U32 rings, DRE::U32 segments, float radius)
+{
+    float constexpr PI = 3.14159265358979f;
+
+    Data::Geometry geometry{ sizeof(Data::DREVertex), sizeof(Data::DREIndex) };
+    geometry.ResizeVertexStorage((rings + 1) * (segments + 1));
+    geometry.ResizeIndexStorage(rings * segments * 6);
+
+    for (DRE::U32 r = 0; r <= rings; r++)
+    {
+        float const phi = PI * static_cast<float>(r) / static_cast<float>(rings);
+        for (DRE::U32 s = 0; s <= segments; s++)
+        {
+            float const theta = 2.0f * PI * static_cast<float>(s) / static_cast<float>(segments);
+
+            glm::vec3 const normal{ std::sin(phi) * std::cos(theta), std::cos(phi), std::sin(phi) * std::sin(theta) };
+            glm::vec3 const tangent{ -std::sin(theta), 0.0f, std::cos(theta) };
+            glm::vec3 const bitangent = glm::cross(normal, tangent);
+
+            Data::DREVertex& v = geometry.GetVertex<Data::DREVertex>(r * (segments + 1) + s);
+            for (DRE::U32 i = 0; i < 3; i++)
+            {
+                v.pos[i] = normal[i] * radius;
+                v.norm[i] = normal[i];
+                v.tan[i] = tangent[i];
+                v.btan[i] = bitangent[i];
+            }
+            v.uv0[0] = static_cast<float>(s) / static_cast<float>(segments);
+            v.uv0[1] = static_cast<float>(r) / static_cast<float>(rings);
+        }
+    }
+
+    DRE::U32 index = 0;
+    for (DRE::U32 r = 0; r < rings; r++)
+    {
+        for (DRE::U32 s = 0; s < segments; s++)
+        {
+            Data::DREIndex const a = r * (segments + 1) + s;
+            Data::DREIndex const b = a + segments + 1;
+
+            geometry.GetIndex<Data::DREIndex>(index++) = a;
+            geometry.GetIndex<Data::DREIndex>(index++) = b;
+            geometry.GetIndex<Data::DREIndex>(index++) = a + 1;
+
+            geometry.GetIndex<Data::DREIndex>(index++) = a + 1;
+            geometry.GetIndex<Data::DREIndex>(index++) = b;
+            geometry.GetIndex<Data::DREIndex>(index++) = b + 1;
+        }
+    }
+
+    return geometry;
+}
+
+// 4x4 solid color, hues spread by the golden ratio so neighbouring materials are easy to tell apart
+Data::Texture2D GenerateAlbedo(char const* name, DRE::U32 materialID)
+{
+    DRE::U32 constexpr SIZE = 4;
+
+    float const hue = std::fmod(static_cast<float>(materialID) * 0.618034f, 1.0f) * 6.0f;
+    float const x = 1.0f - std::fabs(std::fmod(hue, 2.0f) - 1.0f);
+    glm::vec3 rgb;
+    switch (static_cast<DRE::U32>(hue))
+    {
+    case 0: rgb = glm::vec3{ 1.0f, x, 0.0f }; break;
+    case 1: rgb = glm::vec3{ x, 1.0f, 0.0f }; break;
+    case 2: rgb = glm::vec3{ 0.0f, 1.0f, x }; break;
+    case 3: rgb = glm::vec3{ 0.0f, x, 1.0f }; break;
+    case 4: rgb = glm::vec3{ x, 0.0f, 1.0f }; break;
+    default: rgb = glm::vec3{ 1.0f, 0.0f, x }; break;
+    }
+
+    DRE::ByteBuffer pixels{ SIZE * SIZE * 4 };
+    DRE::U8* texel = pixels.As<DRE::U8*>();
+    for (DRE::U32 i = 0; i < SIZE * SIZE; i++)
+    {
+        texel[i * 4 + 0] = static_cast<DRE::U8>(rgb.r * 255.0f);
+        texel[i * 4 + 1] = static_cast<DRE::U8>(rgb.g * 255.0f);
+        texel[i * 4 + 2] = static_cast<DRE::U8>(rgb.b * 255.0f);
+        texel[i * 4 + 3] = 255;
+    }
+
+    Data::Texture2D texture;
+    texture.InitFromMemory(name, SIZE, SIZE, VKW::FORMAT_R8G8B8A8_UNORM, DRE_MOVE(pixels));
+    return texture;
+}
+
+}
+
+SyntheticSceneGenerator::SyntheticSceneGenerator(Data::MaterialLibrary* materialLibrary, Data::GeometryLibrary* geometryLibrary)
+    : m_MaterialLibrary{ materialLibrary }
+    , m_GeometryLibrary{ geometryLibrary }
+    , m_BatchesCount{ 0 }
+{
+}
+
+SceneNode* SyntheticSceneGenerator::Generate(SyntheticSceneDesc const& desc, Scene& targetScene, VKW::Context& context)
+{
+    DRE::U32 const meshesCount = desc.m_MeshesCount > 0 ? desc.m_MeshesCount : 1;
+    DRE::U32 const materialsCount = desc.m_MaterialsCount > 0 ? desc.m_MaterialsCount : 1;
+
+    // every object takes a renderable from GraphicsManager's fixed pool
+    DRE::U32 const objectsCount = std::min(desc.m_ObjectsCount, GFX::g_GraphicsManager->GetFreeRenderableObjectsCount());
+    if (objectsCount < desc.m_ObjectsCount)
+    {
+        DRE_LOG_WARNING("Synthetic scene: %u objects requested, only %u renderable objects are free. Generating %u.",
+            desc.m_ObjectsCount, objectsCount, objectsCount);
+    }
+
+    char sceneName[32];
+    std::snprintf(sceneName, sizeof(sceneName), "synthetic_%u", m_BatchesCount++);
+
+    SceneNode* batchNode = targetScene.CreateSceneNode(nullptr, targetScene.GetRootNode());
+    batchNode->SetName(sceneName);
+
+    // every next mesh is a bit denser, radius cycles so size doesn't follow triangle count
+    for (DRE::U32 i = 0; i < meshesCount; i++)
+    {
+        DRE::U32 const rings = 8 + i * 2;
+        float const radius = 0.3f + 0.2f * static_cast<float>(i % 3) / 2.0f;
+        m_GeometryLibrary->AddGeometry(i, sceneName, GenerateSphere(rings, rings * 2, radius));
+    }
+
+    char name[64];
+    for (DRE::U32 i = 0; i < materialsCount; i++)
+    {
+        std::snprintf(name, sizeof(name), "%s_mat_%u", sceneName, i);
+        Data::Material* material = m_MaterialLibrary->CreateMaterial(i, sceneName, name);
+        material->AssignTextureToSlot(Data::Material::TextureProperty::DIFFUSE, GenerateAlbedo(name, i));
+        material->GetRenderingProperties().SetMaterialType(Data::Material::RenderingProperties::MATERIAL_TYPE_OPAQUE);
+        material->GetRenderingProperties().SetShader("default_pbr");
+    }
+
+    // objects form full trees of treeSize nodes laid out in breadth-first order
+    DRE::U32 treeSize = 1;
+    if (desc.m_FanOut > 0)
+    {
+        DRE::U32 levelSize = 1;
+        for (DRE::U32 level = 1; level < desc.m_HierarchyDepth && treeSize < objectsCount; level++)
+        {
+            levelSize *= desc.m_FanOut;
+            treeSize += levelSize;
+        }
+    }
+
+    DRE::U32 const gridSide = static_cast<DRE::U32>(std::ceil(std::sqrt(static_cast<float>(objectsCount))));
+    auto gridPosition = [&desc, gridSide](DRE::U32 i, float height)
+    {
+        float const x = static_cast<float>(i % gridSide) - static_cast<float>(gridSide) * 0.5f;
+        float const z = static_cast<float>(i / gridSide) - static_cast<float>(gridSide) * 0.5f;
+        return glm::vec3{ x * desc.m_Spacing, height, z * desc.m_Spacing };
+    };
+
+    XorShift32 random{ desc.m_Seed != 0 ? desc.m_Seed : 1 };
+
+    DRE::Vector<Entity*, DRE::DefaultAllocator> objects{ &DRE::g_MainAllocator };
+    DRE::Vector<glm::vec3, DRE::DefaultAllocator> positions{ &DRE::g_MainAllocator };
+    objects.Resize(objectsCount);
+    positions.Resize(objectsCount);
+
+    for (DRE::U32 i = 0; i < objectsCount; i++)
+    {
+        DRE::U32 const treeRoot = i - i % treeSize;
+        DRE::U32 const localID = i - treeRoot;
+        DRE::U32 const parentID = localID > 0 ? treeRoot + (localID - 1) / desc.m_FanOut : DRE_U32_MAX;
+
+        Data::Geometry* geometry = m_GeometryLibrary->GetGeometry(random.Next() % meshesCount, sceneName);
+        Data::Material* material = m_MaterialLibrary->GetMaterial(random.Next() % materialsCount, sceneName);
+
+        SceneNode* parentNode = parentID != DRE_U32_MAX ? objects[parentID]->GetSceneNode() : batchNode;
+        Entity* entity = targetScene.CreateOpaqueEntity(context, geometry, material, parentNode);
+
+        // parents are never rotated or scaled, local position is just the difference
+        positions[i] = gridPosition(i, random.NextFloat() * desc.m_Spacing * 0.5f);
+        entity->SetPosition(parentID != DRE_U32_MAX ? positions[i] - positions[parentID] : positions[i]);
+
+        std::snprintf(name, sizeof(name), "object_%u", i);
+        entity->GetSceneNode()->SetName(name);
+
+        objects[i] = entity;
+    }
+
+    for (DRE::U32 i = 0; i < desc.m_LightsCount; i++)
+    {
+        Light* light = targetScene.CreateDirectionalLight(context, batchNode);
+        light->SetEulerOrientation(glm::vec3{ -30.0f - 40.0f * random.NextFloat(), 360.0f * static_cast<float>(i) / static_cast<float>(desc.m_LightsCount), 0.0f });
+        light->ScheduleUpdateGPUData();
+    }
+
+    DRE_LOG_INFO("Synthetic scene %s: %u objects (trees of %u), %u meshes, %u materials, %u lights",
+        sceneName, objectsCount, treeSize, meshesCount, materialsCount, desc.m_LightsCount);
+
+    return batchNode;
+}
+
+}
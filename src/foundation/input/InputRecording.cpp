@@ -0,0 +1,94 @@
+#include <foundation\input\InputRecording.hpp>
+
+#include <cstdio>
+
+namespace SYS
+{
+
+static constexpr DRE::U32 C_INPUT_RECORDING_MAGIC = 0x49455244; // "DREI"
+static constexpr DRE::U32 C_INPUT_RECORDING_VERSION = 1;
+
+struct InputRecordingHeader
+{
+    DRE::U32 m_Magic;
+    DRE::U32 m_Version;
+    DRE::U32 m_FrameSize;
+    DRE::U32 m_FramesCount;
+};
+
+InputRecording::InputRecording()
+    : m_Frames{ &DRE::g_MainAllocator }
+    , m_ReplayCursor{ DRE_U32_MAX }
+{
+}
+
+void InputRecording::Clear()
+{
+    m_Frames.Clear();
+    m_ReplayCursor = DRE_U32_MAX;
+}
+
+InputFrame& InputRecording::AddFrame()
+{
+    return m_Frames.EmplaceBack();
+}
+
+bool InputRecording::Write(char const* path) const
+{
+    std::FILE* file = std::fopen(path, "wb");
+    if (file == nullptr)
+        return false;
+
+    InputRecordingHeader const header{ C_INPUT_RECORDING_MAGIC, C_INPUT_RECORDING_VERSION, sizeof(InputFrame), m_Frames.Size() };
+    bool result = std::fwrite(&header, sizeof(header), 1, file) == 1;
+    if (result && !m_Frames.Empty())
+        result = std::fwrite(m_Frames.Data(), sizeof(InputFrame), m_Frames.Size(), file) == m_Frames.Size();
+
+    return std::fclose(file) == 0 && result;
+}
+
+bool InputRecording::Read(char const* path)
+{
+    Clear();
+
+    std::FILE* file = std::fopen(path, "rb");
+    if (file == nullptr)
+        return false;
+
+    InputRecordingHeader header{};
+    bool result = std::fread(&header, sizeof(header), 1, file) == 1;
+    result = result && header.m_Magic == C_INPUT_RECORDING_MAGIC && header.m_Version == C_INPUT_RECORDING_VERSION && header.m_FrameSize == sizeof(InputFrame);
+    if (result)
+    {
+        m_Frames.Resize(header.m_FramesCount);
+        result = header.m_FramesCount == 0 || std::fread(m_Frames.Data(), sizeof(InputFrame), header.m_FramesCount, file) == header.m_FramesCount;
+    }
+    std::fclose(file);
+
+    if (!result)
+        m_Frames.Clear();
+
+    return result;
+}
+
+void InputRecording::StartReplay(InputSystem& inputSystem)
+{
+    m_ReplayCursor = 0;
+    inputSystem.SetExternalSource(!m_Frames.Empty());
+}
+
+InputFrame const* InputRecording::ApplyNextFrame(InputSystem& inputSystem)
+{
+    if (!IsReplaying())
+        return nullptr;
+
+    InputFrame const& frame = m_Frames[m_ReplayCursor++];
+    inputSystem.InjectState(frame.m_MouseState, frame.m_KeyboardState);
+
+    if (!IsReplaying())
+        inputSystem.SetExternalSource(false);
+
+    return &frame;
+}
+
+}
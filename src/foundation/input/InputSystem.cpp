@@ -21,6 +21,7 @@ InputSystem::InputSystem()
     , pendingKeyboardState_{}
     , prevKeyboardState_{}
     , keyboardState_{}
+    , externalSource_{ false }
 {
     DRE::MemZero(&pendingMouseState_, sizeof(pendingMouseState_));
     DRE::MemZero(&mouseState_, sizeof(mouseState_));
@@ -38,6 +39,7 @@ InputSystem::InputSystem(HWND windowHandle)
     , pendingKeyboardState_{}
     , prevKeyboardState_{}
     , keyboardState_{}
+    , externalSource_{ false }
 {
     DRE::MemZero(&pendingMouseState_, sizeof(pendingMouseState_));
     DRE::MemZero(&mouseState_, sizeof(mouseState_));
@@ -131,6 +133,22 @@ InputSystem::MouseState const& InputSystem::GetMouseState() const
     return mouseState_;
 }
 
+InputSystem::KeyboardState const& InputSystem::GetKeyboardState() const
+{
+    return keyboardState_;
+}
+
+void InputSystem::SetExternalSource(bool external)
+{
+    externalSource_ = external;
+}
+
+void InputSystem::InjectState(MouseState const& mouseState, KeyboardState const& keyboardState)
+{
+    pendingMouseState_ = mouseState;
+    pendingKeyboardState_ = keyboardState;
+}
+
 bool InputSystem::GetLeftMouseButtonPressed() const
 {
     return mouseState_.mouseButtonStates_ & 1 << (int)MouseState::Left;
@@ -239,6 +257,9 @@ void InputSystem::Update()
 
 void InputSystem::ProcessSystemInput(HWND handle, WPARAM wparam, LPARAM lparam)
 {
+    if (externalSource_)
+        return;
+
     UINT dataSize = 0;
 
     UINT result = GetRawInputData((HRAWINPUT)lparam, RID_INPUT, NULL, &dataSize, sizeof(RAWINPUTHEADER));
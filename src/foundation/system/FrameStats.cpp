@@ -0,0 +1,181 @@
+#include <foundation\system\FrameStats.hpp>
+
+#include <foundation\system\Profiler.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+DRE_BEGIN_NAMESPACE
+
+FrameStats g_FrameStats;
+
+namespace
+{
+
+FrameStats::Percentiles ComputePercentiles(float* values, U32 count)
+{
+    if (count == 0)
+        return FrameStats::Percentiles{};
+
+    std::sort(values, values + count);
+
+    // nearest rank
+    auto rank = [values, count](float percentile)
+    {
+        U32 const index = static_cast<U32>(percentile * static_cast<float>(count - 1) + 0.5f);
+        return values[index];
+    };
+
+    return FrameStats::Percentiles{ rank(0.5f), rank(0.95f), rank(0.99f), values[count - 1] };
+}
+
+}
+
+FrameStats::FrameStats()
+    : m_Samples{}
+    , m_SamplesCount{ 0 }
+    , m_Hitches{}
+    , m_HitchesCount{ 0 }
+    , m_HitchThresholdMS{ 33.3f }
+{
+}
+
+void FrameStats::AddFrame(U64 frame, float cpuMS, float gpuMS, float presentWaitMS)
+{
+    float const frameMS = cpuMS + presentWaitMS;
+    bool const hitch = frameMS > m_HitchThresholdMS;
+
+    m_Samples[m_SamplesCount % MAX_SAMPLES] = Sample{ frame, cpuMS, gpuMS, presentWaitMS, hitch };
+    m_SamplesCount++;
+
+    if (!hitch)
+        return;
+
+    Hitch& record = m_Hitches[m_HitchesCount % MAX_HITCHES];
+    record.m_Frame = frame;
+    record.m_FrameMS = frameMS;
+    record.m_ZonesCount = 0;
+    CollectHitchZones(record);
+    m_HitchesCount++;
+}
+
+FrameStats::Summary FrameStats::ComputeSummary(U32 windowSize) const
+{
+    U32 const count = windowSize < GetSamplesCount() ? windowSize : GetSamplesCount();
+
+    float values[MAX_SAMPLES];
+    Summary summary{};
+    summary.m_SamplesCount = count;
+
+    auto gather = [this, &values, count](auto&& getter)
+    {
+        for (U32 i = 0; i < count; i++)
+        {
+            values[i] = getter(GetSample(i));
+        }
+    };
+
+    gather([](Sample const& s) { return s.m_CPUMS + s.m_PresentWaitMS; });
+    summary.m_Frame = ComputePercentiles(values, count);
+
+    gather([](Sample const& s) { return s.m_CPUMS; });
+    summary.m_CPU = ComputePercentiles(values, count);
+
+    gather([](Sample const& s) { return s.m_GPUMS; });
+    summary.m_GPU = ComputePercentiles(values, count);
+
+    gather([](Sample const& s) { return s.m_PresentWaitMS; });
+    summary.m_PresentWait = ComputePercentiles(values, count);
+
+    return summary;
+}
+
+FrameStats::Sample const& FrameStats::GetSample(U32 offset) const
+{
+    DRE_ASSERT(offset < GetSamplesCount(), "FrameStats: invalid sample offset.");
+    return m_Samples[(m_SamplesCount - 1 - offset) % MAX_SAMPLES];
+}
+
+FrameStats::Hitch const& FrameStats::GetHitch(U32 offset) const
+{
+    DRE_ASSERT(offset < GetHitchesCount(), "FrameStats: invalid hitch offset.");
+    return m_Hitches[(m_HitchesCount - 1 - offset) % MAX_HITCHES];
+}
+
+void FrameStats::CollectHitchZones(Hitch& hitch) const
+{
+#if defined(DRE_PROFILER_ENABLED)
+    U64 startTicks = 0;
+    U64 endTicks = 0;
+    Profiler::ThreadData const* thread = Profiler::GetThreadData();
+    if (thread == nullptr || !Profiler::GetFrameRange(0, startTicks, endTicks))
+        return;
+
+    U32 constexpr MAX_DEPTH = 32;
+    U32 constexpr MAX_NAMES = 64;
+
+    struct NameTime
+    {
+        char const* m_Name;
+        U64         m_SelfTicks;
+    };
+    NameTime names[MAX_NAMES];
+    U32 namesCount = 0;
+
+    // events are written in end order, so children always come before their parent
+    U64 childTicks[MAX_DEPTH + 1] = {};
+    Profiler::ForEachEvent(*thread, startTicks, endTicks, [&](Profiler::Event const& event)
+        {
+            if (event.m_Depth >= MAX_DEPTH)
+                return;
+
+            U64 const duration = event.m_EndTicks - event.m_StartTicks;
+            U64 const children = childTicks[event.m_Depth + 1];
+            U64 const self = duration > children ? duration - children : 0;
+            childTicks[event.m_Depth + 1] = 0;
+            childTicks[event.m_Depth] += duration;
+
+            U32 i = 0;
+            while (i < namesCount && std::strcmp(names[i].m_Name, event.m_Name) != 0)
+                i++;
+
+            if (i == namesCount)
+            {
+                if (namesCount == MAX_NAMES)
+                    return;
+                names[namesCount++] = NameTime{ event.m_Name, 0 };
+            }
+            names[i].m_SelfTicks += self;
+        });
+
+    U32 const zonesCount = namesCount < HITCH_ZONES ? namesCount : HITCH_ZONES;
+    std::partial_sort(names, names + zonesCount, names + namesCount, [](NameTime const& lhs, NameTime const& rhs) { return lhs.m_SelfTicks > rhs.m_SelfTicks; });
+
+    for (U32 i = 0; i < zonesCount; i++)
+    {
+        hitch.m_Zones[i] = HitchZone{ names[i].m_Name, static_cast<float>(Profiler::TicksToMicroseconds(names[i].m_SelfTicks) / 1000.0) };
+    }
+    hitch.m_ZonesCount = zonesCount;
+#endif
+}
+
+bool FrameStats::WriteCSV(char const* path) const
+{
+    std::FILE* file = std::fopen(path, "w");
+    if (file == nullptr)
+        return false;
+
+    std::fprintf(file, "frame,cpu_ms,gpu_ms,present_wait_ms,frame_ms,hitch\n");
+    for (U32 i = GetSamplesCount(); i > 0; i--)
+    {
+        Sample const& sample = GetSample(i - 1);
+        std::fprintf(file, "%llu,%.4f,%.4f,%.4f,%.4f,%u\n",
+            static_cast<unsigned long long>(sample.m_Frame), sample.m_CPUMS, sample.m_GPUMS, sample.m_PresentWaitMS,
+            sample.m_CPUMS + sample.m_PresentWaitMS, sample.m_Hitch ? 1u : 0u);
+    }
+
+    return std::fclose(file) == 0;
+}
+
+DRE_END_NAMESPACE
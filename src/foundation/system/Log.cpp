@@ -0,0 +1,438 @@
+#include <foundation\system\Log.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+DRE_BEGIN_NAMESPACE
+
+namespace
+{
+
+// freed at static destruction after the writer is joined
+std::mutex                  g_RingsMutex;
+std::unique_ptr<Log::ThreadRing> g_Rings[Log::MAX_THREADS];
+std::atomic<U32>            g_RingsCount{ 0 };
+
+// messages of threads that didn't fit into MAX_THREADS
+std::atomic<U64>            g_UnregisteredDropped{ 0 };
+
+char const                  g_SeverityNames[LOG_SEVERITY_MAX] = { 'D', 'I', 'W', 'E' };
+
+U64 TicksPerSecond()
+{
+    static U64 const ticksPerSecond = static_cast<U64>(1000000.0 / Profiler::TicksToMicroseconds(1000000) * 1000000.0);
+    return ticksPerSecond;
+}
+
+// formats one printf conversion with whatever type the argument was captured as
+U32 FormatArg(char* out, U32 capacity, char const* spec, U32 specLength, char conversion, Log::ArgType type, U8 const* data)
+{
+    U64 bits = 0;
+    if (type != Log::ARG_STRING)
+        std::memcpy(&bits, data, sizeof(bits));
+
+    double floatValue = 0.0;
+    std::memcpy(&floatValue, &bits, sizeof(floatValue));
+
+    // flags, width and precision are kept, length modifiers are replaced by the captured type's
+    char format[32];
+    U32 const flagsLength = std::min<U32>(specLength, sizeof(format) - 4);
+    std::memcpy(format, spec, flagsLength);
+
+    int written = 0;
+    switch (conversion)
+    {
+    case 'd': case 'i': case 'u': case 'x': case 'X': case 'o': case 'c':
+        if (type == Log::ARG_FLOAT)
+            bits = static_cast<U64>(static_cast<S64>(floatValue));
+
+        if (conversion == 'c')
+        {
+            format[flagsLength] = 'c';
+            format[flagsLength + 1] = '\0';
+            written = std::snprintf(out, capacity, format, static_cast<int>(bits));
+            break;
+        }
+        format[flagsLength] = 'l';
+        format[flagsLength + 1] = 'l';
+        format[flagsLength + 2] = conversion;
+        format[flagsLength + 3] = '\0';
+        written = std::snprintf(out, capacity, format, bits);
+        break;
+
+    case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+        if (type == Log::ARG_SIGNED)
+            floatValue = static_cast<double>(static_cast<S64>(bits));
+        else if (type == Log::ARG_UNSIGNED || type == Log::ARG_POINTER)
+            floatValue = static_cast<double>(bits);
+
+        format[flagsLength] = conversion;
+        format[flagsLength + 1] = '\0';
+        written = std::snprintf(out, capacity, format, floatValue);
+        break;
+
+    case 'p':
+        written = std::snprintf(out, capacity, "%p", reinterpret_cast<void*>(static_cast<UPtr>(bits)));
+        break;
+
+    default: // 's' and anything unknown
+        format[flagsLength] = 's';
+        format[flagsLength + 1] = '\0';
+        if (type == Log::ARG_STRING)
+            written = std::snprintf(out, capacity, format, reinterpret_cast<char const*>(data + sizeof(U32)));
+        else if (type == Log::ARG_FLOAT)
+            written = std::snprintf(out, capacity, "%g", floatValue);
+        else if (type == Log::ARG_SIGNED)
+            written = std::snprintf(out, capacity, "%lld", static_cast<long long>(bits));
+        else
+            written = std::snprintf(out, capacity, "%llu", static_cast<unsigned long long>(bits));
+        break;
+    }
+
+    return written < 0 ? 0 : std::min<U32>(static_cast<U32>(written), capacity - 1);
+}
+
+U32 FormatMessage(char* out, U32 capacity, Log::RecordHeader const& header)
+{
+    U8 const* argData = reinterpret_cast<U8 const*>(&header) + sizeof(Log::RecordHeader);
+    U32 argIndex = 0;
+    U32 length = 0;
+
+    for (char const* c = header.m_Format; *c != '\0' && length + 1 < capacity; c++)
+    {
+        if (*c != '%')
+        {
+            out[length++] = *c;
+            continue;
+        }
+
+        if (c[1] == '%' || c[1] == '\0')
+        {
+            out[length++] = '%';
+            c += c[1] == '%' ? 1 : 0;
+            continue;
+        }
+
+        char const* const spec = c;
+        c++;
+        while (*c != '\0' && std::strchr("-+ #0123456789.*", *c) != nullptr)
+            c++;
+        U32 const specLength = static_cast<U32>(c - spec);
+        while (*c != '\0' && std::strchr("hljztL", *c) != nullptr)
+            c++;
+        if (*c == '\0')
+            break;
+
+        if (argIndex >= header.m_ArgsCount)
+        {
+            length += std::snprintf(out + length, capacity - length, "<missing>");
+            length = std::min(length, capacity - 1);
+            continue;
+        }
+
+        Log::ArgType const type = header.m_ArgTypes[argIndex++];
+        length += FormatArg(out + length, capacity - length, spec, specLength, *c, type, argData);
+
+        if (type == Log::ARG_STRING)
+        {
+            U32 stringLength = 0;
+            std::memcpy(&stringLength, argData, sizeof(stringLength));
+            argData += (sizeof(U32) + stringLength + 8) & ~7u;
+        }
+        else
+        {
+            argData += sizeof(U64);
+        }
+    }
+
+    out[length] = '\0';
+    return length;
+}
+
+class LogWriter
+{
+public:
+    LogWriter()
+        : m_BaseTicks{ Profiler::Ticks() }
+        , m_FlushRequested{ 0 }
+        , m_FlushCompleted{ 0 }
+        , m_Stop{ false }
+        , m_File{ nullptr }
+        , m_Thread{ [this]() { Run(); } }
+    {
+    }
+
+    ~LogWriter()
+    {
+        {
+            std::lock_guard<std::mutex> lock{ m_Mutex };
+            m_Stop = true;
+        }
+        m_WakeUp.notify_one();
+        m_Thread.join();
+
+        if (m_File != nullptr)
+            std::fclose(m_File);
+    }
+
+    void Flush()
+    {
+        std::unique_lock<std::mutex> lock{ m_Mutex };
+        U64 const ticket = ++m_FlushRequested;
+        m_WakeUp.notify_one();
+        m_Flushed.wait(lock, [this, ticket]() { return m_FlushCompleted >= ticket || m_Stop; });
+    }
+
+    bool SetFileSink(char const* path)
+    {
+        std::FILE* file = path != nullptr ? std::fopen(path, "w") : nullptr;
+
+        std::lock_guard<std::mutex> lock{ m_SinkMutex };
+        if (m_File != nullptr)
+            std::fclose(m_File);
+        m_File = file;
+
+        return path == nullptr || file != nullptr;
+    }
+
+private:
+    struct Line
+    {
+        U64 m_Ticks;
+        U32 m_Offset;
+        U32 m_Length;
+    };
+
+    void Run()
+    {
+        DRE_CPU_THREAD_NAME("Log");
+
+        for (;;)
+        {
+            U64 ticket = 0;
+            bool stop = false;
+            {
+                std::unique_lock<std::mutex> lock{ m_Mutex };
+                m_WakeUp.wait_for(lock, std::chrono::milliseconds{ 10 }, [this]() { return m_Stop || m_FlushRequested != m_FlushCompleted; });
+                ticket = m_FlushRequested;
+                stop = m_Stop;
+            }
+
+            Drain();
+
+            {
+                std::lock_guard<std::mutex> lock{ m_Mutex };
+                m_FlushCompleted = ticket;
+            }
+            m_Flushed.notify_all();
+
+            if (stop)
+                break;
+        }
+    }
+
+    void Drain()
+    {
+        m_Text.clear();
+        m_Lines.clear();
+
+        bool hasErrors = false;
+        char message[Log::MAX_STRING_ARG * 2];
+
+        for (U32 i = 0, size = g_RingsCount.load(std::memory_order_acquire); i < size; i++)
+        {
+            Log::ThreadRing& ring = *g_Rings[i];
+
+            U64 readOffset = ring.m_ReadOffset.load(std::memory_order_relaxed);
+            U64 const writeOffset = ring.m_WriteOffset.load(std::memory_order_acquire);
+            while (readOffset < writeOffset)
+            {
+                U32 const position = static_cast<U32>(readOffset % Log::RING_SIZE);
+                if (Log::RING_SIZE - position < sizeof(Log::RecordHeader))
+                {
+                    readOffset += Log::RING_SIZE - position;
+                    continue;
+                }
+
+                Log::RecordHeader const& header = *reinterpret_cast<Log::RecordHeader const*>(ring.m_Data + position);
+                readOffset += header.m_Size;
+                if (header.m_Format == nullptr)
+                    continue;
+
+                FormatMessage(message, sizeof(message), header);
+                AddLine(header.m_Ticks, header.m_Severity, ring.m_ThreadID, message, header.m_Suppressed);
+                hasErrors |= header.m_Severity == LOG_SEVERITY_ERROR;
+            }
+            ring.m_ReadOffset.store(readOffset, std::memory_order_release);
+
+            U64 const dropped = ring.m_Dropped.exchange(0, std::memory_order_relaxed);
+            if (dropped > 0)
+            {
+                std::snprintf(message, sizeof(message), "%llu messages dropped, log ring buffer was full", static_cast<unsigned long long>(dropped));
+                AddLine(Profiler::Ticks(), LOG_SEVERITY_WARNING, ring.m_ThreadID, message, 0);
+            }
+        }
+
+        U64 const unregisteredDropped = g_UnregisteredDropped.exchange(0, std::memory_order_relaxed);
+        if (unregisteredDropped > 0)
+        {
+            std::snprintf(message, sizeof(message), "%llu messages dropped, logging thread is over Log::MAX_THREADS", static_cast<unsigned long long>(unregisteredDropped));
+            AddLine(Profiler::Ticks(), LOG_SEVERITY_WARNING, 0, message, 0);
+        }
+
+        if (m_Lines.empty())
+            return;
+
+        // rings are drained one after another, restore the global order
+        std::stable_sort(m_Lines.begin(), m_Lines.end(), [](Line const& lhs, Line const& rhs) { return lhs.m_Ticks < rhs.m_Ticks; });
+
+        std::lock_guard<std::mutex> lock{ m_SinkMutex };
+        for (Line const& line : m_Lines)
+        {
+            std::fwrite(m_Text.data() + line.m_Offset, 1, line.m_Length, stdout);
+            if (m_File != nullptr)
+                std::fwrite(m_Text.data() + line.m_Offset, 1, line.m_Length, m_File);
+        }
+        std::fflush(stdout);
+        if (m_File != nullptr && (hasErrors || m_FlushRequested != m_FlushCompleted))
+            std::fflush(m_File);
+    }
+
+    void AddLine(U64 ticks, LogSeverity severity, U32 threadID, char const* message, U32 suppressed)
+    {
+        char prefix[64];
+        double const timeMS = ticks > m_BaseTicks ? Profiler::TicksToMicroseconds(ticks - m_BaseTicks) / 1000.0 : 0.0;
+        int const prefixLength = std::snprintf(prefix, sizeof(prefix), "[%10.3f] %c %5u | ", timeMS, g_SeverityNames[severity < LOG_SEVERITY_MAX ? severity : LOG_SEVERITY_ERROR], threadID);
+
+        U32 const offset = static_cast<U32>(m_Text.size());
+        m_Text.append(prefix, prefixLength);
+        m_Text.append(message);
+        if (suppressed > 0)
+        {
+            char suffix[48];
+            int const suffixLength = std::snprintf(suffix, sizeof(suffix), " (%u similar suppressed)", suppressed);
+            m_Text.append(suffix, suffixLength);
+        }
+        m_Text.push_back('\n');
+
+        m_Lines.emplace_back(Line{ ticks, offset, static_cast<U32>(m_Text.size()) - offset });
+    }
+
+private:
+    U64                         m_BaseTicks;
+
+    std::mutex                  m_Mutex;
+    std::condition_variable     m_WakeUp;
+    std::condition_variable     m_Flushed;
+    U64                         m_FlushRequested;
+    U64                         m_FlushCompleted;
+    bool                        m_Stop;
+
+    std::mutex                  m_SinkMutex;
+    std::FILE*                  m_File;
+
+    // writer thread only
+    std::string                 m_Text;
+    std::vector<Line>           m_Lines;
+
+    std::thread                 m_Thread;
+};
+
+LogWriter& GetWriter()
+{
+    // joined at static destruction, everything logged before exit() makes it to the sinks
+    static LogWriter writer;
+    return writer;
+}
+
+}
+
+Log::ThreadRing* Log::RegisterThread()
+{
+    GetWriter();
+
+    std::lock_guard<std::mutex> lock{ g_RingsMutex };
+    U32 const index = g_RingsCount.load(std::memory_order_relaxed);
+    if (index >= MAX_THREADS)
+        return nullptr;
+
+    // big enough to not go through global allocators, threads can start before or after them
+    ThreadRing* ring = new ThreadRing{};
+    ring->m_ThreadID = static_cast<U32>(GetCurrentThreadId());
+
+    g_Rings[index].reset(ring);
+    g_RingsCount.store(index + 1, std::memory_order_release);
+
+    return ring;
+}
+
+bool Log::PassRateLimit(Site& site, U64 ticks, U32& suppressed)
+{
+    U64 windowStart = site.m_WindowStartTicks.load(std::memory_order_relaxed);
+    if (ticks - windowStart > TicksPerSecond() && site.m_WindowStartTicks.compare_exchange_strong(windowStart, ticks, std::memory_order_relaxed))
+        site.m_WindowCount.store(0, std::memory_order_relaxed);
+
+    if (site.m_WindowCount.fetch_add(1, std::memory_order_relaxed) >= RATE_LIMIT_PER_SECOND)
+    {
+        site.m_Suppressed.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    suppressed = site.m_Suppressed.exchange(0, std::memory_order_relaxed);
+    return true;
+}
+
+void Log::CountUnregisteredDrop()
+{
+    g_UnregisteredDropped.fetch_add(1, std::memory_order_relaxed);
+}
+
+U8* Log::BeginRecord(ThreadRing& ring, U32 size)
+{
+    U32 const recordSize = AlignRecordSize(size);
+    U64 writeOffset = ring.m_WriteOffset.load(std::memory_order_relaxed);
+    U64 const readOffset = ring.m_ReadOffset.load(std::memory_order_acquire);
+
+    // records never wrap, the tail of the ring is skipped if the record doesn't fit
+    U32 const position = static_cast<U32>(writeOffset % RING_SIZE);
+    U32 const padding = RING_SIZE - position < recordSize ? RING_SIZE - position : 0;
+
+    if (writeOffset + padding + recordSize - readOffset > RING_SIZE)
+    {
+        ring.m_Dropped.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    if (padding > 0)
+    {
+        if (padding >= sizeof(RecordHeader))
+        {
+            RecordHeader* paddingHeader = reinterpret_cast<RecordHeader*>(ring.m_Data + position);
+            paddingHeader->m_Format = nullptr;
+            paddingHeader->m_Size = padding;
+        }
+        writeOffset += padding;
+        ring.m_WriteOffset.store(writeOffset, std::memory_order_release);
+    }
+
+    return ring.m_Data + writeOffset % RING_SIZE;
+}
+
+bool Log::SetFileSink(char const* path)
+{
+    return GetWriter().SetFileSink(path);
+}
+
+void Log::Flush()
+{
+    GetWriter().Flush();
+}
+
+DRE_END_NAMESPACE
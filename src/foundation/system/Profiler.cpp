@@ -0,0 +1,184 @@
+#include <foundation\system\Profiler.hpp>
+
+#include <foundation\system\Time.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <fstream>
+
+DRE_BEGIN_NAMESPACE
+
+namespace
+{
+
+// freed at static destruction, worker threads are joined by then
+std::mutex                      g_ThreadsMutex;
+std::unique_ptr<Profiler::ThreadData> g_Threads[Profiler::MAX_THREADS];
+std::atomic<U32>                g_ThreadsCount{ 0 };
+
+U64                             g_FrameTicks[Profiler::MAX_FRAMES];
+U64                             g_FramesCount = 0;
+
+struct TicksCalibration
+{
+    U64     m_BaseTicks;
+    double  m_MicrosecondsPerTick;
+
+    TicksCalibration()
+    {
+        // TSC is invariant on everything we run on, measure its rate against the steady clock once
+        auto const clockStart = std::chrono::steady_clock::now();
+        U64 const ticksStart = Profiler::Ticks();
+
+        std::this_thread::sleep_for(std::chrono::milliseconds{ 20 });
+
+        auto const clockEnd = std::chrono::steady_clock::now();
+        U64 const ticksEnd = Profiler::Ticks();
+
+        double const elapsedUS = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(clockEnd - clockStart).count()) / 1000.0;
+        m_BaseTicks = ticksStart;
+        m_MicrosecondsPerTick = elapsedUS / static_cast<double>(ticksEnd - ticksStart);
+    }
+};
+
+TicksCalibration const& GetCalibration()
+{
+    static TicksCalibration calibration;
+    return calibration;
+}
+
+}
+
+Profiler::ThreadData* Profiler::RegisterThread()
+{
+    std::lock_guard<std::mutex> lock{ g_ThreadsMutex };
+    U32 const index = g_ThreadsCount.load(std::memory_order_relaxed);
+    if (index >= MAX_THREADS)
+        return nullptr;
+
+    // big enough to not go through global allocators, threads can start before or after them
+    ThreadData* data = new ThreadData{};
+    data->m_ThreadID = static_cast<U32>(GetCurrentThreadId());
+    std::snprintf(data->m_Name, sizeof(data->m_Name), "thread_%u", data->m_ThreadID);
+
+    g_Threads[index].reset(data);
+    g_ThreadsCount.store(index + 1, std::memory_order_release);
+
+    return data;
+}
+
+void Profiler::SetThreadName(char const* name)
+{
+    ThreadData* data = GetThreadData();
+    if (data == nullptr)
+        return;
+
+    std::lock_guard<std::mutex> lock{ g_ThreadsMutex };
+    std::snprintf(data->m_Name, sizeof(data->m_Name), "%s", name);
+}
+
+void Profiler::MarkFrame()
+{
+    g_FrameTicks[g_FramesCount % MAX_FRAMES] = Ticks();
+    g_FramesCount++;
+}
+
+double Profiler::TicksToMicroseconds(U64 ticks)
+{
+    return static_cast<double>(ticks) * GetCalibration().m_MicrosecondsPerTick;
+}
+
+U32 Profiler::GetThreadsCount()
+{
+    return g_ThreadsCount.load(std::memory_order_acquire);
+}
+
+Profiler::ThreadData const* Profiler::GetThread(U32 index)
+{
+    DRE_ASSERT(index < GetThreadsCount(), "Profiler: invalid thread index.");
+    return g_Threads[index].get();
+}
+
+bool Profiler::GetFrameRange(U32 frameOffset, U64& startTicks, U64& endTicks)
+{
+    if (frameOffset + 2 > g_FramesCount || frameOffset + 2 > MAX_FRAMES)
+        return false;
+
+    U64 const endMark = g_FramesCount - 1 - frameOffset;
+    startTicks = g_FrameTicks[(endMark - 1) % MAX_FRAMES];
+    endTicks = g_FrameTicks[endMark % MAX_FRAMES];
+
+    return true;
+}
+
+bool Profiler::WriteChromeTrace(char const* path)
+{
+    std::ofstream stream{ path, std::ios_base::out | std::ios_base::trunc };
+    if (!stream)
+        return false;
+
+    U64 const baseTicks = GetCalibration().m_BaseTicks;
+    char line[256];
+    bool first = true;
+
+    stream << "{\"traceEvents\":[\n";
+
+    for (U32 i = 0, size = GetThreadsCount(); i < size; i++)
+    {
+        ThreadData const& thread = *g_Threads[i];
+
+        char threadName[sizeof(thread.m_Name)];
+        {
+            std::lock_guard<std::mutex> lock{ g_ThreadsMutex };
+            std::memcpy(threadName, thread.m_Name, sizeof(threadName));
+        }
+
+        std::snprintf(line, sizeof(line), "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%u,\"args\":{\"name\":\"%s\"}}",
+            first ? "" : ",\n", thread.m_ThreadID, threadName);
+        stream << line;
+        first = false;
+
+        ForEachEvent(thread, 0, DRE_U64_MAX, [&](Event const& event)
+            {
+                if (event.m_StartTicks < baseTicks)
+                    return;
+
+                double const startUS = TicksToMicroseconds(event.m_StartTicks - baseTicks);
+                double const durationUS = TicksToMicroseconds(event.m_EndTicks - event.m_StartTicks);
+                std::snprintf(line, sizeof(line), ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":0,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                    event.m_Name, thread.m_ThreadID, startUS, durationUS);
+                stream << line;
+            });
+    }
+
+    stream << "\n]}\n";
+
+    return static_cast<bool>(stream);
+}
+
+double Profiler::MeasureZoneOverheadNS()
+{
+    U32 constexpr iterations = EVENTS_PER_THREAD;
+
+    // keep the real ring buffer clean
+    ThreadData* const original = GetThreadData();
+    std::unique_ptr<ThreadData> scratch{ new ThreadData{} };
+    s_ThreadData = scratch.get();
+
+    U64 const startTicks = Ticks();
+    for (U32 i = 0; i < iterations; i++)
+    {
+        ProfilerScope scope{ "overhead" };
+    }
+    U64 const endTicks = Ticks();
+
+    s_ThreadData = original;
+
+    return TicksToMicroseconds(endTicks - startTicks) * 1000.0 / iterations;
+}
+
+DRE_END_NAMESPACE
@@ -0,0 +1,152 @@
+#include <foundation\system\TaskGraph.hpp>
+
+#include <foundation\system\Log.hpp>
+#include <foundation\system\Time.hpp>
+
+DRE_BEGIN_NAMESPACE
+
+TaskGraph::TaskGraph(ThreadPool* threadPool)
+    : m_ThreadPool{ threadPool }
+    , m_StartUS{ 0 }
+    , m_TotalTimeUS{ 0 }
+{
+}
+
+TaskGraph::TaskID TaskGraph::AddTask(char const* name, TaskAffinity affinity, TaskFunc&& func, std::initializer_list<TaskID> dependencies)
+{
+    DRE_ASSERT(m_Tasks.Size() < MAX_TASKS, "TaskGraph: too many tasks.");
+
+    TaskID const id = m_Tasks.Size();
+    Task& task = m_Tasks.EmplaceBack();
+    task.m_Name = name;
+    task.m_Affinity = affinity;
+    task.m_Func = DRE_MOVE(func);
+
+    for (TaskID dependency : dependencies)
+    {
+        // tasks can only depend on already added ones, which keeps the graph acyclic
+        DRE_ASSERT(dependency < id, "TaskGraph: invalid dependency.");
+        m_Tasks[dependency].m_Dependents.EmplaceBack(id);
+        task.m_DependenciesCount++;
+    }
+
+    return id;
+}
+
+void TaskGraph::RunTask(TaskID id)
+{
+    Task& task = m_Tasks[id];
+    task.m_StartUS = Stopwatch::GlobalTimeMicroseconds();
+    task.m_Func();
+    task.m_EndUS = Stopwatch::GlobalTimeMicroseconds();
+}
+
+void TaskGraph::Execute()
+{
+    m_StartUS = Stopwatch::GlobalTimeMicroseconds();
+
+    InplaceVector<TaskID, MAX_TASKS> mainThreadReady;
+    InplaceVector<TaskID, MAX_TASKS> completed;
+
+    auto dispatch = [this, &mainThreadReady](TaskID id)
+    {
+        if (m_Tasks[id].m_Affinity == TASK_AFFINITY_MAIN_THREAD)
+        {
+            mainThreadReady.EmplaceBack(id);
+            return;
+        }
+
+        m_ThreadPool->Submit([this, id]()
+            {
+                RunTask(id);
+                {
+                    std::lock_guard<std::mutex> lock{ m_CompletedMutex };
+                    m_CompletedTasks.EmplaceBack(id);
+                }
+                m_CompletedCondition.notify_one();
+            }, TASK_PRIORITY_HIGH);
+    };
+
+    for (U32 i = 0, size = m_Tasks.Size(); i < size; i++)
+    {
+        m_Tasks[i].m_PendingDependencies = m_Tasks[i].m_DependenciesCount;
+    }
+
+    for (U32 i = 0, size = m_Tasks.Size(); i < size; i++)
+    {
+        if (m_Tasks[i].m_PendingDependencies == 0)
+            dispatch(i);
+    }
+
+    U32 completedCount = 0;
+    while (completedCount < m_Tasks.Size())
+    {
+        if (mainThreadReady.Size() > 0)
+        {
+            // first added goes first, keeps main thread order predictable
+            U32 next = 0;
+            for (U32 i = 1, size = mainThreadReady.Size(); i < size; i++)
+            {
+                if (mainThreadReady[i] < mainThreadReady[next])
+                    next = i;
+            }
+            TaskID const id = mainThreadReady[next];
+            mainThreadReady.RemoveIndex(next);
+
+            RunTask(id);
+            completed.EmplaceBack(id);
+        }
+
+        {
+            std::unique_lock<std::mutex> lock{ m_CompletedMutex };
+            if (completed.Size() == 0 && mainThreadReady.Size() == 0)
+            {
+                m_CompletedCondition.wait(lock, [this]() { return m_CompletedTasks.Size() > 0; });
+            }
+
+            for (U32 i = 0, size = m_CompletedTasks.Size(); i < size; i++)
+            {
+                completed.EmplaceBack(m_CompletedTasks[i]);
+            }
+            m_CompletedTasks.Clear();
+        }
+
+        for (U32 i = 0, size = completed.Size(); i < size; i++)
+        {
+            Task& task = m_Tasks[completed[i]];
+            for (U32 j = 0, dependentsCount = task.m_Dependents.Size(); j < dependentsCount; j++)
+            {
+                TaskID const dependent = task.m_Dependents[j];
+                if (--m_Tasks[dependent].m_PendingDependencies == 0)
+                    dispatch(dependent);
+            }
+        }
+        completedCount += completed.Size();
+        completed.Clear();
+    }
+
+    m_TotalTimeUS = Stopwatch::GlobalTimeMicroseconds() - m_StartUS;
+}
+
+U64 TaskGraph::GetSerialTimeUS() const
+{
+    U64 result = 0;
+    for (U32 i = 0, size = m_Tasks.Size(); i < size; i++)
+    {
+        result += m_Tasks[i].m_EndUS - m_Tasks[i].m_StartUS;
+    }
+    return result;
+}
+
+void TaskGraph::PrintTimings() const
+{
+    for (U32 i = 0, size = m_Tasks.Size(); i < size; i++)
+    {
+        Task const& task = m_Tasks[i];
+        DRE_LOG_INFO("    %s [%s]: start %ums, took %ums", task.m_Name.GetData(), task.m_Affinity == TASK_AFFINITY_WORKER ? "worker" : "main",
+            (task.m_StartUS - m_StartUS) / 1000, (task.m_EndUS - task.m_StartUS) / 1000);
+    }
+    DRE_LOG_INFO("    total %ums, serial %ums", m_TotalTimeUS / 1000, GetSerialTimeUS() / 1000);
+}
+
+DRE_END_NAMESPACE
@@ -0,0 +1,114 @@
+#include <foundation\system\ThreadPool.hpp>
+
+#include <foundation\math\SimpleMath.hpp>
+#include <foundation\system\Profiler.hpp>
+
+DRE_BEGIN_NAMESPACE
+
+ThreadPool::ThreadPool(U32 workerCount)
+    : m_WorkerCount{ DRE::Min(DRE::Max(workerCount, 1u), MAX_WORKERS) }
+    , m_ActiveTasks{ 0 }
+    , m_Terminate{ false }
+{
+    for (U32 i = 0; i < m_WorkerCount; i++)
+    {
+        m_Workers[i] = std::thread{ &ThreadPool::WorkerLoop, this };
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock{ m_QueueMutex };
+        m_Terminate = true;
+    }
+    m_QueueCondition.notify_all();
+
+    for (U32 i = 0; i < m_WorkerCount; i++)
+    {
+        m_Workers[i].join();
+    }
+}
+
+U32 ThreadPool::DefaultWorkerCount()
+{
+    // leave one core for the main thread
+    U32 const hardwareThreads = std::thread::hardware_concurrency();
+    return hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+}
+
+void ThreadPool::Submit(Task&& task, TaskPriority priority)
+{
+    DRE_ASSERT(priority < TASK_PRIORITY_MAX, "Invalid TaskPriority.");
+    {
+        std::lock_guard<std::mutex> lock{ m_QueueMutex };
+        m_Queues[priority].emplace_back(DRE_MOVE(task));
+    }
+    m_QueueCondition.notify_one();
+}
+
+void ThreadPool::WaitIdle()
+{
+    std::unique_lock<std::mutex> lock{ m_QueueMutex };
+    m_IdleCondition.wait(lock, [this]()
+        {
+            if (m_ActiveTasks != 0)
+                return false;
+
+            for (U32 i = 0; i < TASK_PRIORITY_MAX; i++)
+            {
+                if (!m_Queues[i].empty())
+                    return false;
+            }
+            return true;
+        });
+}
+
+void ThreadPool::WorkerLoop()
+{
+    DRE_CPU_THREAD_NAME("ThreadPool worker");
+
+    while (true)
+    {
+        Task task;
+        {
+            std::unique_lock<std::mutex> lock{ m_QueueMutex };
+            m_QueueCondition.wait(lock, [this]()
+                {
+                    if (m_Terminate)
+                        return true;
+
+                    for (U32 i = 0; i < TASK_PRIORITY_MAX; i++)
+                    {
+                        if (!m_Queues[i].empty())
+                            return true;
+                    }
+                    return false;
+                });
+
+            if (m_Terminate)
+                return;
+
+            for (U32 i = 0; i < TASK_PRIORITY_MAX; i++)
+            {
+                if (!m_Queues[i].empty())
+                {
+                    task = DRE_MOVE(m_Queues[i].front());
+                    m_Queues[i].pop_front();
+                    break;
+                }
+            }
+            m_ActiveTasks++;
+        }
+
+        task();
+
+        {
+            std::lock_guard<std::mutex> lock{ m_QueueMutex };
+            m_ActiveTasks--;
+        }
+        m_IdleCondition.notify_all();
+    }
+}
+
+DRE_END_NAMESPACE
@@ -1,12 +1,15 @@
 #include <gfx\GraphicsManager.hpp>
 
 #include <foundation\math\Geometry.hpp>
+#include <foundation\system\Profiler.hpp>
+#include <foundation\system\Time.hpp>
 #include <foundation\system\Window.hpp>
 #include <foundation\input\InputSystem.hpp>
 
 #include <vk_wrapper\Device.hpp>
 #include <vk_wrapper\pipeline\Pipeline.hpp>
 #include <vk_wrapper\pipeline\ShaderModule.hpp>
+#include <vk_wrapper\queue\TimestampQueries.hpp>
 
 #include <gfx\pass\ForwardOpaquePass.hpp>
 #include <gfx\pass\WaterPass.hpp>
@@ -31,18 +34,40 @@ namespace GFX
 {
 
 static constexpr std::uint32_t C_STAGING_ARENA_SIZE         = 1024 * 1024 * 128;
-static constexpr std::uint32_t C_UNIFORM_ARENA_SIZE         = DRE_U16_MAX * 2 - 1;
+static constexpr std::uint32_t C_UNIFORM_ARENA_SIZE         = 1024 * 1024 * 10;    // 8MB for shadow + forward draws of every renderable, 2MB for pass uniforms
 static constexpr std::uint32_t C_READBACK_ARENA_SIZE        = 1024 * 1024 * 64;
 static constexpr std::uint32_t C_PERSISTENT_STORAGE_SIZE    = 1024 * 1024 * 16;
 
+// every renderable takes a main and a shadow set per buffered frame, the rest is left for passes
+static_assert(C_MAX_RENDERABLE_OBJECTS * VKW::CONSTANTS::FRAMES_BUFFERING * 2 < VKW::CONSTANTS::MAX_STANDALONE_SETS, "Standalone descriptor pool can't fit every renderable.");
+
+// instance uniforms are 256 byte aligned, the arena is per buffered frame
+static_assert(C_MAX_RENDERABLE_OBJECTS * 2 * 256 < C_UNIFORM_ARENA_SIZE, "Uniform arena can't fit a frame of renderable draws.");
+
 GraphicsManager* g_GraphicsManager = nullptr;
 
 GraphicsManager::GraphicsManager(HINSTANCE hInstance, SYS::Window* window, IO::IOManager* ioManager, bool debug)
+    : GraphicsManager{ hInstance, window->NativeHandle(), window, ioManager, window->Width(), window->Height(), debug }
+{
+}
+
+GraphicsManager::GraphicsManager(IO::IOManager* ioManager, std::uint32_t width, std::uint32_t height, bool debug)
+    : GraphicsManager{ NULL, NULL, nullptr, ioManager, width, height, debug }
+{
+}
+
+GraphicsManager::GraphicsManager(HINSTANCE hInstance, HWND hwnd, SYS::Window* window, IO::IOManager* ioManager, std::uint32_t width, std::uint32_t height, bool debug)
     : m_MainWindow{ window }
     , m_IOManager{ ioManager }
-    , m_Device{ hInstance, window->NativeHandle(), debug}
+    , m_Device{ hInstance, hwnd, debug}
     , m_MainContext{ m_Device.GetFuncTable(), m_Device.GetMainQueue(), &DRE::g_FrameScratchAllocator }
+    , m_AsyncComputeContext{ m_Device.GetComputeQueue() != nullptr ? std::make_unique<VKW::Context>(m_Device.GetFuncTable(), m_Device.GetComputeQueue(), &DRE::g_FrameScratchAllocator) : nullptr }
+    , m_TimestampQueries{ m_Device.GetFuncTable(), m_Device.GetLogicalDevice(), m_Device.GetMainQueue()->GetQueueFamily() }
+    , m_AsyncTimestampQueries{ m_Device.GetComputeQueue() != nullptr ? std::make_unique<VKW::TimestampQueries>(m_Device.GetFuncTable(), m_Device.GetLogicalDevice(), m_Device.GetComputeQueue()->GetQueueFamily()) : nullptr }
     , m_GraphicsFrame{ 0 }
+    , m_PresentWaitUS{ 0 }
+    , m_FrameCounters{}
+    , m_FrameEndCounters{}
     , m_UploadArena{ &m_Device, C_STAGING_ARENA_SIZE }
     , m_UniformArena{ &m_Device, C_UNIFORM_ARENA_SIZE }
     , m_ReadbackArena{ &m_Device, C_READBACK_ARENA_SIZE }
@@ -55,15 +80,25 @@ GraphicsManager::GraphicsManager(HINSTANCE hInstance, SYS::Window* window, IO::I
     , m_LightsManager{ &m_PersistentStorage }
     , m_TransformsManager{ &m_PersistentStorage }
     , m_RenderGraph{ this }
+    , m_ShadowMap{}
     , m_DependencyManager{}
+    , m_RecordingThreadPool{ DRE::ThreadPool::DefaultWorkerCount() }
+    , m_ParallelRecorder{ &m_RecordingThreadPool }
+    , m_DynamicResolution{}
     , m_MainView{ &DRE::g_MainAllocator }
     , m_SunShadowView{ &DRE::g_MainAllocator }
+    , m_RenderableObjectsCount{ 0 }
     , m_Settings{}
 {
     g_GraphicsManager = this;
 
-    m_Settings.m_RenderingWidth = m_MainWindow->Width();
-    m_Settings.m_RenderingHeight = m_MainWindow->Height();
+    m_MainContext.SetTimestampQueries(&m_TimestampQueries);
+    if (m_AsyncComputeContext != nullptr)
+        m_AsyncComputeContext->SetTimestampQueries(m_AsyncTimestampQueries.get());
+
+    m_Settings.m_RenderingWidth = width;
+    m_Settings.m_RenderingHeight = height;
+    m_Settings.m_RecordingJobs = m_RecordingThreadPool.GetWorkerCount() + 1;
 
     for (std::uint32_t i = 0; i < VKW::CONSTANTS::FRAMES_BUFFERING; i++)
     {
@@ -94,10 +129,15 @@ void GraphicsManager::CreateAllPasses(EDITOR::ViewportInputManager* viewportInpu
     m_RenderGraph.AddPass<WaterPass>();
     m_RenderGraph.AddPass<AntiAliasingPass>();
     m_RenderGraph.AddPass<ColorEncodingPass>();
-    m_RenderGraph.AddPass<EditorPass>(viewportInput);
-    //m_RenderGraph.AddPass<DebugPass>();
-    m_RenderGraph.AddPass<ImGuiRenderPass>();
+    if (!IsHeadless())
+    {
+        m_RenderGraph.AddPass<EditorPass>(viewportInput);
+        m_RenderGraph.AddPass<DebugPass>();
+        m_RenderGraph.AddPass<ImGuiRenderPass>();
+    }
     m_RenderGraph.ParseGraph();
+    m_ShadowMap = m_RenderGraph.GetResourcesManager().FindTexture(RESOURCE_ID(TextureID::ShadowMap));
+    m_RenderGraph.CompileGraph();
     m_RenderGraph.InitGraphResources();
 }
 
@@ -122,6 +162,8 @@ glm::vec2 constexpr s_HaltonSequence[16] = {
 
 void GraphicsManager::PrepareGlobalData(VKW::Context& context, WORLD::Scene& scene, std::uint64_t deltaTimeUS, float timeS)
 {
+    DRE_CPU_SCOPE(PrepareGlobalData);
+
     m_MainView.UpdatePreviosFrame();
     m_SunShadowView.UpdatePreviosFrame();
 
@@ -129,12 +171,13 @@ void GraphicsManager::PrepareGlobalData(VKW::Context& context, WORLD::Scene& sce
     void* dst = buffer->memory_.GetRegionMappedPtr();
 
     glm::vec2 const halton = s_HaltonSequence[GetCurrentGraphicsFrame() % (sizeof(s_HaltonSequence) / sizeof(glm::vec2))];
-    glm::vec2 const taaJitter = ((halton - 0.5f) / glm::vec2(m_MainView.GetSize())) * 2.0f * glm::vec2{ GetGraphicsSettings().m_JitterScale };
+    glm::uvec2 const scaledSize = GetScaledRenderingSize();
+    glm::vec2 const taaJitter = ((halton - 0.5f) / glm::vec2(scaledSize)) * 2.0f * glm::vec2{ GetGraphicsSettings().m_JitterScale };
 
 
     WORLD::Camera const& camera = scene.GetMainCamera();
     m_MainView.UpdatePlacement(camera.GetPosition(), camera.GetForward(), camera.GetUp());
-    m_MainView.UpdateViewport(glm::uvec2{ 0, 0 }, glm::uvec2{ m_Settings.m_RenderingWidth, m_Settings.m_RenderingHeight });
+    m_MainView.UpdateViewport(glm::uvec2{ 0, 0 }, scaledSize);
     m_MainView.UpdateProjection(camera.GetFOV(), camera.GetRange()[0], camera.GetRange()[1]);
     m_MainView.UpdateJitter(taaJitter.x, taaJitter.y);
 
@@ -148,14 +191,17 @@ void GraphicsManager::PrepareGlobalData(VKW::Context& context, WORLD::Scene& sce
 
 
     GlobalUniforms globalUniform{};
-    globalUniform.viewportSize_deltaMS_timeS[0] = static_cast<float>(m_Settings.m_RenderingWidth);
-    globalUniform.viewportSize_deltaMS_timeS[1] = static_cast<float>(m_Settings.m_RenderingHeight);
+    globalUniform.viewportSize_deltaMS_timeS[0] = static_cast<float>(scaledSize.x);
+    globalUniform.viewportSize_deltaMS_timeS[1] = static_cast<float>(scaledSize.y);
     globalUniform.viewportSize_deltaMS_timeS[2] = static_cast<float>(static_cast<double>(deltaTimeUS) / 1000.0);
     globalUniform.viewportSize_deltaMS_timeS[3] = timeS;
 
     globalUniform.main_CameraPos_GenericScalar = glm::vec4{ scene.GetMainCamera().GetPosition(), GetGraphicsSettings().m_GenericScalar };
     globalUniform.main_CameraDir        = glm::vec4{ scene.GetMainCamera().GetForward(), 0.0f };
     globalUniform.main_Jitter           = glm::vec4{ taaJitter, 0.0f, 0.0f };
+    globalUniform.main_RenderScale      = glm::vec4{
+        static_cast<float>(scaledSize.x) / m_Settings.m_RenderingWidth, static_cast<float>(scaledSize.y) / m_Settings.m_RenderingHeight,
+        static_cast<float>(m_Settings.m_RenderingWidth), static_cast<float>(m_Settings.m_RenderingHeight) };
 
     globalUniform.main_ViewM            = m_MainView.GetViewM();
     globalUniform.main_iViewM           = m_MainView.GetInvViewM();
@@ -171,7 +217,7 @@ void GraphicsManager::PrepareGlobalData(VKW::Context& context, WORLD::Scene& sce
 
     globalUniform.main_ShadowVP         = m_SunShadowView.GetViewProjectionM();
     globalUniform.main_ShadowSize       = glm::vec4{ C_SHADOW_MAP_WIDTH, C_SHADOW_MAP_HEIGHT, 0.0f, 0.0f };
-    globalUniform.TEX_ID_shadow         = glm::uvec4{ m_RenderGraph.GetTexture(RESOURCE_ID(TextureID::ShadowMap))->GetShaderGlobalDescriptor().id_, 0, 0, 0 };
+    globalUniform.TEX_ID_shadow         = glm::uvec4{ m_RenderGraph.GetTexture(m_ShadowMap)->GetShaderGlobalDescriptor().id_, 0, 0, 0 };
 
     globalUniform.main_SunLightDir      = glm::vec4{ sunLight.GetForward(), 0.0f };
 
@@ -200,128 +246,197 @@ void GraphicsManager::RenderFrame(std::uint64_t frame, std::uint64_t deltaTimeUS
 {
     m_GraphicsFrame = frame;
 
+    DRE::Stopwatch waitStopwatch;
+
     // need to wait for currentFrame - 2 to complete
     if (m_FrameProcessingCompletePoint[GetCurrentFrameID()].GetQueue() != nullptr)
+    {
+        DRE_CPU_SCOPE(WaitFrameCompletion);
         m_FrameProcessingCompletePoint[GetCurrentFrameID()].Wait();
+    }
+    m_PresentWaitUS = waitStopwatch.CurrentMicroseconds();
+
+    // overlay toggled, transient textures move and pass sets are rewritten, so nothing in flight may use them
+    if (m_RenderGraph.NeedsCompile())
+    {
+        WaitIdle();
+        m_RenderGraph.RecompileGraph();
+    }
 
     m_UniformArena.ResetAllocations(GetCurrentFrameID());
     m_UploadArena.ResetAllocations(GetCurrentFrameID());
     m_ReadbackArena.ResetAllocations(GetCurrentFrameID());
+    m_DependencyManager.ReclaimStateSlots(*m_Device.GetResourcesController());
 
     VKW::Context& context = GetMainContext();
 
-    DRE_GPU_SCOPE(FRAME);
-
-    context.ResetDependenciesVectors(&DRE::g_FrameScratchAllocator);
-    PrepareGlobalData(context,  *WORLD::g_MainScene, deltaTimeUS, globalTimeS);
-    m_LightsManager.UpdateGPULights(context);
-
-    float CYLINDER_RADIUS = WORLD::SceneNodeManipulator::GIZMO_CYLINDER_RADIUS * glm::length(m_MainView.GetPosition());
-    float CYLINDER_LENGTH = WORLD::SceneNodeManipulator::GIZMO_CYLINDER_LENGTH * glm::length(m_MainView.GetPosition());
-
-    //float CYLINDER_RADIUS = 0.1f;
-    //float CYLINDER_LENGTH = 2.f;
-
-    //DRE::Cylinder xCylinder{ glm::vec3{ 0.0f, 0.0f, -10.0f }, glm::vec3{ CYLINDER_LENGTH, 0.0f, -10.0f }, CYLINDER_RADIUS };
-    //DRE::Cylinder yCylinder{ glm::vec3{ 0.0f, 0.0f, -10.0f }, glm::vec3{ 0.0f, CYLINDER_LENGTH, -10.0f }, CYLINDER_RADIUS };
-    //DRE::Cylinder zCylinder{ glm::vec3{ 0.0f, 0.0f, -10.0f }, glm::vec3{ 0.0f, 0.0f, CYLINDER_LENGTH - 10.0f }, CYLINDER_RADIUS };
-
-
-    DRE::Cylinder xCylinder{ glm::vec3{ 0.0f, 0.0f, -0.0f }, glm::vec3{ CYLINDER_LENGTH, 0.0f, 0.0f }, CYLINDER_RADIUS };
-    DRE::Cylinder yCylinder{ glm::vec3{ 0.0f, 0.0f, -0.0f }, glm::vec3{ 0.0f, CYLINDER_LENGTH, 0.0f }, CYLINDER_RADIUS };
-    DRE::Cylinder zCylinder{ glm::vec3{ 0.0f, 0.0f, -0.0f }, glm::vec3{ 0.0f, 0.0f, CYLINDER_LENGTH - 0.0f }, CYLINDER_RADIUS };
-
-
-    //glm::uvec2 cursorPos{ 164u, 772u };
-    //glm::vec3 cameraPos{ -0.2300004f, 10.409888f, 14.69998f };
-    //glm::mat4 invView;
-    //glm::mat4 invProj;
-    //
-    //((float*)&invView)[0] = 0.721397758;
-    //((float*)&invView)[1] = 7.45058060e-09;
-    //((float*)&invView)[2] = 0.692520976;
-    //((float*)&invView)[3] = -10.0141373;
-    //((float*)&invView)[4] = 0.159549624;
-    //((float*)&invView)[5] = 0.973098516;
-    //((float*)&invView)[6] = -0.166202530;
-    //((float*)&invView)[7] = -7.65008163;
-    //((float*)&invView)[8] = -0.673891127;
-    //((float*)&invView)[9] = 0.230389595;
-    //((float*)&invView)[10] = 0.701991081;
-    //((float*)&invView)[11] = -12.8726196;
-    //((float*)&invView)[12] = 0.00000000;
-    //((float*)&invView)[13] = 0.00000000;
-    //((float*)&invView)[14] = 0.00000000;
-    //((float*)&invView)[15] = 1.00000000;
-    //
-    //((float*)&invProj)[0] = 1.02640045;
-    //((float*)&invProj)[1] = 0.00000000;
-    //((float*)&invProj)[2] = -0.00000000;
-    //((float*)&invProj)[3] = -0.00000000;
-    //((float*)&invProj)[4] = 0.00000000;
-    //((float*)&invProj)[5] = -0.577350259;
-    //((float*)&invProj)[6] = 0.00000000;
-    //((float*)&invProj)[7] = -0.00000000;
-    //((float*)&invProj)[8] = -0.00000000;
-    //((float*)&invProj)[9] = 0.00000000;
-    //((float*)&invProj)[10] = -0.00000000;
-    //((float*)&invProj)[11] = 9.99900055;
-    //((float*)&invProj)[12] = 0.00000000;
-    //((float*)&invProj)[13] = -0.00000000;
-    //((float*)&invProj)[14] = -1.00000000;
-    //((float*)&invProj)[15] = 0.00100000005;
-    //
-    //glm::mat4 kek = invProj * invView;
-
-    if (SYS::g_InputSystem->GetKeyboardButtonJustPressed(Keys::B))
-        DebugBreak();
-
-
-    //DRE::Ray ray = DRE::RayFromCamera(cursorPos, { 1600u, 900u }, kek);
-    glm::ivec2 pos = { DRE::g_AppContext.m_CursorX, DRE::g_AppContext.m_CursorY };
-    //glm::ivec2 pos = { 1600u, 900u }; pos /= 2;
-    DRE::Ray ray = DRE::RayFromCamera(pos, { 1600u, 900u }, m_MainView.GetInvViewProjectionM(), m_MainView.GetPosition());
-    //DRE::Ray ray = DRE::RayFromCamera(pos, { 1600u, 900u }, m_MainView.GetFOV(), m_MainView.GetInvViewM());
-
-    /*
-    std::cout << "Mouse: " << DRE::g_AppContext.m_CursorX << ' ' << DRE::g_AppContext.m_CursorY
-        << "; Origin: " << ray.origin.x << ", " << ray.origin.y << ", " << ray.origin.z 
-        << "; Direction: " << ray.dir.x << ", " << ray.dir.y << ", " << ray.dir.z << std::endl;
-
-    float t1, t2;
-
-    if (DRE::RayCylinderIntersection(ray, xCylinder, t1, t2))
-    {
-        glm::vec3 p1 = ray.Evaluate(t1);
-        glm::vec3 p2 = ray.Evaluate(t2);
-        std::cout << "X INTERSECTION: t1=" << t1 << ", t2=" << t2 << "p=(" << p1.x << ' ' << p1.y << ' ' << p1.z << ")" << std::endl;
-    }
-    if (DRE::RayCylinderIntersection(ray, yCylinder, t1, t2))
-    {
-        glm::vec3 p1 = ray.Evaluate(t1);
-        glm::vec3 p2 = ray.Evaluate(t2);
-        std::cout << "Y INTERSECTION: t1=" << t1 << ", t2=" << t2 << "p=(" << p1.x << ' ' << p1.y << ' ' << p1.z << ")" << std::endl;
-    }
-    if (DRE::RayCylinderIntersection(ray, zCylinder, t1, t2))
+    m_TimestampQueries.BeginFrame(context, GetCurrentFrameID());
+    if (m_AsyncTimestampQueries != nullptr)
+        m_AsyncTimestampQueries->BeginFrame(*m_AsyncComputeContext, GetCurrentFrameID());
+    m_DynamicResolution.Update(m_Settings, GetGPUFrameTimeMS());
+
+    Texture* finalRT = nullptr;
     {
-        glm::vec3 p1 = ray.Evaluate(t1);
-        glm::vec3 p2 = ray.Evaluate(t2);
-        std::cout << "Z INTERSECTION: t1=" << t1 << ", t2=" << t2 << "p=(" << p1.x << ' ' << p1.y << ' ' << p1.z << ")" << std::endl;
+        DRE_GPU_SCOPE(FRAME);
+
+        DRE_CPU_SCOPE(FRAME);
+
+        context.ResetDependenciesVectors(&DRE::g_FrameScratchAllocator);
+        if (m_AsyncComputeContext != nullptr)
+            m_AsyncComputeContext->ResetDependenciesVectors(&DRE::g_FrameScratchAllocator);
+        PrepareGlobalData(context,  *WORLD::g_MainScene, deltaTimeUS, globalTimeS);
+        m_LightsManager.UpdateGPULights(context);
+
+        float CYLINDER_RADIUS = WORLD::SceneNodeManipulator::GIZMO_CYLINDER_RADIUS * glm::length(m_MainView.GetPosition());
+        float CYLINDER_LENGTH = WORLD::SceneNodeManipulator::GIZMO_CYLINDER_LENGTH * glm::length(m_MainView.GetPosition());
+
+        //float CYLINDER_RADIUS = 0.1f;
+        //float CYLINDER_LENGTH = 2.f;
+
+        //DRE::Cylinder xCylinder{ glm::vec3{ 0.0f, 0.0f, -10.0f }, glm::vec3{ CYLINDER_LENGTH, 0.0f, -10.0f }, CYLINDER_RADIUS };
+        //DRE::Cylinder yCylinder{ glm::vec3{ 0.0f, 0.0f, -10.0f }, glm::vec3{ 0.0f, CYLINDER_LENGTH, -10.0f }, CYLINDER_RADIUS };
+        //DRE::Cylinder zCylinder{ glm::vec3{ 0.0f, 0.0f, -10.0f }, glm::vec3{ 0.0f, 0.0f, CYLINDER_LENGTH - 10.0f }, CYLINDER_RADIUS };
+
+
+        DRE::Cylinder xCylinder{ glm::vec3{ 0.0f, 0.0f, -0.0f }, glm::vec3{ CYLINDER_LENGTH, 0.0f, 0.0f }, CYLINDER_RADIUS };
+        DRE::Cylinder yCylinder{ glm::vec3{ 0.0f, 0.0f, -0.0f }, glm::vec3{ 0.0f, CYLINDER_LENGTH, 0.0f }, CYLINDER_RADIUS };
+        DRE::Cylinder zCylinder{ glm::vec3{ 0.0f, 0.0f, -0.0f }, glm::vec3{ 0.0f, 0.0f, CYLINDER_LENGTH - 0.0f }, CYLINDER_RADIUS };
+
+
+        //glm::uvec2 cursorPos{ 164u, 772u };
+        //glm::vec3 cameraPos{ -0.2300004f, 10.409888f, 14.69998f };
+        //glm::mat4 invView;
+        //glm::mat4 invProj;
+        //
+        //((float*)&invView)[0] = 0.721397758;
+        //((float*)&invView)[1] = 7.45058060e-09;
+        //((float*)&invView)[2] = 0.692520976;
+        //((float*)&invView)[3] = -10.0141373;
+        //((float*)&invView)[4] = 0.159549624;
+        //((float*)&invView)[5] = 0.973098516;
+        //((float*)&invView)[6] = -0.166202530;
+        //((float*)&invView)[7] = -7.65008163;
+        //((float*)&invView)[8] = -0.673891127;
+        //((float*)&invView)[9] = 0.230389595;
+        //((float*)&invView)[10] = 0.701991081;
+        //((float*)&invView)[11] = -12.8726196;
+        //((float*)&invView)[12] = 0.00000000;
+        //((float*)&invView)[13] = 0.00000000;
+        //((float*)&invView)[14] = 0.00000000;
+        //((float*)&invView)[15] = 1.00000000;
+        //
+        //((float*)&invProj)[0] = 1.02640045;
+        //((float*)&invProj)[1] = 0.00000000;
+        //((float*)&invProj)[2] = -0.00000000;
+        //((float*)&invProj)[3] = -0.00000000;
+        //((float*)&invProj)[4] = 0.00000000;
+        //((float*)&invProj)[5] = -0.577350259;
+        //((float*)&invProj)[6] = 0.00000000;
+        //((float*)&invProj)[7] = -0.00000000;
+        //((float*)&invProj)[8] = -0.00000000;
+        //((float*)&invProj)[9] = 0.00000000;
+        //((float*)&invProj)[10] = -0.00000000;
+        //((float*)&invProj)[11] = 9.99900055;
+        //((float*)&invProj)[12] = 0.00000000;
+        //((float*)&invProj)[13] = -0.00000000;
+        //((float*)&invProj)[14] = -1.00000000;
+        //((float*)&invProj)[15] = 0.00100000005;
+        //
+        //glm::mat4 kek = invProj * invView;
+
+        if (SYS::g_InputSystem != nullptr && SYS::g_InputSystem->GetKeyboardButtonJustPressed(Keys::B))
+            DebugBreak();
+
+
+        //DRE::Ray ray = DRE::RayFromCamera(cursorPos, { 1600u, 900u }, kek);
+        glm::ivec2 pos = { DRE::g_AppContext.m_CursorX, DRE::g_AppContext.m_CursorY };
+        //glm::ivec2 pos = { 1600u, 900u }; pos /= 2;
+        DRE::Ray ray = DRE::RayFromCamera(pos, { 1600u, 900u }, m_MainView.GetInvViewProjectionM(), m_MainView.GetPosition());
+        //DRE::Ray ray = DRE::RayFromCamera(pos, { 1600u, 900u }, m_MainView.GetFOV(), m_MainView.GetInvViewM());
+
+        /*
+        std::cout << "Mouse: " << DRE::g_AppContext.m_CursorX << ' ' << DRE::g_AppContext.m_CursorY
+            << "; Origin: " << ray.origin.x << ", " << ray.origin.y << ", " << ray.origin.z 
+            << "; Direction: " << ray.dir.x << ", " << ray.dir.y << ", " << ray.dir.z << std::endl;
+
+        float t1, t2;
+
+        if (DRE::RayCylinderIntersection(ray, xCylinder, t1, t2))
+        {
+            glm::vec3 p1 = ray.Evaluate(t1);
+            glm::vec3 p2 = ray.Evaluate(t2);
+            std::cout << "X INTERSECTION: t1=" << t1 << ", t2=" << t2 << "p=(" << p1.x << ' ' << p1.y << ' ' << p1.z << ")" << std::endl;
+        }
+        if (DRE::RayCylinderIntersection(ray, yCylinder, t1, t2))
+        {
+            glm::vec3 p1 = ray.Evaluate(t1);
+            glm::vec3 p2 = ray.Evaluate(t2);
+            std::cout << "Y INTERSECTION: t1=" << t1 << ", t2=" << t2 << "p=(" << p1.x << ' ' << p1.y << ' ' << p1.z << ")" << std::endl;
+        }
+        if (DRE::RayCylinderIntersection(ray, zCylinder, t1, t2))
+        {
+            glm::vec3 p1 = ray.Evaluate(t1);
+            glm::vec3 p2 = ray.Evaluate(t2);
+            std::cout << "Z INTERSECTION: t1=" << t1 << ", t2=" << t2 << "p=(" << p1.x << ' ' << p1.y << ' ' << p1.z << ")" << std::endl;
+        }
+        */
+        // globalData
+        context.CmdBindGlobalDescriptorSets(*GetMainDevice()->GetDescriptorManager(), GetCurrentFrameID());
+
+        // main graph
+        finalRT = &m_RenderGraph.Render(context);
+
+        // presentation
+        m_DependencyManager.ResourceBarrier(context, finalRT->GetResource(), VKW::RESOURCE_ACCESS_TRANSFER_SRC, VKW::STAGE_TRANSFER);
     }
-    */
-    // globalData
-    context.CmdBindGlobalDescriptorSets(*GetMainDevice()->GetDescriptorManager(), GetCurrentFrameID());
-
-    // main graph
-    Texture& finalRT = m_RenderGraph.Render(context);
 
-    // presentation
-    m_DependencyManager.ResourceBarrier(context, finalRT.GetResource(), VKW::RESOURCE_ACCESS_TRANSFER_SRC, VKW::STAGE_TRANSFER);
+    // FRAME scope is closed above so its end timestamp goes into this submission
+    m_TimestampQueries.EndFrame();
+    if (m_AsyncTimestampQueries != nullptr)
+        m_AsyncTimestampQueries->EndFrame();
 
     GetMainContext().FlushAll();
 
-    VKW::QueueExecutionPoint srcTransferComplete = TransferToSwapchainAndPresent(finalRT);
-    m_FrameProcessingCompletePoint[GetCurrentFrameID()] = srcTransferComplete;
+    DRE_CPU_SCOPE(Present);
+    waitStopwatch.Reset();
+    VKW::QueueExecutionPoint const frameComplete = IsHeadless() ? GetMainContext().SyncPoint() : TransferToSwapchainAndPresent(*finalRT);
+    m_FrameProcessingCompletePoint[GetCurrentFrameID()] = frameComplete;
+    m_PresentWaitUS += waitStopwatch.CurrentMicroseconds();
+
+    RenderCounters frameEnd = SampleRenderCounters(GetMainContext());
+    if (m_AsyncComputeContext != nullptr)
+        AddContextCounters(frameEnd, m_AsyncComputeContext->GetCounters());
+    m_FrameCounters = frameEnd - m_FrameEndCounters;
+    m_FrameEndCounters = frameEnd;
+}
+
+void GraphicsManager::AddContextCounters(RenderCounters& counters, VKW::ContextCounters const& contextCounters)
+{
+    counters.m_Draws            += contextCounters.m_Draws;
+    counters.m_Dispatches       += contextCounters.m_Dispatches;
+    counters.m_PipelineBinds    += contextCounters.m_PipelineBinds;
+    counters.m_Barriers         += contextCounters.m_Barriers;
+    counters.m_BarrierBatches   += contextCounters.m_BarrierBatches;
+    counters.m_SplitBarriers    += contextCounters.m_SplitBarriers;
+    counters.m_Flushes          += contextCounters.m_Flushes;
+}
+
+RenderCounters GraphicsManager::SampleRenderCounters(VKW::Context const& context) const
+{
+    VKW::ContextCounters const& contextCounters = context.GetCounters();
+
+    RenderCounters result;
+    result.m_Draws              = contextCounters.m_Draws;
+    result.m_Dispatches         = contextCounters.m_Dispatches;
+    result.m_PipelineBinds      = contextCounters.m_PipelineBinds;
+    result.m_DescriptorWrites   = m_Device.GetDescriptorManager()->GetSetWritesCount();
+    result.m_Barriers           = contextCounters.m_Barriers;
+    result.m_BarrierBatches     = contextCounters.m_BarrierBatches;
+    result.m_SplitBarriers      = contextCounters.m_SplitBarriers;
+    result.m_Flushes            = contextCounters.m_Flushes;
+    result.m_UploadBytes        = m_UploadArena.GetAllocatedBytes();
+    result.m_UniformBytes       = m_UniformArena.GetAllocatedBytes();
+    return result;
 }
 
 VKW::QueueExecutionPoint GraphicsManager::TransferToSwapchainAndPresent(Texture& src)
@@ -398,7 +513,7 @@ GraphicsManager::GeometryGPU* GraphicsManager::FindOrLoadGPUGeometry(VKW::Contex
     return &m_GeometryGPUMap.Emplace(geometry, vertexBuffer, indexBuffer);
 }
 
-void EmplaceRenderableObjectTexture(Data::Material* material, Data::Material::TextureProperty::Slot slot, TextureBank& textureBank, char const* defaultName, RenderableObject::TexturesVector& result)
+void EmplaceRenderableObjectTexture(VKW::Context& context, Data::Material* material, Data::Material::TextureProperty::Slot slot, TextureBank& textureBank, char const* defaultName, RenderableObject::TexturesVector& result)
 {
     Data::Texture2D const& texture = material->GetTexture(slot);
     if (!texture.IsInitialized())
@@ -410,7 +525,7 @@ void EmplaceRenderableObjectTexture(Data::Material* material, Data::Material::Te
         Texture* gfxTexture = textureBank.FindTexture(texture.GetName());
 
         result.EmplaceBack(gfxTexture == nullptr 
-            ? textureBank.LoadTexture2DSync(texture.GetName(), texture.GetSizeX(), texture.GetSizeY(), texture.GetFormat(), texture.GetBuffer()) 
+            ? textureBank.LoadTexture2D(context, texture.GetName(), texture.GetSizeX(), texture.GetSizeY(), texture.GetFormat(), texture.GetBuffer()) 
             : gfxTexture);
     }
 }
@@ -441,10 +556,10 @@ RenderableObject* GraphicsManager::CreateRenderableObject(WORLD::SceneNode* scen
 
     // - load textures
     RenderableObject::TexturesVector textures;
-    EmplaceRenderableObjectTexture(material, Data::Material::TextureProperty::DIFFUSE, m_TextureBank, "default_color", textures);
-    EmplaceRenderableObjectTexture(material, Data::Material::TextureProperty::NORMAL, m_TextureBank, "default_normal", textures);
-    EmplaceRenderableObjectTexture(material, Data::Material::TextureProperty::METALNESS, m_TextureBank, "zero_r", textures);
-    EmplaceRenderableObjectTexture(material, Data::Material::TextureProperty::ROUGHNESS, m_TextureBank, "one_r", textures);
+    EmplaceRenderableObjectTexture(context, material, Data::Material::TextureProperty::DIFFUSE, m_TextureBank, "default_color", textures);
+    EmplaceRenderableObjectTexture(context, material, Data::Material::TextureProperty::NORMAL, m_TextureBank, "default_normal", textures);
+    EmplaceRenderableObjectTexture(context, material, Data::Material::TextureProperty::METALNESS, m_TextureBank, "zero_r", textures);
+    EmplaceRenderableObjectTexture(context, material, Data::Material::TextureProperty::ROUGHNESS, m_TextureBank, "one_r", textures);
 
     // load geometry
     GeometryGPU* geometryGPU = FindOrLoadGPUGeometry(context, geometry);
@@ -471,6 +586,9 @@ RenderableObject* GraphicsManager::CreateRenderableObject(WORLD::SceneNode* scen
         shadowDescriptors.EmplaceBack(descriptorManager->AllocateStandaloneSet(*shadowLayout->GetMember(shadowLayoutMemberId)));
     }
 
+    DRE_ASSERT(m_RenderableObjectsCount < C_MAX_RENDERABLE_OBJECTS, "Renderable objects pool is exhausted.");
+    m_RenderableObjectsCount++;
+
     return m_RenderableObjectPool.Alloc(sceneNode, layers, pipeline, geometryGPU->vertexBuffer, geometry->GetVertexCount(),
         geometryGPU->indexBuffer, geometry->GetIndexCount(),
         DRE_MOVE(textures), DRE_MOVE(descriptors), DRE_MOVE(shadowDescriptors));
@@ -479,11 +597,31 @@ RenderableObject* GraphicsManager::CreateRenderableObject(WORLD::SceneNode* scen
 void GraphicsManager::FreeRenderableObject(RenderableObject* obj)
 {
     m_RenderableObjectPool.Free(obj);
+    m_RenderableObjectsCount--;
+}
+
+void GraphicsManager::SubmitTransientUploads()
+{
+    // uploads recorded outside RenderFrame use the current frame's regions after that frame was submitted,
+    // so its completion point has to move past them before the regions are reset
+    VKW::QueueExecutionPoint const uploadsComplete = GetMainContext().SyncPoint();
+    GetMainContext().FlushAll();
+    m_FrameProcessingCompletePoint[GetCurrentFrameID()] = uploadsComplete;
+}
+
+float GraphicsManager::GetGPUFrameTimeMS() const
+{
+    // main queue waits for the async join inside its FRAME scope, async time only matters if it ran longer
+    float const mainMS = m_TimestampQueries.GetFrameTimeMS();
+    float const asyncMS = m_AsyncTimestampQueries != nullptr ? m_AsyncTimestampQueries->GetFrameTimeMS() : 0.0f;
+    return mainMS > asyncMS ? mainMS : asyncMS;
 }
 
 void GraphicsManager::WaitIdle()
 {
     GetMainContext().WaitIdle();
+    if (m_AsyncComputeContext != nullptr)
+        m_AsyncComputeContext->WaitIdle();
 }
 
 GraphicsManager::~GraphicsManager()
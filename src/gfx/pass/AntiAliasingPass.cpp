@@ -1,5 +1,7 @@
 #include <gfx\pass\AntiAliasingPass.hpp>
 
+#include <foundation\system\Profiler.hpp>
+
 #include <gfx\GraphicsManager.hpp>
 #include <gfx\scheduling\RenderGraph.hpp>
 #include <gfx\renderer\DrawBatcher.hpp>
@@ -35,8 +37,8 @@ void AntiAliasingPass::RegisterResources(RenderGraph& graph)
         VKW::RESOURCE_ACCESS_SHADER_SAMPLE, VKW::STAGE_COMPUTE, 2);
 
     VKW::ResourceAccess historyAccess = VKW::ResourceAccess(VKW::RESOURCE_ACCESS_SHADER_SAMPLE | std::uint64_t(VKW::RESOURCE_ACCESS_SHADER_WRITE));
-    graph.RegisterStandaloneTexture(RESOURCE_ID(TextureID::ColorHistoryBuffer0), VKW::FORMAT_B8G8R8A8_UNORM, renderWidth, renderHeight, historyAccess);
-    graph.RegisterStandaloneTexture(RESOURCE_ID(TextureID::ColorHistoryBuffer1), VKW::FORMAT_B8G8R8A8_UNORM, renderWidth, renderHeight, historyAccess);
+    m_HistoryBuffers[0] = graph.RegisterStandaloneTexture(RESOURCE_ID(TextureID::ColorHistoryBuffer0), VKW::FORMAT_B8G8R8A8_UNORM, renderWidth, renderHeight, historyAccess);
+    m_HistoryBuffers[1] = graph.RegisterStandaloneTexture(RESOURCE_ID(TextureID::ColorHistoryBuffer1), VKW::FORMAT_B8G8R8A8_UNORM, renderWidth, renderHeight, historyAccess);
 
     graph.RegisterTextureSlot(this, VKW::RESOURCE_ACCESS_SHADER_SAMPLE, VKW::STAGE_COMPUTE, 3);
     graph.RegisterTextureSlot(this, VKW::RESOURCE_ACCESS_SHADER_WRITE, VKW::STAGE_COMPUTE, 4);
@@ -50,14 +52,12 @@ void AntiAliasingPass::RegisterResources(RenderGraph& graph)
 void AntiAliasingPass::Render(RenderGraph& graph, VKW::Context& context)
 {
     DRE_GPU_SCOPE(AtniAliasing);
+    DRE_CPU_SCOPE(AtniAliasing);
 
-    Texture* historyBuffers[2] = { graph.GetTexture(RESOURCE_ID(TextureID::ColorHistoryBuffer0)), graph.GetTexture(RESOURCE_ID(TextureID::ColorHistoryBuffer1)) };
+    Texture* historyBuffers[2] = { graph.GetTexture(m_HistoryBuffers[0]), graph.GetTexture(m_HistoryBuffers[1]) };
 
-    VKW::ImageResourceView* colorInput = graph.GetTexture(RESOURCE_ID(TextureID::WaterColor))->GetShaderView();
-    VKW::ImageResourceView* velocity = graph.GetTexture(RESOURCE_ID(TextureID::Velocity))->GetShaderView();
     VKW::ImageResourceView* history = historyBuffers[g_GraphicsManager->GetPrevFrameID()]->GetShaderView();
     VKW::ImageResourceView* taaOutput = historyBuffers[g_GraphicsManager->GetCurrentFrameID()]->GetShaderView();
-    VKW::ImageResourceView* mainDepth = graph.GetTexture(RESOURCE_ID(TextureID::MainDepth))->GetShaderView();
 
     VKW::DescriptorSet passSet = graph.GetPassDescriptorSet(GetID(), g_GraphicsManager->GetCurrentFrameID());
     VKW::DescriptorManager::WriteDesc writeDesc;
@@ -71,11 +71,8 @@ void AntiAliasingPass::Render(RenderGraph& graph, VKW::Context& context)
         uniform.WriteMember140(taaSettings);
     }
 
-    g_GraphicsManager->GetDependencyManager().ResourceBarrier(context, colorInput->parentResource_, VKW::RESOURCE_ACCESS_SHADER_SAMPLE, VKW::STAGE_COMPUTE);
-    g_GraphicsManager->GetDependencyManager().ResourceBarrier(context, velocity->parentResource_, VKW::RESOURCE_ACCESS_SHADER_SAMPLE, VKW::STAGE_COMPUTE);
     g_GraphicsManager->GetDependencyManager().ResourceBarrier(context, history->parentResource_, VKW::RESOURCE_ACCESS_SHADER_SAMPLE, VKW::STAGE_COMPUTE);
     g_GraphicsManager->GetDependencyManager().ResourceBarrier(context, taaOutput->parentResource_, VKW::RESOURCE_ACCESS_SHADER_WRITE, VKW::STAGE_COMPUTE);
-    g_GraphicsManager->GetDependencyManager().ResourceBarrier(context, mainDepth->parentResource_, VKW::RESOURCE_ACCESS_SHADER_SAMPLE, VKW::STAGE_COMPUTE);
 
     VKW::PipelineLayout* layout = graph.GetPassPipelineLayout(GetID());
     context.CmdBindComputeDescriptorSets(layout, graph.GetPassSetBinding(), 1, &passSet);
@@ -83,6 +80,7 @@ void AntiAliasingPass::Render(RenderGraph& graph, VKW::Context& context)
     VKW::Pipeline* pipeline = g_GraphicsManager->GetPipelineDB().GetPipeline("temporal_AA");
     context.CmdBindComputePipeline(pipeline);
 
+    // output size, the scaled frame is upscaled in the shader
     glm::uvec2 rtSize{ g_GraphicsManager->GetGraphicsSettings().m_RenderingWidth, g_GraphicsManager->GetGraphicsSettings().m_RenderingHeight };
     glm::uvec2 const groupSize{ 8, 8 };
     glm::uvec2 const dispatchSize = rtSize / groupSize + glm::uvec2{ 1, 1 };
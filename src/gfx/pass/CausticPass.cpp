@@ -1,5 +1,7 @@
 #include <gfx\pass\CausticPass.hpp>
 
+#include <foundation\system\Profiler.hpp>
+
 #include <gfx\GraphicsManager.hpp>
 #include <gfx\scheduling\RenderGraph.hpp>
 #include <gfx\renderer\DrawBatcher.hpp>
@@ -25,9 +27,11 @@ void CausticPass::RegisterResources(RenderGraph& graph)
         VKW::FORMAT_R16G16B16A16_FLOAT, C_SHADOW_MAP_WIDTH, C_SHADOW_MAP_HEIGHT, VKW::RESOURCE_ACCESS_SHADER_SAMPLE, VKW::STAGE_VERTEX,
         1);
 
+    graph.RegisterTextureUsage(this, RESOURCE_ID(TextureID::ShadowMap), VKW::RESOURCE_ACCESS_SHADER_SAMPLE, VKW::STAGE_ALL_GRAPHICS);
+
     graph.RegisterUniformBuffer(this, VKW::STAGE_VERTEX, 0);
 
-    graph.RegisterRenderTarget(this,
+    m_CausticMap = graph.RegisterRenderTarget(this,
         RESOURCE_ID(TextureID::CausticMap),
         VKW::FORMAT_R8_UNORM, C_SHADOW_MAP_WIDTH, C_SHADOW_MAP_HEIGHT,
         0);
@@ -58,16 +62,13 @@ void WaterCausticDelegate(RenderableObject& obj, VKW::Context& context, VKW::Des
 void CausticPass::Render(RenderGraph& graph, VKW::Context& context)
 {
     DRE_GPU_SCOPE(Caustic);
+    DRE_CPU_SCOPE(Caustic);
 
-    VKW::ImageResourceView* causticAttachment = graph.GetTexture(RESOURCE_ID(TextureID::CausticMap))->GetShaderView();
-    VKW::ImageResourceView* shadowAttachment = graph.GetTexture(RESOURCE_ID(TextureID::ShadowMap))->GetShaderView();
-    VKW::ImageResourceView* envMapAttachment = graph.GetTexture(RESOURCE_ID(TextureID::CausticEnvMap))->GetShaderView();
-
-    g_GraphicsManager->GetDependencyManager().ResourceBarrier(context, causticAttachment->parentResource_, VKW::RESOURCE_ACCESS_COLOR_ATTACHMENT, VKW::STAGE_COLOR_OUTPUT);
-    g_GraphicsManager->GetDependencyManager().ResourceBarrier(context, shadowAttachment->parentResource_, VKW::RESOURCE_ACCESS_SHADER_SAMPLE, VKW::STAGE_ALL_GRAPHICS);
-    g_GraphicsManager->GetDependencyManager().ResourceBarrier(context, envMapAttachment->parentResource_, VKW::RESOURCE_ACCESS_SHADER_SAMPLE, VKW::STAGE_ALL_GRAPHICS);
+    VKW::ImageResourceView* causticAttachment = graph.GetTexture(m_CausticMap)->GetShaderView();
 
     context.CmdBeginRendering(1, &causticAttachment, nullptr, nullptr);
+    float clearValues[] = { 0.0f, 0.0f, 0.0f, 0.0f };
+    context.CmdClearAttachments(VKW::ATTACHMENT_MASK_COLOR_0, clearValues);
     context.CmdSetViewport(1, 0, 0, C_SHADOW_MAP_WIDTH, C_SHADOW_MAP_HEIGHT);
     context.CmdSetScissor(1, 0, 0, C_SHADOW_MAP_WIDTH, C_SHADOW_MAP_HEIGHT);
 
@@ -1,5 +1,7 @@
 #include <gfx\pass\DebugPass.hpp>
 
+#include <foundation\system\Profiler.hpp>
+
 #include <gfx\GraphicsManager.hpp>
 #include <gfx\scheduling\RenderGraph.hpp>
 #include <gfx\renderer\DrawBatcher.hpp>
@@ -22,7 +24,7 @@ void DebugPass::RegisterResources(RenderGraph& graph)
 {
     std::uint32_t renderWidth = g_GraphicsManager->GetGraphicsSettings().m_RenderingWidth, renderHeight = g_GraphicsManager->GetGraphicsSettings().m_RenderingHeight;
 
-    graph.RegisterTexture(this, RESOURCE_ID(TextureID::DisplayEncodedImage), g_GraphicsManager->GetFinalImageFormat(),
+    m_Output = graph.RegisterTexture(this, RESOURCE_ID(TextureID::DisplayEncodedImage), g_GraphicsManager->GetFinalImageFormat(),
         renderWidth, renderHeight,
         VKW::RESOURCE_ACCESS_SHADER_WRITE, VKW::STAGE_COMPUTE,
         0);
@@ -38,19 +40,9 @@ void DebugPass::RegisterResources(RenderGraph& graph)
 void DebugPass::Render(RenderGraph& graph, VKW::Context& context)
 {
     DRE_GPU_SCOPE(DebugPass);
+    DRE_CPU_SCOPE(DebugPass);
 
-    VKW::ImageResourceView* output = graph.GetTexture(RESOURCE_ID(TextureID::DisplayEncodedImage))->GetShaderView();
-
-    VKW::ImageResourceView* fftH0 = graph.GetTexture(RESOURCE_ID(TextureID::FFTH0))->GetShaderView();
-    VKW::ImageResourceView* fftHxt = graph.GetTexture(RESOURCE_ID(TextureID::FFTHxt))->GetShaderView();
-    VKW::ImageResourceView* height = graph.GetTexture(RESOURCE_ID(TextureID::WaterHeight))->GetShaderView();
-    VKW::ImageResourceView* pingPong = graph.GetTexture(RESOURCE_ID(TextureID::FFTPingPong0))->GetShaderView();
-
-    g_GraphicsManager->GetDependencyManager().ResourceBarrier(context, output->parentResource_, VKW::RESOURCE_ACCESS_SHADER_WRITE, VKW::STAGE_COMPUTE);
-    g_GraphicsManager->GetDependencyManager().ResourceBarrier(context, fftH0->parentResource_, VKW::RESOURCE_ACCESS_SHADER_SAMPLE, VKW::STAGE_COMPUTE);
-    g_GraphicsManager->GetDependencyManager().ResourceBarrier(context, fftHxt->parentResource_, VKW::RESOURCE_ACCESS_SHADER_SAMPLE, VKW::STAGE_COMPUTE);
-    g_GraphicsManager->GetDependencyManager().ResourceBarrier(context, height->parentResource_, VKW::RESOURCE_ACCESS_SHADER_SAMPLE, VKW::STAGE_COMPUTE);
-    g_GraphicsManager->GetDependencyManager().ResourceBarrier(context, pingPong->parentResource_, VKW::RESOURCE_ACCESS_SHADER_SAMPLE, VKW::STAGE_COMPUTE);
+    VKW::ImageResourceView* output = graph.GetTexture(m_Output)->GetShaderView();
 
     VKW::DescriptorSet set = graph.GetPassDescriptorSet(GetID(), g_GraphicsManager->GetCurrentFrameID());
 
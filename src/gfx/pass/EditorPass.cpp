@@ -1,5 +1,7 @@
 #include <gfx\pass\EditorPass.hpp>
 
+#include <foundation\system\Profiler.hpp>
+
 #include <gfx\GraphicsManager.hpp>
 #include <gfx\scheduling\RenderGraph.hpp>
 #include <editor\ViewportInputManager.hpp>
@@ -273,7 +275,7 @@ void EditorPass::RegisterResources(RenderGraph& graph)
 {
     std::uint32_t renderWidth = g_GraphicsManager->GetGraphicsSettings().m_RenderingWidth, renderHeight = g_GraphicsManager->GetGraphicsSettings().m_RenderingHeight;
 
-    graph.RegisterRenderTarget(this, RESOURCE_ID(TextureID::DisplayEncodedImage),
+    m_ColorBuffer = graph.RegisterRenderTarget(this, RESOURCE_ID(TextureID::DisplayEncodedImage),
         g_GraphicsManager->GetFinalImageFormat(), renderWidth, renderHeight,
         0);
 
@@ -283,11 +285,9 @@ void EditorPass::RegisterResources(RenderGraph& graph)
 void EditorPass::Render(RenderGraph& graph, VKW::Context& context)
 {
     DRE_GPU_SCOPE(EditorPass);
+    DRE_CPU_SCOPE(EditorPass);
 
-    VKW::ImageResourceView* colorBuffer = graph.GetTexture(RESOURCE_ID(TextureID::DisplayEncodedImage))->GetShaderView();
-    VKW::ImageResourceView* objectIDBuffer = graph.GetTexture(RESOURCE_ID(TextureID::ObjectIDBuffer))->GetShaderView();
-
-    g_GraphicsManager->GetDependencyManager().ResourceBarrier(context, colorBuffer->parentResource_, VKW::RESOURCE_ACCESS_COLOR_ATTACHMENT, VKW::STAGE_COLOR_OUTPUT);
+    VKW::ImageResourceView* colorBuffer = graph.GetTexture(m_ColorBuffer)->GetShaderView();
 
     context.CmdBeginRendering(1, &colorBuffer, nullptr, nullptr);
 
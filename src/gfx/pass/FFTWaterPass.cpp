@@ -1,5 +1,7 @@
 #include <gfx\pass\FFTWaterPass.hpp>
 
+#include <foundation\system\Profiler.hpp>
+
 #include <vk_wrapper\pipeline\ShaderModule.hpp>
 
 #include <gfx\GraphicsManager.hpp>
@@ -45,6 +47,7 @@ void FFTButterflyGenPass::RegisterResources(RenderGraph& graph)
     std::uint32_t stagesCount = std::uint32_t(glm::log2(float(C_WATER_DIM)));
     graph.RegisterTexture(this, RESOURCE_ID(TextureID::FFTButterfly), VKW::FORMAT_R32G32B32A32_FLOAT, stagesCount, C_WATER_DIM, VKW::RESOURCE_ACCESS_SHADER_WRITE, VKW::STAGE_COMPUTE, 0);
     graph.RegisterUniformBuffer(this, VKW::STAGE_COMPUTE, 1);
+    graph.RegisterAsyncCompute(this);
 }
 
 void FFTButterflyGenPass::Initialize(RenderGraph& graph)
@@ -55,6 +58,7 @@ void FFTButterflyGenPass::Initialize(RenderGraph& graph)
 void FFTButterflyGenPass::Render(RenderGraph& graph, VKW::Context& context)
 {
     DRE_GPU_SCOPE(FFTButterflyGen);
+    DRE_CPU_SCOPE(FFTButterflyGen);
 
     DRE_ASSERT(C_WATER_DIM <= 256, "Can't do dimentions more that 256 (for now)");
 
@@ -74,9 +78,6 @@ void FFTButterflyGenPass::Render(RenderGraph& graph, VKW::Context& context)
     VKW::Pipeline* pipeline = g_GraphicsManager->GetPipelineDB().GetPipeline("gen_butterfly");
     VKW::PipelineLayout* layout = graph.GetPassPipelineLayout(GetID());
 
-    VKW::ImageResourceView* texture = graph.GetTexture(RESOURCE_ID(TextureID::FFTButterfly))->GetShaderView();
-    g_GraphicsManager->GetDependencyManager().ResourceBarrier(context, texture->parentResource_, VKW::RESOURCE_ACCESS_SHADER_WRITE, VKW::STAGE_COMPUTE);
-
 
     VKW::DescriptorSet set = graph.GetPassDescriptorSet(GetID(), g_GraphicsManager->GetCurrentFrameID());
     context.CmdBindComputeDescriptorSets(layout, graph.GetPassSetBinding(), 1, &set);
@@ -101,6 +102,7 @@ void FFTWaterH0GenPass::RegisterResources(RenderGraph& graph)
 {
     graph.RegisterTexture(this, RESOURCE_ID(TextureID::FFTH0), VKW::FORMAT_R32G32B32A32_FLOAT, C_WATER_DIM, C_WATER_DIM, VKW::RESOURCE_ACCESS_SHADER_WRITE, VKW::STAGE_COMPUTE, 0);
     graph.RegisterUniformBuffer(this, VKW::STAGE_COMPUTE, 1);
+    graph.RegisterAsyncCompute(this);
 }
 
 void FFTWaterH0GenPass::Initialize(RenderGraph& graph)
@@ -110,15 +112,13 @@ void FFTWaterH0GenPass::Initialize(RenderGraph& graph)
 void FFTWaterH0GenPass::Render(RenderGraph& graph, VKW::Context& context)
 {
     DRE_GPU_SCOPE(FFTWaterH0Gen);
+    DRE_CPU_SCOPE(FFTWaterH0Gen);
 
     UniformProxy uniform = graph.GetPassUniform(GetID(), context, WATER_UNIFORM_SIZE);
     FillWaterUniform(uniform, *g_GraphicsManager->GetTextureBank().FindTexture("blue_noise_256"));
 
     VKW::Pipeline* pipeline = g_GraphicsManager->GetPipelineDB().GetPipeline("gen_h0");
     VKW::PipelineLayout* layout = graph.GetPassPipelineLayout(GetID());
-    
-    VKW::ImageResourceView* texture = graph.GetTexture(RESOURCE_ID(TextureID::FFTH0))->GetShaderView();
-    g_GraphicsManager->GetDependencyManager().ResourceBarrier(context, texture->parentResource_, VKW::RESOURCE_ACCESS_SHADER_WRITE, VKW::STAGE_COMPUTE);
 
 
     VKW::DescriptorSet set = graph.GetPassDescriptorSet(GetID(), g_GraphicsManager->GetCurrentFrameID());
@@ -145,6 +145,7 @@ void FFTWaterHxtGenPass::RegisterResources(RenderGraph& graph)
     graph.RegisterTexture(this, RESOURCE_ID(TextureID::FFTH0), VKW::FORMAT_R32G32B32A32_FLOAT, C_WATER_DIM, C_WATER_DIM, VKW::RESOURCE_ACCESS_SHADER_READ, VKW::STAGE_COMPUTE, 1);
 
     graph.RegisterUniformBuffer(this, VKW::STAGE_COMPUTE, 2);
+    graph.RegisterAsyncCompute(this);
 }
 
 void FFTWaterHxtGenPass::Initialize(RenderGraph& graph)
@@ -154,16 +155,11 @@ void FFTWaterHxtGenPass::Initialize(RenderGraph& graph)
 void FFTWaterHxtGenPass::Render(RenderGraph& graph, VKW::Context& context)
 {
     DRE_GPU_SCOPE(FFTWaterHxtGen);
+    DRE_CPU_SCOPE(FFTWaterHxtGen);
 
     UniformProxy uniform = graph.GetPassUniform(GetID(), context, WATER_UNIFORM_SIZE);
     FillWaterUniform(uniform, *g_GraphicsManager->GetTextureBank().FindTexture("blue_noise_256"));
 
-    VKW::ImageResourceView* fftHxt = graph.GetTexture(RESOURCE_ID(TextureID::FFTHxt))->GetShaderView();
-    VKW::ImageResourceView* fftH0 = graph.GetTexture(RESOURCE_ID(TextureID::FFTH0))->GetShaderView();
-
-    g_GraphicsManager->GetDependencyManager().ResourceBarrier(context, fftHxt->parentResource_, VKW::RESOURCE_ACCESS_SHADER_WRITE, VKW::STAGE_COMPUTE);
-    g_GraphicsManager->GetDependencyManager().ResourceBarrier(context, fftH0->parentResource_, VKW::RESOURCE_ACCESS_SHADER_READ, VKW::STAGE_COMPUTE);
-
     VKW::Pipeline* pipeline = g_GraphicsManager->GetPipelineDB().GetPipeline("gen_hxt");
     VKW::PipelineLayout* layout = graph.GetPassPipelineLayout(GetID());
 
@@ -189,15 +185,22 @@ void FFTWaterFFTPass::RegisterResources(RenderGraph& graph)
 {
     std::uint32_t stagesCount = std::uint32_t(glm::log2(float(C_WATER_DIM)));
 
-    graph.RegisterTexture(this, RESOURCE_ID(TextureID::FFTButterfly), VKW::FORMAT_R32G32B32A32_FLOAT, stagesCount, C_WATER_DIM, VKW::RESOURCE_ACCESS_SHADER_READ, VKW::STAGE_COMPUTE, 0);
+    m_Butterfly = graph.RegisterTexture(this, RESOURCE_ID(TextureID::FFTButterfly), VKW::FORMAT_R32G32B32A32_FLOAT, stagesCount, C_WATER_DIM, VKW::RESOURCE_ACCESS_SHADER_READ, VKW::STAGE_COMPUTE, 0);
 
     graph.RegisterTextureSlot(this, VKW::RESOURCE_ACCESS_SHADER_READ, VKW::STAGE_COMPUTE, 1);
     graph.RegisterTextureSlot(this, VKW::RESOURCE_ACCESS_SHADER_WRITE, VKW::STAGE_COMPUTE, 2);
 
     graph.RegisterUniformBuffer(this, VKW::STAGE_COMPUTE, 3);
 
-    graph.RegisterStandaloneTexture(RESOURCE_ID(TextureID::FFTPingPong0), VKW::FORMAT_R32G32_FLOAT, C_WATER_DIM, C_WATER_DIM, VKW::ResourceAccess(VKW::RESOURCE_ACCESS_SHADER_RW));
-    graph.RegisterStandaloneTexture(RESOURCE_ID(TextureID::FFTPingPong1), VKW::FORMAT_R32G32_FLOAT, C_WATER_DIM, C_WATER_DIM, VKW::RESOURCE_ACCESS_SHADER_RW);
+    m_PingPong[0] = graph.RegisterStandaloneTexture(RESOURCE_ID(TextureID::FFTPingPong0), VKW::FORMAT_R32G32_FLOAT, C_WATER_DIM, C_WATER_DIM, VKW::ResourceAccess(VKW::RESOURCE_ACCESS_SHADER_RW));
+    m_PingPong[1] = graph.RegisterStandaloneTexture(RESOURCE_ID(TextureID::FFTPingPong1), VKW::FORMAT_R32G32_FLOAT, C_WATER_DIM, C_WATER_DIM, VKW::RESOURCE_ACCESS_SHADER_RW);
+
+    // Hxt is copied into the first ping-pong texture, ping-pong transitions inside the pass are done by the pass
+    graph.RegisterTextureUsage(this, RESOURCE_ID(TextureID::FFTPingPong0), VKW::RESOURCE_ACCESS_TRANSFER_DST, VKW::STAGE_TRANSFER);
+    m_Hxt = graph.RegisterTextureUsage(this, RESOURCE_ID(TextureID::FFTHxt), VKW::RESOURCE_ACCESS_TRANSFER_SRC, VKW::STAGE_TRANSFER);
+
+    // ping-pong slots only ever point at FFTPingPong0/1
+    graph.RegisterAsyncCompute(this);
 }
 
 void FFTWaterFFTPass::Initialize(RenderGraph& graph)
@@ -217,15 +220,13 @@ static VKW::ImageResourceView* fftOutput = nullptr;
 void FFTWaterFFTPass::Render(RenderGraph& graph, VKW::Context& context)
 {
     DRE_GPU_SCOPE(FFTWaterFFT);
+    DRE_CPU_SCOPE(FFTWaterFFT);
 
-    VKW::ImageResourceView* fftHxt = graph.GetTexture(RESOURCE_ID(TextureID::FFTHxt))->GetShaderView();
-    VKW::ImageResourceView* fftButterfly = graph.GetTexture(RESOURCE_ID(TextureID::FFTButterfly))->GetShaderView();
-
-    VKW::ImageResourceView* pingPong0 = graph.GetTexture(RESOURCE_ID(TextureID::FFTPingPong0))->GetShaderView();
-    VKW::ImageResourceView* pingPong1 = graph.GetTexture(RESOURCE_ID(TextureID::FFTPingPong1))->GetShaderView();
+    VKW::ImageResourceView* fftHxt = graph.GetTexture(m_Hxt)->GetShaderView();
+    VKW::ImageResourceView* fftButterfly = graph.GetTexture(m_Butterfly)->GetShaderView();
 
-    g_GraphicsManager->GetDependencyManager().ResourceBarrier(context, pingPong0->parentResource_, VKW::RESOURCE_ACCESS_TRANSFER_DST, VKW::STAGE_TRANSFER);
-    g_GraphicsManager->GetDependencyManager().ResourceBarrier(context, fftHxt->parentResource_, VKW::RESOURCE_ACCESS_TRANSFER_SRC, VKW::STAGE_TRANSFER);
+    VKW::ImageResourceView* pingPong0 = graph.GetTexture(m_PingPong[0])->GetShaderView();
+    VKW::ImageResourceView* pingPong1 = graph.GetTexture(m_PingPong[1])->GetShaderView();
 
     context.CmdCopyImageToImage(pingPong0->parentResource_, fftHxt->parentResource_);
 
@@ -244,9 +245,6 @@ void FFTWaterFFTPass::Render(RenderGraph& graph, VKW::Context& context)
 
     context.CmdBindComputePipeline(pipeline);
 
-    g_GraphicsManager->GetDependencyManager().ResourceBarrier(context, fftButterfly->parentResource_, VKW::RESOURCE_ACCESS_SHADER_READ, VKW::STAGE_COMPUTE);
-
-
     // horizontal
     {
         for (std::uint32_t i = 0; i < stagesCount * 2; i++)
@@ -292,10 +290,11 @@ PassID GFX::FFTInvPermutationPass::GetID() const
 
 void FFTInvPermutationPass::RegisterResources(RenderGraph& graph)
 {
-    graph.RegisterTexture(this, RESOURCE_ID(TextureID::FFTPingPong0), VKW::FORMAT_R32G32_FLOAT, C_WATER_DIM, C_WATER_DIM, VKW::RESOURCE_ACCESS_SHADER_WRITE, VKW::STAGE_COMPUTE, 0);
-    graph.RegisterTexture(this, RESOURCE_ID(TextureID::WaterHeight), VKW::FORMAT_R32_FLOAT, C_WATER_DIM, C_WATER_DIM, VKW::RESOURCE_ACCESS_SHADER_READ, VKW::STAGE_COMPUTE, 1);
+    graph.RegisterTexture(this, RESOURCE_ID(TextureID::FFTPingPong0), VKW::FORMAT_R32G32_FLOAT, C_WATER_DIM, C_WATER_DIM, VKW::RESOURCE_ACCESS_SHADER_READ, VKW::STAGE_COMPUTE, 0);
+    graph.RegisterTexture(this, RESOURCE_ID(TextureID::WaterHeight), VKW::FORMAT_R32_FLOAT, C_WATER_DIM, C_WATER_DIM, VKW::RESOURCE_ACCESS_SHADER_WRITE, VKW::STAGE_COMPUTE, 1);
 
     graph.RegisterUniformBuffer(this, VKW::STAGE_COMPUTE, 2);
+    graph.RegisterAsyncCompute(this);
 }
 
 void FFTInvPermutationPass::Initialize(RenderGraph& graph)
@@ -305,12 +304,7 @@ void FFTInvPermutationPass::Initialize(RenderGraph& graph)
 void FFTInvPermutationPass::Render(RenderGraph& graph, VKW::Context& context)
 {
     DRE_GPU_SCOPE(FFTInvPermutation);
-
-    VKW::ImageResourceView* input = graph.GetTexture(RESOURCE_ID(TextureID::FFTPingPong0))->GetShaderView();
-    VKW::ImageResourceView* heightMap = graph.GetTexture(RESOURCE_ID(TextureID::WaterHeight))->GetShaderView();
-
-    g_GraphicsManager->GetDependencyManager().ResourceBarrier(context, input->parentResource_, VKW::RESOURCE_ACCESS_SHADER_READ, VKW::STAGE_COMPUTE);
-    g_GraphicsManager->GetDependencyManager().ResourceBarrier(context, heightMap->parentResource_, VKW::RESOURCE_ACCESS_SHADER_WRITE, VKW::STAGE_COMPUTE);
+    DRE_CPU_SCOPE(FFTInvPermutation);
 
     UniformProxy uniform = graph.GetPassUniform(GetID(), context, WATER_UNIFORM_SIZE);
     FillWaterUniform(uniform, *g_GraphicsManager->GetTextureBank().FindTexture("blue_noise_256"));
@@ -1,10 +1,13 @@
 #include <gfx\pass\ForwardOpaquePass.hpp>
 
+#include <foundation\system\Profiler.hpp>
+
 #include <vk_wrapper\pipeline\ShaderModule.hpp>
 
 #include <gfx\GraphicsManager.hpp>
 #include <gfx\scheduling\RenderGraph.hpp>
 #include <gfx\renderer\DrawBatcher.hpp>
+#include <gfx\renderer\ParallelRecorder.hpp>
 
 #include <engine\io\IOManager.hpp>
 #include <engine\scene\Scene.hpp>
@@ -37,22 +40,22 @@ void ForwardOpaquePass::RegisterResources(RenderGraph& graph)
         VKW::FORMAT_R8_UNORM, C_SHADOW_MAP_WIDTH, C_SHADOW_MAP_HEIGHT, VKW::RESOURCE_ACCESS_SHADER_SAMPLE, VKW::STAGE_VERTEX | VKW::STAGE_FRAGMENT, 2);
 
 
-    graph.RegisterRenderTarget(this,
+    m_ForwardColor = graph.RegisterRenderTarget(this,
         RESOURCE_ID(TextureID::ForwardColor),
         g_GraphicsManager->GetMainColorFormat(), renderWidth, renderHeight,
         0);
 
-    graph.RegisterRenderTarget(this,
+    m_Velocity = graph.RegisterRenderTarget(this,
         RESOURCE_ID(TextureID::Velocity),
         VKW::FORMAT_R16G16_FLOAT, renderWidth, renderHeight,
         1);
 
-    graph.RegisterRenderTarget(this,
+    m_ObjectIDBuffer = graph.RegisterRenderTarget(this,
         RESOURCE_ID(TextureID::ObjectIDBuffer),
         g_GraphicsManager->GetObjectIDBufferFormat(), renderWidth, renderHeight,
         2);
 
-    graph.RegisterDepthOnlyTarget(this,
+    m_MainDepth = graph.RegisterDepthOnlyTarget(this,
         RESOURCE_ID(TextureID::MainDepth),
         g_GraphicsManager->GetMainDepthFormat(), renderWidth, renderHeight);
 }
@@ -90,22 +93,15 @@ void ForwardObjectDelegate(RenderableObject& obj, VKW::Context& context, VKW::De
 void ForwardOpaquePass::Render(RenderGraph& graph, VKW::Context& context)
 {
     DRE_GPU_SCOPE(ForwardOpaque);
+    DRE_CPU_SCOPE(ForwardOpaque);
 
     std::uint32_t renderWidth = g_GraphicsManager->GetGraphicsSettings().m_RenderingWidth, renderHeight = g_GraphicsManager->GetGraphicsSettings().m_RenderingHeight;
+    glm::uvec2 const scaledSize = g_GraphicsManager->GetScaledRenderingSize();
 
-    VKW::ImageResourceView* colorAttachment = graph.GetTexture(RESOURCE_ID(TextureID::ForwardColor))->GetShaderView();
-    VKW::ImageResourceView* velocityAttachment = graph.GetTexture(RESOURCE_ID(TextureID::Velocity))->GetShaderView();
-    VKW::ImageResourceView* objectIDAttachment = graph.GetTexture(RESOURCE_ID(TextureID::ObjectIDBuffer))->GetShaderView();
-    VKW::ImageResourceView* depthAttachment = graph.GetTexture(RESOURCE_ID(TextureID::MainDepth))->GetShaderView();
-    VKW::ImageResourceView* shadowMap       = graph.GetTexture(RESOURCE_ID(TextureID::ShadowMap))->GetShaderView();
-    VKW::ImageResourceView* causticMap      = graph.GetTexture(RESOURCE_ID(TextureID::CausticMap))->GetShaderView();
-
-    g_GraphicsManager->GetDependencyManager().ResourceBarrier(context, colorAttachment->parentResource_, VKW::RESOURCE_ACCESS_COLOR_ATTACHMENT, VKW::STAGE_COLOR_OUTPUT);
-    g_GraphicsManager->GetDependencyManager().ResourceBarrier(context, velocityAttachment->parentResource_, VKW::RESOURCE_ACCESS_COLOR_ATTACHMENT, VKW::STAGE_COLOR_OUTPUT);
-    g_GraphicsManager->GetDependencyManager().ResourceBarrier(context, objectIDAttachment->parentResource_, VKW::RESOURCE_ACCESS_COLOR_ATTACHMENT, VKW::STAGE_COLOR_OUTPUT);
-    g_GraphicsManager->GetDependencyManager().ResourceBarrier(context, depthAttachment->parentResource_, VKW::RESOURCE_ACCESS_DEPTH_ONLY_ATTACHMENT, VKW::STAGE_ALL_GRAPHICS);
-    g_GraphicsManager->GetDependencyManager().ResourceBarrier(context, shadowMap->parentResource_, VKW::RESOURCE_ACCESS_SHADER_SAMPLE, VKW::STAGE_FRAGMENT);
-    g_GraphicsManager->GetDependencyManager().ResourceBarrier(context, causticMap->parentResource_, VKW::RESOURCE_ACCESS_SHADER_SAMPLE, VKW::STAGE_FRAGMENT);
+    VKW::ImageResourceView* colorAttachment = graph.GetTexture(m_ForwardColor)->GetShaderView();
+    VKW::ImageResourceView* velocityAttachment = graph.GetTexture(m_Velocity)->GetShaderView();
+    VKW::ImageResourceView* objectIDAttachment = graph.GetTexture(m_ObjectIDBuffer)->GetShaderView();
+    VKW::ImageResourceView* depthAttachment = graph.GetTexture(m_MainDepth)->GetShaderView();
 
     std::uint32_t constexpr attachmentsCount = 3;
     static_assert(FORWARD_PASS_OUTPUT_COUNT == attachmentsCount, "Don't forget to modify PipelineDB and ForwardOpaquePass");
@@ -114,21 +110,6 @@ void ForwardOpaquePass::Render(RenderGraph& graph, VKW::Context& context)
     DrawBatcher batcher{ &DRE::g_FrameScratchAllocator, g_GraphicsManager->GetMainDevice()->GetDescriptorManager(), &g_GraphicsManager->GetUniformArena() };
     batcher.Batch(context, g_GraphicsManager->GetMainRenderView(), RenderableObject::LAYER_OPAQUE_BIT, GFX::ForwardObjectDelegate);
 
-
-    context.CmdBeginRendering(attachmentsCount, attachments, depthAttachment, nullptr);
-    float clearColors[4] = { 0.9f, 0.9f, 0.9f, 0.0f };
-    float clearVelocity[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
-    std::uint32_t clearID[4] = { 0, 0, 0, 0 };
-    context.CmdClearAttachments(VKW::ATTACHMENT_MASK_COLOR_0, clearColors);
-    context.CmdClearAttachments(VKW::ATTACHMENT_MASK_COLOR_1 | VKW::ATTACHMENT_MASK_COLOR_2, clearVelocity);
-    context.CmdClearAttachments(VKW::ATTACHMENT_MASK_DEPTH, 0.0f, 0);
-
-    context.CmdSetViewport(attachmentsCount, 0, 0, renderWidth, renderHeight);
-    context.CmdSetScissor(attachmentsCount, 0, 0, renderWidth, renderHeight);
-#ifndef DRE_COMPILE_FOR_RENDERDOC
-    context.CmdSetPolygonMode(VKW::POLYGON_FILL);
-#endif // DRE_COMPILE_FOR_RENDERDOC
-
     {
         glm::mat4 const shadow_ViewProj = g_GraphicsManager->GetSunShadowRenderView().GetViewProjectionM();
         glm::vec4 const shadow_Size = glm::vec4{ C_SHADOW_MAP_WIDTH, C_SHADOW_MAP_HEIGHT, 0.0f, 0.0f };
@@ -143,30 +124,50 @@ void ForwardOpaquePass::Render(RenderGraph& graph, VKW::Context& context)
     }
 
     VKW::DescriptorSet passSet = graph.GetPassDescriptorSet(GetID(), g_GraphicsManager->GetCurrentFrameID());
-
     VKW::PipelineLayout* passLayout = graph.GetPassPipelineLayout(GetID());
-    context.CmdBindDescriptorSets(passLayout, VKW::BindPoint::Graphics, graph.GetPassSetBinding(), 1, &passSet);
+    std::uint32_t const passSetBinding = graph.GetPassSetBinding();
+    std::uint32_t const userSetBinding = graph.GetUserSetBinding(GetID());
 
     auto& draws = batcher.GetDraws();
 
-    std::uint32_t const userSetBinding = graph.GetUserSetBinding(GetID());
-    VKW::Pipeline* prevPipeline = nullptr;
-    for (std::uint32_t i = 0, size = draws.Size(); i < size; i++)
+    // may run on recording workers, see ParallelRecorder
+    auto recordDraws = [&](VKW::Context& drawContext, std::uint32_t job, std::uint32_t begin, std::uint32_t end)
     {
-        AtomDraw const& atom = draws[i];
-        if (prevPipeline != atom.pipeline)
+        if (job == 0)
         {
-            context.CmdBindGraphicsPipeline(atom.pipeline);
-            prevPipeline = atom.pipeline;
+            float clearColors[4] = { 0.9f, 0.9f, 0.9f, 0.0f };
+            float clearVelocity[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+            drawContext.CmdClearAttachments(VKW::ATTACHMENT_MASK_COLOR_0, clearColors);
+            drawContext.CmdClearAttachments(VKW::ATTACHMENT_MASK_COLOR_1 | VKW::ATTACHMENT_MASK_COLOR_2, clearVelocity);
+            drawContext.CmdClearAttachments(VKW::ATTACHMENT_MASK_DEPTH, 0.0f, 0);
         }
 
-        context.CmdBindGraphicsDescriptorSets(atom.pipeline->GetLayout(), userSetBinding, 1, &atom.descriptorSet);
-        context.CmdBindVertexBuffer(atom.vertexBuffer, atom.vertexOffset);
-        context.CmdBindIndexBuffer(atom.indexBuffer, atom.indexOffset);
-        context.CmdDrawIndexed(atom.indexCount);
-    }
+        drawContext.CmdSetViewport(attachmentsCount, 0, 0, scaledSize.x, scaledSize.y);
+        drawContext.CmdSetScissor(attachmentsCount, 0, 0, scaledSize.x, scaledSize.y);
+#ifndef DRE_COMPILE_FOR_RENDERDOC
+        drawContext.CmdSetPolygonMode(VKW::POLYGON_FILL);
+#endif // DRE_COMPILE_FOR_RENDERDOC
+
+        drawContext.CmdBindDescriptorSets(passLayout, VKW::BindPoint::Graphics, passSetBinding, 1, &passSet);
+
+        VKW::Pipeline* prevPipeline = nullptr;
+        for (std::uint32_t i = begin; i < end; i++)
+        {
+            AtomDraw const& atom = draws[i];
+            if (prevPipeline != atom.pipeline)
+            {
+                drawContext.CmdBindGraphicsPipeline(atom.pipeline);
+                prevPipeline = atom.pipeline;
+            }
+
+            drawContext.CmdBindGraphicsDescriptorSets(atom.pipeline->GetLayout(), userSetBinding, 1, &atom.descriptorSet);
+            drawContext.CmdBindVertexBuffer(atom.vertexBuffer, atom.vertexOffset);
+            drawContext.CmdBindIndexBuffer(atom.indexBuffer, atom.indexOffset);
+            drawContext.CmdDrawIndexed(atom.indexCount);
+        }
+    };
 
-    context.CmdEndRendering();
+    g_GraphicsManager->GetParallelRecorder().RecordRendering(context, attachmentsCount, attachments, depthAttachment, draws.Size(), recordDraws);
 
     ReadbackScheduler readback(g_GraphicsManager->GetCurrentFrameID(), &g_GraphicsManager->GetReadbackArena(), renderWidth * renderHeight * 4);
     g_GraphicsManager->GetDependencyManager().ResourceBarrier(context, objectIDAttachment->parentResource_, VKW::RESOURCE_ACCESS_TRANSFER_SRC, VKW::STAGE_TRANSFER);
@@ -180,8 +181,9 @@ void ForwardOpaquePass::Render(RenderGraph& graph, VKW::Context& context)
         m_LastObjectIDsFuture.Sync();
         void* readbackData = m_LastObjectIDsFuture.GetMappedPtr();
 
-        DRE::S32 x = DRE::Clamp(DRE::g_AppContext.m_CursorX, 0, DRE::S32(renderWidth - 1));
-        DRE::S32 y = DRE::Clamp(DRE::g_AppContext.m_CursorY, 0, DRE::S32(renderHeight - 1));
+        // the readback holds the full target, the frame is in its scaled top-left part
+        DRE::S32 x = DRE::Clamp(DRE::S32(DRE::g_AppContext.m_CursorX * DRE::S32(scaledSize.x) / DRE::S32(renderWidth)), 0, DRE::S32(scaledSize.x - 1));
+        DRE::S32 y = DRE::Clamp(DRE::S32(DRE::g_AppContext.m_CursorY * DRE::S32(scaledSize.y) / DRE::S32(renderHeight)), 0, DRE::S32(scaledSize.y - 1));
         DRE::g_AppContext.m_MouseHoveredObjectID = ObjectIDFromBuffer(readbackData, x, y);
     }
 
@@ -1,5 +1,7 @@
 #include <gfx\pass\ImGuiRenderPass.hpp>
 
+#include <foundation\system\Profiler.hpp>
+
 #include <foundation\memory\ByteBuffer.hpp>
 
 #include <vk_wrapper\pipeline\ShaderModule.hpp>
@@ -34,7 +36,7 @@ PassID ImGuiRenderPass::GetID() const
 /////////////////////////
 void ImGuiRenderPass::RegisterResources(RenderGraph& graph)
 {
-    graph.RegisterRenderTarget(this, RESOURCE_ID(TextureID::DisplayEncodedImage), g_GraphicsManager->GetFinalImageFormat(),
+    m_RenderTarget = graph.RegisterRenderTarget(this, RESOURCE_ID(TextureID::DisplayEncodedImage), g_GraphicsManager->GetFinalImageFormat(),
         g_GraphicsManager->GetGraphicsSettings().m_RenderingWidth, g_GraphicsManager->GetGraphicsSettings().m_RenderingHeight,
         0);
 }
@@ -51,10 +53,9 @@ ImGuiRenderPass::~ImGuiRenderPass()
 void ImGuiRenderPass::Render(RenderGraph& graph, VKW::Context& context)
 {
     DRE_GPU_SCOPE(ImGuiRender);
+    DRE_CPU_SCOPE(ImGuiRender);
 
-    VKW::ImageResourceView* imGuiRT = graph.GetTexture(RESOURCE_ID(TextureID::DisplayEncodedImage))->GetShaderView();
-
-    g_GraphicsManager->GetDependencyManager().ResourceBarrier(context, imGuiRT->parentResource_, VKW::RESOURCE_ACCESS_COLOR_ATTACHMENT, VKW::STAGE_COLOR_OUTPUT);
+    VKW::ImageResourceView* imGuiRT = graph.GetTexture(m_RenderTarget)->GetShaderView();
 
 #ifdef DRE_IMGUI_CUSTOM_TEXTURE
 	auto& imGuiSyncQueue = g_GraphicsManager->GetImGuiSyncQueue();
@@ -1,8 +1,11 @@
 #include <gfx\pass\ShadowPass.hpp>
 
+#include <foundation\system\Profiler.hpp>
+
 #include <gfx\GraphicsManager.hpp>
 #include <gfx\scheduling\RenderGraph.hpp>
 #include <gfx\renderer\DrawBatcher.hpp>
+#include <gfx\renderer\ParallelRecorder.hpp>
 
 #include <engine\scene\Scene.hpp>
 
@@ -20,11 +23,11 @@ void ShadowPass::Initialize(RenderGraph& graph)
 
 void ShadowPass::RegisterResources(RenderGraph& graph)
 {
-    graph.RegisterRenderTarget(this,
+    m_CausticEnvMap = graph.RegisterRenderTarget(this,
         RESOURCE_ID(TextureID::CausticEnvMap),
         VKW::FORMAT_R16G16B16A16_FLOAT, C_SHADOW_MAP_WIDTH, C_SHADOW_MAP_HEIGHT, 0);
 
-    graph.RegisterDepthOnlyTarget(this,
+    m_ShadowMap = graph.RegisterDepthOnlyTarget(this,
         RESOURCE_ID(TextureID::ShadowMap),
         VKW::FORMAT_D16_UNORM, C_SHADOW_MAP_WIDTH, C_SHADOW_MAP_WIDTH);
 }
@@ -51,45 +54,45 @@ void ShadowObjectDelegate(RenderableObject& obj, VKW::Context& context, VKW::Des
 void ShadowPass::Render(RenderGraph& graph, VKW::Context& context)
 {
     DRE_GPU_SCOPE(Shadow);
+    DRE_CPU_SCOPE(Shadow);
 
-    VKW::ImageResourceView* wposAttachment = graph.GetTexture(RESOURCE_ID(TextureID::CausticEnvMap))->GetShaderView();
-    VKW::ImageResourceView* depthAttachment = graph.GetTexture(RESOURCE_ID(TextureID::ShadowMap))->GetShaderView();
-
-    g_GraphicsManager->GetDependencyManager().ResourceBarrier(context, wposAttachment->parentResource_, VKW::RESOURCE_ACCESS_COLOR_ATTACHMENT, VKW::STAGE_COLOR_OUTPUT);
-    g_GraphicsManager->GetDependencyManager().ResourceBarrier(context, depthAttachment->parentResource_, VKW::RESOURCE_ACCESS_DEPTH_ONLY_ATTACHMENT, VKW::STAGE_ALL_GRAPHICS);
-
-    context.CmdBeginRendering(1, &wposAttachment, depthAttachment, nullptr);
-    float clearValues[] = { 0.0f, 0.0f, 0.0f, 0.0f };
-    context.CmdClearAttachments(VKW::ATTACHMENT_MASK_COLOR_0, clearValues);
-    context.CmdClearAttachments(VKW::ATTACHMENT_MASK_DEPTH, 0.0f, 0);
-
-    context.CmdSetViewport(1, 0, 0, C_SHADOW_MAP_WIDTH, C_SHADOW_MAP_HEIGHT);
-    context.CmdSetScissor(1, 0, 0, C_SHADOW_MAP_WIDTH, C_SHADOW_MAP_HEIGHT);
-#ifndef DRE_COMPILE_FOR_RENDERDOC
-    context.CmdSetPolygonMode(VKW::POLYGON_FILL);
-#endif // DRE_COMPILE_FOR_RENDERDOC
+    VKW::ImageResourceView* wposAttachment = graph.GetTexture(m_CausticEnvMap)->GetShaderView();
+    VKW::ImageResourceView* depthAttachment = graph.GetTexture(m_ShadowMap)->GetShaderView();
 
-    // 1. take all RenderableObject's in main scene
     DrawBatcher batcher{ &DRE::g_FrameScratchAllocator, g_GraphicsManager->GetMainDevice()->GetDescriptorManager(), &g_GraphicsManager->GetUniformArena() };
-
     batcher.BatchShadow(context, g_GraphicsManager->GetSunShadowRenderView(), RenderableObject::LAYER_OPAQUE_BIT, GFX::ShadowObjectDelegate);
 
     std::uint32_t const startSet = graph.GetUserSetBinding(GetID());
-
     auto& draws = batcher.GetDraws();
-    for (std::uint32_t i = 0, size = draws.Size(); i < size; i++)
+
+    // may run on recording workers, see ParallelRecorder
+    auto recordDraws = [&](VKW::Context& drawContext, std::uint32_t job, std::uint32_t begin, std::uint32_t end)
     {
-        AtomDraw const& atom = draws[i];
-        context.CmdBindGraphicsPipeline(atom.pipeline);
-        context.CmdBindGraphicsDescriptorSets(atom.pipeline->GetLayout(), startSet, 1, &atom.descriptorSet);
-        context.CmdBindVertexBuffer(atom.vertexBuffer, atom.vertexOffset);
-        context.CmdBindIndexBuffer(atom.indexBuffer, atom.indexOffset);
-        context.CmdDrawIndexed(atom.indexCount);
-    }
-
-    // 2. feed all RenderableObject's to DrawBatcher
-    // 3. DrawBatcher produces atomic draw commands
-    context.CmdEndRendering();
+        if (job == 0)
+        {
+            float clearValues[] = { 0.0f, 0.0f, 0.0f, 0.0f };
+            drawContext.CmdClearAttachments(VKW::ATTACHMENT_MASK_COLOR_0, clearValues);
+            drawContext.CmdClearAttachments(VKW::ATTACHMENT_MASK_DEPTH, 0.0f, 0);
+        }
+
+        drawContext.CmdSetViewport(1, 0, 0, C_SHADOW_MAP_WIDTH, C_SHADOW_MAP_HEIGHT);
+        drawContext.CmdSetScissor(1, 0, 0, C_SHADOW_MAP_WIDTH, C_SHADOW_MAP_HEIGHT);
+#ifndef DRE_COMPILE_FOR_RENDERDOC
+        drawContext.CmdSetPolygonMode(VKW::POLYGON_FILL);
+#endif // DRE_COMPILE_FOR_RENDERDOC
+
+        for (std::uint32_t i = begin; i < end; i++)
+        {
+            AtomDraw const& atom = draws[i];
+            drawContext.CmdBindGraphicsPipeline(atom.pipeline);
+            drawContext.CmdBindGraphicsDescriptorSets(atom.pipeline->GetLayout(), startSet, 1, &atom.descriptorSet);
+            drawContext.CmdBindVertexBuffer(atom.vertexBuffer, atom.vertexOffset);
+            drawContext.CmdBindIndexBuffer(atom.indexBuffer, atom.indexOffset);
+            drawContext.CmdDrawIndexed(atom.indexCount);
+        }
+    };
+
+    g_GraphicsManager->GetParallelRecorder().RecordRendering(context, 1, &wposAttachment, depthAttachment, draws.Size(), recordDraws);
 }
 
 }
@@ -1,5 +1,7 @@
 #include <gfx\pass\WaterPass.hpp>
 
+#include <foundation\system\Profiler.hpp>
+
 #include <vk_wrapper\pipeline\ShaderModule.hpp>
 
 #include <gfx\GraphicsManager.hpp>
@@ -21,11 +23,15 @@ void WaterPass::RegisterResources(RenderGraph& graph)
 {
     std::uint32_t renderWidth = g_GraphicsManager->GetGraphicsSettings().m_RenderingWidth, renderHeight = g_GraphicsManager->GetGraphicsSettings().m_RenderingHeight;
 
+    // forward color is copied into the water target first, both are transitioned again after the copy
+    graph.RegisterTextureUsage(this, RESOURCE_ID(TextureID::WaterColor), VKW::RESOURCE_ACCESS_TRANSFER_DST, VKW::STAGE_TRANSFER);
+    graph.RegisterTextureUsage(this, RESOURCE_ID(TextureID::ForwardColor), VKW::RESOURCE_ACCESS_TRANSFER_SRC, VKW::STAGE_TRANSFER);
+
     graph.RegisterTexture(this,
         RESOURCE_ID(TextureID::ShadowMap),
         VKW::FORMAT_D16_UNORM, C_SHADOW_MAP_WIDTH, C_SHADOW_MAP_HEIGHT, VKW::RESOURCE_ACCESS_SHADER_SAMPLE, VKW::STAGE_FRAGMENT, 0);
 
-    graph.RegisterTexture(this,
+    m_ForwardColor = graph.RegisterTexture(this,
         RESOURCE_ID(TextureID::ForwardColor),
         g_GraphicsManager->GetMainColorFormat(), renderWidth, renderHeight,
         VKW::RESOURCE_ACCESS_SHADER_SAMPLE, VKW::STAGE_FRAGMENT, 1);
@@ -42,17 +48,17 @@ void WaterPass::RegisterResources(RenderGraph& graph)
 
     graph.RegisterUniformBuffer(this, VKW::STAGE_FRAGMENT, 4);
 
-    graph.RegisterRenderTarget(this,
+    m_WaterColor = graph.RegisterRenderTarget(this,
         RESOURCE_ID(TextureID::WaterColor),
         g_GraphicsManager->GetMainColorFormat(), renderWidth, renderHeight,
         0);
 
-    graph.RegisterRenderTarget(this,
+    m_Velocity = graph.RegisterRenderTarget(this,
         RESOURCE_ID(TextureID::Velocity),
         VKW::FORMAT_R16G16_FLOAT, renderWidth, renderHeight,
         1);
 
-    graph.RegisterDepthOnlyTarget(this,
+    m_MainDepth = graph.RegisterDepthOnlyTarget(this,
         RESOURCE_ID(TextureID::MainDepth),
         g_GraphicsManager->GetMainDepthFormat(), renderWidth, renderHeight);
 }
@@ -83,24 +89,16 @@ void WaterObjectDelegate(RenderableObject& obj, VKW::Context& context, VKW::Desc
 void WaterPass::Render(RenderGraph& graph, VKW::Context& context)
 {
     DRE_GPU_SCOPE(Water);
+    DRE_CPU_SCOPE(Water);
 
-    VKW::ImageResourceView* waterAttachment = graph.GetTexture(RESOURCE_ID(TextureID::WaterColor))->GetShaderView();
-    VKW::ImageResourceView* velocityAttachment = graph.GetTexture(RESOURCE_ID(TextureID::Velocity))->GetShaderView();
-    VKW::ImageResourceView* depthAttachment = graph.GetTexture(RESOURCE_ID(TextureID::MainDepth))->GetShaderView();
-    VKW::ImageResourceView* shadowMap       = graph.GetTexture(RESOURCE_ID(TextureID::ShadowMap))->GetShaderView();
-    VKW::ImageResourceView* heightMap       = graph.GetTexture(RESOURCE_ID(TextureID::WaterHeight))->GetShaderView();
-    VKW::ImageResourceView* color           = graph.GetTexture(RESOURCE_ID(TextureID::ForwardColor))->GetShaderView();
-
-    g_GraphicsManager->GetDependencyManager().ResourceBarrier(context, waterAttachment->parentResource_, VKW::RESOURCE_ACCESS_TRANSFER_DST, VKW::STAGE_TRANSFER);
-    g_GraphicsManager->GetDependencyManager().ResourceBarrier(context, color->parentResource_, VKW::RESOURCE_ACCESS_TRANSFER_SRC, VKW::STAGE_TRANSFER);
+    VKW::ImageResourceView* waterAttachment = graph.GetTexture(m_WaterColor)->GetShaderView();
+    VKW::ImageResourceView* velocityAttachment = graph.GetTexture(m_Velocity)->GetShaderView();
+    VKW::ImageResourceView* depthAttachment = graph.GetTexture(m_MainDepth)->GetShaderView();
+    VKW::ImageResourceView* color           = graph.GetTexture(m_ForwardColor)->GetShaderView();
 
     context.CmdCopyImageToImage(waterAttachment->parentResource_, color->parentResource_);
 
     g_GraphicsManager->GetDependencyManager().ResourceBarrier(context, waterAttachment->parentResource_, VKW::RESOURCE_ACCESS_COLOR_ATTACHMENT, VKW::STAGE_COLOR_OUTPUT);
-    g_GraphicsManager->GetDependencyManager().ResourceBarrier(context, velocityAttachment->parentResource_, VKW::RESOURCE_ACCESS_COLOR_ATTACHMENT, VKW::STAGE_COLOR_OUTPUT);
-    g_GraphicsManager->GetDependencyManager().ResourceBarrier(context, depthAttachment->parentResource_, VKW::RESOURCE_ACCESS_SHADER_SAMPLE, VKW::STAGE_ALL_GRAPHICS); // but also used as depth readonly attachment
-    g_GraphicsManager->GetDependencyManager().ResourceBarrier(context, shadowMap->parentResource_, VKW::RESOURCE_ACCESS_SHADER_SAMPLE, VKW::STAGE_FRAGMENT);
-    g_GraphicsManager->GetDependencyManager().ResourceBarrier(context, heightMap->parentResource_, VKW::RESOURCE_ACCESS_SHADER_SAMPLE, VKW::STAGE_VERTEX);
     g_GraphicsManager->GetDependencyManager().ResourceBarrier(context, color->parentResource_, VKW::RESOURCE_ACCESS_SHADER_SAMPLE, VKW::STAGE_FRAGMENT);
 
     VKW::ImageResourceView* attachments[2] = { waterAttachment, velocityAttachment };
@@ -110,9 +108,9 @@ void WaterPass::Render(RenderGraph& graph, VKW::Context& context)
 
     context.CmdBeginRendering(2, attachments, depthAttachment, nullptr);
 
-    std::uint32_t renderWidth = g_GraphicsManager->GetGraphicsSettings().m_RenderingWidth, renderHeight = g_GraphicsManager->GetGraphicsSettings().m_RenderingHeight;
-    context.CmdSetViewport(2, 0, 0, renderWidth, renderHeight);
-    context.CmdSetScissor(2, 0, 0, renderWidth, renderHeight);
+    glm::uvec2 const scaledSize = g_GraphicsManager->GetScaledRenderingSize();
+    context.CmdSetViewport(2, 0, 0, scaledSize.x, scaledSize.y);
+    context.CmdSetScissor(2, 0, 0, scaledSize.x, scaledSize.y);
 #ifndef DRE_COMPILE_FOR_RENDERDOC
     context.CmdSetPolygonMode(g_GraphicsManager->GetGraphicsSettings().m_WaterWireframe ? VKW::POLYGON_WIREFRAME : VKW::POLYGON_FILL);
 #endif // DRE_COMPILE_FOR_RENDERDOC
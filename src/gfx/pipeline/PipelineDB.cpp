@@ -8,6 +8,8 @@
 
 #include <engine\io\IOManager.hpp>
 
+#include <foundation\system\Log.hpp>
+
 #include <forward_output.h>
 
 namespace GFX
@@ -241,7 +243,7 @@ DRE::String64 const* PipelineDB::CreateGraphicsGizmoPipeline(char const* name)
 
 void PipelineDB::ReloadPipeline(char const* name)
 {
-    std::cout << "Reloading pipeline " << name << std::endl;
+    DRE_LOG_INFO("Reloading pipeline %s", name);
 
     DRE::String128 layoutName{ name }; layoutName.Append("_layout");
     VKW::PipelineLayout* layout = GetLayout(layoutName.GetData());
@@ -268,7 +270,7 @@ void PipelineDB::ReloadPipeline(char const* name)
         DRE::ByteBuffer compiledBinary = m_IOManager->CompileGLSL(vertPath.GetData());
         if (compiledBinary.Size() == 0)
         {
-            std::cout << "Failed to recompile shader " << vertPath.GetData() << ". Pipeline was not cecreated." << std::endl;
+            DRE_LOG_ERROR("Failed to recompile shader %s. Pipeline was not recreated.", vertPath.GetData());
             return;
         }
 
@@ -287,7 +289,7 @@ void PipelineDB::ReloadPipeline(char const* name)
         DRE::ByteBuffer compiledBinary = m_IOManager->CompileGLSL(fragPath.GetData());
         if (compiledBinary.Size() == 0)
         {
-            std::cout << "Failed to recompile shader " << fragPath.GetData() << ". Pipeline was not cecreated." << std::endl;
+            DRE_LOG_ERROR("Failed to recompile shader %s. Pipeline was not recreated.", fragPath.GetData());
             return;
         }
 
@@ -306,7 +308,7 @@ void PipelineDB::ReloadPipeline(char const* name)
         DRE::ByteBuffer compiledBinary = m_IOManager->CompileGLSL(compPath.GetData());
         if (compiledBinary.Size() == 0)
         {
-            std::cout << "Failed to recompile shader " << compPath.GetData() << ". Pipeline was not cecreated." << std::endl;
+            DRE_LOG_ERROR("Failed to recompile shader %s. Pipeline was not recreated.", compPath.GetData());
             return;
         }
 
@@ -1,5 +1,7 @@
 #include <gfx\renderer\DrawBatcher.hpp>
 
+#include <foundation\system\Profiler.hpp>
+
 #include <vk_wrapper\descriptor\DescriptorManager.hpp>
 
 #include <gfx\GraphicsManager.hpp>
@@ -22,6 +24,8 @@ DrawBatcher::DrawBatcher(DRE::AllocatorLinear* allocator, VKW::DescriptorManager
 
 void DrawBatcher::Batch(VKW::Context& context, RenderView const& view, RenderableObject::LayerBits layers, AtomDataDelegate atomDelegate)
 {
+    DRE_CPU_SCOPE(DrawBatcher_Batch);
+
     auto const& renderables = view.GetObjects();
     for (std::uint32_t i = 0, count = renderables.Size(); i < count; i++)
     {
@@ -0,0 +1,64 @@
+#include <gfx\renderer\DynamicResolution.hpp>
+
+#include <foundation\math\SimpleMath.hpp>
+
+#include <vk_wrapper\Constant.hpp>
+
+#include <gfx\GraphicsManager.hpp>
+
+#include <cmath>
+
+namespace GFX
+{
+
+DynamicResolution::DynamicResolution()
+    : m_Scale{ 1.0f }
+    , m_FramesSinceChange{ 0 }
+{
+}
+
+void DynamicResolution::Update(GraphicsSettings const& settings, float gpuTimeMS)
+{
+    float const minScale = DRE::Clamp(settings.m_MinRenderScale, 0.1f, 1.0f);
+    float const maxScale = DRE::Clamp(settings.m_MaxRenderScale, minScale, 1.0f);
+
+    if (!settings.m_DynamicResolution)
+    {
+        m_Scale = maxScale;
+        m_FramesSinceChange = 0;
+        return;
+    }
+
+    m_Scale = DRE::Clamp(m_Scale, minScale, maxScale);
+
+    // timings of the frames recorded before the last change are still coming
+    std::uint32_t const settleFrames = DRE::Max(settings.m_ResolutionChangeFrames, std::uint32_t(VKW::CONSTANTS::FRAMES_BUFFERING + 1));
+    if (++m_FramesSinceChange < settleFrames || gpuTimeMS <= 0.0f || settings.m_TargetGPUTimeMS <= 0.0f)
+        return;
+
+    float const budget = settings.m_TargetGPUTimeMS;
+    if (gpuTimeMS <= budget * (1.0f + settings.m_ResolutionHysteresis) && gpuTimeMS >= budget * (1.0f - settings.m_ResolutionHysteresis))
+        return;
+
+    // GPU time follows the pixel count, scale is per axis
+    float scale = m_Scale * std::sqrt(budget / gpuTimeMS);
+
+    // steps keep the noise around the band edges from moving the scale every time
+    float const step = DRE::Max(settings.m_RenderScaleStep, 0.01f);
+    scale = DRE::Clamp(std::round(scale / step) * step, minScale, maxScale);
+
+    if (scale != m_Scale)
+    {
+        m_Scale = scale;
+        m_FramesSinceChange = 0;
+    }
+}
+
+glm::uvec2 DynamicResolution::GetScaledSize(std::uint32_t width, std::uint32_t height) const
+{
+    return glm::uvec2{
+        DRE::Max(static_cast<std::uint32_t>(static_cast<float>(width) * m_Scale + 0.5f), 1u),
+        DRE::Max(static_cast<std::uint32_t>(static_cast<float>(height) * m_Scale + 0.5f), 1u) };
+}
+
+}
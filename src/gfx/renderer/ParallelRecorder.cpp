@@ -0,0 +1,75 @@
+#include <gfx\renderer\ParallelRecorder.hpp>
+
+#include <latch>
+#include <optional>
+
+#include <foundation\math\SimpleMath.hpp>
+#include <foundation\system\Profiler.hpp>
+
+#include <vk_wrapper\Context.hpp>
+
+#include <gfx\GraphicsManager.hpp>
+
+namespace GFX
+{
+
+ParallelRecorder::ParallelRecorder(DRE::ThreadPool* threadPool)
+    : m_ThreadPool{ threadPool }
+{
+}
+
+void ParallelRecorder::RecordRendering(VKW::Context& context,
+    std::uint32_t attachmentCount, VKW::ImageResourceView* const* attachments, VKW::ImageResourceView const* depthAttachment,
+    std::uint32_t drawsCount, RecordRangeFunc const& func)
+{
+    DRE_CPU_SCOPE(ParallelRecorder_RecordRendering);
+
+    std::uint32_t const maxJobs = DRE::Min(DRE::Max(g_GraphicsManager->GetGraphicsSettings().m_RecordingJobs, 1u), MAX_JOBS);
+    std::uint32_t const jobsCount = DRE::Max(DRE::Min(maxJobs, drawsCount / MIN_DRAWS_PER_JOB), 1u);
+
+    if (jobsCount == 1)
+    {
+        context.CmdBeginRendering(attachmentCount, attachments, depthAttachment, nullptr);
+        func(context, 0, 0, drawsCount);
+        context.CmdEndRendering();
+        return;
+    }
+
+    context.CmdBeginRendering(attachmentCount, attachments, depthAttachment, nullptr, true);
+
+    // commandlists are taken from the queue here, only the recording itself leaves the main thread
+    std::optional<VKW::Context> secondaries[MAX_JOBS];
+    VKW::Context* executeOrder[MAX_JOBS];
+    for (std::uint32_t i = 0; i < jobsCount; i++)
+    {
+        VKW::Context& secondary = secondaries[i].emplace(context);
+        secondary.CmdBindGlobalDescriptorSets(*g_GraphicsManager->GetMainDevice()->GetDescriptorManager(), g_GraphicsManager->GetCurrentFrameID());
+        executeOrder[i] = &secondary;
+    }
+
+    // waits for this rendering's jobs only, the pool may be running other work
+    std::latch jobsComplete{ jobsCount - 1 };
+
+    std::uint32_t const drawsPerJob = (drawsCount + jobsCount - 1) / jobsCount;
+    for (std::uint32_t i = 1; i < jobsCount; i++)
+    {
+        std::uint32_t const begin = i * drawsPerJob;
+        std::uint32_t const end = DRE::Min(begin + drawsPerJob, drawsCount);
+        VKW::Context* secondary = executeOrder[i];
+        m_ThreadPool->Submit([&func, &jobsComplete, secondary, i, begin, end]()
+            {
+                DRE_CPU_SCOPE(ParallelRecorder_Job);
+                func(*secondary, i, begin, end);
+                jobsComplete.count_down();
+            }, DRE::TASK_PRIORITY_HIGH);
+    }
+
+    func(*executeOrder[0], 0, 0, drawsPerJob);
+    jobsComplete.wait();
+
+    context.CmdExecuteCommands(jobsCount, executeOrder);
+    context.CmdEndRendering();
+}
+
+}
+
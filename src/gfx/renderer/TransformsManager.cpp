@@ -1,5 +1,7 @@
 #include <gfx\renderer\TransformsManager.hpp>
 
+#include <foundation\system\Profiler.hpp>
+
 #include <vk_wrapper\descriptor\DescriptorManager.hpp>
 
 #include <gfx\GraphicsManager.hpp>
@@ -48,6 +50,8 @@ void TransformsManager::ScheduleTransformUpdate(std::uint32_t id, glm::vec3 cons
 
 void TransformsManager::UpdateGPUTransforms(VKW::Context& context)
 {
+    DRE_CPU_SCOPE(UpdateGPUTransforms);
+
     std::uint64_t baseAddress = m_PersistentAllocation.GetGPUAddress();
 
     for (std::uint32_t i = 0, count = m_TransformUpdateQueue.Size(); i < count; i++)
@@ -6,6 +6,8 @@
 #include <vk_wrapper\Helper.hpp>
 #include <vk_wrapper\pipeline\Dependency.hpp>
 #include <vk_wrapper\Context.hpp>
+#include <vk_wrapper\queue\EventPool.hpp>
+#include <vk_wrapper\resources\ResourcesController.hpp>
 
 #include <gfx\GraphicsManager.hpp>
 #include <gfx\pass\BasePass.hpp>
@@ -15,6 +17,8 @@ namespace GFX
 {
 
 DependencyManager::DependencyManager()
+    : m_TextureStates{}
+    , m_BufferStates{}
 {}
 
 DependencyManager::~DependencyManager()
@@ -44,29 +48,247 @@ bool VectorContains(std::vector<T> const& list, T const& b)
     return std::find(list.begin(), list.end(), b) != list.end(); 
 }
 
-void DependencyManager::ResourceBarrier(VKW::Context& context, VKW::ImageResource* resource, VKW::ResourceAccess access, VKW::Stages stageFlags)
+static bool IsReadOnlyAccess(VKW::ResourceAccess access)
 {
-    TextureAccessEntry& entry = m_TextureHistory[resource];
+    switch (access)
+    {
+    case VKW::RESOURCE_ACCESS_TRANSFER_SRC:
+    case VKW::RESOURCE_ACCESS_SHADER_READ:
+    case VKW::RESOURCE_ACCESS_SHADER_UNIFORM:
+    case VKW::RESOURCE_ACCESS_SHADER_SAMPLE:
+    case VKW::RESOURCE_ACCESS_HOST_READ:
+    case VKW::RESOURCE_ACCESS_GENERIC_READ:
+        return true;
 
-    context.CmdResourceDependency(resource, 
-        entry.access,   entry.stage,
-        access,         stageFlags);
+    default:
+        return false;
+    }
+}
+
+// false if the previous barrier already made the resource visible to these stages
+template<typename TEntry>
+static bool UpdateAccessEntry(TEntry& entry, VKW::ResourceAccess access, VKW::Stages stageFlags, VKW::Stages& srcStage)
+{
+    srcStage = entry.stage;
+
+    if (entry.access == access && IsReadOnlyAccess(access))
+    {
+        if ((stageFlags & ~entry.stage) == 0)
+            return false;
+
+        entry.stage |= stageFlags;
+        return true;
+    }
 
     entry.access = access;
     entry.stage  = stageFlags;
+    return true;
+}
+
+// first access on another queue, the semaphore between the queues already waits for the previous access
+template<typename TEntry>
+static void ChangeQueueFamily(TEntry& entry, std::uint32_t queueFamily)
+{
+    if (entry.queueFamily != queueFamily && entry.queueFamily != VK_QUEUE_FAMILY_IGNORED)
+    {
+        entry.access = VKW::RESOURCE_ACCESS_UNDEFINED;
+        entry.stage  = VKW::STAGE_UNDEFINED;
+    }
 
+    entry.queueFamily = queueFamily;
 }
 
-void DependencyManager::ResourceBarrier(VKW::Context& context, VKW::BufferResource* resource, VKW::ResourceAccess access, VKW::Stages stageFlags)
+template<typename TEntry>
+std::uint32_t DependencyManager::AllocateSlot(StatePages<TEntry>& states, std::vector<std::uint32_t>& freeSlots)
 {
-    BufferAccessEntry& entry = m_BufferHistory[resource];
+    std::lock_guard<std::mutex> lock{ m_SlotsMutex };
+
+    if (!freeSlots.empty())
+    {
+        std::uint32_t const slot = freeSlots.back();
+        freeSlots.pop_back();
+        return slot;
+    }
+
+    if (states.m_SlotsCount == states.m_PagesCount * STATES_PAGE_SIZE)
+    {
+        DRE_ASSERT(states.m_PagesCount < MAX_STATES_PAGES, "DependencyManager: out of resource state pages.");
+        states.m_Pages[states.m_PagesCount++] = std::make_unique<TEntry[]>(STATES_PAGE_SIZE);
+    }
+
+    return states.m_SlotsCount++;
+}
+
+DependencyManager::TextureAccessEntry& DependencyManager::GetState(VKW::ImageResource* resource)
+{
+    if (resource->stateSlot_ == DRE_U32_MAX)
+    {
+        resource->stateSlot_ = AllocateSlot(m_TextureStates, m_FreeTextureSlots);
+        m_TextureStates[resource->stateSlot_] = TextureAccessEntry{};
+    }
+
+    return m_TextureStates[resource->stateSlot_];
+}
+
+DependencyManager::BufferAccessEntry& DependencyManager::GetState(VKW::BufferResource* resource)
+{
+    if (resource->stateSlot_ == DRE_U32_MAX)
+    {
+        resource->stateSlot_ = AllocateSlot(m_BufferStates, m_FreeBufferSlots);
+        m_BufferStates[resource->stateSlot_] = BufferAccessEntry{};
+    }
+
+    return m_BufferStates[resource->stateSlot_];
+}
+
+void DependencyManager::ReclaimStateSlots(VKW::ResourcesController& controller)
+{
+    std::vector<std::uint32_t>& releasedTextures = controller.GetReleasedImageStateSlots();
+    std::vector<std::uint32_t>& releasedBuffers = controller.GetReleasedBufferStateSlots();
+
+    std::lock_guard<std::mutex> lock{ m_SlotsMutex };
+    m_FreeTextureSlots.insert(m_FreeTextureSlots.end(), releasedTextures.begin(), releasedTextures.end());
+    m_FreeBufferSlots.insert(m_FreeBufferSlots.end(), releasedBuffers.begin(), releasedBuffers.end());
+    releasedTextures.clear();
+    releasedBuffers.clear();
+}
+
+void DependencyManager::WaitPendingSplit(VKW::Context& context, VKW::ImageResource* resource, TextureAccessEntry& entry)
+{
+    if (entry.splitEvent == VK_NULL_HANDLE)
+        return;
+
+    context.CmdWaitEvent(entry.splitEvent, resource,
+        entry.splitSrcAccess,   entry.splitSrcStage,
+        entry.access,           entry.stage);
+
+    entry.splitEvent = VK_NULL_HANDLE;
+}
+
+void DependencyManager::ResourceBarrier(VKW::Context& context, VKW::ImageResource* resource, VKW::ResourceAccess access, VKW::Stages stageFlags)
+{
+    TextureAccessEntry& entry = GetState(resource);
+    WaitPendingSplit(context, resource, entry);
+
+    std::uint32_t const queueFamily = context.GetParentQueue()->GetQueueFamily();
+    if (entry.releasedTo == queueFamily)
+    {
+        // acquire, layouts have to match the release
+        context.CmdQueueOwnershipTransfer(resource,
+            entry.access,           VKW::STAGE_UNDEFINED,   entry.queueFamily,
+            entry.releasedAccess,   stageFlags,             queueFamily);
+
+        entry.access        = entry.releasedAccess;
+        entry.stage         = stageFlags;
+        entry.queueFamily   = queueFamily;
+        entry.releasedTo    = VK_QUEUE_FAMILY_IGNORED;
 
+        if (entry.access == access)
+            return;
+    }
+    else
+    {
+        ChangeQueueFamily(entry, queueFamily);
+    }
+
+    VKW::ResourceAccess const srcAccess = entry.access;
+    VKW::Stages srcStage;
+    if (!UpdateAccessEntry(entry, access, stageFlags, srcStage))
+        return;
+
+    context.CmdResourceDependency(resource, 
+        srcAccess,  srcStage,
+        access,     stageFlags);
+}
+
+void DependencyManager::DiscardBarrier(VKW::Context& context, VKW::ImageResource* resource, VKW::ResourceAccess access, VKW::Stages stageFlags)
+{
+    TextureAccessEntry& entry = GetState(resource);
+
+    // the transition is replaced, signaled event is reset with the frame
+    entry.splitEvent = VK_NULL_HANDLE;
+
+    // last access of the aliased image is unknown here, wait for everything before
     context.CmdResourceDependency(resource,
-        entry.access,   entry.stage,
-        access,         stageFlags);
+        VKW::RESOURCE_ACCESS_UNDEFINED, VKW::STAGE_ALL_GRAPHICS | VKW::STAGE_COMPUTE | VKW::STAGE_TRANSFER,
+        access, stageFlags);
 
-    entry.access = access;
-    entry.stage  = stageFlags;
+    entry.access        = access;
+    entry.stage         = stageFlags;
+    entry.queueFamily   = context.GetParentQueue()->GetQueueFamily();
+    entry.releasedTo    = VK_QUEUE_FAMILY_IGNORED;
+}
+
+void DependencyManager::ReleaseOwnership(VKW::Context& context, VKW::ImageResource* resource, VKW::Queue* dstQueue, VKW::ResourceAccess access)
+{
+    TextureAccessEntry& entry = GetState(resource);
+
+    std::uint32_t const queueFamily = context.GetParentQueue()->GetQueueFamily();
+    std::uint32_t const dstQueueFamily = dstQueue->GetQueueFamily();
+    if (entry.queueFamily != queueFamily || dstQueueFamily == queueFamily || entry.releasedTo != VK_QUEUE_FAMILY_IGNORED)
+        return;
+
+    WaitPendingSplit(context, resource, entry);
+
+    context.CmdQueueOwnershipTransfer(resource,
+        entry.access,   entry.stage,            queueFamily,
+        access,         VKW::STAGE_UNDEFINED,   dstQueueFamily);
+
+    entry.releasedTo        = dstQueueFamily;
+    entry.releasedAccess    = access;
+}
+
+void DependencyManager::SignalSplitBarrier(VKW::Context& context, VKW::ImageResource* resource, VKW::EventPool& events, VKW::ResourceAccess access, VKW::Stages stageFlags)
+{
+    TextureAccessEntry& entry = GetState(resource);
+
+    // ownership transfers stay regular barriers
+    std::uint32_t const queueFamily = context.GetParentQueue()->GetQueueFamily();
+    if (entry.queueFamily != queueFamily || entry.releasedTo != VK_QUEUE_FAMILY_IGNORED || entry.splitEvent != VK_NULL_HANDLE)
+        return;
+
+    TextureAccessEntry next = entry;
+    VKW::Stages srcStage;
+    if (!UpdateAccessEntry(next, access, stageFlags, srcStage))
+        return;
+
+    VkEvent const event = events.Allocate();
+    if (event == VK_NULL_HANDLE)
+        return;
+
+    context.CmdSetEvent(event, resource,
+        entry.access,   srcStage,
+        next.access,    next.stage);
+
+    next.splitEvent     = event;
+    next.splitSrcAccess = entry.access;
+    next.splitSrcStage  = srcStage;
+    entry = next;
+}
+
+bool DependencyManager::WaitSplitBarrier(VKW::Context& context, VKW::ImageResource* resource)
+{
+    TextureAccessEntry& entry = GetState(resource);
+    if (entry.splitEvent == VK_NULL_HANDLE)
+        return false;
+
+    WaitPendingSplit(context, resource, entry);
+    return true;
+}
+
+void DependencyManager::ResourceBarrier(VKW::Context& context, VKW::BufferResource* resource, VKW::ResourceAccess access, VKW::Stages stageFlags)
+{
+    BufferAccessEntry& entry = GetState(resource);
+    ChangeQueueFamily(entry, context.GetParentQueue()->GetQueueFamily());
+
+    VKW::ResourceAccess const srcAccess = entry.access;
+    VKW::Stages srcStage;
+    if (!UpdateAccessEntry(entry, access, stageFlags, srcStage))
+        return;
+
+    context.CmdResourceDependency(resource,
+        srcAccess,  srcStage,
+        access,     stageFlags);
 }
 
 }
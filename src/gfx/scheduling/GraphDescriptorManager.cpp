@@ -18,16 +18,16 @@ GraphDescriptorManager::GraphDescriptorManager(VKW::Device* device, GraphResourc
 {
 }
 
-void GraphDescriptorManager::RegisterTexture(PassID pass, char const* id, VKW::ResourceAccess access, VKW::DescriptorStage stages, std::uint8_t binding)
+void GraphDescriptorManager::RegisterTexture(PassID pass, TextureHandle handle, VKW::ResourceAccess access, VKW::DescriptorStage stages, std::uint8_t binding)
 {
     SetInfo& setInfo = m_DescriptorsInfo[pass];
-    setInfo.descriptorInfos.EmplaceBack(id, access, stages, 0u, 0u, std::uint8_t(1), binding);
+    setInfo.descriptorInfos.EmplaceBack(handle.m_Index, access, stages, 0u, 0u, std::uint8_t(1), binding);
 }
 
-void GraphDescriptorManager::RegisterBuffer(PassID pass, char const* id, VKW::ResourceAccess access, VKW::DescriptorStage stages, std::uint8_t binding)
+void GraphDescriptorManager::RegisterBuffer(PassID pass, BufferHandle handle, VKW::ResourceAccess access, VKW::DescriptorStage stages, std::uint8_t binding)
 {
     SetInfo& setInfo = m_DescriptorsInfo[pass];
-    setInfo.descriptorInfos.EmplaceBack(id, access, stages, 0u, 0u, std::uint8_t(0), binding);
+    setInfo.descriptorInfos.EmplaceBack(handle.m_Index, access, stages, 0u, 0u, std::uint8_t(0), binding);
 }
 
 void GraphDescriptorManager::RegisterUniformBuffer(PassID pass, VKW::DescriptorStage stages, std::uint8_t binding)
@@ -64,7 +64,6 @@ void GraphDescriptorManager::InitDescriptors()
         descriptorInfos.SortBubble([](DescriptorInfo const& lhs, DescriptorInfo const& rhs) { return lhs.m_Binding < rhs.m_Binding; });
 
         VKW::DescriptorSetLayout::Descriptor layoutDesc{};
-        VKW::DescriptorManager::WriteDesc writeDesc{};
         for (std::uint8_t i = 0, size = descriptorInfos.Size(); i < size; i++)
         {
             DescriptorInfo const& info = descriptorInfos[i];
@@ -76,20 +75,15 @@ void GraphDescriptorManager::InitDescriptors()
                 case VKW::RESOURCE_ACCESS_SHADER_RW:
                 case VKW::RESOURCE_ACCESS_SHADER_READ:
                     layoutDesc.Add(VKW::DESCRIPTOR_TYPE_STORAGE_IMAGE, info.m_Binding, info.m_Stages);
-                    if (info.m_ResourceID != RESOURCE_ID(TextureID::ID_None))
-                        writeDesc.AddStorageImage(m_ResourcesManager->GetTexture(info.m_ResourceID)->GetShaderView(), info.m_Binding);
                     break;
                 case VKW::RESOURCE_ACCESS_SHADER_SAMPLE:
                     layoutDesc.Add(VKW::DESCRIPTOR_TYPE_TEXTURE, info.m_Binding, info.m_Stages);
-                    if (info.m_ResourceID != RESOURCE_ID(TextureID::ID_None))
-                        writeDesc.AddSampledImage(m_ResourcesManager->GetTexture(info.m_ResourceID)->GetShaderView(), info.m_Binding);
                     break;
                 }
             }
             else
             {
                 layoutDesc.Add(VKW::DESCRIPTOR_TYPE_STORAGE_BUFFER, info.m_Binding, info.m_Stages);
-                writeDesc.AddStorageBuffer(m_ResourcesManager->GetBuffer(info.m_ResourceID)->GetResource(), info.m_Binding);
             }
         }
 
@@ -111,8 +105,8 @@ void GraphDescriptorManager::InitDescriptors()
         for (std::uint8_t i = 0; i < VKW::CONSTANTS::FRAMES_BUFFERING; i++)
         {
             perPassDescriptors.m_DescriptorSet[i] = m_ParentDevice->GetDescriptorManager()->AllocateStandaloneSet(*perPassDescriptors.m_DescriptorLayout);
-            m_ParentDevice->GetDescriptorManager()->WriteDescriptorSet(perPassDescriptors.m_DescriptorSet[i], writeDesc);
         }
+        WritePassSets(setInfo, perPassDescriptors.m_DescriptorSet);
 
         VKW::PipelineLayout::Descriptor pipelinelayoutDesc;
         m_PipelineDB->AddGlobalLayouts(pipelinelayoutDesc);
@@ -128,6 +122,52 @@ void GraphDescriptorManager::InitDescriptors()
     });
 }
 
+void GraphDescriptorManager::WriteDescriptors()
+{
+    m_DescriptorsInfo.ForEach([this](auto const& pair)
+    {
+        PerPassDescriptors& perPassDescriptors = m_PassDescriptors[*pair.key];
+        if (perPassDescriptors.m_DescriptorLayout != nullptr)
+            WritePassSets(*pair.value, perPassDescriptors.m_DescriptorSet);
+    });
+}
+
+void GraphDescriptorManager::WritePassSets(SetInfo const& setInfo, VKW::DescriptorSet const* sets)
+{
+    // uniform is written by the pass every frame
+    VKW::DescriptorManager::WriteDesc writeDesc{};
+    for (std::uint8_t i = 0, size = setInfo.descriptorInfos.Size(); i < size; i++)
+    {
+        DescriptorInfo const& info = setInfo.descriptorInfos[i];
+        if (info.m_IsTexture)
+        {
+            if (info.m_ResourceIndex == DRE_U32_MAX)
+                continue;
+
+            switch (info.m_Access)
+            {
+            case VKW::RESOURCE_ACCESS_SHADER_WRITE:
+            case VKW::RESOURCE_ACCESS_SHADER_RW:
+            case VKW::RESOURCE_ACCESS_SHADER_READ:
+                writeDesc.AddStorageImage(m_ResourcesManager->GetTexture(TextureHandle{ info.m_ResourceIndex })->GetShaderView(), info.m_Binding);
+                break;
+            case VKW::RESOURCE_ACCESS_SHADER_SAMPLE:
+                writeDesc.AddSampledImage(m_ResourcesManager->GetTexture(TextureHandle{ info.m_ResourceIndex })->GetShaderView(), info.m_Binding);
+                break;
+            }
+        }
+        else
+        {
+            writeDesc.AddStorageBuffer(m_ResourcesManager->GetBuffer(BufferHandle{ info.m_ResourceIndex })->GetResource(), info.m_Binding);
+        }
+    }
+
+    for (std::uint8_t i = 0; i < VKW::CONSTANTS::FRAMES_BUFFERING; i++)
+    {
+        m_ParentDevice->GetDescriptorManager()->WriteDescriptorSet(sets[i], writeDesc);
+    }
+}
+
 void GraphDescriptorManager::DestroyDescriptors()
 {
     m_PassDescriptors.Clear();
@@ -138,14 +178,24 @@ VKW::DescriptorSet GraphDescriptorManager::GetPassDescriptorSet(PassID pass, Fra
     return m_PassDescriptors[pass].m_DescriptorSet[id];
 }
 
+VKW::DescriptorSet const* GraphDescriptorManager::GetPassDescriptorSets(PassID pass)
+{
+    return m_PassDescriptors[pass].m_DescriptorSet;
+}
+
 VKW::PipelineLayout* GraphDescriptorManager::GetPassPipelineLayout(PassID pass)
 {
     return m_PassDescriptors[pass].m_PipelineLayout;
 }
 
+bool GraphDescriptorManager::HasPassUniform(PassID pass)
+{
+    return m_PassDescriptors[pass].m_UniformBinding != DRE_U32_MAX;
+}
+
 std::uint32_t GraphDescriptorManager::GetPassUniformBinding(PassID pass)
 {
-    DRE_ASSERT(m_PassDescriptors[pass].m_UniformBinding != DRE_U32_MAX, "No binding assigned for pass uniform.");
+    DRE_ASSERT(HasPassUniform(pass), "No binding assigned for pass uniform.");
     return m_PassDescriptors[pass].m_UniformBinding;
 }
 
@@ -9,20 +9,56 @@
 #include <gfx\pass\BasePass.hpp>
 #include <gfx\buffer\UniformProxy.hpp>
 
+#include <algorithm>
+
 namespace GFX
 {
 
+static_assert(GraphResourcesManager::MAX_TEXTURES <= 32, "Standalone textures are tracked in a 32 bit mask.");
+
 GraphResourcesManager::GraphResourcesManager(VKW::Device* device)
     : m_Device{ device }
+    , m_StandaloneTextures{ 0 }
+    , m_TransientHeap{}
+    , m_TransientStats{}
 {
 
 }
 
 GraphResourcesManager::~GraphResourcesManager() = default;
 
-void GraphResourcesManager::RegisterTexture(char const* id, VKW::Format format, std::uint32_t width, std::uint32_t height, VKW::ResourceAccess access)
+TextureHandle GraphResourcesManager::AcquireTextureHandle(char const* id)
+{
+    auto pair = m_TextureHandles.Find(id);
+    if (pair.key != nullptr)
+        return *pair.value;
+
+    DRE_ASSERT(m_TextureNames.Size() < MAX_TEXTURES, "GraphResourcesManager: out of texture handles.");
+
+    TextureHandle handle{ m_TextureNames.Size() };
+    m_TextureNames.EmplaceBack(id);
+    m_TextureHandles.Emplace(id, handle);
+    return handle;
+}
+
+BufferHandle GraphResourcesManager::AcquireBufferHandle(char const* id)
+{
+    auto pair = m_BufferHandles.Find(id);
+    if (pair.key != nullptr)
+        return *pair.value;
+
+    DRE_ASSERT(m_BufferNames.Size() < MAX_BUFFERS, "GraphResourcesManager: out of buffer handles.");
+
+    BufferHandle handle{ m_BufferNames.Size() };
+    m_BufferNames.EmplaceBack(id);
+    m_BufferHandles.Emplace(id, handle);
+    return handle;
+}
+
+TextureHandle GraphResourcesManager::RegisterTexture(char const* id, VKW::Format format, std::uint32_t width, std::uint32_t height, VKW::ResourceAccess access)
 {
-    AccumulatedInfo& info = m_AccumulatedTextureInfo[id];
+    TextureHandle const handle = AcquireTextureHandle(id);
+    AccumulatedInfo& info = m_AccumulatedTextureInfo[handle.m_Index];
 
     DRE_DEBUG_ONLY(if (info.access != VKW::RESOURCE_ACCESS_UNDEFINED))
         DRE_ASSERT(info.size0 == width && info.size1 == height && info.depth == 1, "Different sized specified for same resource");
@@ -32,11 +68,14 @@ void GraphResourcesManager::RegisterTexture(char const* id, VKW::Format format,
     info.size0 = width;
     info.size1 = height;
     info.depth = 1;
+
+    return handle;
 }
 
-void GraphResourcesManager::RegisterBuffer(char const* id, std::uint32_t size, VKW::ResourceAccess access)
+BufferHandle GraphResourcesManager::RegisterBuffer(char const* id, std::uint32_t size, VKW::ResourceAccess access)
 {
-    AccumulatedInfo& info = m_AccumulatedBufferInfo[id];
+    BufferHandle const handle = AcquireBufferHandle(id);
+    AccumulatedInfo& info = m_AccumulatedBufferInfo[handle.m_Index];
 
     DRE_DEBUG_ONLY(if (info.access != VKW::RESOURCE_ACCESS_UNDEFINED))
         DRE_ASSERT(info.size0 == size, "Different sized specified for same resource");
@@ -46,89 +85,257 @@ void GraphResourcesManager::RegisterBuffer(char const* id, std::uint32_t size, V
     info.size0 = size;
     info.size1 = 0;
     info.depth = 0;
+
+    return handle;
 }
 
-void GraphResourcesManager::InitResources()
+void GraphResourcesManager::RegisterTextureUse(TextureHandle handle, std::uint32_t passIndex, bool overwrites)
 {
-    m_AccumulatedTextureInfo.ForEach([this](auto& pair)
+    TextureLifetime& lifetime = m_TextureLifetimes[handle.m_Index];
+    if (passIndex < lifetime.firstPass)
     {
-        AccumulatedInfo const& info = *pair.value;
-        auto texturePair = m_StorageTextures.Find(*pair.key);
-        if (texturePair.key != nullptr)
-        {
-            if (texturePair.value->info == info)
-                return;
-        }
+        // previous content is read, has to survive since the last frame
+        if (!overwrites)
+            lifetime.persistent = true;
 
+        lifetime.firstPass = passIndex;
+    }
 
-        VKW::ImageUsage usage = VKW::ImageUsage::STORAGE_IMAGE;
-        VkImageAspectFlags imageAspect = VK_IMAGE_ASPECT_COLOR_BIT;
-        if (info.access & VKW::RESOURCE_ACCESS_COLOR_ATTACHMENT)
-        {
-            usage = VKW::ImageUsage::RENDER_TARGET;
-            imageAspect = VK_IMAGE_ASPECT_COLOR_BIT;
-        }
-        else if (info.access & VKW::RESOURCE_ACCESS_DEPTH_STENCIL_ATTACHMENT)
-        {
-            usage = VKW::ImageUsage::DEPTH_STENCIL;
-            imageAspect = VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT;
-        }
-        else if (info.access & VKW::RESOURCE_ACCESS_DEPTH_ONLY_ATTACHMENT)
+    lifetime.lastPass = std::max(lifetime.lastPass, passIndex);
+}
+
+void GraphResourcesManager::MarkPersistent(TextureHandle handle)
+{
+    m_TextureLifetimes[handle.m_Index].persistent = true;
+}
+
+void GraphResourcesManager::MarkStandalone(TextureHandle handle)
+{
+    m_StandaloneTextures |= 1u << handle.m_Index;
+    MarkPersistent(handle);
+}
+
+void GraphResourcesManager::ResetTextureLifetimes()
+{
+    for (std::uint32_t i = 0, size = m_TextureNames.Size(); i < size; i++)
+    {
+        m_TextureLifetimes[i] = TextureLifetime{};
+        m_TextureLifetimes[i].persistent = (m_StandaloneTextures & (1u << i)) != 0;
+    }
+}
+
+static void GetTextureUsage(GraphResourcesManager::AccumulatedInfo const& info, VKW::ImageUsage& usage, VkImageAspectFlags& imageAspect)
+{
+    usage = VKW::ImageUsage::STORAGE_IMAGE;
+    imageAspect = VK_IMAGE_ASPECT_COLOR_BIT;
+    if (info.access & VKW::RESOURCE_ACCESS_COLOR_ATTACHMENT)
+    {
+        usage = VKW::ImageUsage::RENDER_TARGET;
+        imageAspect = VK_IMAGE_ASPECT_COLOR_BIT;
+    }
+    else if (info.access & VKW::RESOURCE_ACCESS_DEPTH_STENCIL_ATTACHMENT)
+    {
+        usage = VKW::ImageUsage::DEPTH_STENCIL;
+        imageAspect = VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT;
+    }
+    else if (info.access & VKW::RESOURCE_ACCESS_DEPTH_ONLY_ATTACHMENT)
+    {
+        usage = VKW::ImageUsage::DEPTH;
+        if ((info.access & (VKW::RESOURCE_ACCESS_SHADER_READ | VKW::RESOURCE_ACCESS_SHADER_WRITE | VKW::RESOURCE_ACCESS_SHADER_RW | VKW::RESOURCE_ACCESS_SHADER_SAMPLE)) != 0)
+            usage = VKW::ImageUsage::DEPTH_SAMPLED;
+        imageAspect = VK_IMAGE_ASPECT_DEPTH_BIT;
+    }
+}
+
+void GraphResourcesManager::CreateTexture(TextureHandle handle, AccumulatedInfo const& info, VKW::ImageUsage usage, VkImageAspectFlags aspect, VKW::ImageResource* image)
+{
+    VkImageSubresourceRange range = VKW::HELPER::DefaultImageSubresourceRange(aspect);
+    VKW::ImageResourceView* view = m_Device->GetResourcesController()->ViewImageAs(image, &range);
+    VKW::TextureDescriptorIndex globalDescriptor = m_Device->GetDescriptorManager()->AllocateTextureDescriptor(view);
+
+    m_Textures[handle.m_Index] = GraphTexture{ Texture{ m_Device, image, view, globalDescriptor }, info };
+}
+
+void GraphResourcesManager::PlaceTransientTextures(TransientTextures& textures)
+{
+    if (textures.Size() == 0)
+        return;
+
+    DRE_ASSERT(m_TransientHeap.page_ == nullptr, "Transient textures are placed once, DestroyResources first.");
+
+    // biggest first, every texture goes to the lowest offset free from textures alive at the same time
+    std::sort(textures.Data(), textures.Data() + textures.Size(), [](TransientTexture const& lhs, TransientTexture const& rhs)
+    {
+        return lhs.requirements.size > rhs.requirements.size;
+    });
+
+    std::uint64_t heapSize = 0;
+    std::uint64_t heapAlignment = 1;
+    std::uint32_t memoryTypeBits = ~0u;
+    for (std::uint32_t i = 0, size = textures.Size(); i < size; i++)
+    {
+        TransientTexture& texture = textures[i];
+        VkMemoryRequirements const& requirements = texture.requirements;
+
+        std::uint64_t offset = 0;
+        bool overlaps = true;
+        while (overlaps)
         {
-            usage = VKW::ImageUsage::DEPTH;
-            if ((info.access & (VKW::RESOURCE_ACCESS_SHADER_READ | VKW::RESOURCE_ACCESS_SHADER_WRITE | VKW::RESOURCE_ACCESS_SHADER_RW | VKW::RESOURCE_ACCESS_SHADER_SAMPLE)) != 0)
-                usage = VKW::ImageUsage::DEPTH_SAMPLED;
-            imageAspect = VK_IMAGE_ASPECT_DEPTH_BIT;
+            overlaps = false;
+            offset = DRE::Align(offset, static_cast<DRE::U32>(requirements.alignment));
+
+            for (std::uint32_t j = 0; j < i; j++)
+            {
+                TransientTexture const& placed = textures[j];
+                bool const aliveTogether = texture.lifetime.firstPass <= placed.lifetime.lastPass && placed.lifetime.firstPass <= texture.lifetime.lastPass;
+                bool const memoryOverlaps = offset < placed.offset + placed.requirements.size && placed.offset < offset + requirements.size;
+                if (aliveTogether && memoryOverlaps)
+                {
+                    offset = placed.offset + placed.requirements.size;
+                    overlaps = true;
+                }
+            }
         }
- 
-        //if (*pair.key == TextureID::FFTHxt)
-        //    DebugBreak();
 
-        VKW::ImageResource* image    = m_Device->GetResourcesController()->CreateImage(info.size0, info.size1, info.format, usage, *pair.key);
+        texture.offset = offset;
+        heapSize = std::max(heapSize, offset + requirements.size);
+        heapAlignment = std::max(heapAlignment, static_cast<std::uint64_t>(requirements.alignment));
+        memoryTypeBits &= requirements.memoryTypeBits;
 
+        m_TransientStats.texturesCount++;
+        m_TransientStats.dedicatedBytes += requirements.size;
+    }
 
-        VkImageSubresourceRange range = VKW::HELPER::DefaultImageSubresourceRange(imageAspect);
-        VKW::ImageResourceView* view = m_Device->GetResourcesController()->ViewImageAs(image, &range);
-        VKW::TextureDescriptorIndex globalDescriptor = m_Device->GetDescriptorManager()->AllocateTextureDescriptor(view);
+    DRE_ASSERT(memoryTypeBits != 0, "Transient textures have no common memory type.");
 
-        m_StorageTextures[*pair.key] = GraphTexture{ Texture{ m_Device, image, view, globalDescriptor }, info };
-    });
- 
+    VKW::ResourcesController* controller = m_Device->GetResourcesController();
+    m_TransientHeap = controller->AllocateImageHeap(heapSize, heapAlignment, memoryTypeBits);
+    m_TransientStats.heapBytes = heapSize;
+
+    for (std::uint32_t i = 0, size = textures.Size(); i < size; i++)
+    {
+        TransientTexture const& texture = textures[i];
+        VKW::ImageResource* image = controller->CreatePlacedImage(texture.info.size0, texture.info.size1, texture.info.format, texture.usage, m_TextureNames[texture.handle.m_Index], m_TransientHeap, texture.offset);
+        CreateTexture(texture.handle, texture.info, texture.usage, texture.aspect, image);
+    }
+}
+
+void GraphResourcesManager::InitResources()
+{
+    TransientTextures transientTextures;
 
-    m_AccumulatedBufferInfo.ForEach([this](auto& pair)
+    for (std::uint32_t i = 0, size = m_TextureNames.Size(); i < size; i++)
     {
-        AccumulatedInfo const& info = *pair.value;
-        auto bufferPair = m_StorageBuffers.Find(*pair.key);
-        if (bufferPair.key != nullptr)
+        AccumulatedInfo const& info = m_AccumulatedTextureInfo[i];
+        if (info.access == VKW::RESOURCE_ACCESS_UNDEFINED)
+            continue;
+
+        GraphTexture& texture = m_Textures[i];
+        if (texture.texture.GetResource() != nullptr && texture.info == info)
+            continue;
+
+        VKW::ImageUsage usage;
+        VkImageAspectFlags imageAspect;
+        GetTextureUsage(info, usage, imageAspect);
+
+        TextureLifetime const& lifetime = m_TextureLifetimes[i];
+        bool const used = lifetime.firstPass <= lifetime.lastPass;
+        if (used && !lifetime.persistent)
         {
-            if (bufferPair.value->info == info)
-                return;
+            TransientTexture& transient = transientTextures.EmplaceBack();
+            transient.handle = TextureHandle{ i };
+            transient.info = info;
+            transient.lifetime = lifetime;
+            transient.usage = usage;
+            transient.aspect = imageAspect;
+            transient.requirements = m_Device->GetResourcesController()->GetImageMemoryRequirements(info.size0, info.size1, info.format, usage);
+            transient.offset = 0;
+            continue;
         }
 
+        VKW::ImageResource* image = m_Device->GetResourcesController()->CreateImage(info.size0, info.size1, info.format, usage, m_TextureNames[i]);
+        m_TransientStats.persistentBytes += image->memory_.size_;
+
+        CreateTexture(TextureHandle{ i }, info, usage, imageAspect, image);
+    }
+
+    PlaceTransientTextures(transientTextures);
+
+    for (std::uint32_t i = 0, size = m_BufferNames.Size(); i < size; i++)
+    {
+        AccumulatedInfo const& info = m_AccumulatedBufferInfo[i];
+        if (info.access == VKW::RESOURCE_ACCESS_UNDEFINED)
+            continue;
+
+        GraphBuffer& buffer = m_Buffers[i];
+        if (buffer.buffer.GetResource() != nullptr && buffer.info == info)
+            continue;
+
         DRE_ASSERT(info.access | VKW::RESOURCE_ACCESS_SHADER_RW, "If there's no shader access, why we need this buffer?");
 
         // create storage buffer
-        VKW::BufferResource* buffer = m_Device->GetResourcesController()->CreateBuffer(info.size0, VKW::BufferUsage::STORAGE, *pair.key);
-        m_StorageBuffers.Emplace(*pair.key, GraphBuffer{ StorageBuffer{ m_Device, buffer }, info });
-    });
+        VKW::BufferResource* resource = m_Device->GetResourcesController()->CreateBuffer(info.size0, VKW::BufferUsage::STORAGE, m_BufferNames[i]);
+        buffer = GraphBuffer{ StorageBuffer{ m_Device, resource }, info };
+    }
 }
 
 void GraphResourcesManager::DestroyResources()
 {
-    m_StorageBuffers.Clear();
-    m_StorageTextures.Clear();
+    for (std::uint32_t i = 0, size = m_BufferNames.Size(); i < size; i++)
+    {
+        m_Buffers[i] = GraphBuffer{};
+    }
+
+    for (std::uint32_t i = 0, size = m_TextureNames.Size(); i < size; i++)
+    {
+        m_Textures[i] = GraphTexture{};
+    }
+
+    if (m_TransientHeap.page_ != nullptr)
+        m_Device->GetResourcesController()->FreeImageHeap(m_TransientHeap);
+
+    m_TransientStats = TransientMemoryStats{};
+}
+
+void GraphResourcesManager::DestroyTransientResources()
+{
+    for (std::uint32_t i = 0, size = m_TextureNames.Size(); i < size; i++)
+    {
+        VKW::ImageResource const* image = m_Textures[i].texture.GetResource();
+        if (image != nullptr && image->placed_)
+            m_Textures[i] = GraphTexture{};
+    }
+
+    // images are gone, the heap can go too and PlaceTransientTextures gets a fresh one
+    if (m_TransientHeap.page_ != nullptr)
+        m_Device->GetResourcesController()->FreeImageHeap(m_TransientHeap);
+
+    m_TransientStats.texturesCount = 0;
+    m_TransientStats.dedicatedBytes = 0;
+    m_TransientStats.heapBytes = 0;
+}
+
+TextureHandle GraphResourcesManager::FindTexture(char const* id)
+{
+    auto pair = m_TextureHandles.Find(id);
+    return pair.key != nullptr ? *pair.value : TextureHandle{};
+}
+
+BufferHandle GraphResourcesManager::FindBuffer(char const* id)
+{
+    auto pair = m_BufferHandles.Find(id);
+    return pair.key != nullptr ? *pair.value : BufferHandle{};
 }
 
 StorageBuffer* GraphResourcesManager::GetBuffer(char const* id)
 {
-    return &m_StorageBuffers.Find(id).value->buffer;
+    return GetBuffer(FindBuffer(id));
 }
 
 Texture* GraphResourcesManager::GetTexture(char const* id)
 {
-    return &m_StorageTextures.Find(id).value->texture;
+    return GetTexture(FindTexture(id));
 }
 
 
 }
-
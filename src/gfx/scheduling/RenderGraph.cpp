@@ -1,6 +1,14 @@
 #include <gfx\scheduling\RenderGraph.hpp>
 
+#include <bit>
+#include <cstring>
+
 #include <foundation\Common.hpp>
+#include <foundation\math\SimpleMath.hpp>
+#include <foundation\system\Profiler.hpp>
+#include <foundation\system\Time.hpp>
+
+#include <vk_wrapper\Context.hpp>
 
 #include <gfx\GraphicsManager.hpp>
 #include <gfx\pass\BasePass.hpp>
@@ -13,8 +21,22 @@ RenderGraph::RenderGraph(GraphicsManager* graphicsManager)
     : m_GraphicsManager{ graphicsManager }
     , m_ResourcesManager{ m_GraphicsManager->GetMainDevice() }
     , m_DescriptorManager{ m_GraphicsManager->GetMainDevice(), &m_ResourcesManager, &m_GraphicsManager->GetPipelineDB() }
+    , m_OutputTexture{ m_ResourcesManager.AcquireTextureHandle(RESOURCE_ID(TextureID::DisplayEncodedImage)) }
     , m_Passes{}
+    , m_PassCounters{}
+    , m_PassRecordUS{}
+    , m_OverheadUS{ 0 }
+    , m_SplitBarrierEvents{ m_GraphicsManager->GetMainDevice()->GetFuncTable(), m_GraphicsManager->GetMainDevice()->GetLogicalDevice() }
+    , m_ExecutionOrder{}
+    , m_CompiledPassSet{ 0 }
+    , m_InitializedPasses{ 0 }
+    , m_CompiledPasses{}
+    , m_TextureSlotPasses{ 0 }
+    , m_AsyncCandidates{ 0 }
+    , m_AsyncPasses{ 0 }
+    , m_AsyncJoinPosition{ 0 }
 {
+    std::memset(m_CompiledPassIndex, 0xFF, sizeof(m_CompiledPassIndex));
 }
 
 RenderGraph::~RenderGraph()
@@ -25,41 +47,61 @@ RenderGraph::~RenderGraph()
     }
 }
 
-void RenderGraph::RegisterTexture(BasePass* pass, char const* id, VKW::Format format, std::uint32_t width, std::uint32_t height, VKW::ResourceAccess access, VKW::Stages stage, std::uint32_t binding)
+TextureHandle RenderGraph::RegisterTexture(BasePass* pass, char const* id, VKW::Format format, std::uint32_t width, std::uint32_t height, VKW::ResourceAccess access, VKW::Stages stage, std::uint32_t binding)
 {
-    m_ResourcesManager.RegisterTexture(id, format, width, height, access);
-    m_DescriptorManager.RegisterTexture(pass->GetID(), id, access, VKW::StageToDescriptorStage(stage), binding);
+    TextureHandle const handle = m_ResourcesManager.RegisterTexture(id, format, width, height, access);
+    m_DescriptorManager.RegisterTexture(pass->GetID(), handle, access, VKW::StageToDescriptorStage(stage), binding);
+    AddResourceUsage(pass, handle, BufferHandle{}, access, stage);
+    return handle;
 }
 
-void RenderGraph::RegisterStandaloneTexture(char const* id, VKW::Format format, std::uint32_t width, std::uint32_t height, VKW::ResourceAccess access)
+TextureHandle RenderGraph::RegisterStandaloneTexture(char const* id, VKW::Format format, std::uint32_t width, std::uint32_t height, VKW::ResourceAccess access)
 {
-    m_ResourcesManager.RegisterTexture(id, format, width, height, access);
+    TextureHandle const handle = m_ResourcesManager.RegisterTexture(id, format, width, height, access);
+    m_ResourcesManager.MarkStandalone(handle);
+    return handle;
 }
 
 void RenderGraph::RegisterTextureSlot(BasePass* pass, VKW::ResourceAccess access, VKW::Stages stage, std::uint32_t binding)
 {
-    m_DescriptorManager.RegisterTexture(pass->GetID(), RESOURCE_ID(TextureID::ID_None), access, VKW::StageToDescriptorStage(stage), binding);
+    m_TextureSlotPasses |= 1u << std::uint32_t(pass->GetID());
+    m_DescriptorManager.RegisterTexture(pass->GetID(), TextureHandle{}, access, VKW::StageToDescriptorStage(stage), binding);
+}
+
+TextureHandle RenderGraph::RegisterTextureUsage(BasePass* pass, char const* id, VKW::ResourceAccess access, VKW::Stages stage)
+{
+    TextureHandle const handle = m_ResourcesManager.AcquireTextureHandle(id);
+    AddResourceUsage(pass, handle, BufferHandle{}, access, stage);
+    return handle;
 }
 
-void RenderGraph::RegisterRenderTarget(BasePass* pass, char const* id, VKW::Format format, std::uint32_t width, std::uint32_t height, std::uint32_t)
+TextureHandle RenderGraph::RegisterRenderTarget(BasePass* pass, char const* id, VKW::Format format, std::uint32_t width, std::uint32_t height, std::uint32_t)
 {
-    m_ResourcesManager.RegisterTexture(id, format, width, height, VKW::RESOURCE_ACCESS_COLOR_ATTACHMENT);
+    TextureHandle const handle = m_ResourcesManager.RegisterTexture(id, format, width, height, VKW::RESOURCE_ACCESS_COLOR_ATTACHMENT);
+    AddResourceUsage(pass, handle, BufferHandle{}, VKW::RESOURCE_ACCESS_COLOR_ATTACHMENT, VKW::STAGE_COLOR_OUTPUT);
+    return handle;
 }
 
-void RenderGraph::RegisterDepthStencilTarget(BasePass* pass, char const* id, VKW::Format format, std::uint32_t width, std::uint32_t height)
+TextureHandle RenderGraph::RegisterDepthStencilTarget(BasePass* pass, char const* id, VKW::Format format, std::uint32_t width, std::uint32_t height)
 {
-    m_ResourcesManager.RegisterTexture(id, format, width, height, VKW::RESOURCE_ACCESS_DEPTH_STENCIL_ATTACHMENT);
+    TextureHandle const handle = m_ResourcesManager.RegisterTexture(id, format, width, height, VKW::RESOURCE_ACCESS_DEPTH_STENCIL_ATTACHMENT);
+    AddResourceUsage(pass, handle, BufferHandle{}, VKW::RESOURCE_ACCESS_DEPTH_STENCIL_ATTACHMENT, VKW::STAGE_ALL_GRAPHICS);
+    return handle;
 }
 
-void RenderGraph::RegisterDepthOnlyTarget(BasePass* pass, char const* id, VKW::Format format, std::uint32_t width, std::uint32_t height)
+TextureHandle RenderGraph::RegisterDepthOnlyTarget(BasePass* pass, char const* id, VKW::Format format, std::uint32_t width, std::uint32_t height)
 {
-    m_ResourcesManager.RegisterTexture(id, format, width, height, VKW::RESOURCE_ACCESS_DEPTH_ONLY_ATTACHMENT);
+    TextureHandle const handle = m_ResourcesManager.RegisterTexture(id, format, width, height, VKW::RESOURCE_ACCESS_DEPTH_ONLY_ATTACHMENT);
+    AddResourceUsage(pass, handle, BufferHandle{}, VKW::RESOURCE_ACCESS_DEPTH_ONLY_ATTACHMENT, VKW::STAGE_ALL_GRAPHICS);
+    return handle;
 }
 
-void RenderGraph::RegisterStorageBuffer(BasePass* pass, char const* id, std::uint32_t size, VKW::ResourceAccess access, VKW::Stages stage, std::uint32_t binding)
+BufferHandle RenderGraph::RegisterStorageBuffer(BasePass* pass, char const* id, std::uint32_t size, VKW::ResourceAccess access, VKW::Stages stage, std::uint32_t binding)
 {
-    m_ResourcesManager.RegisterBuffer(id, size, access);
-    m_DescriptorManager.RegisterBuffer(pass->GetID(), id, access, VKW::StageToDescriptorStage(stage), binding);
+    BufferHandle const handle = m_ResourcesManager.RegisterBuffer(id, size, access);
+    m_DescriptorManager.RegisterBuffer(pass->GetID(), handle, access, VKW::StageToDescriptorStage(stage), binding);
+    AddResourceUsage(pass, TextureHandle{}, handle, access, stage);
+    return handle;
 }
 
 void RenderGraph::RegisterUniformBuffer(BasePass* pass, VKW::Stages stage, std::uint32_t binding)
@@ -72,6 +114,273 @@ void RenderGraph::RegisterPushConstant(BasePass* pass, std::uint32_t size, VKW::
     m_DescriptorManager.RegisterPushConstant(pass->GetID(), size, VKW::StageToDescriptorStage(stage));
 }
 
+void RenderGraph::RegisterAsyncCompute(BasePass* pass)
+{
+    m_AsyncCandidates |= 1u << std::uint32_t(pass->GetID());
+}
+
+void RenderGraph::AddResourceUsage(BasePass* pass, TextureHandle texture, BufferHandle buffer, VKW::ResourceAccess access, VKW::Stages stage)
+{
+    PassUsages& usages = m_PassUsages[std::uint32_t(pass->GetID())];
+    for (std::uint32_t i = 0, size = usages.Size(); i < size; i++)
+    {
+        ResourceUsage& usage = usages[i];
+        if (usage.m_TextureHandle != texture || usage.m_BufferHandle != buffer)
+            continue;
+
+        // depth attachment after a sample of the same texture is a read-only depth, stays in the sampled layout
+        bool const readOnlyDepth = usage.m_Access == VKW::RESOURCE_ACCESS_SHADER_SAMPLE &&
+            (access == VKW::RESOURCE_ACCESS_DEPTH_ONLY_ATTACHMENT || access == VKW::RESOURCE_ACCESS_DEPTH_STENCIL_ATTACHMENT);
+
+        if (usage.m_Access == access || readOnlyDepth)
+            usage.m_Stages |= stage;
+
+        return;
+    }
+
+    ResourceUsage& usage = usages.EmplaceBack();
+    usage.m_TextureHandle = texture;
+    usage.m_BufferHandle = buffer;
+    usage.m_Access = access;
+    usage.m_Stages = stage;
+    usage.m_IsTexture = texture.IsValid();
+}
+
+static bool IsOverwriteAccess(VKW::ResourceAccess access)
+{
+    switch (access)
+    {
+    case VKW::RESOURCE_ACCESS_TRANSFER_DST:
+    case VKW::RESOURCE_ACCESS_COLOR_ATTACHMENT:
+    case VKW::RESOURCE_ACCESS_DEPTH_ONLY_ATTACHMENT:
+    case VKW::RESOURCE_ACCESS_DEPTH_STENCIL_ATTACHMENT:
+    case VKW::RESOURCE_ACCESS_SHADER_WRITE:
+        return true;
+
+    default:
+        return false;
+    }
+}
+
+static bool IsWriteAccess(VKW::ResourceAccess access)
+{
+    std::uint64_t constexpr writeMask =
+        VKW::RESOURCE_ACCESS_TRANSFER_DST | VKW::RESOURCE_ACCESS_COLOR_ATTACHMENT |
+        VKW::RESOURCE_ACCESS_DEPTH_ONLY_ATTACHMENT | VKW::RESOURCE_ACCESS_DEPTH_STENCIL_ATTACHMENT |
+        VKW::RESOURCE_ACCESS_SHADER_WRITE | VKW::RESOURCE_ACCESS_SHADER_RW |
+        VKW::RESOURCE_ACCESS_HOST_WRITE | VKW::RESOURCE_ACCESS_CLEAR | VKW::RESOURCE_ACCESS_GENERIC_WRITE;
+
+    return (access & writeMask) != 0;
+}
+
+static bool IsReadAccess(VKW::ResourceAccess access)
+{
+    std::uint64_t constexpr readMask =
+        VKW::RESOURCE_ACCESS_TRANSFER_SRC | VKW::RESOURCE_ACCESS_SHADER_READ |
+        VKW::RESOURCE_ACCESS_SHADER_UNIFORM | VKW::RESOURCE_ACCESS_SHADER_SAMPLE | VKW::RESOURCE_ACCESS_SHADER_RW |
+        VKW::RESOURCE_ACCESS_HOST_READ | VKW::RESOURCE_ACCESS_PRESENT | VKW::RESOURCE_ACCESS_GENERIC_READ;
+
+    return (access & readMask) != 0;
+}
+
+bool RenderGraph::IsPassEnabled(PassID pass) const
+{
+    GraphicsSettings const& settings = m_GraphicsManager->GetGraphicsSettings();
+    switch (pass)
+    {
+    case PassID::Editor:    return settings.m_EditorOverlay;
+    case PassID::Debug:     return settings.m_DebugView;
+    default:                return true;
+    }
+}
+
+std::uint32_t RenderGraph::GetEnabledPassSet() const
+{
+    std::uint32_t passSet = 0;
+    for (std::uint32_t i = 0, size = m_Passes.Size(); i < size; i++)
+    {
+        if (IsPassEnabled(m_Passes[i]->GetID()))
+            passSet |= 1u << std::uint32_t(m_Passes[i]->GetID());
+    }
+
+    return passSet;
+}
+
+bool RenderGraph::IsRootPass(PassID pass, PassUsages const& usages)
+{
+    // overlays write the graph output too, they only count when switched on
+    if (!IsPassEnabled(pass))
+        return false;
+
+    bool writes = false;
+    for (std::uint32_t i = 0, size = usages.Size(); i < size; i++)
+    {
+        ResourceUsage const& usage = usages[i];
+        if (!IsWriteAccess(usage.m_Access))
+            continue;
+
+        writes = true;
+        if (!usage.m_IsTexture)
+            continue;
+
+        // graph output, or a standalone texture the next frame reads
+        if (usage.m_TextureHandle == m_OutputTexture || m_ResourcesManager.GetTextureLifetime(usage.m_TextureHandle).persistent)
+            return true;
+    }
+
+    // no declared writes, the pass works through texture slots or readbacks the graph can't follow
+    return !writes;
+}
+
+bool RenderGraph::HasDependency(PassUsages const& first, PassUsages const& second)
+{
+    for (std::uint32_t i = 0, firstSize = first.Size(); i < firstSize; i++)
+    {
+        for (std::uint32_t j = 0, secondSize = second.Size(); j < secondSize; j++)
+        {
+            ResourceUsage const& lhs = first[i];
+            ResourceUsage const& rhs = second[j];
+            if (lhs.m_TextureHandle == rhs.m_TextureHandle && lhs.m_BufferHandle == rhs.m_BufferHandle && (IsWriteAccess(lhs.m_Access) || IsWriteAccess(rhs.m_Access)))
+                return true;
+        }
+    }
+
+    return false;
+}
+
+bool RenderGraph::ReadsOutputOf(PassUsages const& reader, PassUsages const& writer)
+{
+    for (std::uint32_t i = 0, readerSize = reader.Size(); i < readerSize; i++)
+    {
+        for (std::uint32_t j = 0, writerSize = writer.Size(); j < writerSize; j++)
+        {
+            ResourceUsage const& read = reader[i];
+            ResourceUsage const& write = writer[j];
+            if (read.m_TextureHandle == write.m_TextureHandle && read.m_BufferHandle == write.m_BufferHandle && IsReadAccess(read.m_Access) && IsWriteAccess(write.m_Access))
+                return true;
+        }
+    }
+
+    return false;
+}
+
+void RenderGraph::RegisterTextureLifetimes()
+{
+    for (std::uint32_t i = 0, size = m_ExecutionOrder.Size(); i < size; i++)
+    {
+        PassUsages const& usages = m_PassUsages[std::uint32_t(m_Passes[m_ExecutionOrder[i]]->GetID())];
+        for (std::uint32_t j = 0, usagesCount = usages.Size(); j < usagesCount; j++)
+        {
+            ResourceUsage const& usage = usages[j];
+            if (!usage.m_IsTexture)
+                continue;
+
+            m_ResourcesManager.RegisterTextureUse(usage.m_TextureHandle, i, IsOverwriteAccess(usage.m_Access));
+
+            // runs next to graphics passes regardless of the order, can't share memory with them
+            if (IsAsyncPass(m_ExecutionOrder[i]))
+                m_ResourcesManager.MarkPersistent(usage.m_TextureHandle);
+        }
+    }
+
+    // copied to the swapchain after the graph
+    m_ResourcesManager.MarkPersistent(m_OutputTexture);
+}
+
+void RenderGraph::ResolveResourceUsages()
+{
+    for (std::uint32_t i = 0, size = m_ExecutionOrder.Size(); i < size; i++)
+    {
+        PassUsages& usages = m_PassUsages[std::uint32_t(m_Passes[m_ExecutionOrder[i]]->GetID())];
+        for (std::uint32_t j = 0, usagesCount = usages.Size(); j < usagesCount; j++)
+        {
+            ResourceUsage& usage = usages[j];
+            if (usage.m_IsTexture)
+            {
+                usage.m_Image = m_ResourcesManager.GetTexture(usage.m_TextureHandle)->GetResource();
+                usage.m_Discard = usage.m_Image->placed_ && m_ResourcesManager.GetTextureLifetime(usage.m_TextureHandle).firstPass == i;
+            }
+            else
+            {
+                usage.m_Buffer = m_ResourcesManager.GetBuffer(usage.m_BufferHandle)->GetResource();
+            }
+        }
+    }
+
+    PlanSplitBarriers();
+}
+
+void RenderGraph::PlanSplitBarriers()
+{
+    std::uint32_t const size = m_ExecutionOrder.Size();
+    for (std::uint32_t i = 0; i < size; i++)
+    {
+        m_SplitSignals[i].Clear();
+
+        PassUsages& usages = m_PassUsages[std::uint32_t(m_Passes[m_ExecutionOrder[i]]->GetID())];
+        for (std::uint32_t j = 0, usagesCount = usages.Size(); j < usagesCount; j++)
+        {
+            usages[j].m_SplitWait = false;
+        }
+    }
+
+    // a transition that can start after its producer and has at least one pass to hide behind.
+    // Async passes are on another queue, their images change owners instead
+    for (std::uint32_t i = 0; i < size; i++)
+    {
+        if (IsAsyncPass(m_ExecutionOrder[i]))
+            continue;
+
+        PassUsages const& usages = m_PassUsages[std::uint32_t(m_Passes[m_ExecutionOrder[i]]->GetID())];
+        for (std::uint32_t j = 0, usagesCount = usages.Size(); j < usagesCount; j++)
+        {
+            if (!usages[j].m_IsTexture)
+                continue;
+
+            ResourceUsage* next = nullptr;
+            std::uint32_t nextPosition = i + 1;
+            for (; nextPosition < size; nextPosition++)
+            {
+                PassUsages& nextUsages = m_PassUsages[std::uint32_t(m_Passes[m_ExecutionOrder[nextPosition]]->GetID())];
+                for (std::uint32_t k = 0, nextCount = nextUsages.Size(); k < nextCount && next == nullptr; k++)
+                {
+                    if (nextUsages[k].m_TextureHandle == usages[j].m_TextureHandle)
+                        next = &nextUsages[k];
+                }
+
+                if (next != nullptr)
+                    break;
+            }
+
+            if (next == nullptr || nextPosition == i + 1 || next->m_Discard || IsAsyncPass(m_ExecutionOrder[nextPosition]))
+                continue;
+
+            next->m_SplitWait = true;
+            m_SplitSignals[i].EmplaceBack(SplitBarrier{ usages[j].m_Image, next->m_Access, next->m_Stages });
+        }
+    }
+}
+
+void RenderGraph::TransitionPassResources(PassID pass, VKW::Context& context)
+{
+    DependencyManager& dependencyManager = m_GraphicsManager->GetDependencyManager();
+
+    PassUsages const& usages = m_PassUsages[std::uint32_t(pass)];
+    for (std::uint32_t i = 0, size = usages.Size(); i < size; i++)
+    {
+        ResourceUsage const& usage = usages[i];
+        if (usage.m_SplitWait && dependencyManager.WaitSplitBarrier(context, usage.m_Image))
+            continue;
+
+        if (usage.m_Discard)
+            dependencyManager.DiscardBarrier(context, usage.m_Image, usage.m_Access, usage.m_Stages);
+        else if (usage.m_IsTexture)
+            dependencyManager.ResourceBarrier(context, usage.m_Image, usage.m_Access, usage.m_Stages);
+        else
+            dependencyManager.ResourceBarrier(context, usage.m_Buffer, usage.m_Access, usage.m_Stages);
+    }
+}
+
 Texture* RenderGraph::GetTexture(char const* id)
 {
     return m_ResourcesManager.GetTexture(id);
@@ -84,12 +393,34 @@ StorageBuffer* RenderGraph::GetBuffer(char const* id)
 
 UniformProxy RenderGraph::GetPassUniform(PassID id, VKW::Context& context, std::uint32_t size)
 {
-    UniformArena::Allocation allocation = m_GraphicsManager->GetUniformArena().AllocateTransientRegion(m_GraphicsManager->GetCurrentFrameID(), size, 256);
+    FrameID const frameID = m_GraphicsManager->GetCurrentFrameID();
+    UniformArena::Allocation allocation = m_GraphicsManager->GetUniformArena().AllocateTransientRegion(frameID, size, 256);
 
-    VKW::DescriptorManager::WriteDesc writes;
-    writes.AddUniform(allocation.m_Buffer, allocation.m_OffsetInBuffer, allocation.m_Size, m_DescriptorManager.GetPassUniformBinding(id));
+    std::uint32_t uniformBinding;
+    VKW::DescriptorSet passSet;
+    if (CompiledPass* compiled = FindCompiledPass(id))
+    {
+        CompiledPass::UniformRegion& written = compiled->m_WrittenUniform[frameID];
+        if (written.m_Buffer == allocation.m_Buffer && written.m_Offset == allocation.m_OffsetInBuffer && written.m_Size == allocation.m_Size)
+            return UniformProxy{ &context, allocation };
+
+        written = CompiledPass::UniformRegion{ allocation.m_Buffer, allocation.m_OffsetInBuffer, allocation.m_Size };
+        uniformBinding = compiled->m_UniformBinding;
+        passSet = compiled->m_PassSet[frameID];
+    }
+    else
+    {
+        // the set changes behind the cache, it's written again once the cache is back on
+        std::uint8_t const compiledIndex = m_CompiledPassIndex[std::uint32_t(id)];
+        if (compiledIndex != 0xFF)
+            m_CompiledPasses[compiledIndex].m_WrittenUniform[frameID] = CompiledPass::UniformRegion{};
+
+        uniformBinding = m_DescriptorManager.GetPassUniformBinding(id);
+        passSet = m_DescriptorManager.GetPassDescriptorSet(id, frameID);
+    }
 
-    VKW::DescriptorSet passSet = GetPassDescriptorSet(id, m_GraphicsManager->GetCurrentFrameID());
+    VKW::DescriptorManager::WriteDesc writes;
+    writes.AddUniform(allocation.m_Buffer, allocation.m_OffsetInBuffer, allocation.m_Size, uniformBinding);
     
     m_GraphicsManager->GetMainDevice()->GetDescriptorManager()->WriteDescriptorSet(passSet, writes);
 
@@ -103,10 +434,50 @@ std::uint32_t RenderGraph::GetPassSetBinding()
 
 std::uint32_t RenderGraph::GetUserSetBinding(PassID pass)
 {
+    if (CompiledPass const* compiled = FindCompiledPass(pass))
+        return compiled->m_UserSetBinding;
+
     return g_GraphicsManager->GetMainDevice()->GetDescriptorManager()->GetGlobalSetLayoutsCount() +
         (GetPassDescriptorSet(pass, g_GraphicsManager->GetCurrentFrameID()).IsValid() ? 1 : 0);
 }
 
+void RenderGraph::CompilePassBindings()
+{
+    DRE_CPU_SCOPE(RenderGraph_CompileBindings);
+
+    m_CompiledPasses.Clear();
+    std::memset(m_CompiledPassIndex, 0xFF, sizeof(m_CompiledPassIndex));
+
+    std::uint32_t const globalSetsCount = m_GraphicsManager->GetMainDevice()->GetDescriptorManager()->GetGlobalSetLayoutsCount();
+    for (std::uint32_t i = 0, size = m_ExecutionOrder.Size(); i < size; i++)
+    {
+        PassID const passID = m_Passes[m_ExecutionOrder[i]]->GetID();
+
+        CompiledPass& compiled = m_CompiledPasses.EmplaceBack();
+        VKW::DescriptorSet const* passSets = m_DescriptorManager.GetPassDescriptorSets(passID);
+        for (std::uint32_t j = 0; j < VKW::CONSTANTS::FRAMES_BUFFERING; j++)
+        {
+            compiled.m_PassSet[j] = passSets[j];
+        }
+
+        compiled.m_PipelineLayout = m_DescriptorManager.GetPassPipelineLayout(passID);
+        if (m_DescriptorManager.HasPassUniform(passID))
+            compiled.m_UniformBinding = m_DescriptorManager.GetPassUniformBinding(passID);
+        compiled.m_UserSetBinding = globalSetsCount + (compiled.m_PassSet[0].IsValid() ? 1 : 0);
+
+        m_CompiledPassIndex[std::uint32_t(passID)] = static_cast<std::uint8_t>(i);
+    }
+}
+
+RenderGraph::CompiledPass* RenderGraph::FindCompiledPass(PassID pass)
+{
+    std::uint8_t const index = m_CompiledPassIndex[std::uint32_t(pass)];
+    if (index == 0xFF || !m_GraphicsManager->GetGraphicsSettings().m_GraphBindingsCache)
+        return nullptr;
+
+    return &m_CompiledPasses[index];
+}
+
 void RenderGraph::ParseGraph()
 {
     for (std::uint32_t i = 0, size = m_Passes.Size(); i < size; i++)
@@ -115,41 +486,340 @@ void RenderGraph::ParseGraph()
     }
 }
 
+void RenderGraph::CompileGraph()
+{
+    std::uint32_t const passesCount = m_Passes.Size();
+
+    // disabled overlays are left out, GraphicsManager calls RecompileGraph when one is toggled
+    std::uint32_t const passSet = GetEnabledPassSet();
+    if (passSet == m_CompiledPassSet)
+        return;
+
+    DRE_CPU_SCOPE(RenderGraph_Compile);
+
+    // positions change, bindings are compiled again with the resources
+    m_CompiledPasses.Clear();
+    std::memset(m_CompiledPassIndex, 0xFF, sizeof(m_CompiledPassIndex));
+
+    // bit j of dependencies[i] is set if pass j has to run before pass i.
+    // Declarations are ordered by AddPass, a read before any write in the frame is the previous frame's content,
+    // so only conflicting pairs keep their AddPass order and any topological order renders the same frame.
+    // Texture slots aren't tracked by handle, passes using them stay where AddPass put them relative to every other pass.
+    // Async candidates are exempt, they declare everything they touch
+    std::uint32_t const fencePasses = m_TextureSlotPasses & ~m_AsyncCandidates;
+    std::uint32_t dependencies[20] = {};
+    for (std::uint32_t i = 0; i < passesCount; i++)
+    {
+        PassID const passID = m_Passes[i]->GetID();
+        PassUsages const& usages = m_PassUsages[std::uint32_t(passID)];
+        for (std::uint32_t j = 0; j < i; j++)
+        {
+            PassID const otherID = m_Passes[j]->GetID();
+            bool const fence = (fencePasses & ((1u << std::uint32_t(passID)) | (1u << std::uint32_t(otherID)))) != 0;
+            if (fence || HasDependency(m_PassUsages[std::uint32_t(otherID)], usages))
+                dependencies[i] |= 1u << j;
+        }
+    }
+
+    std::uint32_t alive = 0;
+    std::uint32_t enabled = 0;
+    for (std::uint32_t i = 0; i < passesCount; i++)
+    {
+        PassID const passID = m_Passes[i]->GetID();
+        if (IsPassEnabled(passID))
+            enabled |= 1u << i;
+        if (IsRootPass(passID, m_PassUsages[std::uint32_t(passID)]))
+            alive |= 1u << i;
+    }
+
+    // writers of everything an alive pass reads, in this frame or the previous one
+    bool aliveChanged = true;
+    while (aliveChanged)
+    {
+        aliveChanged = false;
+        for (std::uint32_t i = 0; i < passesCount; i++)
+        {
+            if ((alive & (1u << i)) == 0)
+                continue;
+
+            for (std::uint32_t j = 0; j < passesCount; j++)
+            {
+                if ((alive & (1u << j)) == 0 && (enabled & (1u << j)) != 0 && ReadsOutputOf(m_PassUsages[std::uint32_t(m_Passes[i]->GetID())], m_PassUsages[std::uint32_t(m_Passes[j]->GetID())]))
+                {
+                    alive |= 1u << j;
+                    aliveChanged = true;
+                }
+            }
+        }
+    }
+
+    // dependencies only point to lower indices: a forward sweep finds the passes waiting on async candidates,
+    // a backward one the length of the longest chain every pass starts
+    std::uint32_t chainLength[20] = {};
+    std::uint32_t asyncDependents = 0;
+    for (std::uint32_t i = 0; i < passesCount; i++)
+    {
+        std::uint32_t const liveDependencies = dependencies[i] & alive;
+        for (std::uint32_t j = 0; j < i; j++)
+        {
+            bool const asyncCandidate = (m_AsyncCandidates & (1u << std::uint32_t(m_Passes[j]->GetID()))) != 0;
+            if ((liveDependencies & (1u << j)) != 0 && ((asyncDependents & (1u << j)) != 0 || asyncCandidate))
+                asyncDependents |= 1u << i;
+        }
+    }
+    for (std::uint32_t i = passesCount; i-- > 0;)
+    {
+        chainLength[i] = 1;
+        for (std::uint32_t j = i + 1; j < passesCount; j++)
+        {
+            if ((dependencies[j] & alive & (1u << i)) != 0)
+                chainLength[i] = DRE::Max(chainLength[i], chainLength[j] + 1);
+        }
+    }
+
+    // list scheduling over the alive passes, among the ready ones:
+    // 1. async candidates, they fork to the compute queue at the frame start
+    // 2. graphics work that doesn't wait on them, pushes the join back so compute has more to overlap with
+    // 3. the longest chain, producers move away from their consumers and split barriers get work to hide behind
+    // ties keep the AddPass order
+    m_ExecutionOrder.Clear();
+    std::uint32_t scheduled = ~alive & ((1u << passesCount) - 1);
+    for (std::uint32_t step = 0, aliveCount = std::popcount(alive); step < aliveCount; step++)
+    {
+        std::uint32_t next = DRE_U32_MAX;
+        std::uint32_t nextRank = 0;
+        for (std::uint32_t i = 0; i < passesCount; i++)
+        {
+            if ((scheduled & (1u << i)) != 0 || (dependencies[i] & ~scheduled) != 0)
+                continue;
+
+            bool const asyncCandidate = (m_AsyncCandidates & (1u << std::uint32_t(m_Passes[i]->GetID()))) != 0;
+            bool const waitsOnAsync = (asyncDependents & (1u << i)) != 0;
+            std::uint32_t const rank = (asyncCandidate ? 1u << 17 : 0u) | (waitsOnAsync ? 0u : 1u << 16) | chainLength[i];
+            if (next == DRE_U32_MAX || rank > nextRank)
+            {
+                next = i;
+                nextRank = rank;
+            }
+        }
+
+        DRE_ASSERT(next != DRE_U32_MAX, "RenderGraph: cyclic pass dependencies.");
+
+        scheduled |= 1u << next;
+        m_ExecutionOrder.EmplaceBack(next);
+    }
+
+    // async passes depend only on each other and are recorded up to the first pass that needs their results,
+    // the compute queue starts after the frame setup and graphics wait for it at the join
+    m_AsyncPasses = 0;
+    m_AsyncJoinPosition = m_ExecutionOrder.Size();
+    bool const asyncComputeAvailable = m_GraphicsManager->GetAsyncComputeContext() != nullptr;
+    for (std::uint32_t i = 0, size = m_ExecutionOrder.Size(); i < size && asyncComputeAvailable; i++)
+    {
+        std::uint32_t const passIndex = m_ExecutionOrder[i];
+        PassID const passID = m_Passes[passIndex]->GetID();
+        std::uint32_t const graphicsDependencies = dependencies[passIndex] & alive & ~m_AsyncPasses;
+
+        if ((m_AsyncCandidates & (1u << std::uint32_t(passID))) != 0 && graphicsDependencies == 0)
+        {
+            PassUsages const& usages = m_PassUsages[std::uint32_t(passID)];
+            for (std::uint32_t j = 0, usagesCount = usages.Size(); j < usagesCount; j++)
+            {
+                DRE_ASSERT((usages[j].m_Stages & ~(VKW::STAGE_COMPUTE | VKW::STAGE_TRANSFER)) == 0, "RenderGraph: async compute pass declared a graphics stage.");
+            }
+
+            m_AsyncPasses |= 1u << passIndex;
+            continue;
+        }
+
+        if ((dependencies[passIndex] & m_AsyncPasses) != 0)
+        {
+            m_AsyncJoinPosition = i;
+            break;
+        }
+    }
+
+    m_CompiledPassSet = passSet;
+}
+
 void RenderGraph::InitGraphResources()
 {
+    RegisterTextureLifetimes();
+
     m_ResourcesManager.InitResources();
     m_DescriptorManager.InitDescriptors();
+    ResolveResourceUsages();
+    CompilePassBindings();
+    InitializePasses();
+}
 
-    for (std::uint32_t i = 0, size = m_Passes.Size(); i < size; i++)
+void RenderGraph::InitializePasses()
+{
+    for (std::uint32_t i = 0, size = m_ExecutionOrder.Size(); i < size; i++)
     {
-        m_Passes[i]->Initialize(*this);
+        PassID const passID = m_Passes[m_ExecutionOrder[i]]->GetID();
+        if ((m_InitializedPasses & (1u << std::uint32_t(passID))) != 0)
+            continue;
+
+        m_Passes[m_ExecutionOrder[i]]->Initialize(*this);
+        m_InitializedPasses |= 1u << std::uint32_t(passID);
     }
 }
 
+bool RenderGraph::NeedsCompile() const
+{
+    return GetEnabledPassSet() != m_CompiledPassSet;
+}
+
+void RenderGraph::RecompileGraph()
+{
+    DRE_CPU_SCOPE(RenderGraph_Recompile);
+
+    // placement and lifetimes follow the execution order, both are rebuilt for the new one.
+    // Standalone textures stay persistent, the rest is derived from the uses again
+    m_ResourcesManager.DestroyTransientResources();
+    m_ResourcesManager.ResetTextureLifetimes();
+
+    CompileGraph();
+    RegisterTextureLifetimes();
+
+    m_ResourcesManager.InitResources();
+    m_DescriptorManager.WriteDescriptors();
+    ResolveResourceUsages();
+    CompilePassBindings();
+    InitializePasses();
+}
+
 void RenderGraph::UnloadGraphResources()
 {
+    m_CompiledPasses.Clear();
+    std::memset(m_CompiledPassIndex, 0xFF, sizeof(m_CompiledPassIndex));
+
     m_DescriptorManager.DestroyDescriptors();
     m_ResourcesManager.DestroyResources();
 }
 
 VKW::DescriptorSet RenderGraph::GetPassDescriptorSet(PassID pass, FrameID frameID)
 {
+    if (CompiledPass const* compiled = FindCompiledPass(pass))
+        return compiled->m_PassSet[frameID];
+
     return m_DescriptorManager.GetPassDescriptorSet(pass, frameID);
 }
 
 VKW::PipelineLayout* RenderGraph::GetPassPipelineLayout(PassID pass)
 {
+    if (CompiledPass const* compiled = FindCompiledPass(pass))
+        return compiled->m_PipelineLayout;
+
     return m_DescriptorManager.GetPassPipelineLayout(pass);
 }
 
+VKW::QueueExecutionPoint RenderGraph::ForkAsyncCompute(VKW::Context& context, VKW::Context& asyncContext)
+{
+    DependencyManager& dependencyManager = m_GraphicsManager->GetDependencyManager();
+
+    // images the graphics queue used last, compute acquires them with the first declared access
+    for (std::uint32_t i = 0, size = m_ExecutionOrder.Size(); i < size; i++)
+    {
+        if (!IsAsyncPass(m_ExecutionOrder[i]))
+            continue;
+
+        PassUsages const& usages = m_PassUsages[std::uint32_t(m_Passes[m_ExecutionOrder[i]]->GetID())];
+        for (std::uint32_t j = 0, usagesCount = usages.Size(); j < usagesCount; j++)
+        {
+            if (usages[j].m_IsTexture)
+                dependencyManager.ReleaseOwnership(context, usages[j].m_Image, asyncContext.GetParentQueue(), usages[j].m_Access);
+        }
+    }
+
+    // frame setup (global uniforms, uploads) is submitted here, async passes start after it
+    VKW::QueueExecutionPoint const forkPoint = context.SyncPoint();
+
+    // bound sets don't survive the new commandlist
+    VKW::DescriptorManager& descriptorManager = *m_GraphicsManager->GetMainDevice()->GetDescriptorManager();
+    context.CmdBindGlobalDescriptorSets(descriptorManager, m_GraphicsManager->GetCurrentFrameID());
+    asyncContext.CmdBindGlobalDescriptorSets(descriptorManager, m_GraphicsManager->GetCurrentFrameID());
+
+    return forkPoint;
+}
+
+void RenderGraph::JoinAsyncCompute(VKW::Context& context, VKW::Context& asyncContext, VKW::QueueExecutionPoint const& forkPoint)
+{
+    DependencyManager& dependencyManager = m_GraphicsManager->GetDependencyManager();
+
+    // images the rest of the graph uses from the compute queue
+    for (std::uint32_t i = m_AsyncJoinPosition, size = m_ExecutionOrder.Size(); i < size; i++)
+    {
+        PassUsages const& usages = m_PassUsages[std::uint32_t(m_Passes[m_ExecutionOrder[i]]->GetID())];
+        for (std::uint32_t j = 0, usagesCount = usages.Size(); j < usagesCount; j++)
+        {
+            if (usages[j].m_IsTexture)
+                dependencyManager.ReleaseOwnership(asyncContext, usages[j].m_Image, context.GetParentQueue(), usages[j].m_Access);
+        }
+    }
+
+    VKW::QueueExecutionPoint const asyncComplete = asyncContext.SyncPoint(forkPoint);
+
+    // graphics recorded so far runs next to the async passes, only what follows waits
+    context.SyncPoint();
+    context.WaitOnNextSubmit(asyncComplete);
+    context.CmdBindGlobalDescriptorSets(*m_GraphicsManager->GetMainDevice()->GetDescriptorManager(), m_GraphicsManager->GetCurrentFrameID());
+}
+
 Texture& RenderGraph::Render(VKW::Context& context)
 {
-    for (std::uint32_t i = 0, size = m_Passes.Size(); i < size; i++)
+    DRE_CPU_SCOPE(RenderGraph_Render);
+
+    std::uint64_t const renderBeginUS = DRE::Stopwatch::GlobalTimeMicroseconds();
+    std::uint64_t passesUS = 0;
+
+    DependencyManager& dependencyManager = m_GraphicsManager->GetDependencyManager();
+    bool const splitBarriers = m_GraphicsManager->GetGraphicsSettings().m_SplitBarriers;
+    m_SplitBarrierEvents.BeginFrame(context, m_GraphicsManager->GetCurrentFrameID());
+
+    VKW::Context* asyncContext = m_AsyncPasses != 0 ? m_GraphicsManager->GetAsyncComputeContext() : nullptr;
+    VKW::QueueExecutionPoint forkPoint;
+    if (asyncContext != nullptr)
+        forkPoint = ForkAsyncCompute(context, *asyncContext);
+
+    for (std::uint32_t i = 0, size = m_ExecutionOrder.Size(); i < size; i++)
     {
-        m_Passes[i]->Render(*this, context);
+        if (asyncContext != nullptr && i == m_AsyncJoinPosition)
+            JoinAsyncCompute(context, *asyncContext, forkPoint);
+
+        std::uint32_t const passIndex = m_ExecutionOrder[i];
+        BasePass* pass = m_Passes[passIndex];
+        VKW::Context& passContext = IsAsyncPass(passIndex) ? *asyncContext : context;
+
+        RenderCounters const passBegin = m_GraphicsManager->SampleRenderCounters(passContext);
+        TransitionPassResources(pass->GetID(), passContext);
+
+        std::uint64_t const recordBeginUS = DRE::Stopwatch::GlobalTimeMicroseconds();
+        pass->Render(*this, passContext);
+        m_PassRecordUS[i] = DRE::Stopwatch::GlobalTimeMicroseconds() - recordBeginUS;
+        passesUS += m_PassRecordUS[i];
+
+        for (std::uint32_t j = 0, splitsCount = m_SplitSignals[i].Size(); j < splitsCount && splitBarriers; j++)
+        {
+            SplitBarrier const& split = m_SplitSignals[i][j];
+            dependencyManager.SignalSplitBarrier(passContext, split.m_Image, m_SplitBarrierEvents, split.m_Access, split.m_Stages);
+        }
+
+        m_PassCounters[i] = m_GraphicsManager->SampleRenderCounters(passContext) - passBegin;
     }
 
-    return *m_ResourcesManager.GetTexture(RESOURCE_ID(TextureID::DisplayEncodedImage));
+    if (asyncContext != nullptr && m_AsyncJoinPosition == m_ExecutionOrder.Size())
+        JoinAsyncCompute(context, *asyncContext, forkPoint);
+
+    m_OverheadUS = DRE::Stopwatch::GlobalTimeMicroseconds() - renderBeginUS - passesUS;
+
+    return *m_ResourcesManager.GetTexture(m_OutputTexture);
+}
+
+PassID RenderGraph::GetPassID(std::uint32_t passIndex) const
+{
+    return m_Passes[m_ExecutionOrder[passIndex]]->GetID();
 }
 
 GraphResourcesManager& RenderGraph::GetResourcesManager()
@@ -60,6 +60,18 @@ struct Complex
 };
 
 Texture* TextureBank::LoadTexture2DSync(DRE::String128 const& name, std::uint32_t width, std::uint32_t height, VKW::Format format, DRE::ByteBuffer const& textureData)
+{
+    Texture* texture = LoadTexture2D(*m_LoadingContext, name, width, height, format, textureData);
+
+    VKW::QueueExecutionPoint syncPoint = m_LoadingContext->SyncPoint();
+    m_LoadingContext->FlushAll();
+    syncPoint.Wait();
+    g_GraphicsManager->GetUploadArena().ResetAllocations(g_GraphicsManager->GetCurrentFrameID());
+
+    return texture;
+}
+
+Texture* TextureBank::LoadTexture2D(VKW::Context& context, DRE::String128 const& name, std::uint32_t width, std::uint32_t height, VKW::Format format, DRE::ByteBuffer const& textureData)
 {
     UploadArena& transientArena = g_GraphicsManager->GetUploadArena();
 
@@ -69,25 +81,20 @@ Texture* TextureBank::LoadTexture2DSync(DRE::String128 const& name, std::uint32_
     std::memcpy(stagingRegion.m_MappedRange, textureData.Data(), textureData.Size());
     stagingRegion.FlushCaches();
 
-    m_LoadingContext->CmdResourceDependency(imageResource, 
+    context.CmdResourceDependency(imageResource, 
         VKW::RESOURCE_ACCESS_UNDEFINED,     VKW::STAGE_UNDEFINED, 
         VKW::RESOURCE_ACCESS_TRANSFER_DST,  VKW::STAGE_TRANSFER);
 
-    m_LoadingContext->CmdResourceDependency(stagingRegion.m_Buffer, stagingRegion.m_OffsetInBuffer, stagingRegion.m_Size,
+    context.CmdResourceDependency(stagingRegion.m_Buffer, stagingRegion.m_OffsetInBuffer, stagingRegion.m_Size,
         VKW::RESOURCE_ACCESS_HOST_WRITE,    VKW::STAGE_HOST,
         VKW::RESOURCE_ACCESS_TRANSFER_SRC,  VKW::STAGE_TRANSFER);
 
-    m_LoadingContext->CmdCopyBufferToImage(imageResource, stagingRegion.m_Buffer, stagingRegion.m_OffsetInBuffer);
+    context.CmdCopyBufferToImage(imageResource, stagingRegion.m_Buffer, stagingRegion.m_OffsetInBuffer);
 
-    m_LoadingContext->CmdResourceDependency(imageResource,
+    context.CmdResourceDependency(imageResource,
         VKW::RESOURCE_ACCESS_TRANSFER_DST,  VKW::STAGE_TRANSFER,
         VKW::RESOURCE_ACCESS_SHADER_SAMPLE, VKW::STAGE_ALL_GRAPHICS | VKW::STAGE_COMPUTE);
 
-    VKW::QueueExecutionPoint syncPoint = m_LoadingContext->SyncPoint();
-    m_LoadingContext->FlushAll();
-    syncPoint.Wait();
-    transientArena.ResetAllocations(g_GraphicsManager->GetCurrentFrameID());
-
     VKW::ImageResourceView* imageView = m_ResourcesController->ViewImageAs(imageResource);
     VKW::TextureDescriptorIndex descriptorHandle = m_DescriptorAllocator->AllocateTextureDescriptor(imageView);
 
@@ -7,6 +7,7 @@
 #include <vk_wrapper\descriptor\DescriptorManager.hpp>
 #include <vk_wrapper\Helper.hpp>
 #include <vk_wrapper\pipeline\Dependency.hpp>
+#include <vk_wrapper\queue\TimestampQueries.hpp>
 
 namespace VKW
 {
@@ -17,14 +18,59 @@ Context::Context(VKW::ImportTable* table, VKW::Queue* queue, DRE::AllocatorLinea
     : m_ImportTable{ table }
     , m_ParentQueue{ queue }
     , m_RenderingRect{}
+    , m_RenderingFormats{}
+    , m_IsSecondary{ false }
     , m_PendingDependency{ barrierAllocator }
+    , m_PendingWaits{}
+    , m_TimestampQueries{ nullptr }
+    , m_Counters{}
 {
     m_CurrentCommandList = m_ParentQueue->GetFreeCommandList();
 }
 
+Context::Context(VKW::Context& primary)
+    : m_ImportTable{ primary.m_ImportTable }
+    , m_ParentQueue{ primary.m_ParentQueue }
+    , m_RenderingRect{ primary.m_RenderingRect }
+    , m_RenderingFormats{ primary.m_RenderingFormats }
+    , m_IsSecondary{ true }
+    , m_PendingDependency{}
+    , m_PendingWaits{}
+    , m_TimestampQueries{ nullptr }
+    , m_Counters{}
+{
+    DRE_ASSERT(!primary.m_IsSecondary && primary.m_RenderingRect.extent.width > 0, "Secondary context can only continue rendering begun on a primary context.");
+
+    VkCommandBufferInheritanceRenderingInfoKHR renderingInfo;
+    renderingInfo.sType                     = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_RENDERING_INFO_KHR;
+    renderingInfo.pNext                     = nullptr;
+    renderingInfo.flags                     = VK_FLAGS_NONE;
+    renderingInfo.viewMask                  = 0;
+    renderingInfo.colorAttachmentCount      = m_RenderingFormats.m_ColorCount;
+    renderingInfo.pColorAttachmentFormats   = m_RenderingFormats.m_Color;
+    renderingInfo.depthAttachmentFormat     = m_RenderingFormats.m_Depth;
+    renderingInfo.stencilAttachmentFormat   = m_RenderingFormats.m_Stencil;
+    renderingInfo.rasterizationSamples      = VK_SAMPLE_COUNT_1_BIT;
+
+    VkCommandBufferInheritanceInfo inheritance;
+    inheritance.sType                   = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+    inheritance.pNext                   = &renderingInfo;
+    inheritance.renderPass              = VK_NULL_HANDLE;
+    inheritance.subpass                 = 0;
+    inheritance.framebuffer             = VK_NULL_HANDLE;
+    inheritance.occlusionQueryEnable    = VK_FALSE;
+    inheritance.queryFlags              = VK_FLAGS_NONE;
+    inheritance.pipelineStatistics      = VK_FLAGS_NONE;
+
+    m_CurrentCommandList = m_ParentQueue->GetFreeSecondaryCommandList();
+    m_CurrentCommandList->Begin(inheritance);
+}
+
 Context::~Context()
 {
-    m_ParentQueue->ReturnCommandList(m_CurrentCommandList);
+    // secondaries belong to the primary after CmdExecuteCommands
+    if (m_CurrentCommandList != nullptr)
+        m_ParentQueue->ReturnCommandList(m_CurrentCommandList);
 }
 
 void Context::ResetDependenciesVectors(DRE::AllocatorLinear* allocator)
@@ -36,7 +82,9 @@ void Context::FlushAll()
 {
     WriteResourceDependencies();
     FlushOnlyPending();
-    m_ParentQueue->Execute(m_CurrentCommandList);
+    m_ParentQueue->Execute(m_CurrentCommandList, std::uint8_t(m_PendingWaits.Size()), m_PendingWaits.Data());
+    m_PendingWaits.Clear();
+    m_Counters.m_Flushes++;
     m_CurrentCommandList = m_ParentQueue->GetFreeCommandList();
 }
 
@@ -54,13 +102,16 @@ void Context::WriteResourceDependencies()
     m_PendingDependency.GetDependency(info);
     m_ImportTable->vkCmdPipelineBarrier2(*m_CurrentCommandList, &info);
     m_PendingDependency.Clear();
+    m_Counters.m_BarrierBatches++;
 }
 
 void Context::FlushWaitSwapchain(PresentationContext& presentContext)
 {
     WriteResourceDependencies();
     FlushOnlyPending();
-    m_ParentQueue->ExecuteWaitSwapchain(m_CurrentCommandList, presentContext);
+    m_ParentQueue->ExecuteWaitSwapchain(m_CurrentCommandList, presentContext, std::uint8_t(m_PendingWaits.Size()), m_PendingWaits.Data());
+    m_PendingWaits.Clear();
+    m_Counters.m_Flushes++;
     m_CurrentCommandList = m_ParentQueue->GetFreeCommandList();
 }
 
@@ -74,9 +125,15 @@ VKW::QueueExecutionPoint Context::SyncPoint(std::uint8_t waitCount, VKW::QueueEx
     DRE_ASSERT(m_CurrentCommandList != nullptr, "Failed to submit CommandLists, current CmdList is nullptr.");
 
     WriteResourceDependencies();
-    VKW::QueueExecutionPoint point = m_ParentQueue->ScheduleExecute(m_CurrentCommandList, waitCount, waits);
+    for (std::uint8_t i = 0; i < waitCount; i++)
+    {
+        m_PendingWaits.EmplaceBack(waits[i]);
+    }
+    VKW::QueueExecutionPoint point = m_ParentQueue->ScheduleExecute(m_CurrentCommandList, std::uint8_t(m_PendingWaits.Size()), m_PendingWaits.Data());
+    m_PendingWaits.Clear();
     m_ParentQueue->ExecutePending();
     m_CurrentCommandList = m_ParentQueue->GetFreeCommandList();
+    m_Counters.m_Flushes++;
 
     return point;
 }
@@ -86,20 +143,28 @@ VKW::QueueExecutionPoint Context::SyncPoint(VKW::QueueExecutionPoint const& wait
     return SyncPoint(1, &wait);
 }
 
+void Context::WaitOnNextSubmit(VKW::QueueExecutionPoint const& point)
+{
+    m_PendingWaits.EmplaceBack(point);
+}
+
 void Context::CmdDraw(std::uint32_t vertexCount, std::uint32_t instanceCount, std::uint32_t firstVertex, std::uint32_t firstInstance)
 {
     m_ImportTable->vkCmdDraw(*m_CurrentCommandList, vertexCount, instanceCount, firstVertex, firstInstance);
+    m_Counters.m_Draws++;
 }
 
 void Context::CmdDrawIndexed(std::uint32_t indexCount, std::uint32_t instanceCount, std::uint32_t firstIndex, std::int32_t vertexOffset, std::uint32_t firstInstance)
 {
     m_ImportTable->vkCmdDrawIndexed(*m_CurrentCommandList, indexCount, instanceCount, firstIndex, vertexOffset, firstInstance);
+    m_Counters.m_Draws++;
 }
 
 void Context::CmdDispatch(std::uint32_t x, std::uint32_t y, std::uint32_t z)
 {
     WriteResourceDependencies();
     m_ImportTable->vkCmdDispatch(*m_CurrentCommandList, x, y, z);
+    m_Counters.m_Dispatches++;
 }
 
 void Context::CmdBindVertexBuffer(VKW::BufferResource const* buffer, std::uint32_t offset)
@@ -120,6 +185,7 @@ void Context::CmdBindPipeline(BindPoint bindPoint, VKW::Pipeline const* pipeline
 {
     VkPipelineBindPoint const vkBindPoint = (bindPoint == BindPoint::Graphics) ? VK_PIPELINE_BIND_POINT_GRAPHICS : VK_PIPELINE_BIND_POINT_COMPUTE;
     m_ImportTable->vkCmdBindPipeline(*m_CurrentCommandList, vkBindPoint, pipeline->GetHandle());
+    m_Counters.m_PipelineBinds++;
 }
 
 void Context::CmdBindGraphicsPipeline(VKW::Pipeline const* pipeline)
@@ -171,7 +237,8 @@ void Context::CmdBindGlobalDescriptorSets(VKW::DescriptorManager& descriptorMana
     globalSets[1] = descriptorManager.GetGlobalTexturesSet().GetHandle();
     globalSets[2] = descriptorManager.GetGlobalUniformSet(frameID).GetHandle();
 
-    m_ImportTable->vkCmdBindDescriptorSets(*m_CurrentCommandList, VK_PIPELINE_BIND_POINT_GRAPHICS, descriptorManager.GetGlobalPipelineLayout()->GetHandle(), 0, 3, globalSets, 0, nullptr);
+    if (m_ParentQueue->SupportsGraphics())
+        m_ImportTable->vkCmdBindDescriptorSets(*m_CurrentCommandList, VK_PIPELINE_BIND_POINT_GRAPHICS, descriptorManager.GetGlobalPipelineLayout()->GetHandle(), 0, 3, globalSets, 0, nullptr);
     m_ImportTable->vkCmdBindDescriptorSets(*m_CurrentCommandList, VK_PIPELINE_BIND_POINT_COMPUTE, descriptorManager.GetGlobalPipelineLayout()->GetHandle(), 0, 3, globalSets, 0, nullptr);
 }
 
@@ -223,22 +290,27 @@ void Context::CmdResourceDependency(VKW::ImageResource const* resource,
     ResourceAccess srcAccess, Stages srcStage,
     ResourceAccess dstAccess, Stages dstStage)
 {
+    // secondaries have no barrier allocator, barriers must be recorded on the primary outside the rendering
+    DRE_ASSERT(!m_IsSecondary, "Resource dependencies can't be recorded on a secondary context.");
     std::uint32_t const queueFamily = m_ParentQueue->GetQueueFamily();
 
     m_PendingDependency.Add(resource,
         srcAccess, srcStage, queueFamily,
         dstAccess, dstStage, queueFamily);
+    m_Counters.m_Barriers++;
 }
 
 void Context::CmdResourceDependency(VKW::BufferResource const* resource,
     ResourceAccess srcAccess, Stages srcStage,
     ResourceAccess dstAccess, Stages dstStage)
 {
+    DRE_ASSERT(!m_IsSecondary, "Resource dependencies can't be recorded on a secondary context.");
     std::uint32_t const queueFamily = m_ParentQueue->GetQueueFamily();
 
     m_PendingDependency.Add(resource,
         srcAccess, srcStage, queueFamily,
         dstAccess, dstStage, queueFamily);
+    m_Counters.m_Barriers++;
 }
 
 void Context::CmdResourceDependency(VKW::BufferResource const* resource,
@@ -246,12 +318,73 @@ void Context::CmdResourceDependency(VKW::BufferResource const* resource,
     ResourceAccess srcAccess, Stages srcStage,
     ResourceAccess dstAccess, Stages dstStage)
 {
+    DRE_ASSERT(!m_IsSecondary, "Resource dependencies can't be recorded on a secondary context.");
     std::uint32_t const queueFamily = m_ParentQueue->GetQueueFamily();
 
     m_PendingDependency.Add(resource,
         offset, size,
         srcAccess, srcStage, queueFamily,
         dstAccess, dstStage, queueFamily);
+    m_Counters.m_Barriers++;
+}
+
+void Context::CmdQueueOwnershipTransfer(VKW::ImageResource const* resource,
+    ResourceAccess srcAccess, Stages srcStage, std::uint32_t srcQueueFamily,
+    ResourceAccess dstAccess, Stages dstStage, std::uint32_t dstQueueFamily)
+{
+    DRE_ASSERT(!m_IsSecondary, "Resource dependencies can't be recorded on a secondary context.");
+    m_PendingDependency.Add(resource,
+        srcAccess, srcStage, srcQueueFamily,
+        dstAccess, dstStage, dstQueueFamily);
+    m_Counters.m_Barriers++;
+}
+
+void Context::CmdSetEvent(VkEvent event, VKW::ImageResource const* resource,
+    ResourceAccess srcAccess, Stages srcStage,
+    ResourceAccess dstAccess, Stages dstStage)
+{
+    // batched barriers may order earlier writes to the image, they go first
+    WriteResourceDependencies();
+
+    std::uint32_t const queueFamily = m_ParentQueue->GetQueueFamily();
+    VkImageMemoryBarrier2KHR const barrier = VKW::ImageBarrier(resource,
+        srcAccess, srcStage, queueFamily,
+        dstAccess, dstStage, queueFamily);
+
+    VkDependencyInfoKHR info{};
+    info.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO_KHR;
+    info.imageMemoryBarrierCount = 1;
+    info.pImageMemoryBarriers = &barrier;
+
+    m_ImportTable->vkCmdSetEvent2(*m_CurrentCommandList, event, &info);
+    m_Counters.m_Barriers++;
+    m_Counters.m_SplitBarriers++;
+}
+
+void Context::CmdWaitEvent(VkEvent event, VKW::ImageResource const* resource,
+    ResourceAccess srcAccess, Stages srcStage,
+    ResourceAccess dstAccess, Stages dstStage)
+{
+    WriteResourceDependencies();
+
+    // has to match the dependency of the set exactly
+    std::uint32_t const queueFamily = m_ParentQueue->GetQueueFamily();
+    VkImageMemoryBarrier2KHR const barrier = VKW::ImageBarrier(resource,
+        srcAccess, srcStage, queueFamily,
+        dstAccess, dstStage, queueFamily);
+
+    VkDependencyInfoKHR info{};
+    info.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO_KHR;
+    info.imageMemoryBarrierCount = 1;
+    info.pImageMemoryBarriers = &barrier;
+
+    m_ImportTable->vkCmdWaitEvents2(*m_CurrentCommandList, 1, &event, &info);
+}
+
+void Context::CmdResetEvent(VkEvent event, VkPipelineStageFlags2 stages)
+{
+    WriteResourceDependencies();
+    m_ImportTable->vkCmdResetEvent2(*m_CurrentCommandList, event, stages);
 }
 
 void Context::CmdClearAttachments(AttachmentMask attachments, std::uint32_t* value)
@@ -337,7 +470,7 @@ void Context::CmdClearAttachments(AttachmentMask attachments, float depth, std::
 }
 
 void Context::CmdBeginRendering(std::uint32_t attachmentCount, VKW::ImageResourceView* const* attachments,
-    VKW::ImageResourceView const* depthAttachment, VKW::ImageResourceView const* stencilAttachment)
+    VKW::ImageResourceView const* depthAttachment, VKW::ImageResourceView const* stencilAttachment, bool secondaryContents)
 {
     DRE_ASSERT(attachmentCount <= VKW::CONSTANTS::MAX_COLOR_ATTACHMENTS, "Exceeded maximum color attachment count.");
 
@@ -369,9 +502,15 @@ void Context::CmdBeginRendering(std::uint32_t attachmentCount, VKW::ImageResourc
     m_RenderingRect.extent.width = renderingWidth;
     m_RenderingRect.extent.height = renderingHeight;
 
+    m_RenderingFormats.m_ColorCount = attachmentCount;
+    m_RenderingFormats.m_Depth = depthAttachment != nullptr ? depthAttachment->createInfo_.format : VK_FORMAT_UNDEFINED;
+    m_RenderingFormats.m_Stencil = stencilAttachment != nullptr ? stencilAttachment->createInfo_.format : VK_FORMAT_UNDEFINED;
+
     DRE::InplaceVector<VkRenderingAttachmentInfoKHR, VKW::CONSTANTS::MAX_COLOR_ATTACHMENTS> colorInfos;
     for (std::uint32_t i = 0; i < attachmentCount; i++)
     {
+        m_RenderingFormats.m_Color[i] = attachments[i]->createInfo_.format;
+
         VkRenderingAttachmentInfoKHR& attachmentInfo = colorInfos.EmplaceBack();
         attachmentInfo.sType                = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO_KHR;
         attachmentInfo.pNext                = nullptr;
@@ -418,7 +557,7 @@ void Context::CmdBeginRendering(std::uint32_t attachmentCount, VKW::ImageResourc
     VkRenderingInfoKHR info;
     info.sType                          = VK_STRUCTURE_TYPE_RENDERING_INFO_KHR;
     info.pNext                          = nullptr;
-    info.flags                          = VK_FLAGS_NONE;
+    info.flags                          = secondaryContents ? VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT_KHR : VK_FLAGS_NONE;
     info.renderArea.offset.x            = 0;
     info.renderArea.offset.y            = 0;
     info.renderArea.extent.width        = renderingWidth;
@@ -444,6 +583,29 @@ void Context::CmdEndRendering()
     m_ImportTable->vkCmdEndRendering(*m_CurrentCommandList);
 }
 
+void Context::CmdExecuteCommands(std::uint32_t count, VKW::Context* const* secondaries)
+{
+    DRE_ASSERT(count <= VKW::CONSTANTS::MAX_SECONDARY_PER_PRIMARY, "Exceeded maximum secondary commandlists count.");
+
+    VkCommandBuffer commandBuffers[VKW::CONSTANTS::MAX_SECONDARY_PER_PRIMARY];
+    for (std::uint32_t i = 0; i < count; i++)
+    {
+        VKW::Context& secondary = *secondaries[i];
+        DRE_ASSERT(secondary.m_IsSecondary && secondary.m_ParentQueue == m_ParentQueue, "Only secondaries of the same queue can be executed.");
+
+        secondary.m_CurrentCommandList->End();
+        commandBuffers[i] = *secondary.m_CurrentCommandList;
+        m_CurrentCommandList->AddExecutedSecondary(secondary.m_CurrentCommandList);
+        secondary.m_CurrentCommandList = nullptr;
+
+        m_Counters.m_Draws          += secondary.m_Counters.m_Draws;
+        m_Counters.m_Dispatches     += secondary.m_Counters.m_Dispatches;
+        m_Counters.m_PipelineBinds  += secondary.m_Counters.m_PipelineBinds;
+    }
+
+    m_ImportTable->vkCmdExecuteCommands(*m_CurrentCommandList, count, commandBuffers);
+}
+
 void Context::CmdBindVertexBuffer(VKW::BufferResource* vertexBuffer, std::uint32_t offset)
 {
     VkDeviceSize vkOffset = static_cast<VkDeviceSize>(offset);
@@ -602,6 +764,22 @@ void Context::CmdEndDebugLabel()
     m_ImportTable->vkCmdEndDebugUtilsLabelEXT(*m_CurrentCommandList);
 }
 
+std::uint32_t Context::CmdBeginTimestampScope(char const* name)
+{
+    if (m_TimestampQueries == nullptr || !m_TimestampQueries->IsSupported())
+        return VKW::TimestampQueries::INVALID_SCOPE;
+
+    return m_TimestampQueries->BeginScope(*this, name);
+}
+
+void Context::CmdEndTimestampScope(std::uint32_t scope)
+{
+    if (m_TimestampQueries == nullptr)
+        return;
+
+    m_TimestampQueries->EndScope(*this, scope);
+}
+
 void Context::CmdInsertDebugLabel(char const* label)
 {
     VkDebugUtilsLabelEXT sLabel;
@@ -20,7 +20,13 @@ Device::Device(HINSTANCE hInstance, HWND hwnd, bool debug)
 
     table_ = std::make_unique<ImportTable>(*vulkanLibrary_);
 
-    auto instanceExtensions = std::vector<std::string>{ "VK_KHR_surface", VK_KHR_WIN32_SURFACE_EXTENSION_NAME };
+    bool const headless = hwnd == NULL;
+
+    auto instanceExtensions = std::vector<std::string>{};
+    if (!headless) {
+        instanceExtensions.emplace_back("VK_KHR_surface");
+        instanceExtensions.emplace_back(VK_KHR_WIN32_SURFACE_EXTENSION_NAME);
+    }
     if (debug)
         instanceExtensions.emplace_back(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
 
@@ -45,23 +51,51 @@ Device::Device(HINSTANCE hInstance, HWND hwnd, bool debug)
     deviceDesc.table_ = table_.get();
     deviceDesc.instance_ = instance_.get();
     deviceDesc.requiredExtensions_ = {
-        VK_KHR_SWAPCHAIN_EXTENSION_NAME,
-        VK_KHR_SYNCHRONIZATION_2_EXTENSION_NAME,
-        VK_KHR_ACCELERATION_STRUCTURE_EXTENSION_NAME,
-        VK_KHR_RAY_TRACING_PIPELINE_EXTENSION_NAME,
-        VK_KHR_DEFERRED_HOST_OPERATIONS_EXTENSION_NAME
+        VK_KHR_SYNCHRONIZATION_2_EXTENSION_NAME
 #ifndef DRE_COMPILE_FOR_RENDERDOC
         , VK_EXT_EXTENDED_DYNAMIC_STATE_3_EXTENSION_NAME
 #endif // DRE_COMPILE_FOR_RENDERDOC
     };
+    if (!headless) {
+        // software rasterizers used for headless runs don't expose ray tracing
+        deviceDesc.requiredExtensions_.emplace_back(VK_KHR_SWAPCHAIN_EXTENSION_NAME);
+        deviceDesc.requiredExtensions_.emplace_back(VK_KHR_ACCELERATION_STRUCTURE_EXTENSION_NAME);
+        deviceDesc.requiredExtensions_.emplace_back(VK_KHR_RAY_TRACING_PIPELINE_EXTENSION_NAME);
+        deviceDesc.requiredExtensions_.emplace_back(VK_KHR_DEFERRED_HOST_OPERATIONS_EXTENSION_NAME);
+    }
     deviceDesc.graphicsPresentQueueCount_ = 1;
-    deviceDesc.computeQueueCount_ = 0;
+    deviceDesc.computeQueueCount_ = 1; // optional, only created from a dedicated family
     deviceDesc.transferQueueCount_ = 0;
+    deviceDesc.headless_ = headless;
 
     device_ = std::make_unique<VKW::LogicalDevice>(deviceDesc);
     
+    queueProvider_ = std::make_unique<VKW::QueueProvider>(table_.get(), device_.get());
+
+    if (!headless) {
+        CreatePresentation(hInstance, hwnd);
+    }
+
+
+    VKW::MemoryControllerDesc memoryControllerDesc;
+    memoryControllerDesc.table_ = table_.get();
+    memoryControllerDesc.device_ = device_.get();
 
+    memoryController_ = std::make_unique<VKW::MemoryController>(memoryControllerDesc);
+
+
+
+    resourcesController_ = std::make_unique<VKW::ResourcesController>(table_.get(), device_.get(), memoryController_.get());
+    descriptorManager_ = std::make_unique<VKW::DescriptorManager>(table_.get(), device_.get());
+}
+
+Device::~Device()
+{
+    
+}
 
+void Device::CreatePresentation(HINSTANCE hInstance, HWND hwnd)
+{
     VKW::SurfaceDesc surfaceDesc;
     surfaceDesc.table_ = table_.get();
     surfaceDesc.instance_ = instance_.get();
@@ -81,25 +115,7 @@ Device::Device(HINSTANCE hInstance, HWND hwnd, bool debug)
 
     swapchain_ = std::make_unique<VKW::Swapchain>(swapchainDesc);
 
-    queueProvider_ = std::make_unique<VKW::QueueProvider>(table_.get(), device_.get());
     presentationController_ = std::make_unique<VKW::PresentationController>(table_.get(), device_.get(), swapchain_.get(), queueProvider_->GetPresentationQueue());
-
-
-    VKW::MemoryControllerDesc memoryControllerDesc;
-    memoryControllerDesc.table_ = table_.get();
-    memoryControllerDesc.device_ = device_.get();
-
-    memoryController_ = std::make_unique<VKW::MemoryController>(memoryControllerDesc);
-
-
-
-    resourcesController_ = std::make_unique<VKW::ResourcesController>(table_.get(), device_.get(), memoryController_.get());
-    descriptorManager_ = std::make_unique<VKW::DescriptorManager>(table_.get(), device_.get());
-}
-
-Device::~Device()
-{
-    
 }
 
 }
\ No newline at end of file
@@ -177,6 +177,11 @@ void ImportTable::GetDeviceProcAddresses(VkDevice device)
     VKW_IMPORT_VULKAN_DEVICE_FUNCTION(vkCmdDispatch);
     VKW_IMPORT_VULKAN_DEVICE_FUNCTION(vkCmdPipelineBarrier);
     VKW_IMPORT_VULKAN_DEVICE_FUNCTION(vkCmdPipelineBarrier2);
+    VKW_IMPORT_VULKAN_DEVICE_FUNCTION(vkCreateEvent);
+    VKW_IMPORT_VULKAN_DEVICE_FUNCTION(vkDestroyEvent);
+    VKW_IMPORT_VULKAN_DEVICE_FUNCTION(vkCmdSetEvent2);
+    VKW_IMPORT_VULKAN_DEVICE_FUNCTION(vkCmdWaitEvents2);
+    VKW_IMPORT_VULKAN_DEVICE_FUNCTION(vkCmdResetEvent2);
     VKW_IMPORT_VULKAN_DEVICE_FUNCTION(vkCmdBeginRenderPass);
     VKW_IMPORT_VULKAN_DEVICE_FUNCTION(vkCmdEndRenderPass);
     VKW_IMPORT_VULKAN_DEVICE_FUNCTION(vkCmdNextSubpass);
@@ -185,9 +190,14 @@ void ImportTable::GetDeviceProcAddresses(VkDevice device)
     VKW_IMPORT_VULKAN_DEVICE_FUNCTION(vkCmdClearAttachments);
     VKW_IMPORT_VULKAN_DEVICE_FUNCTION(vkCmdDraw);
     VKW_IMPORT_VULKAN_DEVICE_FUNCTION(vkCmdDrawIndexed);
+    VKW_IMPORT_VULKAN_DEVICE_FUNCTION(vkCmdExecuteCommands);
 
     VKW_IMPORT_VULKAN_DEVICE_FUNCTION(vkCreateQueryPool);
     VKW_IMPORT_VULKAN_DEVICE_FUNCTION(vkResetQueryPool);
+    VKW_IMPORT_VULKAN_DEVICE_FUNCTION(vkDestroyQueryPool);
+    VKW_IMPORT_VULKAN_DEVICE_FUNCTION(vkGetQueryPoolResults);
+    VKW_IMPORT_VULKAN_DEVICE_FUNCTION(vkCmdResetQueryPool);
+    VKW_IMPORT_VULKAN_DEVICE_FUNCTION(vkCmdWriteTimestamp2);
 
     VKW_IMPORT_VULKAN_DEVICE_FUNCTION(vkGetAccelerationStructureDeviceAddressKHR);
     VKW_IMPORT_VULKAN_DEVICE_FUNCTION(vkGetAccelerationStructureBuildSizesKHR);
@@ -15,6 +15,7 @@ LogicalDevice::LogicalDevice()
     , table_{ nullptr }
     , physicalDevice_{ VK_NULL_HANDLE }
     , physicalDeviceProperties_{}
+    , headless_{ false }
 {
 }
 
@@ -23,6 +24,7 @@ LogicalDevice::LogicalDevice(DeviceDesc const& desc)
     , table_{ desc.table_ }
     , physicalDevice_{ VK_NULL_HANDLE }
     , physicalDeviceProperties_{}
+    , headless_{ desc.headless_ }
 {
     std::uint32_t physicalDeviceCount = 0;
     std::vector<VkPhysicalDevice> physicalDevices;
@@ -128,7 +130,11 @@ LogicalDevice::LogicalDevice(DeviceDesc const& desc)
                 bool const queueCountSupported = queueFamilyProperties[j].queueCount >= QUEUE_COUNTS[i];
                 bool const queuePresentSupported = std::find(presentationFamilies.cbegin(), presentationFamilies.cend(), j) != presentationFamilies.cend() ? true : false;
 
-                if(queueTypeGraphics && !queuePresentSupported)
+                if(queueTypeGraphics && !queuePresentSupported && !headless_)
+                    continue;
+
+                // compute and transfer queues are only worth it in their own family, the graphics queue runs that work anyway
+                if(queueTypeGraphics && QUEUE_TYPE_FLAGS[i] != VK_QUEUE_GRAPHICS_BIT)
                     continue;
 
 
@@ -167,7 +173,7 @@ LogicalDevice::LogicalDevice(DeviceDesc const& desc)
                 }
             }
 
-            if (QUEUE_COUNTS[i] > 0) {
+            if (QUEUE_TYPE_FLAGS[i] == VK_QUEUE_GRAPHICS_BIT) {
                 assert(chosenQueueFamily != INVALID_QUEUE_INDEX && "Couldn't create all required queues");
             }
         }
@@ -180,6 +186,11 @@ LogicalDevice::LogicalDevice(DeviceDesc const& desc)
 
         DisableHeavyPhysicalDeviceFeatures();
 
+        if (headless_) {
+            // ray tracing extensions aren't enabled, their feature structs can't be in the chain
+            physicalDeviceProperties_.vulkan13Features.pNext = nullptr;
+        }
+
         VkDeviceCreateInfo createInfo;
         createInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
         createInfo.pNext = &physicalDeviceProperties_.features2;
@@ -209,6 +220,7 @@ LogicalDevice::LogicalDevice(LogicalDevice&& rhs)
     , table_{ nullptr }
     , physicalDevice_{ VK_NULL_HANDLE }
     , physicalDeviceProperties_{}
+    , headless_{ false }
 {
     operator=(std::move(rhs));
 }
@@ -220,6 +232,7 @@ LogicalDevice& LogicalDevice::operator=(LogicalDevice&& rhs)
     std::swap(physicalDevice_, rhs.physicalDevice_);
     std::swap(physicalDeviceProperties_, rhs.physicalDeviceProperties_);
     std::swap(queueInfo_, rhs.queueInfo_);
+    std::swap(headless_, rhs.headless_);
 
     return *this;
 }
@@ -337,7 +350,7 @@ bool LogicalDevice::IsPhysicalDeviceValid(
         }
     }
 
-    if (deviceProperties.presentationFamilies.size() > 0) {
+    if (headless_ || deviceProperties.presentationFamilies.size() > 0) {
         supportsSurface = true;
     }
 
@@ -475,7 +488,8 @@ void LogicalDevice::RequestDeviceProperties(
 
 #ifdef _WIN32
     deviceProperties.presentationFamilies.clear();
-    for (std::uint32_t i = 0u; i < queuePropsCount; ++i) {
+    // surface extensions aren't loaded by the headless instance
+    for (std::uint32_t i = 0u; i < queuePropsCount && !headless_; ++i) {
         VkBool32 presentationSupport = table_->vkGetPhysicalDeviceWin32PresentationSupportKHR(targetDevice, i);
         if (presentationSupport == VK_TRUE) {
             deviceProperties.presentationFamilies.push_back(i);
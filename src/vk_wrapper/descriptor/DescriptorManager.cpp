@@ -18,9 +18,10 @@ DescriptorManager::DescriptorManager(ImportTable* table, LogicalDevice* device)
 #ifdef DRE_IMGUI_CUSTOM_TEXTURE
     , perTextureDescriptors_{ VK_NULL_HANDLE }
 #endif
+    , setWritesCount_{ 0 }
 {
     std::uint32_t constexpr STANDALONE_DESCRIPTOR_COUNT = 1024;
-    std::uint32_t constexpr MAX_STANDALONE_SETS         = 1024;
+    std::uint32_t constexpr MAX_STANDALONE_SETS         = CONSTANTS::MAX_STANDALONE_SETS;
 
     VkDescriptorPoolSize sizes[4];
     sizes[0].type               = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
@@ -32,8 +33,9 @@ DescriptorManager::DescriptorManager(ImportTable* table, LogicalDevice* device)
     sizes[2].type               = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
     sizes[2].descriptorCount    = STANDALONE_DESCRIPTOR_COUNT;
 
+    // per-object sets are a single uniform buffer each
     sizes[3].type               = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-    sizes[3].descriptorCount    = STANDALONE_DESCRIPTOR_COUNT;
+    sizes[3].descriptorCount    = MAX_STANDALONE_SETS;
 
     VkDescriptorPoolCreateInfo standalonePoolInfo;
     standalonePoolInfo.sType          = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
@@ -109,6 +111,7 @@ DescriptorManager::DescriptorManager(ImportTable* table, LogicalDevice* device)
 DescriptorManager::DescriptorManager(DescriptorManager&& rhs)
     : table_{ nullptr }
     , device_{ nullptr }
+    , setWritesCount_{ 0 }
 {
     operator=(DRE_MOVE(rhs));
 }
@@ -133,6 +136,8 @@ DescriptorManager& DescriptorManager::operator=(DescriptorManager&& rhs)
 
     DRE_SWAP_MEMBER(standalonePool_);
 
+    DRE_SWAP_MEMBER(setWritesCount_);
+
     return *this;
 }
 
@@ -398,6 +403,8 @@ void DescriptorManager::WriteDescriptorSet(DescriptorSet set, WriteDesc& desc)
         desc.Writes(),
         0,
         nullptr);
+
+    setWritesCount_++;
 }
 
 DescriptorSet DescriptorManager::AllocateStandaloneSet(DescriptorSetLayout const& layout)
@@ -206,6 +206,33 @@ VkPipelineStageFlags2 StagesToFlags(Stages stage)
 //    return false;
 //}
 
+VkImageMemoryBarrier2KHR ImageBarrier(VKW::ImageResource const* resource,
+    ResourceAccess srcAccess, Stages srcStage, std::uint32_t srcQueueFamily,
+    ResourceAccess dstAccess, Stages dstStage, std::uint32_t dstQueueFamily)
+{
+    VkImageMemoryBarrier2KHR barrier{};
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2_KHR;
+    barrier.pNext = nullptr;
+    barrier.srcStageMask    = StagesToFlags(srcStage);
+    barrier.srcAccessMask   = AccessToFlags(srcAccess);
+    barrier.dstStageMask    = StagesToFlags(dstStage);
+    barrier.dstAccessMask   = AccessToFlags(dstAccess);
+    barrier.oldLayout       = AccessToLayout(srcAccess);
+    barrier.newLayout       = AccessToLayout(dstAccess);
+    barrier.image           = resource->handle_;
+
+    // same family is no ownership transfer
+    bool const transfer = srcQueueFamily != dstQueueFamily;
+    barrier.srcQueueFamilyIndex = transfer ? srcQueueFamily : VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = transfer ? dstQueueFamily : VK_QUEUE_FAMILY_IGNORED;
+
+    VkImageAspectFlags aspectFlags = Format2Aspect(resource->format_);
+    
+    barrier.subresourceRange = HELPER::DefaultImageSubresourceRange(aspectFlags);
+
+    return barrier;
+}
+
 Dependency::Dependency()
     : memoryBarriers_{}
     , bufferBarriers_{}
@@ -223,20 +250,9 @@ void Dependency::Add(
     ResourceAccess srcAccess, Stages srcStage, std::uint32_t srcQueueFamily,
     ResourceAccess dstAccess, Stages dstStage, std::uint32_t dstQueueFamily)
 {
-    VkImageMemoryBarrier2KHR& barrier = imageBarriers_.EmplaceBack();
-    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2_KHR;
-    barrier.pNext = nullptr;
-    barrier.srcStageMask    = StagesToFlags(srcStage);
-    barrier.srcAccessMask   = AccessToFlags(srcAccess);
-    barrier.dstStageMask    = StagesToFlags(dstStage);
-    barrier.dstAccessMask   = AccessToFlags(dstAccess);
-    barrier.oldLayout       = AccessToLayout(srcAccess);
-    barrier.newLayout       = AccessToLayout(dstAccess);
-    barrier.image           = resource->handle_;
-
-    VkImageAspectFlags aspectFlags = Format2Aspect(resource->format_);
-    
-    barrier.subresourceRange = HELPER::DefaultImageSubresourceRange(aspectFlags);
+    imageBarriers_.EmplaceBack(ImageBarrier(resource,
+        srcAccess, srcStage, srcQueueFamily,
+        dstAccess, dstStage, dstQueueFamily));
 }
 
 void Dependency::Add(
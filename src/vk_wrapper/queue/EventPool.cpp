@@ -0,0 +1,66 @@
+#include <vk_wrapper\queue\EventPool.hpp>
+
+#include <vk_wrapper\ImportTable.hpp>
+#include <vk_wrapper\LogicalDevice.hpp>
+#include <vk_wrapper\Context.hpp>
+#include <vk_wrapper\Tools.hpp>
+
+namespace VKW
+{
+
+EventPool::EventPool(ImportTable* table, LogicalDevice* device)
+    : m_Table{ table }
+    , m_Device{ device }
+    , m_Events{}
+    , m_UsedCount{}
+    , m_CurrentFrameID{ 0 }
+{
+    VkEventCreateInfo info;
+    info.sType = VK_STRUCTURE_TYPE_EVENT_CREATE_INFO;
+    info.pNext = nullptr;
+    info.flags = VK_EVENT_CREATE_DEVICE_ONLY_BIT;
+
+    for (std::uint32_t i = 0; i < CONSTANTS::FRAMES_BUFFERING; i++)
+    {
+        for (std::uint32_t j = 0; j < MAX_EVENTS_PER_FRAME; j++)
+        {
+            VK_ASSERT(m_Table->vkCreateEvent(m_Device->Handle(), &info, nullptr, &m_Events[i][j]));
+        }
+    }
+}
+
+EventPool::~EventPool()
+{
+    for (std::uint32_t i = 0; i < CONSTANTS::FRAMES_BUFFERING; i++)
+    {
+        for (std::uint32_t j = 0; j < MAX_EVENTS_PER_FRAME; j++)
+        {
+            if (m_Events[i][j] != VK_NULL_HANDLE)
+                m_Table->vkDestroyEvent(m_Device->Handle(), m_Events[i][j], nullptr);
+        }
+    }
+}
+
+void EventPool::BeginFrame(Context& context, std::uint8_t frameID)
+{
+    m_CurrentFrameID = frameID;
+
+    // waits of the previous use were recorded before the frame's completion point, only the signal state is left
+    for (std::uint32_t i = 0, size = m_UsedCount[frameID]; i < size; i++)
+    {
+        context.CmdResetEvent(m_Events[frameID][i], VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT);
+    }
+
+    m_UsedCount[frameID] = 0;
+}
+
+VkEvent EventPool::Allocate()
+{
+    std::uint32_t& used = m_UsedCount[m_CurrentFrameID];
+    if (used >= MAX_EVENTS_PER_FRAME)
+        return VK_NULL_HANDLE;
+
+    return m_Events[m_CurrentFrameID][used++];
+}
+
+}
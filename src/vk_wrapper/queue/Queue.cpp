@@ -31,13 +31,14 @@ VkSemaphore QueueExecutionPoint::GetTimelineSemaphore() const
 }
 
 ///////////////////////////////////////////
-CommandList::CommandList(ImportTable* table, LogicalDevice* device, Queue* parentQueue)
+CommandList::CommandList(ImportTable* table, LogicalDevice* device, Queue* parentQueue, bool secondary)
     : table_{ table }
     , device_{ device }
     , commandBuffer_{ VK_NULL_HANDLE }
     , commandPool_{ VK_NULL_HANDLE }
     , executionFinishPoint_{ parentQueue, 0 }
     , parentQueue_{ parentQueue }
+    , secondary_{ secondary }
 {
     DRE_DEBUG_ONLY(isOpened_ = false);
 
@@ -53,7 +54,7 @@ CommandList::CommandList(ImportTable* table, LogicalDevice* device, Queue* paren
     allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
     allocInfo.pNext = nullptr;
     allocInfo.commandPool = commandPool_;
-    allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    allocInfo.level = secondary_ ? VK_COMMAND_BUFFER_LEVEL_SECONDARY : VK_COMMAND_BUFFER_LEVEL_PRIMARY;
     allocInfo.commandBufferCount = 1;
     VK_ASSERT(table_->vkAllocateCommandBuffers(device_->Handle(), &allocInfo, &commandBuffer_));
 }
@@ -65,6 +66,7 @@ CommandList::CommandList(CommandList&& rhs)
     , commandPool_{ VK_NULL_HANDLE }
     , executionFinishPoint_{ nullptr, 0 }
     , parentQueue_{ nullptr }
+    , secondary_{ false }
 {
     DRE_DEBUG_ONLY(isOpened_ = false);
 
@@ -81,6 +83,8 @@ CommandList& CommandList::operator=(CommandList&& rhs)
     DRE_SWAP_MEMBER(executionFinishPoint_);
 
     DRE_SWAP_MEMBER(parentQueue_);
+    DRE_SWAP_MEMBER(secondary_);
+    DRE_SWAP_MEMBER(executedSecondaries_);
 
     DRE_DEBUG_ONLY( DRE_SWAP_MEMBER(isOpened_) );
 
@@ -107,6 +111,20 @@ void CommandList::Begin()
     DRE_DEBUG_ONLY(isOpened_ = true);
 }
 
+void CommandList::Begin(VkCommandBufferInheritanceInfo const& inheritance)
+{
+    DRE_ASSERT(secondary_, "Inheritance info is only used by secondary commandlists.");
+
+    VkCommandBufferBeginInfo info;
+    info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    info.pNext = nullptr;
+    info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT | VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+    info.pInheritanceInfo = &inheritance;
+
+    VK_ASSERT(table_->vkBeginCommandBuffer(commandBuffer_, &info));
+    DRE_DEBUG_ONLY(isOpened_ = true);
+}
+
 void CommandList::End()
 {
     DRE_DEBUG_ONLY(DRE_ASSERT(isOpened_, "Attempt to call End on commandlist that was not opened."));
@@ -119,7 +137,7 @@ void CommandList::Reset()
     DRE_DEBUG_ONLY(isOpened_ = false);
 }
 
-void CommandList::SetFinishExecutionPoint(QueueExecutionPoint& point)
+void CommandList::SetFinishExecutionPoint(QueueExecutionPoint const& point)
 {
     executionFinishPoint_ = point;
 }
@@ -129,6 +147,12 @@ void CommandList::WaitForPendingExecution()
     executionFinishPoint_.Wait();
 }
 
+void CommandList::AddExecutedSecondary(CommandList* secondary)
+{
+    DRE_ASSERT(!secondary_ && secondary->IsSecondary(), "Only primary commandlists execute secondaries.");
+    executedSecondaries_.EmplaceBack(secondary);
+}
+
 ///////////////////////////////////////////
 Queue::Queue()
     : table_{ nullptr }
@@ -136,6 +160,7 @@ Queue::Queue()
     , queue_{ VK_NULL_HANDLE }
     , queueFamily_{ INVALID_QUEUE }
     , queueIndex_{ INVALID_QUEUE }
+    , supportsGraphics_{ false }
     , timelineSemaphore_{ VK_NULL_HANDLE }
     , submitCounter_{ 0 }
 {
@@ -147,14 +172,26 @@ Queue::Queue(ImportTable* table, LogicalDevice* device, std::uint32_t queueFamil
     , queue_{ VK_NULL_HANDLE }
     , queueFamily_{ queueFamily }
     , queueIndex_{ queueIndex }
+    , supportsGraphics_{ false }
     , timelineSemaphore_{ VK_NULL_HANDLE }
     , submitCounter_{ 0 }
 {
     table_->vkGetDeviceQueue(device_->Handle(), queueFamily_, queueIndex, &queue_);
     assert(queue_ != VK_NULL_HANDLE && "Can't get device queue.");
 
+    for (std::uint32_t i = 0, count = device_->QueueFamilyCount(); i < count; i++)
+    {
+        DeviceQueueFamilyInfo const& family = device_->GetQueueFamily(i);
+        if (family.familyIndex_ == queueFamily_ && family.type_ == DeviceQueueType::GRAPHICS_PRESENT)
+            supportsGraphics_ = true;
+    }
+
     commandListPool_.Init(VKW::CONSTANTS::MAX_COMMANDLIST_PER_QUEUE, table, device, this);
 
+    // secondaries only continue rendering, compute queues don't need them
+    if (supportsGraphics_)
+        secondaryCommandListPool_.Init(VKW::CONSTANTS::MAX_SECONDARY_PER_QUEUE, table, device, this, true);
+
     VkSemaphoreCreateInfo semaphoreInfo;
     VkSemaphoreTypeCreateInfo typeInfo;
 
@@ -182,9 +219,11 @@ Queue& Queue::operator=(Queue&& rhs)
     DRE_SWAP_MEMBER(queue_);
     DRE_SWAP_MEMBER(queueFamily_);
     DRE_SWAP_MEMBER(queueIndex_);
+    DRE_SWAP_MEMBER(supportsGraphics_);
     DRE_SWAP_MEMBER(timelineSemaphore_);
     DRE_SWAP_MEMBER(submitCounter_);
     DRE_SWAP_MEMBER(commandListPool_);
+    DRE_SWAP_MEMBER(secondaryCommandListPool_);
 
     return *this;
 }
@@ -198,6 +237,14 @@ CommandList* Queue::GetFreeCommandList()
     return commandList;
 }
 
+CommandList* Queue::GetFreeSecondaryCommandList()
+{
+    CommandList* commandList = secondaryCommandListPool_.AcquireObject();
+    commandList->WaitForPendingExecution();
+    commandList->Reset();
+    return commandList;
+}
+
 QueueExecutionPoint Queue::ScheduleExecute(CommandList* commandList, QueueExecutionPoint const& waitPoint)
 {
     return ScheduleExecute(commandList, 1, &waitPoint);
@@ -259,12 +306,14 @@ QueueExecutionPoint Queue::ExecuteInternal(CommandList* commandList, std::uint8_
     std::uint8_t const binary = presentationContext == nullptr ? 0 : 1;
 
     DRE_ASSERT(waitPointCount + binary <= WAIT_COUNT_MAX, "Can't wait for more that 5 semaphores");
-    static VkPipelineStageFlags const waitStage[WAIT_COUNT_MAX] = {
-        VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
-        VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
-        VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
-        VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
-        VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT
+
+    // timeline points can come from another queue, nothing in the submission may start before them
+    VkPipelineStageFlags waitStage[WAIT_COUNT_MAX] = {
+        VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+        VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+        VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+        VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+        VK_PIPELINE_STAGE_ALL_COMMANDS_BIT
     };
 
     static std::uint64_t semaphoreWaitValues[WAIT_COUNT_MAX];
@@ -292,11 +341,12 @@ QueueExecutionPoint Queue::ExecuteInternal(CommandList* commandList, std::uint8_
     {
         semaphoreWaitValues[0] = 0;
         waitSemaphores[0] = presentationContext->GetSwapchainReleaseSemaphore();
+        waitStage[0] = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
     }
     for (std::uint8_t i = binary; i < waitPointCount + binary; i++)
     {
-        semaphoreWaitValues[i] = waitExecutionPoints[i].GetPoint();
-        waitSemaphores[i] = waitExecutionPoints[i].GetTimelineSemaphore();
+        semaphoreWaitValues[i] = waitExecutionPoints[i - binary].GetPoint();
+        waitSemaphores[i] = waitExecutionPoints[i - binary].GetTimelineSemaphore();
     }
 
     VkSubmitInfo submitInfo;
@@ -314,15 +364,37 @@ QueueExecutionPoint Queue::ExecuteInternal(CommandList* commandList, std::uint8_
 
     QueueExecutionPoint executionEndPoint{ this, signalValues[0] }; 
     commandList->SetFinishExecutionPoint(executionEndPoint);
+    ReturnExecutedSecondaries(commandList, executionEndPoint);
 
     commandListPool_.ReturnObject(commandList);
 
     return executionEndPoint;
 }
 
+void Queue::ReturnExecutedSecondaries(CommandList* commandList, QueueExecutionPoint const& finishPoint)
+{
+    for (std::uint32_t i = 0, size = commandList->executedSecondaries_.Size(); i < size; i++)
+    {
+        CommandList* secondary = commandList->executedSecondaries_[i];
+        secondary->SetFinishExecutionPoint(finishPoint);
+        secondaryCommandListPool_.ReturnObject(secondary);
+    }
+    commandList->executedSecondaries_.Clear();
+}
+
 void Queue::ReturnCommandList(CommandList* commandList)
 {
     commandList->End();
+
+    if (commandList->IsSecondary())
+    {
+        secondaryCommandListPool_.ReturnObject(commandList);
+        return;
+    }
+
+    // never submitted, nothing to wait for
+    ReturnExecutedSecondaries(commandList, QueueExecutionPoint{ this, 0 });
+
     commandListPool_.ReturnObject(commandList);
 }
 
@@ -10,6 +10,7 @@ QueueProvider::QueueProvider()
     : table_{ nullptr }
     , device_{ nullptr }
     , mainQueue_{}
+    , computeQueue_{}
 {
 }
 
@@ -17,14 +18,20 @@ QueueProvider::QueueProvider(ImportTable* table, LogicalDevice* device)
     : table_{ table }
     , device_{ device }
     , mainQueue_{ table, device, FindFamilyIndex(device_, DeviceQueueType::GRAPHICS_PRESENT, 1), 0 }
+    , computeQueue_{}
 {
-    
+    std::uint32_t const computeFamily = FindFamilyIndex(device_, DeviceQueueType::COMPUTE, 1);
+    if (computeFamily != std::numeric_limits<std::uint32_t>::max())
+    {
+        computeQueue_ = std::make_unique<Queue>(table, device, computeFamily, 0);
+    }
 }
 
 QueueProvider::QueueProvider(QueueProvider&& rhs)
     : table_{ nullptr }
     , device_{ nullptr }
     , mainQueue_{}
+    , computeQueue_{}
 {
     operator=(std::move(rhs));
 }
@@ -34,6 +41,7 @@ QueueProvider& QueueProvider::operator=(QueueProvider&& rhs)
     DRE_SWAP_MEMBER(table_);
     DRE_SWAP_MEMBER(device_);
     DRE_SWAP_MEMBER(mainQueue_);
+    DRE_SWAP_MEMBER(computeQueue_);
 
     return *this;
 }
@@ -41,6 +49,10 @@ QueueProvider& QueueProvider::operator=(QueueProvider&& rhs)
 QueueProvider::~QueueProvider()
 {
     VK_ASSERT(table_->vkQueueWaitIdle(mainQueue_.GetHardwareQueue()));
+    if (computeQueue_ != nullptr)
+    {
+        VK_ASSERT(table_->vkQueueWaitIdle(computeQueue_->GetHardwareQueue()));
+    }
 }
 
 Queue* QueueProvider::GetLoadingQueue()
@@ -58,6 +70,11 @@ Queue* QueueProvider::GetPresentationQueue()
     return &mainQueue_;
 }
 
+Queue* QueueProvider::GetComputeQueue()
+{
+    return computeQueue_.get();
+}
+
 std::uint32_t QueueProvider::FindFamilyIndex(LogicalDevice const* device, DeviceQueueType type, std::uint32_t requiredCount)
 {
     std::uint32_t constexpr INVALID_RESULT = std::numeric_limits<std::uint32_t>::max();
@@ -67,7 +84,7 @@ std::uint32_t QueueProvider::FindFamilyIndex(LogicalDevice const* device, Device
         return result;
     }
 
-    bool const presentRequired = type == DeviceQueueType::GRAPHICS_PRESENT;
+    bool const presentRequired = type == DeviceQueueType::GRAPHICS_PRESENT && !device->IsHeadless();
 
     std::uint32_t const familyCount = device->QueueFamilyCount();
     for (std::uint32_t i = 0u; i < familyCount; ++i) {
@@ -85,7 +102,8 @@ std::uint32_t QueueProvider::FindFamilyIndex(LogicalDevice const* device, Device
         }
     }
 
-    assert(result != INVALID_RESULT && "Couldn't find queue family index for WorkerGroup");
+    // only the graphics queue is required, compute and transfer families are optional
+    assert((result != INVALID_RESULT || type != DeviceQueueType::GRAPHICS_PRESENT) && "Couldn't find queue family index for WorkerGroup");
 
     return result;
 }
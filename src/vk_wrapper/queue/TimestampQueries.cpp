@@ -0,0 +1,171 @@
+#include <vk_wrapper\queue\TimestampQueries.hpp>
+
+#include <vk_wrapper\ImportTable.hpp>
+#include <vk_wrapper\LogicalDevice.hpp>
+#include <vk_wrapper\Context.hpp>
+#include <vk_wrapper\Tools.hpp>
+
+#include <cstdio>
+
+namespace VKW
+{
+
+TimestampQueries::TimestampQueries(ImportTable* table, LogicalDevice* device, std::uint32_t queueFamily)
+    : m_Table{ table }
+    , m_Device{ device }
+    , m_Supported{ false }
+    , m_TimestampPeriodNS{ 0.0f }
+    , m_TimestampMask{ 0 }
+    , m_QueryPools{}
+    , m_CurrentFrameID{ 0 }
+    , m_FrameActive{ false }
+    , m_Depth{ 0 }
+{
+    LogicalDevice::PhysicalDeviceProperties const& properties = m_Device->Properties();
+    std::uint32_t const validBits = properties.queueFamilyProperties[queueFamily].timestampValidBits;
+
+    m_TimestampPeriodNS = properties.properties2.properties.limits.timestampPeriod;
+    m_Supported = validBits != 0 && m_TimestampPeriodNS > 0.0f;
+    if (!m_Supported)
+        return;
+
+    m_TimestampMask = validBits >= 64 ? DRE_U64_MAX : ((std::uint64_t{ 1 } << validBits) - 1);
+
+    VkQueryPoolCreateInfo info;
+    info.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+    info.pNext = nullptr;
+    info.flags = VK_FLAGS_NONE;
+    info.queryType = VK_QUERY_TYPE_TIMESTAMP;
+    info.queryCount = MAX_SCOPES * 2;
+    info.pipelineStatistics = VK_FLAGS_NONE;
+
+    for (std::uint32_t i = 0; i < CONSTANTS::FRAMES_BUFFERING; i++)
+    {
+        VK_ASSERT(m_Table->vkCreateQueryPool(m_Device->Handle(), &info, nullptr, &m_QueryPools[i]));
+        // host reset so the first BeginFrame doesn't read garbage
+        m_Table->vkResetQueryPool(m_Device->Handle(), m_QueryPools[i], 0, MAX_SCOPES * 2);
+    }
+}
+
+TimestampQueries::~TimestampQueries()
+{
+    for (std::uint32_t i = 0; i < CONSTANTS::FRAMES_BUFFERING; i++)
+    {
+        if (m_QueryPools[i] != VK_NULL_HANDLE)
+            m_Table->vkDestroyQueryPool(m_Device->Handle(), m_QueryPools[i], nullptr);
+    }
+}
+
+void TimestampQueries::BeginFrame(Context& context, std::uint8_t frameID)
+{
+    DRE_ASSERT(!m_FrameActive, "TimestampQueries: BeginFrame called twice.");
+    if (!m_Supported)
+        return;
+
+    ResolveFrame(frameID);
+
+    m_CurrentFrameID = frameID;
+    m_FrameActive = true;
+    m_Depth = 0;
+    m_FrameScopes[frameID].Clear();
+
+    m_Table->vkCmdResetQueryPool(*context.GetCurrentCommandList(), m_QueryPools[frameID], 0, MAX_SCOPES * 2);
+}
+
+void TimestampQueries::EndFrame()
+{
+    DRE_ASSERT(m_Depth == 0, "TimestampQueries: frame ended with open scopes.");
+    m_FrameActive = false;
+}
+
+std::uint32_t TimestampQueries::BeginScope(Context& context, char const* name)
+{
+    auto& scopes = m_FrameScopes[m_CurrentFrameID];
+    if (!m_FrameActive || scopes.Size() >= MAX_SCOPES)
+        return INVALID_SCOPE;
+
+    std::uint32_t const scope = scopes.Size();
+    scopes.EmplaceBack(Scope{ name, m_Depth++, false });
+
+    m_Table->vkCmdWriteTimestamp2(*context.GetCurrentCommandList(), VK_PIPELINE_STAGE_2_TOP_OF_PIPE_BIT, m_QueryPools[m_CurrentFrameID], scope * 2);
+
+    return scope;
+}
+
+void TimestampQueries::EndScope(Context& context, std::uint32_t scope)
+{
+    if (scope == INVALID_SCOPE || !m_FrameActive)
+        return;
+
+    m_FrameScopes[m_CurrentFrameID][scope].m_Closed = true;
+    m_Depth--;
+
+    m_Table->vkCmdWriteTimestamp2(*context.GetCurrentCommandList(), VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT, m_QueryPools[m_CurrentFrameID], scope * 2 + 1);
+}
+
+void TimestampQueries::ResolveFrame(std::uint8_t frameID)
+{
+    // a queue can have frames without scopes (async compute with no async passes), old results don't carry over
+    auto const& scopes = m_FrameScopes[frameID];
+    if (scopes.Size() == 0)
+    {
+        m_Results.Clear();
+        return;
+    }
+
+    // value + availability per query, the frame's completion point was already waited on so everything should be there
+    std::uint64_t data[MAX_SCOPES * 2][2];
+    VkResult const result = m_Table->vkGetQueryPoolResults(
+        m_Device->Handle(), m_QueryPools[frameID], 0, scopes.Size() * 2,
+        sizeof(data), data, sizeof(data[0]),
+        VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT);
+
+    if (result != VK_SUCCESS && result != VK_NOT_READY)
+        return;
+
+    m_Results.Clear();
+    for (std::uint32_t i = 0, size = scopes.Size(); i < size; i++)
+    {
+        Scope const& scope = scopes[i];
+        std::uint64_t const* begin = data[i * 2];
+        std::uint64_t const* end = data[i * 2 + 1];
+
+        float timeMS = 0.0f;
+        if (scope.m_Closed && begin[1] != 0 && end[1] != 0)
+        {
+            std::uint64_t const ticks = ((end[0] & m_TimestampMask) - (begin[0] & m_TimestampMask)) & m_TimestampMask;
+            timeMS = static_cast<float>(static_cast<double>(ticks) * m_TimestampPeriodNS / 1000000.0);
+        }
+
+        m_Results.EmplaceBack(ScopeResult{ scope.m_Name, scope.m_Depth, timeMS });
+    }
+}
+
+float TimestampQueries::GetFrameTimeMS() const
+{
+    float result = 0.0f;
+    for (std::uint32_t i = 0, size = m_Results.Size(); i < size; i++)
+    {
+        if (m_Results[i].m_Depth == 0)
+            result += m_Results[i].m_TimeMS;
+    }
+    return result;
+}
+
+bool TimestampQueries::WriteResults(char const* path) const
+{
+    std::FILE* file = std::fopen(path, "w");
+    if (file == nullptr)
+        return false;
+
+    std::fprintf(file, "scope,depth,gpu_ms\n");
+    for (std::uint32_t i = 0, size = m_Results.Size(); i < size; i++)
+    {
+        ScopeResult const& result = m_Results[i];
+        std::fprintf(file, "%s,%u,%.4f\n", result.m_Name, result.m_Depth, result.m_TimeMS);
+    }
+
+    return std::fclose(file) == 0;
+}
+
+}
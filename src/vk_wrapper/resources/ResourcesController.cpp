@@ -1,6 +1,7 @@
 #include <vk_wrapper\resources\ResourcesController.hpp>
 
 #include <algorithm>
+#include <vector>
 
 #include <foundation\string\InplaceString.hpp>
 
@@ -42,6 +43,9 @@ ResourcesController& ResourcesController::operator=(ResourcesController&& rhs)
     std::swap(buffers_, rhs.buffers_);
     std::swap(images_, rhs.images_);
     std::swap(imageViewMap_, rhs.imageViewMap_);
+
+    std::swap(releasedImageStateSlots_, rhs.releasedImageStateSlots_);
+    std::swap(releasedBufferStateSlots_, rhs.releasedBufferStateSlots_);
     
     return *this;
 }
@@ -58,19 +62,32 @@ ResourcesController::~ResourcesController()
 
     for (auto& imageResource : images_) {
         table_->vkDestroyImage(device, imageResource->handle_, nullptr);
-        memoryController_->ReleaseMemoryRegion(imageResource->memory_);
+        if (!imageResource->placed_)
+            memoryController_->ReleaseMemoryRegion(imageResource->memory_);
         delete imageResource;
     }
 }
 
 BufferResource* ResourcesController::CreateBuffer(std::uint32_t size, BufferUsage usage, char const* name)
 {
+    // buffers are shared by all queues, only images go through ownership transfers
+    // compute and transfer can land in the same family, concurrent sharing wants every index once
+    std::vector<std::uint32_t> queueFamilies;
+    queueFamilies.reserve(device_->QueueFamilyCount());
+    for (std::uint32_t i = 0; i < device_->QueueFamilyCount(); i++)
+    {
+        std::uint32_t const familyIndex = device_->GetQueueFamily(i).familyIndex_;
+        if (std::find(queueFamilies.begin(), queueFamilies.end(), familyIndex) == queueFamilies.end())
+            queueFamilies.emplace_back(familyIndex);
+    }
+    std::uint32_t const queueFamiliesCount = static_cast<std::uint32_t>(queueFamilies.size());
+
     VkBufferCreateInfo vkBufferCreateInfo;
     vkBufferCreateInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
     vkBufferCreateInfo.pNext = nullptr;
-    vkBufferCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-    vkBufferCreateInfo.queueFamilyIndexCount = 0;
-    vkBufferCreateInfo.pQueueFamilyIndices = nullptr;
+    vkBufferCreateInfo.sharingMode = queueFamiliesCount > 1 ? VK_SHARING_MODE_CONCURRENT : VK_SHARING_MODE_EXCLUSIVE;
+    vkBufferCreateInfo.queueFamilyIndexCount = queueFamiliesCount > 1 ? queueFamiliesCount : 0;
+    vkBufferCreateInfo.pQueueFamilyIndices = queueFamiliesCount > 1 ? queueFamilies.data() : nullptr;
     vkBufferCreateInfo.size = size;
     vkBufferCreateInfo.flags = VK_FLAGS_NONE;
     vkBufferCreateInfo.usage = VK_FLAGS_NONE; // temp value, assigned below
@@ -162,9 +179,8 @@ BufferResource* ResourcesController::CreateBuffer(std::uint32_t size, BufferUsag
     return resource;
 }
 
-ImageResource* ResourcesController::CreateImage(std::uint32_t width, std::uint32_t height, Format format, ImageUsage usage, char const* name)
+static void FillImageCreateInfo(std::uint32_t width, std::uint32_t height, Format format, ImageUsage usage, VkImageCreateInfo& info, MemoryClass& memoryClass)
 {
-    VkImageCreateInfo info;
     info.sType                  = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
     info.pNext                  = nullptr;
     info.format                 = Format2VK(format);
@@ -182,20 +198,18 @@ ImageResource* ResourcesController::CreateImage(std::uint32_t width, std::uint32
     info.initialLayout          = VK_IMAGE_LAYOUT_UNDEFINED;
     info.flags                  = VK_FLAGS_NONE;
 
-    MemoryPageRegionDesc memoryDesc;
-
     switch (usage)
     {
     case ImageUsage::TEXTURE:
         info.usage = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
-        memoryDesc.memoryClass_ = MemoryClass::DeviceFast;
+        memoryClass = MemoryClass::DeviceFast;
         break;
         
     case ImageUsage::STORAGE_IMAGE:
         info.usage = VK_IMAGE_USAGE_TRANSFER_SRC_BIT | 
             VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
 
-        memoryDesc.memoryClass_ = MemoryClass::DeviceFast;
+        memoryClass = MemoryClass::DeviceFast;
         break;
 
     case ImageUsage::RENDER_TARGET:
@@ -203,31 +217,37 @@ ImageResource* ResourcesController::CreateImage(std::uint32_t width, std::uint32
             VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | 
             VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
 
-        memoryDesc.memoryClass_ = MemoryClass::DeviceFast;
+        memoryClass = MemoryClass::DeviceFast;
         break;
 
     case ImageUsage::DEPTH:
     case ImageUsage::STENCIL:
     case ImageUsage::DEPTH_STENCIL:
         info.usage = VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
-        memoryDesc.memoryClass_ = MemoryClass::DeviceFast;
+        memoryClass = MemoryClass::DeviceFast;
         break;
 
     case ImageUsage::DEPTH_SAMPLED:
         info.usage = VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
-        memoryDesc.memoryClass_ = MemoryClass::DeviceFast;
+        memoryClass = MemoryClass::DeviceFast;
         break;
 
     case ImageUsage::UPLOAD_IMAGE:
         info.usage = VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
         info.tiling = VK_IMAGE_TILING_LINEAR;
-        memoryDesc.memoryClass_ = MemoryClass::CpuStaging;
+        memoryClass = MemoryClass::CpuStaging;
         break;
     default:
         assert(false && "Non-supported usage for image.");
         break;
     }
+}
 
+ImageResource* ResourcesController::CreateImage(std::uint32_t width, std::uint32_t height, Format format, ImageUsage usage, char const* name)
+{
+    VkImageCreateInfo info;
+    MemoryPageRegionDesc memoryDesc;
+    FillImageCreateInfo(width, height, format, usage, info, memoryDesc.memoryClass_);
 
     VkImage vkImage = VK_NULL_HANDLE;
     VK_ASSERT(table_->vkCreateImage(device_->Handle(), &info, nullptr, &vkImage));
@@ -245,6 +265,76 @@ ImageResource* ResourcesController::CreateImage(std::uint32_t width, std::uint32
     ImageResource* imageResource = new ImageResource{ vkImage, format, width, height, memoryRegion, info, name };
     images_.emplace(imageResource);
 
+    SetImageDebugName(vkImage, name);
+
+    return imageResource;
+}
+
+VkMemoryRequirements ResourcesController::GetImageMemoryRequirements(std::uint32_t width, std::uint32_t height, Format format, ImageUsage usage)
+{
+    VkImageCreateInfo info;
+    MemoryClass memoryClass;
+    FillImageCreateInfo(width, height, format, usage, info, memoryClass);
+
+    VkImage vkImage = VK_NULL_HANDLE;
+    VK_ASSERT(table_->vkCreateImage(device_->Handle(), &info, nullptr, &vkImage));
+
+    VkMemoryRequirements memoryRequirements;
+    table_->vkGetImageMemoryRequirements(device_->Handle(), vkImage, &memoryRequirements);
+
+    table_->vkDestroyImage(device_->Handle(), vkImage, nullptr);
+
+    return memoryRequirements;
+}
+
+MemoryRegion ResourcesController::AllocateImageHeap(std::uint64_t size, std::uint64_t alignment, std::uint32_t memoryTypeBits)
+{
+    MemoryPageRegionDesc memoryDesc;
+    memoryDesc.size_ = size;
+    memoryDesc.alignment_ = alignment;
+    memoryDesc.memoryTypeBits_ = memoryTypeBits;
+    memoryDesc.memoryClass_ = MemoryClass::DeviceFast;
+
+    return memoryController_->AllocateMemoryRegion(memoryDesc);
+}
+
+void ResourcesController::FreeImageHeap(MemoryRegion& heap)
+{
+    memoryController_->ReleaseMemoryRegion(heap);
+}
+
+ImageResource* ResourcesController::CreatePlacedImage(std::uint32_t width, std::uint32_t height, Format format, ImageUsage usage, char const* name, MemoryRegion const& heap, std::uint64_t offset)
+{
+    VkImageCreateInfo info;
+    MemoryClass memoryClass;
+    FillImageCreateInfo(width, height, format, usage, info, memoryClass);
+    // aliased memory may be written through other images, content is undefined until the first write
+    info.flags |= VK_IMAGE_CREATE_ALIAS_BIT;
+
+    VkImage vkImage = VK_NULL_HANDLE;
+    VK_ASSERT(table_->vkCreateImage(device_->Handle(), &info, nullptr, &vkImage));
+
+    VkMemoryRequirements memoryRequirements;
+    table_->vkGetImageMemoryRequirements(device_->Handle(), vkImage, &memoryRequirements);
+
+    DRE_ASSERT(memoryClass == MemoryClass::DeviceFast, "Only device memory can be placed.");
+    DRE_ASSERT(offset % memoryRequirements.alignment == 0, "Misaligned placed image.");
+    DRE_ASSERT(offset + memoryRequirements.size <= heap.size_, "Placed image is out of the heap.");
+
+    MemoryRegion const memoryRegion{ heap.page_, heap.offset_ + offset, memoryRequirements.size };
+    VK_ASSERT(table_->vkBindImageMemory(device_->Handle(), vkImage, memoryRegion.page_->deviceMemory_, memoryRegion.offset_));
+
+    ImageResource* imageResource = new ImageResource{ vkImage, format, width, height, memoryRegion, info, name };
+    imageResource->placed_ = true;
+    images_.emplace(imageResource);
+
+    SetImageDebugName(vkImage, name);
+
+    return imageResource;
+}
+
+void ResourcesController::SetImageDebugName(VkImage image, char const* name)
+{
 #ifdef DRE_DEBUG
     DRE::String128 nameBuffer{ "IMAGE|" };
     nameBuffer.Append(name);
@@ -253,13 +343,11 @@ ImageResource* ResourcesController::CreateImage(std::uint32_t width, std::uint32
     nameInfo.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_OBJECT_NAME_INFO_EXT;
     nameInfo.pNext = nullptr;
     nameInfo.objectType = VK_OBJECT_TYPE_IMAGE;
-    nameInfo.objectHandle = (std::uint64_t)vkImage;
+    nameInfo.objectHandle = (std::uint64_t)image;
     nameInfo.pObjectName = nameBuffer.GetData();
 
     VK_ASSERT(table_->vkSetDebugUtilsObjectNameEXT(device_->Handle(), &nameInfo));
 #endif
-
-    return imageResource;
 }
 
 void ResourcesController::FreeBuffer(BufferResource* buffer)
@@ -267,6 +355,9 @@ void ResourcesController::FreeBuffer(BufferResource* buffer)
     auto bufferIt = buffers_.find(buffer);
     assert(bufferIt != buffers_.end() && "Can't free BufferResource.");
 
+    if (buffer->stateSlot_ != DRE_U32_MAX)
+        releasedBufferStateSlots_.emplace_back(buffer->stateSlot_);
+
     table_->vkDestroyBuffer(device_->Handle(), buffer->handle_, nullptr);
     delete buffer;
 
@@ -286,6 +377,9 @@ void ResourcesController::FreeImage(ImageResource* image)
     }
     imageViewMap_.erase(views.first, views.second);
 
+    if (image->stateSlot_ != DRE_U32_MAX)
+        releasedImageStateSlots_.emplace_back(image->stateSlot_);
+
     table_->vkDestroyImage(device_->Handle(), image->handle_, nullptr);
     delete image;
 